@@ -0,0 +1,1234 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <queue>
+#include <set>
+#include <shared_mutex>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && __has_include(<span>)
+#include <span>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+/**
+* **BENCHMARKS - EVERY STRUCTURE AGAINST THE STANDARD LIBRARY**
+*
+*   === DynamicArray vs std::vector ===
+*   pushBack<int>            DynamicArray      std::vector     ratio
+*     n = 1000                 1.52 ns/op        1.61 ns/op     0.94
+*     n = 1000000              1.38 ns/op        1.47 ns/op     0.94
+*
+* Every project in this repository is a standalone program with its own main().
+* This file compiles all of them into one binary. Each source is included inside
+* its own namespace (arrays::, dynamic::, ... graphs::), so names that two projects
+* both define cannot collide, and the demo main()s become ordinary functions that
+* are never called. Nothing in the projects changes to be benchmarked.
+*
+* The standard headers the projects use are included above, before any project.
+* Their include guards then keep them out of the namespaces. A project that starts
+* using a new standard header needs it added to that list.
+*
+* Each operation is timed on sizes 10, 100, ... up to --max-size, for int and, where
+* the structure stores values, for std::string (24 characters, past the small-string
+* buffer, so every string owns heap memory). The result is nanoseconds per element
+* operation, next to the same work on the std container. Ratio = ours / std, so
+* below 1 is faster.
+*
+* Usage:
+*   benchmarks                          every suite, sizes 10 .. 10^6
+*   benchmarks --max-size 100000000     sweep up to 10^8
+*   benchmarks --filter DynamicArray    only operations whose name contains the text
+*   benchmarks --min-time 50            time each sample for at least 50 ms (default 20)
+*   benchmarks --json results.json      also write every measurement as JSON
+*   benchmarks --baseline results.json  compare with an earlier run; exit code 1 on regression
+*   benchmarks --tolerance 0.15         growth over the baseline that counts as a regression (default 0.25)
+*   benchmarks --noise-floor 5          judge only measurements of at least 5 ns/op (default 1)
+*/
+
+// ***************  STRUCTURES UNDER TEST  ****************
+
+namespace arrays {
+#include "../Linear-DS-Arrays/Linear-DS-Arrays.cpp"
+}
+namespace dynamic {
+#include "../Linear-DS-Dynamic-Arrays/Linear-DS-Dynamic-Arrays.cpp"
+}
+namespace lists {
+#include "../Linear-DS-Linked-Lists/Linear-DS-Linked-Lists.cpp"
+}
+namespace stacks {
+#include "../Linear-DS-Stacks/Linear-DS-Stacks.cpp"
+}
+namespace queues {
+#include "../Linear-DS-Queues/Linear-DS-Queues.cpp"
+}
+namespace deques {
+#include "../Linear-DS-Deques/Linear-DS-Deques.cpp"
+}
+namespace trees {
+#include "../Non-Linear-DS-Trees/Non-Linear-DS-Trees.cpp"
+}
+namespace hashing {
+#include "../Non-Linear-DS-Hash-Tables/Non-Linear-DS-Hash-Tables.cpp"
+}
+namespace graphs {
+#include "../Non-Linear-DS-Graphs/Non-Linear-DS-Graphs.cpp"
+}
+
+using namespace std;
+
+// ***************  HARNESS  ****************
+
+using Clock = chrono::steady_clock;
+
+// The escape hatch for doNotOptimize on compilers without GNU inline assembly.
+volatile const void* benchmarkSink = nullptr;
+
+/**
+* @brief Keeps the compiler from deleting work whose result is never used.
+*
+* The value is handed to an empty asm statement as an input, so the computation
+* that produced it must happen. The "memory" clobber also forces pending stores
+* (the elements a push just wrote) to be made before the timer stops.
+*/
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    benchmarkSink = &value;
+    atomic_signal_fence(memory_order_seq_cst);
+#endif
+}
+
+// SplitMix64: a fast, deterministic generator, so every run sees the same data.
+inline uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Test values. Keys derived from different seeds are (almost always) distinct, which
+// gives lookups that miss.
+template <typename T> T makeValue(uint64_t seed, size_t i);
+
+template <> int makeValue<int>(uint64_t seed, size_t i) {
+    return static_cast<int>(mix64(seed ^ (i * 0xD6E8FEB86659FD93ULL)) & 0x7FFFFFFF);
+}
+
+template <> string makeValue<string>(uint64_t seed, size_t i) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "user:%016llx:k",
+             static_cast<unsigned long long>(mix64(seed ^ (i * 0xD6E8FEB86659FD93ULL))));
+    return buffer;   // 23 characters
+}
+
+template <typename T>
+vector<T> makeValues(size_t n, uint64_t seed) {
+    vector<T> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; i++) values.push_back(makeValue<T>(seed, i));
+    return values;
+}
+
+template <typename T> const char* typeName();
+template <> const char* typeName<int>() { return "int"; }
+template <> const char* typeName<string>() { return "string"; }
+
+// Strings cost ~56 bytes each plus the container; 10^8 of them would need several GB per contender.
+template <typename T> size_t typeCap() { return is_same<T, string>::value ? 10000000 : SIZE_MAX; }
+
+struct Options {
+    size_t maxSize = 1000000;
+    double minTimeMs = 20;
+    unsigned samples = 3;
+    string filter;
+    string jsonPath;
+    string baselinePath;
+    double tolerance = 0.25;
+    double noiseFloorNs = 1;
+    set<string> only;     // when not empty: time only these of our measurements, and print nothing
+};
+
+// One timed contender at one size.
+struct Measurement {
+    string name;          // Structure/operation/type/size, the key for baseline comparison
+    string structure;
+    string operation;
+    string type;
+    size_t size;
+    size_t iterations;    // timed runs, summed over the samples
+    double nsPerOp;
+    double ratio;         // ours / std in the same run; 0 for the std side
+};
+
+// An operation at one size: `ops` element operations per run, used to normalise the time.
+struct Case {
+    const char* operation;
+    const char* type;
+    size_t n;
+    size_t ops;
+};
+
+struct NoState {};
+
+/**
+* @brief A named implementation of an operation.
+*
+* `setup()` builds the state a run starts from (an empty container, an unsorted
+* copy) and is not timed. `body(state)` is the work that is timed. States are
+* destroyed after the clock stops, so a container's destructor is not counted.
+*/
+template <typename Setup, typename Body>
+struct Contender {
+    const char* name;
+    Setup setup;
+    Body body;
+};
+
+template <typename Setup, typename Body>
+Contender<Setup, Body> contender(const char* name, Setup setup, Body body) {
+    return { name, std::move(setup), std::move(body) };
+}
+
+// A contender that needs no fresh state per run, e.g. searching a structure built beforehand.
+template <typename Body>
+auto contender(const char* name, Body body) {
+    return contender(name, [] { return NoState(); }, [body](NoState&) mutable { body(); });
+}
+
+/**
+* @brief Times one contender on one case, a sample at a time.
+*
+* A sample repeats runs until it has spent at least --min-time inside the timed
+* body. Small sizes are batched: the states for several runs are built first and
+* then timed back to back, so one clock read covers at least ~4096 operations.
+* The fastest sample is kept, since interference (other processes, frequency
+* changes) only ever adds time.
+*/
+template <typename C>
+class SampleTimer {
+    using State = decltype(declval<C&>().setup());
+
+    C& contender;
+    size_t ops;
+    size_t batch;
+    vector<State> states;
+
+public:
+    double best = numeric_limits<double>::infinity();   // ns per operation
+    size_t iterations = 0;
+
+    SampleTimer(const Case& c, C& contender)
+        : contender(contender), ops(c.ops > 0 ? c.ops : 1), batch(ops >= 4096 ? 1 : 4096 / ops) {
+        states.reserve(batch);
+    }
+
+    // One untimed round, so the first sample does not pay for cold caches and page faults.
+    void warmUp() {
+        for (size_t i = 0; i < batch; i++) states.push_back(contender.setup());
+        for (State& state : states) contender.body(state);
+        states.clear();
+    }
+
+    void sample(Clock::duration minTime) {
+        Clock::duration elapsed{};
+        size_t runs = 0;
+        do {
+            states.clear();
+            for (size_t i = 0; i < batch; i++) states.push_back(contender.setup());
+            Clock::time_point start = Clock::now();
+            for (State& state : states) contender.body(state);
+            elapsed += Clock::now() - start;
+            runs += batch;
+        } while (elapsed < minTime);
+        states.clear();   // before the other contender runs, so it starts with the same free memory
+        double ns = chrono::duration<double, nano>(elapsed).count() / (static_cast<double>(runs) * ops);
+        if (ns < best) best = ns;
+        iterations += runs;
+    }
+};
+
+class BenchmarkRunner {
+    Options options;
+    string suite;          // structure name of the current section
+    string reference;      // std counterpart of the current section
+    bool sectionPrinted = false;
+    string headingOperation, headingOurs, headingStd;   // what the last heading named
+    vector<Measurement> results;
+
+    template <typename C>
+    void record(const Case& c, const C& contender, const SampleTimer<C>& timer) {
+        string name = string(contender.name) + "/" + c.operation + "/" + c.type + "/" + to_string(c.n);
+        results.push_back({ name, contender.name, c.operation, c.type, c.n, timer.iterations, timer.best, 0 });
+    }
+
+public:
+    explicit BenchmarkRunner(const Options& options) : options(options) {}
+
+    // Start a section. Its title, "=== DynamicArray vs std::vector ===", is printed
+    // with the first operation the filter selects, so empty sections print nothing.
+    void section(const char* structure, const char* stdName) {
+        suite = structure;
+        reference = stdName;
+        sectionPrinted = false;
+    }
+
+    // Whether --filter is part of "Section/operation/type", or of the same path on the std side.
+    bool selected(const char* operation, const char* type) const {
+        if (options.filter.empty()) return true;
+        for (const string* owner : { &suite, &reference }) {
+            string path = *owner + "/" + operation + "/" + type;
+            if (path.find(options.filter) != string::npos) return true;
+        }
+        return false;
+    }
+
+    // Sizes 10, 100, ... up to --max-size and `cap`.
+    vector<size_t> sizes(size_t cap = SIZE_MAX) const {
+        vector<size_t> result;
+        size_t limit = min(options.maxSize, cap);
+        for (size_t n = 10; n <= limit; n *= 10) {
+            result.push_back(n);
+            if (n > SIZE_MAX / 10) break;
+        }
+        return result;
+    }
+
+    // Print the heading of one operation: "pushBack<int>   DynamicArray   std::vector   ratio".
+    void heading(const char* operation, const char* type, const char* oursName, const char* stdName) {
+        if (!options.only.empty()) return;
+        if (!sectionPrinted) {
+            cout << endl << "=== " << suite << " vs " << reference << " ===" << endl;
+            sectionPrinted = true;
+        }
+        headingOperation = operation;
+        headingOurs = oursName;
+        headingStd = stdName;
+        string label = string(operation) + "<" + type + ">";
+        printf("%-24s %16s %16s %8s\n", label.c_str(), oursName, stdName, "ratio");
+    }
+
+    /**
+    * @brief Time both contenders on one case and print one row of the table.
+    *
+    * The samples alternate, ours then std, so a slow spell of the machine lands on
+    * both sides of the ratio instead of only on whichever was running.
+    *
+    * A row whose operation or contenders differ from the heading above it names
+    * them at the end, e.g. "findMiss" or "AvlTree vs std::set".
+    */
+    template <typename Ours, typename Reference>
+    void compare(const Case& c, Ours ours, Reference reference) {
+        string oursName = string(ours.name) + "/" + c.operation + "/" + c.type + "/" + to_string(c.n);
+        if (!options.only.empty() && !options.only.count(oursName)) return;
+        auto minTime = chrono::duration_cast<Clock::duration>(chrono::duration<double, milli>(options.minTimeMs));
+        SampleTimer<Ours> oursTimer(c, ours);
+        SampleTimer<Reference> referenceTimer(c, reference);
+        oursTimer.warmUp();
+        referenceTimer.warmUp();
+        for (unsigned sample = 0; sample < options.samples; sample++) {
+            oursTimer.sample(minTime);
+            referenceTimer.sample(minTime);
+        }
+        double oursNs = oursTimer.best;
+        double referenceNs = referenceTimer.best;
+        record(c, ours, oursTimer);
+        results.back().ratio = oursNs / referenceNs;
+        record(c, reference, referenceTimer);
+        if (!options.only.empty()) return;
+        string note;
+        if (headingOperation != c.operation) note += string("  ") + c.operation;
+        if (headingOurs != ours.name || headingStd != reference.name) {
+            note += string("  ") + ours.name + " vs " + reference.name;
+        }
+        printf("  n = %-18zu %10.2f ns/op %10.2f ns/op %8.2f%s\n", c.n, oursNs, referenceNs, oursNs / referenceNs,
+               note.c_str());
+        fflush(stdout);
+    }
+
+    const vector<Measurement>& measurements() const { return results; }
+};
+
+// ***************  JSON OUTPUT & BASELINES  ****************
+
+string jsonEscape(const string& text) {
+    string out;
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+/**
+* @brief Write every measurement, plus the build context, as JSON.
+*
+* One object per contender and size. `name` is the key --baseline matches on, so
+* two runs of the same binary on the same machine can be compared line by line.
+*/
+void writeJson(const string& path, const Options& options, const vector<Measurement>& results) {
+    ofstream out(path);
+    if (!out) throw runtime_error("Cannot write " + path);
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+#if defined(DS_DISABLE_SIMD)
+    const char* simd = "disabled";
+#else
+    const char* simd = "enabled";
+#endif
+#if defined(NDEBUG)
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+#if defined(__clang__)
+    string compiler = string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    string compiler = string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    string compiler = "msvc " + to_string(_MSC_VER);
+#else
+    string compiler = "unknown";
+#endif
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n";
+    out << "    \"build_type\": \"" << build << "\",\n";
+    out << "    \"simd\": \"" << simd << "\",\n";
+    out << "    \"compiler\": \"" << jsonEscape(compiler) << "\",\n";
+    out << "    \"max_size\": " << options.maxSize << ",\n";
+    out << "    \"min_time_ms\": " << options.minTimeMs << "\n";
+    out << "  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Measurement& m = results[i];
+        char ns[32];
+        snprintf(ns, sizeof(ns), "%.4f", m.nsPerOp);
+        out << "    { \"name\": \"" << jsonEscape(m.name) << "\", \"structure\": \"" << jsonEscape(m.structure)
+            << "\", \"operation\": \"" << m.operation << "\", \"type\": \"" << m.type << "\", \"size\": " << m.size
+            << ", \"iterations\": " << m.iterations << ", \"ns_per_op\": " << ns;
+        if (m.ratio > 0) {
+            char ratio[32];
+            snprintf(ratio, sizeof(ratio), "%.4f", m.ratio);
+            out << ", \"ratio_to_std\": " << ratio;
+        }
+        out << " }"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+struct BaselineEntry {
+    double nsPerOp = 0;
+    double ratio = 0;     // 0 when the file has no ratio_to_std for the entry
+};
+
+/**
+* @brief Read the entries of a file written by writeJson, by name.
+*
+* Not a general JSON parser: it scans for each "name" and the fields that follow
+* it up to the next entry, which is all the format above contains.
+*/
+map<string, BaselineEntry> readBaseline(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("Cannot read " + path);
+    stringstream buffer;
+    buffer << in.rdbuf();
+    string text = buffer.str();
+
+    auto numberAfter = [&text](const char* field, size_t from, size_t to) {
+        size_t at = text.find(field, from);
+        if (at == string::npos || at >= to) return 0.0;
+        return strtod(text.c_str() + text.find(':', at) + 1, nullptr);
+    };
+
+    map<string, BaselineEntry> baseline;
+    size_t at = text.find("\"name\"");
+    while (at != string::npos) {
+        size_t open = text.find('"', text.find(':', at) + 1);
+        if (open == string::npos) break;
+        string name;
+        size_t i = open + 1;
+        for (; i < text.size() && text[i] != '"'; i++) {
+            if (text[i] == '\\' && i + 1 < text.size()) i++;
+            name += text[i];
+        }
+        size_t next = text.find("\"name\"", i);
+        size_t end = next == string::npos ? text.size() : next;
+        baseline[name] = { numberAfter("\"ns_per_op\"", i, end), numberAfter("\"ratio_to_std\"", i, end) };
+        at = next;
+    }
+    return baseline;
+}
+
+/**
+* @brief Judge one of our measurements against its baseline entry.
+*
+* Only our structures are judged, and on their ratio to the std contender. Both
+* sides of a ratio were timed in the same run, so a slower machine, a busy CI
+* runner or a different clock speed cancels out, while a change that slows one of
+* our structures does not. A regression is a ratio and our own ns/op that both
+* grew by more than the tolerance (0.25 = 25 %): a ratio that grew only because
+* the std side happened to run faster this time is noise, not a change of ours.
+*
+*/
+enum class Verdict { Unchanged, Regression, Improved };
+
+Verdict judge(const Measurement& m, const BaselineEntry& base, const Options& options) {
+    double change = m.ratio / base.ratio;
+    double timeChange = base.nsPerOp > 0 ? m.nsPerOp / base.nsPerOp : 1;
+    if (change > 1 + options.tolerance && timeChange > 1 + options.tolerance) return Verdict::Regression;
+    if (change < 1 - options.tolerance && timeChange < 1 - options.tolerance) return Verdict::Improved;
+    return Verdict::Unchanged;
+}
+
+// The baseline entry `m` can be judged against, or nullptr: none, or both runs under the noise floor.
+const BaselineEntry* comparable(const map<string, BaselineEntry>& baseline, const Measurement& m, const Options& options) {
+    auto it = baseline.find(m.name);
+    if (it == baseline.end() || !(it->second.ratio > 0)) return nullptr;
+    if (m.nsPerOp < options.noiseFloorNs && it->second.nsPerOp < options.noiseFloorNs) return nullptr;
+    return &it->second;
+}
+
+// Names of our measurements that judge() calls a regression; main() times these a second time.
+set<string> suspectedRegressions(const map<string, BaselineEntry>& baseline, const vector<Measurement>& results,
+                                 const Options& options) {
+    set<string> suspects;
+    for (const Measurement& m : results) {
+        if (m.ratio <= 0) continue;
+        const BaselineEntry* base = comparable(baseline, m, options);
+        if (base && judge(m, *base, options) == Verdict::Regression) suspects.insert(m.name);
+    }
+    return suspects;
+}
+
+/**
+* @brief Compare this run with a baseline; returns the number of regressions.
+*
+* Two runs of the same binary still differ by more than 10 % on about one entry in
+* ten, hence the wide default tolerance. The outliers come from the state of the
+* whole run (heap and code placement, a slow spell of the machine), not from the
+* operation: timed again on its own, such an entry is back in line. So a suspected
+* regression counts only if `retimed`, a second timing of just the suspects, is a
+* regression as well. Placement that differs per process is not caught this way,
+* so a failed comparison is worth repeating. Entries under the noise floor in both
+* runs take a few cycles each, where one shifted loop is already a large change,
+* and are not judged. Names present in only one of the runs are counted but not compared.
+*/
+size_t compareWithBaseline(const map<string, BaselineEntry>& baseline, const vector<Measurement>& results,
+                           const vector<Measurement>& retimed, const Options& options) {
+    map<string, const Measurement*> second;
+    for (const Measurement& m : retimed) second[m.name] = &m;
+
+    size_t compared = 0, regressions = 0, notRepeated = 0, improvements = 0, unmatched = 0, belowFloor = 0;
+    cout << endl << "=== Baseline comparison (tolerance " << options.tolerance * 100 << " %, noise floor "
+         << options.noiseFloorNs << " ns/op) ===" << endl;
+    for (const Measurement& m : results) {
+        if (m.ratio <= 0) continue;   // a std contender: the yardstick, not under test
+        auto it = baseline.find(m.name);
+        if (it == baseline.end() || !(it->second.ratio > 0)) {
+            unmatched++;
+            continue;
+        }
+        const BaselineEntry* base = comparable(baseline, m, options);
+        if (!base) {
+            belowFloor++;
+            continue;
+        }
+        compared++;
+        Verdict verdict = judge(m, *base, options);
+        if (verdict == Verdict::Unchanged) continue;
+        bool regression = verdict == Verdict::Regression;
+        if (regression) {
+            auto again = second.find(m.name);
+            if (again == second.end() || judge(*again->second, *base, options) != Verdict::Regression) {
+                notRepeated++;
+                continue;
+            }
+        }
+        (regression ? regressions : improvements)++;
+        printf("%-11s %-44s ratio %5.2f -> %5.2f (x%.2f)   %9.2f -> %9.2f ns/op\n", regression ? "REGRESSION" : "improved", m.name.c_str(),
+               base->ratio, m.ratio, m.ratio / base->ratio, base->nsPerOp, m.nsPerOp);
+    }
+    cout << compared << " compared, " << regressions << " regressions (" << notRepeated << " more not repeated when re-timed), "
+         << improvements << " improvements, " << belowFloor << " below the noise floor, " << unmatched
+         << " not in the baseline" << endl;
+    return regressions;
+}
+
+// ***************  LINEAR-DS-ARRAYS  ****************
+
+void benchArrays(BenchmarkRunner& runner) {
+    runner.section("Arrays", "std::find");
+
+    // Every search misses, so each one scans all n elements.
+    if (runner.selected("linearSearchSimd", "int")) {
+        runner.heading("linearSearchSimd", "int", "Arrays", "std::find");
+        for (size_t n : runner.sizes()) {
+            vector<int> data = makeValues<int>(n, 1);
+            int missing = -1;
+            runner.compare({ "linearSearchSimd", "int", n, n },
+                contender("Arrays", [&] { doNotOptimize(arrays::linearSearchSimd(data.data(), n, missing)); }),
+                contender("std::find", [&] { doNotOptimize(std::find(data.begin(), data.end(), missing)); }));
+        }
+    }
+
+    if (runner.selected("linearSearchSentinel", "int")) {
+        runner.heading("linearSearchSentinel", "int", "Arrays", "std::find");
+        for (size_t n : runner.sizes()) {
+            vector<int> data = makeValues<int>(n, 1);
+            int missing = -1;
+            runner.compare({ "linearSearchSentinel", "int", n, n },
+                contender("Arrays", [&] { doNotOptimize(arrays::linearSearchSentinel(data.data(), n, missing)); }),
+                contender("std::find", [&] { doNotOptimize(std::find(data.begin(), data.end(), missing)); }));
+        }
+    }
+
+    // Eight targets answered in one pass over the array, against eight separate scans.
+    if (runner.selected("linearSearchMany", "int")) {
+        runner.heading("linearSearchMany", "int", "Arrays", "std::find");
+        for (size_t n : runner.sizes()) {
+            vector<int> data = makeValues<int>(n, 1);
+            int targets[8] = { -1, -2, -3, -4, -5, -6, -7, -8 };
+            ptrdiff_t found[8];
+            runner.compare({ "linearSearchMany", "int", n, 8 * n },
+                contender("Arrays", [&] { doNotOptimize(arrays::linearSearchMany(data.data(), n, targets, 8, found)); }),
+                contender("std::find", [&] {
+                    for (int target : targets) doNotOptimize(std::find(data.begin(), data.end(), target));
+                }));
+        }
+    }
+
+    // Sorted IDs with small gaps: the compressed array is searched without decoding it to memory.
+    if (runner.selected("searchCompressed", "int")) {
+        runner.heading("searchCompressed", "int", "Arrays", "std::find");
+        for (size_t n : runner.sizes()) {
+            vector<uint32_t> ids(n);
+            uint32_t id = 1000;
+            for (size_t i = 0; i < n; i++) ids[i] = id += 1 + static_cast<uint32_t>(mix64(i) % 16);
+            arrays::FrameOfReferenceArray packed(ids.data(), n);
+            uint32_t missing = 7;
+            runner.compare({ "searchCompressed", "int", n, n },
+                contender("Arrays", [&] { doNotOptimize(arrays::linearSearch(packed, missing)); }),
+                contender("std::find", [&] { doNotOptimize(std::find(ids.begin(), ids.end(), missing)); }));
+        }
+    }
+}
+
+// ***************  LINEAR-DS-DYNAMIC-ARRAYS  ****************
+
+template <typename T>
+void benchDynamicArray(BenchmarkRunner& runner) {
+    const char* type = typeName<T>();
+    using Array = dynamic::DynamicArray<T>;
+
+    if (runner.selected("pushBack", type)) {
+        runner.heading("pushBack", type, "DynamicArray", "std::vector");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "pushBack", type, n, n },
+                contender("DynamicArray", [] { return Array(); },
+                    [&](Array& a) { for (const T& v : values) a.pushBack(v); doNotOptimize(a.data()); }),
+                contender("std::vector", [] { return vector<T>(); },
+                    [&](vector<T>& a) { for (const T& v : values) a.push_back(v); doNotOptimize(a.data()); }));
+        }
+    }
+
+    // n inserts, each in the middle of what is there so far: O(n^2) shifting, so the sweep stops early.
+    if (runner.selected("insertMiddle", type)) {
+        runner.heading("insertMiddle", type, "DynamicArray", "std::vector");
+        for (size_t n : runner.sizes(is_same<T, string>::value ? 10000 : 100000)) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "insertMiddle", type, n, n },
+                contender("DynamicArray", [] { return Array(); },
+                    [&](Array& a) { for (const T& v : values) a.insert(a.size() / 2, v); doNotOptimize(a.data()); }),
+                contender("std::vector", [] { return vector<T>(); },
+                    [&](vector<T>& a) { for (const T& v : values) a.insert(a.begin() + a.size() / 2, v); doNotOptimize(a.data()); }));
+        }
+    }
+
+    // A search that misses scans the whole array.
+    if (runner.selected("findMiss", type)) {
+        runner.heading("findMiss", type, "DynamicArray", "std::vector");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            Array ours;
+            ours.reserve(n);
+            for (const T& v : values) ours.pushBack(v);
+            T missing = makeValue<T>(2, 0);
+            runner.compare({ "findMiss", type, n, n },
+                contender("DynamicArray", [&] { doNotOptimize(ours.contains(missing)); }),
+                contender("std::vector", [&] { doNotOptimize(std::find(values.begin(), values.end(), missing)); }));
+        }
+    }
+
+    // Random input; the unsorted copy each run starts from is made in setup.
+    if (runner.selected("sort", type)) {
+        runner.heading("sort", type, "DynamicArray", "std::vector");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            Array unsorted;
+            unsorted.reserve(n);
+            for (const T& v : values) unsorted.pushBack(v);
+            runner.compare({ "sort", type, n, n },
+                contender("DynamicArray", [&] { return unsorted; },
+                    [](Array& a) { a.sortInPlace(); doNotOptimize(a.data()); }),
+                contender("std::vector", [&] { return values; },
+                    [](vector<T>& a) { std::sort(a.begin(), a.end()); doNotOptimize(a.data()); }));
+        }
+    }
+}
+
+// ***************  LINEAR-DS-LINKED-LISTS  ****************
+
+void benchLinkedLists(BenchmarkRunner& runner) {
+    runner.section("LinkedList", "std::list");
+    using List = lists::DoublyLinkedList<int>;
+
+    if (runner.selected("pushBack", "int")) {
+        runner.heading("pushBack", "int", "DoublyLinkedList", "std::list");
+        for (size_t n : runner.sizes()) {
+            vector<int> values = makeValues<int>(n, 1);
+            runner.compare({ "pushBack", "int", n, n },
+                contender("DoublyLinkedList", [] { return make_unique<List>(); },
+                    [&](unique_ptr<List>& l) { for (int v : values) l->pushBack(v); doNotOptimize(l->size()); }),
+                contender("std::list", [] { return list<int>(); },
+                    [&](list<int>& l) { for (int v : values) l.push_back(v); doNotOptimize(l.size()); }));
+        }
+    }
+
+    // Summing every element: following links, or (unrolled) reading one small array per link.
+    if (runner.selected("traverse", "int")) {
+        runner.heading("traverse", "int", "DoublyLinkedList", "std::list");
+        for (size_t n : runner.sizes()) {
+            vector<int> values = makeValues<int>(n, 1);
+            List doubly;
+            lists::UnrolledLinkedList<int> unrolled;
+            list<int> reference;
+            for (int v : values) {
+                doubly.pushBack(v);
+                unrolled.pushBack(v);
+                reference.push_back(v);
+            }
+            auto sum = [](const auto& container) {
+                int64_t total = 0;
+                for (int v : container) total += v;
+                doNotOptimize(total);
+            };
+            runner.compare({ "traverse", "int", n, n },
+                contender("DoublyLinkedList", [&] { sum(doubly); }),
+                contender("std::list", [&] { sum(reference); }));
+            runner.compare({ "traverseUnrolled", "int", n, n },
+                contender("UnrolledLinkedList", [&] { sum(unrolled); }),
+                contender("std::list", [&] { sum(reference); }));
+        }
+    }
+}
+
+// ***************  LINEAR-DS-STACKS  ****************
+
+template <typename T>
+void benchStacks(BenchmarkRunner& runner) {
+    const char* type = typeName<T>();
+
+    // n pushes, then n pops.
+    if (runner.selected("pushPop", type)) {
+        runner.heading("pushPop", type, "ArrayStack", "std::stack");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "pushPop", type, n, 2 * n },
+                contender("ArrayStack", [] { return stacks::ArrayStack<T>(); },
+                    [&](stacks::ArrayStack<T>& s) {
+                        for (const T& v : values) s.push(v);
+                        while (!s.isEmpty()) doNotOptimize(s.pop());
+                    }),
+                contender("std::stack", [] { return stack<T, vector<T>>(); },
+                    [&](stack<T, vector<T>>& s) {
+                        for (const T& v : values) s.push(v);
+                        while (!s.empty()) { doNotOptimize(s.top()); s.pop(); }
+                    }));
+            runner.compare({ "pushPopChunked", type, n, 2 * n },
+                contender("ChunkedStack", [] { return make_unique<stacks::ChunkedStack<T>>(); },
+                    [&](unique_ptr<stacks::ChunkedStack<T>>& s) {
+                        for (const T& v : values) s->push(v);
+                        while (!s->isEmpty()) doNotOptimize(s->pop());
+                    }),
+                contender("std::stack", [] { return stack<T>(); },
+                    [&](stack<T>& s) {
+                        for (const T& v : values) s.push(v);
+                        while (!s.empty()) { doNotOptimize(s.top()); s.pop(); }
+                    }));
+        }
+    }
+}
+
+// ***************  LINEAR-DS-QUEUES  ****************
+
+template <typename T>
+void benchQueues(BenchmarkRunner& runner) {
+    const char* type = typeName<T>();
+
+    // n enqueues, then n dequeues.
+    if (runner.selected("enqueueDequeue", type)) {
+        runner.heading("enqueueDequeue", type, "CircularQueue", "std::queue");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "enqueueDequeue", type, n, 2 * n },
+                contender("CircularQueue", [] { return queues::CircularQueue<T>(); },
+                    [&](queues::CircularQueue<T>& q) {
+                        for (const T& v : values) q.enqueue(v);
+                        while (!q.isEmpty()) doNotOptimize(q.dequeue());
+                    }),
+                contender("std::queue", [] { return queue<T>(); },
+                    [&](queue<T>& q) {
+                        for (const T& v : values) q.push(v);
+                        while (!q.empty()) { doNotOptimize(q.front()); q.pop(); }
+                    }));
+        }
+    }
+
+    // n random pushes, then pop everything in order (a heap sort through the queue).
+    if (runner.selected("heapPushPop", type)) {
+        runner.heading("heapPushPop", type, "PriorityQueue", "std::priority_queue");
+        using MinQueue = priority_queue<T, vector<T>, greater<T>>;
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "heapPushPop", type, n, 2 * n },
+                contender("PriorityQueue", [] { return queues::PriorityQueue<T>(); },
+                    [&](queues::PriorityQueue<T>& q) {
+                        for (const T& v : values) q.push(v);
+                        while (q.size() > 0) { doNotOptimize(q.top()); q.pop(); }
+                    }),
+                contender("std::priority_queue", [] { return MinQueue(); },
+                    [&](MinQueue& q) {
+                        for (const T& v : values) q.push(v);
+                        while (!q.empty()) { doNotOptimize(q.top()); q.pop(); }
+                    }));
+        }
+    }
+}
+
+// ***************  LINEAR-DS-DEQUES  ****************
+
+template <typename T>
+void benchDeques(BenchmarkRunner& runner) {
+    const char* type = typeName<T>();
+
+    // Alternate pushFront / pushBack, then pop everything from the front.
+    if (runner.selected("pushBothEnds", type)) {
+        runner.heading("pushBothEnds", type, "Deque", "std::deque");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            runner.compare({ "pushBothEnds", type, n, 2 * n },
+                contender("Deque", [] { return deques::Deque<T>(); },
+                    [&](deques::Deque<T>& d) {
+                        for (size_t i = 0; i < n; i++) {
+                            if (i & 1) d.pushFront(values[i]);
+                            else d.pushBack(values[i]);
+                        }
+                        while (!d.isEmpty()) { doNotOptimize(d.peekFront()); d.popFront(); }
+                    }),
+                contender("std::deque", [] { return deque<T>(); },
+                    [&](deque<T>& d) {
+                        for (size_t i = 0; i < n; i++) {
+                            if (i & 1) d.push_front(values[i]);
+                            else d.push_back(values[i]);
+                        }
+                        while (!d.empty()) { doNotOptimize(d.front()); d.pop_front(); }
+                    }));
+        }
+    }
+
+    // Random indexing: each access finds the block, then the slot.
+    if (runner.selected("randomAccess", type)) {
+        runner.heading("randomAccess", type, "Deque", "std::deque");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> values = makeValues<T>(n, 1);
+            deques::Deque<T> ours;
+            deque<T> reference;
+            for (const T& v : values) {
+                ours.pushBack(v);
+                reference.push_back(v);
+            }
+            vector<size_t> order(n);
+            for (size_t i = 0; i < n; i++) order[i] = mix64(i) % n;
+            runner.compare({ "randomAccess", type, n, n },
+                contender("Deque", [&] { for (size_t i : order) doNotOptimize(ours[i]); }),
+                contender("std::deque", [&] { for (size_t i : order) doNotOptimize(reference[i]); }));
+        }
+    }
+}
+
+// ***************  NON-LINEAR-DS-TREES  ****************
+
+void benchTrees(BenchmarkRunner& runner) {
+    runner.section("Trees", "std::map");
+    using Tree = trees::BPlusTree<int, int>;
+
+    if (runner.selected("insert", "int")) {
+        runner.heading("insert", "int", "BPlusTree", "std::map");
+        for (size_t n : runner.sizes()) {
+            vector<int> keys = makeValues<int>(n, 1);
+            runner.compare({ "insert", "int", n, n },
+                contender("BPlusTree", [] { return make_unique<Tree>(); },
+                    [&](unique_ptr<Tree>& t) { for (int k : keys) t->insert(k, k); doNotOptimize(t->size()); }),
+                contender("std::map", [] { return map<int, int>(); },
+                    [&](map<int, int>& t) { for (int k : keys) t.emplace(k, k); doNotOptimize(t.size()); }));
+            runner.compare({ "insert", "int", n, n },
+                contender("AvlTree", [] { return make_unique<trees::AvlTree<int>>(); },
+                    [&](unique_ptr<trees::AvlTree<int>>& t) { for (int k : keys) t->insert(k); doNotOptimize(t->size()); }),
+                contender("std::set", [] { return set<int>(); },
+                    [&](set<int>& t) { for (int k : keys) t.insert(k); doNotOptimize(t.size()); }));
+        }
+    }
+
+    // Lookups of present keys, in an order unrelated to the key order.
+    if (runner.selected("find", "int")) {
+        runner.heading("find", "int", "BPlusTree", "std::map");
+        for (size_t n : runner.sizes()) {
+            vector<int> keys = makeValues<int>(n, 1);
+            Tree bplus;
+            trees::AvlTree<int> avl;
+            map<int, int> ordered;
+            set<int> keySet;
+            for (int k : keys) {
+                bplus.insert(k, k);
+                avl.insert(k);
+                ordered.emplace(k, k);
+                keySet.insert(k);
+            }
+            vector<int> queries(n);
+            for (size_t i = 0; i < n; i++) queries[i] = keys[mix64(i) % n];
+            runner.compare({ "find", "int", n, n },
+                contender("BPlusTree", [&] { for (int q : queries) doNotOptimize(bplus.find(q)); }),
+                contender("std::map", [&] { for (int q : queries) doNotOptimize(ordered.find(q)); }));
+            runner.compare({ "find", "int", n, n },
+                contender("AvlTree", [&] { for (int q : queries) doNotOptimize(avl.contains(q)); }),
+                contender("std::set", [&] { for (int q : queries) doNotOptimize(keySet.count(q)); }));
+        }
+    }
+
+    // String keys: the radix tree against an ordered map of strings.
+    if (runner.selected("insert", "string") || runner.selected("find", "string")) {
+        runner.heading("insert", "string", "AdaptiveRadixTree", "std::map");
+        using Radix = trees::AdaptiveRadixTree<int>;
+        for (size_t n : runner.sizes(typeCap<string>())) {
+            vector<string> keys = makeValues<string>(n, 1);
+            runner.compare({ "insert", "string", n, n },
+                contender("AdaptiveRadixTree", [] { return make_unique<Radix>(); },
+                    [&](unique_ptr<Radix>& t) { for (const string& k : keys) t->insert(k, 1); doNotOptimize(t->size()); }),
+                contender("std::map", [] { return map<string, int>(); },
+                    [&](map<string, int>& t) { for (const string& k : keys) t.emplace(k, 1); doNotOptimize(t.size()); }));
+
+            Radix radix;
+            map<string, int> ordered;
+            for (const string& k : keys) {
+                radix.insert(k, 1);
+                ordered.emplace(k, 1);
+            }
+            vector<size_t> order(n);
+            for (size_t i = 0; i < n; i++) order[i] = mix64(i) % n;
+            runner.compare({ "find", "string", n, n },
+                contender("AdaptiveRadixTree", [&] { for (size_t i : order) doNotOptimize(radix.find(keys[i])); }),
+                contender("std::map", [&] { for (size_t i : order) doNotOptimize(ordered.find(keys[i])); }));
+        }
+    }
+}
+
+// ***************  NON-LINEAR-DS-HASH-TABLES  ****************
+
+template <typename T>
+void benchHashTables(BenchmarkRunner& runner) {
+    const char* type = typeName<T>();
+    using Map = hashing::FlatHashMap<T, int>;
+
+    if (runner.selected("insert", type)) {
+        runner.heading("insert", type, "FlatHashMap", "std::unordered_map");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> keys = makeValues<T>(n, 1);
+            runner.compare({ "insert", type, n, n },
+                contender("FlatHashMap", [] { return Map(); },
+                    [&](Map& m) { for (const T& k : keys) m.insert(k, 1); doNotOptimize(m.size()); }),
+                contender("std::unordered_map", [] { return unordered_map<T, int>(); },
+                    [&](unordered_map<T, int>& m) { for (const T& k : keys) m.emplace(k, 1); doNotOptimize(m.size()); }));
+        }
+    }
+
+    // Lookups of present keys in random order, and of keys that are absent.
+    if (runner.selected("findHit", type) || runner.selected("findMiss", type)) {
+        runner.heading("findHit", type, "FlatHashMap", "std::unordered_map");
+        for (size_t n : runner.sizes(typeCap<T>())) {
+            vector<T> keys = makeValues<T>(n, 1);
+            vector<T> absent = makeValues<T>(n, 2);
+            Map ours;
+            unordered_map<T, int> reference;
+            for (const T& k : keys) {
+                ours.insert(k, 1);
+                reference.emplace(k, 1);
+            }
+            vector<size_t> order(n);
+            for (size_t i = 0; i < n; i++) order[i] = mix64(i) % n;
+            runner.compare({ "findHit", type, n, n },
+                contender("FlatHashMap", [&] { for (size_t i : order) doNotOptimize(ours.find(keys[i])); }),
+                contender("std::unordered_map", [&] { for (size_t i : order) doNotOptimize(reference.find(keys[i])); }));
+            runner.compare({ "findMiss", type, n, n },
+                contender("FlatHashMap", [&] { for (const T& k : absent) doNotOptimize(ours.find(k)); }),
+                contender("std::unordered_map", [&] { for (const T& k : absent) doNotOptimize(reference.find(k)); }));
+        }
+    }
+}
+
+// ***************  NON-LINEAR-DS-GRAPHS  ****************
+
+// The textbook adjacency list the CSR graph replaces.
+struct AdjacencyList {
+    vector<vector<pair<uint32_t, uint32_t>>> out;   // (target, weight)
+
+    AdjacencyList(size_t n, const vector<graphs::Edge<uint32_t>>& edges) : out(n) {
+        for (const auto& e : edges) {
+            out[e.from].push_back({ e.to, e.weight });
+            out[e.to].push_back({ e.from, e.weight });
+        }
+    }
+};
+
+// Random undirected graph with n vertices, 8n edges and weights 1..100.
+vector<graphs::Edge<uint32_t>> randomEdges(size_t n) {
+    vector<graphs::Edge<uint32_t>> edges(8 * n);
+    for (size_t i = 0; i < edges.size(); i++) {
+        uint64_t r = mix64(i);
+        edges[i] = { static_cast<uint32_t>(r % n), static_cast<uint32_t>((r >> 32) % n),
+                     static_cast<uint32_t>(1 + (r >> 20) % 100) };
+    }
+    return edges;
+}
+
+// Times are per edge, since every algorithm here is O(V + E).
+void benchGraphs(BenchmarkRunner& runner) {
+    runner.section("Graphs", "std::vector adjacency list");
+    using Graph = graphs::CsrGraph<uint32_t>;
+    const size_t graphCap = 10000000;
+
+    if (runner.selected("build", "int")) {
+        runner.heading("build", "int", "CsrGraph", "AdjacencyList");
+        for (size_t n : runner.sizes(graphCap)) {
+            vector<graphs::Edge<uint32_t>> edges = randomEdges(n);
+            runner.compare({ "build", "int", n, edges.size() },
+                contender("CsrGraph", [&] {
+                    Graph g(static_cast<uint32_t>(n), edges.data(), edges.size(), graphs::EdgeDirection::Undirected);
+                    doNotOptimize(g.edgeCount());
+                }),
+                contender("AdjacencyList", [&] {
+                    AdjacencyList g(n, edges);
+                    doNotOptimize(g.out.data());
+                }));
+        }
+    }
+
+    // One thread: what is measured is the layout and the direction switching, not parallelism.
+    if (runner.selected("bfs", "int")) {
+        runner.heading("bfs", "int", "ParallelBfs", "AdjacencyList");
+        for (size_t n : runner.sizes(graphCap)) {
+            vector<graphs::Edge<uint32_t>> edges = randomEdges(n);
+            Graph graph(static_cast<uint32_t>(n), edges.data(), edges.size(), graphs::EdgeDirection::Undirected);
+            AdjacencyList adjacency(n, edges);
+            graphs::ParallelBfs<uint32_t> bfs(graph, 1);
+            vector<uint32_t> depth(n);
+            runner.compare({ "bfs", "int", n, edges.size() },
+                contender("ParallelBfs", [&] { doNotOptimize(bfs.run(0)); }),
+                contender("AdjacencyList", [&] {
+                    fill(depth.begin(), depth.end(), UINT32_MAX);
+                    queue<uint32_t> frontier;
+                    depth[0] = 0;
+                    frontier.push(0);
+                    while (!frontier.empty()) {
+                        uint32_t u = frontier.front();
+                        frontier.pop();
+                        for (const auto& [v, w] : adjacency.out[u]) {
+                            (void)w;
+                            if (depth[v] == UINT32_MAX) {
+                                depth[v] = depth[u] + 1;
+                                frontier.push(v);
+                            }
+                        }
+                    }
+                    doNotOptimize(depth.data());
+                }));
+        }
+    }
+
+    // Full single-source Dijkstra, against the usual lazy-deletion std::priority_queue version.
+    if (runner.selected("dijkstra", "int")) {
+        runner.heading("dijkstra", "int", "ShortestPaths", "AdjacencyList");
+        using Entry = pair<uint64_t, uint32_t>;
+        for (size_t n : runner.sizes(graphCap)) {
+            vector<graphs::Edge<uint32_t>> edges = randomEdges(n);
+            Graph graph(static_cast<uint32_t>(n), edges.data(), edges.size(), graphs::EdgeDirection::Undirected);
+            AdjacencyList adjacency(n, edges);
+            graphs::ShortestPaths<uint32_t> paths(graph);
+            graphs::SearchWorkspace<uint32_t> workspace(static_cast<uint32_t>(n));
+            vector<uint64_t> dist(n);
+            runner.compare({ "dijkstra", "int", n, edges.size() },
+                contender("ShortestPaths", [&] { doNotOptimize(paths.dijkstra(0, workspace)); }),
+                contender("AdjacencyList", [&] {
+                    fill(dist.begin(), dist.end(), UINT64_MAX);
+                    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+                    dist[0] = 0;
+                    heap.push({ 0, 0 });
+                    while (!heap.empty()) {
+                        auto [d, u] = heap.top();
+                        heap.pop();
+                        if (d != dist[u]) continue;
+                        for (const auto& [v, w] : adjacency.out[u]) {
+                            if (d + w < dist[v]) {
+                                dist[v] = d + w;
+                                heap.push({ d + w, v });
+                            }
+                        }
+                    }
+                    doNotOptimize(dist.data());
+                }));
+        }
+    }
+}
+
+// ***************  MAIN  ****************
+
+void printUsage() {
+    cout << "Usage: benchmarks [--max-size N] [--filter TEXT] [--min-time MS] [--samples K]\n"
+            "                  [--json FILE] [--baseline FILE] [--tolerance F] [--noise-floor NS]" << endl;
+}
+
+// Every suite, in the order of the tables.
+void runSuites(BenchmarkRunner& runner) {
+    benchArrays(runner);
+
+    runner.section("DynamicArray", "std::vector");
+    {
+        benchDynamicArray<int>(runner);
+        benchDynamicArray<string>(runner);
+    }
+
+    benchLinkedLists(runner);
+
+    runner.section("Stacks", "std::stack");
+    {
+        benchStacks<int>(runner);
+        benchStacks<string>(runner);
+    }
+
+    runner.section("Queues", "std::queue");
+    {
+        benchQueues<int>(runner);
+        benchQueues<string>(runner);
+    }
+
+    runner.section("Deque", "std::deque");
+    {
+        benchDeques<int>(runner);
+        benchDeques<string>(runner);
+    }
+
+    benchTrees(runner);
+
+    runner.section("FlatHashMap", "std::unordered_map");
+    {
+        benchHashTables<int>(runner);
+        benchHashTables<string>(runner);
+    }
+
+    benchGraphs(runner);
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--max-size" && hasValue) options.maxSize = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--min-time" && hasValue) options.minTimeMs = atof(argv[++i]);
+        else if (arg == "--samples" && hasValue) options.samples = static_cast<unsigned>(max(1, atoi(argv[++i])));
+        else if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+        else if (arg == "--baseline" && hasValue) options.baselinePath = argv[++i];
+        else if (arg == "--tolerance" && hasValue) options.tolerance = atof(argv[++i]);
+        else if (arg == "--noise-floor" && hasValue) options.noiseFloorNs = atof(argv[++i]);
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+
+#if !defined(NDEBUG)
+    cout << "Warning: built without NDEBUG; compile with -O2 -DNDEBUG for meaningful numbers." << endl;
+#endif
+    cout << "Sizes 10 .. " << options.maxSize << ", best of " << options.samples << " samples of at least "
+         << options.minTimeMs << " ms. ratio = ours / std (below 1 is faster)." << endl;
+
+    BenchmarkRunner runner(options);
+    runSuites(runner);
+
+    try {
+        if (!options.jsonPath.empty()) {
+            writeJson(options.jsonPath, options, runner.measurements());
+            cout << endl << runner.measurements().size() << " measurements written to " << options.jsonPath << endl;
+        }
+        if (!options.baselinePath.empty()) {
+            map<string, BaselineEntry> baseline = readBaseline(options.baselinePath);
+            Options retime = options;
+            retime.only = suspectedRegressions(baseline, runner.measurements(), options);
+            BenchmarkRunner second(retime);
+            if (!retime.only.empty()) {
+                cout << endl << "Re-timing " << retime.only.size() << " suspected regressions..." << endl;
+                runSuites(second);
+            }
+            if (compareWithBaseline(baseline, runner.measurements(), second.measurements(), options) > 0) return 1;
+        }
+    }
+    catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 2;
+    }
+    return 0;
+}
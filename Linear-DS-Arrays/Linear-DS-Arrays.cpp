@@ -84,9 +84,130 @@
 * 
 */
 
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// SIMD search kernels. x86-64 always has SSE2; AVX2 is used when the CPU reports it.
+// Compile with -DDS_DISABLE_SIMD to force the scalar loops.
+#if defined(DS_DISABLE_SIMD)
+#define DS_ARRAYS_SIMD_X86 0
+#define DS_ARRAYS_SIMD_NEON 0
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define DS_ARRAYS_SIMD_X86 1
+#define DS_ARRAYS_SIMD_NEON 0
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DS_ARRAYS_SIMD_X86 0
+#define DS_ARRAYS_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define DS_ARRAYS_SIMD_X86 0
+#define DS_ARRAYS_SIMD_NEON 0
+#endif
+
 using namespace std;
 
+// ***************  STATIC ARRAY & CHECK POLICIES  ****************
+
+/**
+* StaticArray<T, N> - a fixed-capacity array that remembers how many slots are in use.
+*
+* It is a plain aggregate (no constructors), so it can be built in a constant expression:
+*
+*   StaticArray<int, 10> ages = { { 21, 25, 30, 19, 45 }, 5 };   // capacity 10, size 5
+*
+* The operations below never print anything. They report problems through ArrayStatus,
+* and a compile-time check policy decides whether they check at all:
+*
+*   insertAt(ages, 2, 99);                  // DefaultCheck policy
+*   insertAt<Checked>(ages, 2, 99);         // always validates, returns an ArrayStatus
+*   insertAt<Unchecked>(ages, 2, 99);       // no validation: one memmove and a store
+*
+* DefaultCheck is Checked unless the program is compiled with -DDS_ARRAYS_UNCHECKED.
+*/
+template <typename T, size_t N>
+struct StaticArray {
+    T elements[N] = {};
+    size_t count = 0;
+
+    constexpr size_t size() const { return count; }
+    static constexpr size_t capacity() { return N; }
+    constexpr bool isEmpty() const { return count == 0; }
+    constexpr bool isFull() const { return count == N; }
+
+    constexpr T& operator[](size_t index) { return elements[index]; }
+    constexpr const T& operator[](size_t index) const { return elements[index]; }
+
+    constexpr T* data() { return elements; }
+    constexpr const T* data() const { return elements; }
+    constexpr T* begin() { return elements; }
+    constexpr T* end() { return elements + count; }
+    constexpr const T* begin() const { return elements; }
+    constexpr const T* end() const { return elements + count; }
+};
+
+// Error codes returned by the operations. Ok is the only success value.
+enum class ArrayStatus { Ok, Full, InvalidIndex, ValueTooWide };
+
+constexpr const char* statusName(ArrayStatus status) {
+    switch (status) {
+    case ArrayStatus::Ok:           return "Ok";
+    case ArrayStatus::Full:         return "Full";
+    case ArrayStatus::InvalidIndex: return "InvalidIndex";
+    case ArrayStatus::ValueTooWide: return "ValueTooWide";
+    }
+    return "Unknown";
+}
+
+// Check policies: validate capacity and index (Checked) or trust the caller (Unchecked).
+struct Checked   { static constexpr bool enabled = true; };
+struct Unchecked { static constexpr bool enabled = false; };
+
+#if defined(DS_ARRAYS_UNCHECKED)
+using DefaultCheck = Unchecked;
+#else
+using DefaultCheck = Checked;
+#endif
+
+// True while the compiler is evaluating a constant expression; memmove is not allowed there.
+constexpr bool inConstantEvaluation() {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;  // unknown compiler: always use the loop, which is correct in both contexts
+#endif
+}
+
+// Copy `count` elements from `source` to `destination`; the ranges may overlap.
+// Trivially copyable types use a single memmove at run time instead of an element-by-element loop.
+template <typename T>
+constexpr void shiftElements(T* destination, const T* source, size_t count) {
+    if constexpr (is_trivially_copyable<T>::value) {
+        if (!inConstantEvaluation()) {
+            if (count != 0) {
+                std::memmove(destination, source, count * sizeof(T));
+            }
+            return;
+        }
+    }
+    if (destination < source) {
+        for (size_t i = 0; i < count; i++) {
+            destination[i] = source[i];
+        }
+    }
+    else {
+        for (size_t i = count; i-- > 0;) {
+            destination[i] = source[i];
+        }
+    }
+}
+
 // ***************  OPERATIONS & COMPLEXITY ANALYSIS  ****************
 
 // 1- Access (Read/Write): O(1) - implementation
@@ -95,73 +216,259 @@ void demonstrateAccess() {
 
     // Read - O(1)
     int value = data[2];  // Instant access to index 2
-    cout << "Element at index 2: " << value << endl;  // 300
+    printf("Element at index 2: %d\n", value);  // 300
 
     // Write - O(1)
     data[2] = 999;  // Instant modification
-    cout << "After modification: " << data[2] << endl;  // 999
+    printf("After modification: %d\n", data[2]);  // 999
 }
 
 // 2- Search for a value in unsorted array
-int linearSearch(int arr[], int size, int target) {
-    for (int i = 0; i < size; i++) {  // Must check each element
-        if (arr[i] == target) {
-            return i;  // Found at index i
+// Returns the index of the first match, or -1 when the value is not present.
+template <typename T, size_t N>
+constexpr ptrdiff_t linearSearch(const StaticArray<T, N>& arr, const T& target) {
+    for (size_t i = 0; i < arr.count; i++) {  // Must check each element
+        if (arr.elements[i] == target) {
+            return static_cast<ptrdiff_t>(i);  // Found at index i
         }
     }
     return -1;  // Not found
 }
 
-// 3- Insert element at specific index
-void insertAt(int arr[], int& size, int capacity, int index, int value) {
-    // Check if array is full
-    if (size >= capacity) {
-        cout << "Array is full!" << endl;
-        return;
+// 2.1- Sentinel search: one compare per element, no bounds check
+//
+// The last element is saved and replaced by the target, so the loop is
+// guaranteed to stop at the end of the array without testing "i < size":
+//
+// Array :  [10] [20] [30] [40] [50]     search 35
+//  temp :  [10] [20] [30] [40] [35]     <- sentinel
+//
+// Afterwards the last element is restored. If the loop stopped on the
+// sentinel, the original last element decides whether it was a real match.
+// Time Complexity: O(n), with half the comparisons of the plain loop.
+template <typename T>
+constexpr ptrdiff_t linearSearchSentinel(T* data, size_t size, const T& target) {
+    if (size == 0) {
+        return -1;
     }
+    T last = data[size - 1];
+    data[size - 1] = target;
 
-    // Check if index is valid
-    // 
-    // Index:  0     1    2    3    4   5
-    // Array: [10] [20] [30] [40] [50] [ ]
-    //         ↑                   ↑
-    //      index 0            index 5 (= size)
-    // 
-    // **Valid insertion indices : 0, 1, 2, 3, 4, 5 * *
-	//   - index = 0: Insert at beginning [number of shifts = size (shifting all elements)] **worst case**
-    //   - index = 1, 2, 3, 4: Insert in middle [Number of shifts = size - index]
-	//   - index = 5: Insert at end(after last element) [No shifts neded] **best case**
-    
-    if (index < 0 || index > size) {
-        cout << "Invalid index!" << endl;
-        return;
+    size_t i = 0;
+    while (!(data[i] == target)) {
+        i++;
+    }
+
+    data[size - 1] = last;
+    if (i < size - 1 || last == target) {
+        return static_cast<ptrdiff_t>(i);
+    }
+    return -1;
+}
+
+template <typename T, size_t N>
+constexpr ptrdiff_t linearSearchSentinel(StaticArray<T, N>& arr, const T& target) {
+    return linearSearchSentinel(arr.elements, arr.count, target);
+}
+
+// 2.2- SIMD search: compare 16 ints per loop iteration
+//
+// AVX2 : two 8-int compares per iteration (16 ints)
+// SSE2 : four 4-int compares per iteration (16 ints)
+// NEON : four 4-int compares per iteration (16 ints)
+//
+// The compare results are OR-ed together, so the loop costs one branch per 16
+// elements. When a block contains the target, the scalar loop finds its exact
+// position inside those 16 elements. Time Complexity: O(n), ~n/16 branches.
+#if DS_ARRAYS_SIMD_X86
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+inline size_t avx2SkipToMatch(const int* data, size_t size, int target) {
+    const __m256i key = _mm256_set1_epi32(target);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), key);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8)), key);
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+            break;
+        }
+    }
+    return i;
+}
+
+inline bool cpuHasAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#endif
+
+inline size_t sse2SkipToMatch(const int* data, size_t size, int target) {
+    const __m128i key = _mm_set1_epi32(target);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), key);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), key);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8)), key);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12)), key);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+#elif DS_ARRAYS_SIMD_NEON
+inline size_t neonSkipToMatch(const int* data, size_t size, int target) {
+    const int32x4_t key = vdupq_n_s32(target);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint32x4_t a = vceqq_s32(vld1q_s32(data + i), key);
+        uint32x4_t b = vceqq_s32(vld1q_s32(data + i + 4), key);
+        uint32x4_t c = vceqq_s32(vld1q_s32(data + i + 8), key);
+        uint32x4_t d = vceqq_s32(vld1q_s32(data + i + 12), key);
+        if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+#endif
+
+// Returns the index of the first match in data[0, size), or -1.
+inline ptrdiff_t linearSearchSimd(const int* data, size_t size, int target) {
+    size_t i = 0;
+#if DS_ARRAYS_SIMD_X86
+#if defined(__GNUC__) || defined(__clang__)
+    i = cpuHasAvx2() ? avx2SkipToMatch(data, size, target) : sse2SkipToMatch(data, size, target);
+#else
+    i = sse2SkipToMatch(data, size, target);
+#endif
+#elif DS_ARRAYS_SIMD_NEON
+    i = neonSkipToMatch(data, size, target);
+#endif
+    // Either the block at i holds the target, or fewer than 16 elements are left.
+    for (; i < size; i++) {
+        if (data[i] == target) {
+            return static_cast<ptrdiff_t>(i);
+        }
+    }
+    return -1;
+}
+
+// Element types without a SIMD kernel use the plain loop.
+template <typename T>
+ptrdiff_t linearSearchSimd(const T* data, size_t size, const T& target) {
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == target) {
+            return static_cast<ptrdiff_t>(i);
+        }
+    }
+    return -1;
+}
+
+template <typename T, size_t N>
+ptrdiff_t linearSearchSimd(const StaticArray<T, N>& arr, const T& target) {
+    return linearSearchSimd(arr.elements, arr.count, target);
+}
+
+// 2.3- Batch search: answer k queries with one pass over the data
+//
+// Searching k targets one after another reads the whole array k times. Here the
+// array is walked once, in blocks small enough to stay in L1 cache, and every
+// query that is still unanswered is checked against the block while it is hot:
+//
+//   for each block of the array          <- read from memory once
+//       for each unanswered target       <- SIMD scan of a cached block
+//
+// results[q] gets the index of the first occurrence of targets[q], or -1.
+// The walk stops early once every query has been answered.
+// Returns the number of targets found. Time Complexity: O(n * k) compares, O(n) memory traffic.
+constexpr size_t searchBlockBytes = 4096;
+
+template <typename T>
+size_t linearSearchMany(const T* data, size_t size, const T* targets, size_t k, ptrdiff_t* results) {
+    constexpr size_t block = searchBlockBytes / sizeof(T) > 0 ? searchBlockBytes / sizeof(T) : 1;
+    for (size_t q = 0; q < k; q++) {
+        results[q] = -1;
+    }
+
+    size_t found = 0;
+    for (size_t start = 0; start < size && found < k; start += block) {
+        size_t length = size - start < block ? size - start : block;
+        for (size_t q = 0; q < k; q++) {
+            if (results[q] >= 0) {
+                continue;  // answered in an earlier block
+            }
+            ptrdiff_t hit = linearSearchSimd(data + start, length, targets[q]);
+            if (hit >= 0) {
+                results[q] = static_cast<ptrdiff_t>(start) + hit;
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+template <typename T, size_t N>
+size_t linearSearchMany(const StaticArray<T, N>& arr, const T* targets, size_t k, ptrdiff_t* results) {
+    return linearSearchMany(arr.elements, arr.count, targets, k, results);
+}
+
+// 3- Insert element at specific index
+template <typename Check = DefaultCheck, typename T, size_t N>
+constexpr ArrayStatus insertAt(StaticArray<T, N>& arr, size_t index, const T& value) {
+    if constexpr (Check::enabled) {
+        // Check if array is full
+        if (arr.count >= N) {
+            return ArrayStatus::Full;
+        }
+
+        // Check if index is valid
+        // 
+        // Index:  0     1    2    3    4   5
+        // Array: [10] [20] [30] [40] [50] [ ]
+        //         ↑                   ↑
+        //      index 0            index 5 (= size)
+        // 
+        // **Valid insertion indices : 0, 1, 2, 3, 4, 5 * *
+        //   - index = 0: Insert at beginning [number of shifts = size (shifting all elements)] **worst case**
+        //   - index = 1, 2, 3, 4: Insert in middle [Number of shifts = size - index]
+        //   - index = 5: Insert at end(after last element) [No shifts neded] **best case**
+        //
+        // (index is unsigned, so "index < 0" can no longer happen.)
+
+        if (index > arr.count) {
+            return ArrayStatus::InvalidIndex;
+        }
     }
 
     // Shift elements to the right
     // Index:             0    1    2    3   4
     // Array :          [10] [20] [30] [40] [50] [ ] [ ] [ ] [ ] [ ]
     //                             ↑
-	//              Want to insert a value [99] here at index 2
+    //              Want to insert a value [99] here at index 2
     // 
     // After shifting:  [10] [20] [30] [30] [40] [50] [ ] [ ] [ ] [ ]
     // Then the result: [10] [20] [99] [30] [40] [50] [ ] [ ] [ ] [ ]
+    //
+    // The whole block [index, size) moves in one shiftElements call (a memmove for int).
 
-    for (int i = size; i > index; i--) {
-        arr[i] = arr[i - 1];
-    }
+    shiftElements(arr.elements + index + 1, arr.elements + index, arr.count - index);
 
     // Insert new element
-    arr[index] = value;
-    size++;
+    arr.elements[index] = value;
+    arr.count++;
+    return ArrayStatus::Ok;
 }
 
 // 4- Delete element at specific index
-void deleteAt(int arr[], int& size, int index) {
+template <typename Check = DefaultCheck, typename T, size_t N>
+constexpr ArrayStatus deleteAt(StaticArray<T, N>& arr, size_t index) {
 
     // Check if index is valid
-    if (index < 0 || index >= size) {
-        cout << "Invalid index!" << endl;
-        return;
+    if constexpr (Check::enabled) {
+        if (index >= arr.count) {
+            return ArrayStatus::InvalidIndex;
+        }
     }
 
     
@@ -173,35 +480,635 @@ void deleteAt(int arr[], int& size, int index) {
     // size = 6                   ↑
     //                       Delete this (30)
     // Shift elements to the left
-    for (int i = index; i < size - 1; i++) {
-        arr[i] = arr[i + 1];
-    }
+    shiftElements(arr.elements + index, arr.elements + index + 1, arr.count - index - 1);
 
     // After shifting: [10] [20] [40] [50] [60] [60]
     // Then we just decrease the size to ignore the last duplicate element:
-    size--;
+    arr.count--;
+    return ArrayStatus::Ok;
+}
+
+// The same operations run at compile time: the loop path of shiftElements is used there.
+constexpr StaticArray<int, 5> buildAtCompileTime() {
+    StaticArray<int, 5> arr = { { 10, 20, 30 }, 3 };
+    insertAt(arr, 1, 15);   // {10, 15, 20, 30}
+    deleteAt(arr, 3);       // {10, 15, 20}
+    insertAt(arr, 0, 5);    // {5, 10, 15, 20}
+    return arr;
+}
+
+static_assert(buildAtCompileTime().size() == 4, "constexpr insert/delete");
+static_assert(buildAtCompileTime()[0] == 5 && buildAtCompileTime()[3] == 20, "constexpr shifting");
+static_assert(linearSearch(buildAtCompileTime(), 15) == 2, "constexpr search");
+
+// ***************  COMPRESSED INTEGER ARRAYS  ****************
+//
+// Arrays of small integers and IDs rarely need 32 bits per element. The two types below
+// store the same values in fewer bits per element, and their searches read the fewer bytes directly:
+//
+// * PackedArray<Bits, N> - every element is exactly Bits wide.  O(1) get / set.
+//
+//     Bits = 12:   word 0 = [ e0 | e1 | e2 | e3 | e4 | e5 (low 4 bits) ]  word 1 = [ e5 (high 8) | e6 | ...
+//
+// * FrameOfReferenceArray - read-only, in blocks of 128 values. Each block stores a
+//   reference value plus, per element, its offset from the reference (or, for non-decreasing
+//   blocks, its delta from the element four positions earlier), in the fewest bits that fit.
+//   A block is decoded with SIMD four lanes at a time.
+
+// Bits needed for values up to `value` (0 for 0).
+constexpr unsigned bitWidth(uint32_t value) {
+    unsigned bits = 0;
+    while (value != 0) {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+constexpr unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned n = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+* PackedArray<Bits, N> - up to N unsigned values of Bits bits each, packed into 64-bit words.
+*
+* Element i occupies bits [i * Bits, (i + 1) * Bits) of the word array; a field may
+* straddle two words. Like StaticArray it is an aggregate and works in constant expressions.
+*
+*   PackedArray<12, 1000> ids = {};      // 1504 bytes instead of 4000 for int[1000]
+*/
+template <unsigned Bits, size_t N>
+struct PackedArray {
+    static_assert(Bits >= 1 && Bits <= 32, "PackedArray fields are 1 to 32 bits wide");
+
+    static constexpr size_t wordCount = (N * Bits + 63) / 64;
+    static constexpr uint32_t maxValue = Bits == 32 ? 0xFFFFFFFFu : (1u << Bits) - 1;
+
+    uint64_t words[wordCount] = {};
+    size_t count = 0;
+
+    constexpr size_t size() const { return count; }
+    static constexpr size_t capacity() { return N; }
+    static constexpr size_t bytes() { return sizeof(words); }
+    constexpr bool isEmpty() const { return count == 0; }
+    constexpr bool isFull() const { return count == N; }
+
+    // Reads element `index`: one or two word loads, a shift and a mask. O(1), unchecked.
+    constexpr uint32_t get(size_t index) const {
+        size_t bit = index * Bits;
+        size_t word = bit / 64;
+        unsigned shift = static_cast<unsigned>(bit % 64);
+        uint64_t value = words[word] >> shift;
+        if (shift + Bits > 64) {
+            value |= words[word + 1] << (64 - shift);
+        }
+        return static_cast<uint32_t>(value & maxValue);
+    }
+
+    // Overwrites element `index` with the low Bits bits of `value`. O(1), unchecked.
+    constexpr void set(size_t index, uint32_t value) {
+        uint64_t field = value & maxValue;
+        size_t bit = index * Bits;
+        size_t word = bit / 64;
+        unsigned shift = static_cast<unsigned>(bit % 64);
+        words[word] = (words[word] & ~(uint64_t(maxValue) << shift)) | (field << shift);
+        if (shift + Bits > 64) {
+            unsigned spill = 64 - shift;
+            words[word + 1] = (words[word + 1] & ~(uint64_t(maxValue) >> spill)) | (field >> spill);
+        }
+    }
+};
+
+// Checked set / append for PackedArray: a value wider than Bits is ValueTooWide, not silently truncated.
+template <typename Check = DefaultCheck, unsigned Bits, size_t N>
+constexpr ArrayStatus setAt(PackedArray<Bits, N>& arr, size_t index, uint32_t value) {
+    if constexpr (Check::enabled) {
+        if (index >= arr.count) {
+            return ArrayStatus::InvalidIndex;
+        }
+        if (value > PackedArray<Bits, N>::maxValue) {
+            return ArrayStatus::ValueTooWide;
+        }
+    }
+    arr.set(index, value);
+    return ArrayStatus::Ok;
+}
+
+template <typename Check = DefaultCheck, unsigned Bits, size_t N>
+constexpr ArrayStatus pushBack(PackedArray<Bits, N>& arr, uint32_t value) {
+    if constexpr (Check::enabled) {
+        if (arr.count >= N) {
+            return ArrayStatus::Full;
+        }
+        if (value > PackedArray<Bits, N>::maxValue) {
+            return ArrayStatus::ValueTooWide;
+        }
+    }
+    arr.set(arr.count++, value);
+    return ArrayStatus::Ok;
+}
+
+// 5- Search a PackedArray without unpacking it
+//
+// When Bits divides 64, fields never straddle words, and a whole word is tested at once (SWAR):
+// XOR with the target repeated in every field turns matching fields into zero fields, and
+//
+//   (x - low) & ~x & high        low = lowest bit of every field, high = highest bit
+//
+// is non-zero exactly when some field of x is zero; its lowest set bit marks the first match.
+// One subtract and two ANDs test 64 / Bits elements. Other widths read the fields one by one.
+// Time Complexity: O(n), O(n * Bits / 64) word operations for the SWAR path.
+template <unsigned Bits, size_t N>
+constexpr ptrdiff_t linearSearch(const PackedArray<Bits, N>& arr, uint32_t target) {
+    using Packed = PackedArray<Bits, N>;
+    if (target > Packed::maxValue) {
+        return -1;
+    }
+    if constexpr (64 % Bits == 0) {
+        constexpr uint64_t low = ~uint64_t(0) / Packed::maxValue;   // 0x0001_0001... for 16 bits
+        constexpr uint64_t high = low << (Bits - 1);
+        const uint64_t pattern = low * target;
+        size_t words = (arr.count * Bits + 63) / 64;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t x = arr.words[w] ^ pattern;
+            uint64_t zero = (x - low) & ~x & high;
+            if (zero != 0) {
+                size_t index = w * (64 / Bits) + countTrailingZeros(zero) / Bits;
+                return index < arr.count ? static_cast<ptrdiff_t>(index) : -1;
+            }
+        }
+        return -1;
+    }
+    else {
+        for (size_t i = 0; i < arr.count; i++) {
+            if (arr.get(i) == target) {
+                return static_cast<ptrdiff_t>(i);
+            }
+        }
+        return -1;
+    }
+}
+
+constexpr PackedArray<4, 20> packAtCompileTime() {
+    PackedArray<4, 20> arr = {};
+    for (uint32_t i = 0; i < 20; i++) {
+        pushBack(arr, (i * 7) % 16);
+    }
+    setAt(arr, 3, 15);
+    return arr;
+}
+
+static_assert(packAtCompileTime().get(3) == 15 && packAtCompileTime().get(19) == (19 * 7) % 16, "constexpr get/set");
+static_assert(linearSearch(packAtCompileTime(), 15) == 3, "constexpr SWAR search");
+static_assert(linearSearch(packAtCompileTime(), 16) == -1, "value wider than Bits");
+
+// 6- Frame-of-reference / delta encoding with SIMD block decode
+//
+// Values are cut into blocks of 128. Each block is encoded in one of two modes:
+//
+//   FOR:    element = reference + residual            reference = block minimum
+//   Delta:  element = element[i - 4] + residual       (non-decreasing blocks; element[-4..-1] = reference)
+//
+// and its residuals are packed in b bits, the width of the largest residual. Sorted ID columns
+// have tiny deltas, so b is often 1 to 8 bits.
+// The residuals are laid out "vertically" across four 32-bit lanes: element i goes to lane i % 4,
+// row i / 4. Row r of every lane starts at the same bit offset, so SSE2 / NEON decodes
+// four elements per shift-and-mask, and delta decoding is a vector add of the previous row.
+//
+//   lane 0: e0  e4  e8  ... e124    each lane is 32 residuals * b bits = b words
+//   lane 1: e1  e5  e9  ... e125    words interleaved: [w0 l0][w0 l1][w0 l2][w0 l3][w1 l0]...
+//   lane 2: e2  e6  e10 ... e126
+//   lane 3: e3  e7  e11 ... e127
+constexpr size_t forBlockSize = 128;
+
+struct ForBlockHeader {
+    uint32_t reference;   // FOR: block minimum. Delta: value that e0..e3 are deltas from.
+    uint32_t maxValue;    // lets a search skip blocks that cannot contain the target
+    uint32_t wordOffset;  // first word of the block's residuals
+    uint8_t bits;         // residual width, 0..32
+    uint8_t delta;        // 1 for delta mode, 0 for FOR
+};
+
+// Unpacks 128 b-bit residuals and adds them to the reference. `out` receives 128 values.
+inline void decodeForBlockScalar(const ForBlockHeader& header, const uint32_t* words, uint32_t* out) {
+    const unsigned bits = header.bits;
+    const uint32_t mask = bits == 32 ? 0xFFFFFFFFu : (1u << bits) - 1;
+    uint32_t previous[4] = { header.reference, header.reference, header.reference, header.reference };
+    for (unsigned row = 0; row < forBlockSize / 4; row++) {
+        unsigned bit = row * bits;
+        unsigned word = bit / 32;
+        unsigned shift = bit % 32;
+        for (unsigned lane = 0; lane < 4; lane++) {
+            uint32_t residual = 0;
+            if (bits != 0) {
+                residual = words[4 * word + lane] >> shift;
+                if (shift + bits > 32) {
+                    residual |= words[4 * (word + 1) + lane] << (32 - shift);
+                }
+                residual &= mask;
+            }
+            uint32_t value = (header.delta ? previous[lane] : header.reference) + residual;
+            previous[lane] = value;
+            out[4 * row + lane] = value;
+        }
+    }
+}
+
+#if DS_ARRAYS_SIMD_X86
+inline void decodeForBlockSse2(const ForBlockHeader& header, const uint32_t* words, uint32_t* out) {
+    const unsigned bits = header.bits;
+    const __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    const __m128i reference = _mm_set1_epi32(static_cast<int>(header.reference));
+    __m128i previous = reference;
+    for (unsigned row = 0; row < forBlockSize / 4; row++) {
+        unsigned bit = row * bits;
+        unsigned word = bit / 32;
+        unsigned shift = bit % 32;
+        __m128i residual = _mm_setzero_si128();
+        if (bits != 0) {
+            residual = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words + 4 * word)),
+                                     _mm_cvtsi32_si128(static_cast<int>(shift)));
+            if (shift + bits > 32) {
+                __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + 4 * (word + 1)));
+                residual = _mm_or_si128(residual, _mm_sll_epi32(next, _mm_cvtsi32_si128(static_cast<int>(32 - shift))));
+            }
+            residual = _mm_and_si128(residual, mask);
+        }
+        __m128i value = _mm_add_epi32(header.delta ? previous : reference, residual);
+        previous = value;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * row), value);
+    }
+}
+#elif DS_ARRAYS_SIMD_NEON
+inline void decodeForBlockNeon(const ForBlockHeader& header, const uint32_t* words, uint32_t* out) {
+    const unsigned bits = header.bits;
+    const uint32x4_t mask = vdupq_n_u32(bits == 32 ? 0xFFFFFFFFu : (1u << bits) - 1);
+    const uint32x4_t reference = vdupq_n_u32(header.reference);
+    uint32x4_t previous = reference;
+    for (unsigned row = 0; row < forBlockSize / 4; row++) {
+        unsigned bit = row * bits;
+        unsigned word = bit / 32;
+        unsigned shift = bit % 32;
+        uint32x4_t residual = vdupq_n_u32(0);
+        if (bits != 0) {
+            // vshlq with a negative count shifts right.
+            residual = vshlq_u32(vld1q_u32(words + 4 * word), vdupq_n_s32(-static_cast<int>(shift)));
+            if (shift + bits > 32) {
+                uint32x4_t next = vld1q_u32(words + 4 * (word + 1));
+                residual = vorrq_u32(residual, vshlq_u32(next, vdupq_n_s32(static_cast<int>(32 - shift))));
+            }
+            residual = vandq_u32(residual, mask);
+        }
+        uint32x4_t value = vaddq_u32(header.delta ? previous : reference, residual);
+        previous = value;
+        vst1q_u32(out + 4 * row, value);
+    }
+}
+#endif
+
+inline void decodeForBlock(const ForBlockHeader& header, const uint32_t* words, uint32_t* out) {
+#if DS_ARRAYS_SIMD_X86
+    decodeForBlockSse2(header, words, out);
+#elif DS_ARRAYS_SIMD_NEON
+    decodeForBlockNeon(header, words, out);
+#else
+    decodeForBlockScalar(header, words, out);
+#endif
+}
+
+/**
+* FrameOfReferenceArray - a read-only, block-compressed array of uint32_t.
+*
+*   FrameOfReferenceArray ids(column, n);        // encode once
+*   ids.at(i);                                   // O(1) for FOR blocks, O(32) for delta blocks
+*   linearSearch(ids, 4711);                     // skips blocks by [reference, maxValue], decodes the rest
+*
+* The last block is padded with copies of the last value, so every block decodes 128 values.
+* Unlike the fixed-capacity types above, the size is only known at run time, so the blocks live on the heap.
+*/
+class FrameOfReferenceArray {
+    unique_ptr<ForBlockHeader[]> headers;
+    unique_ptr<uint32_t[]> words;
+    size_t count = 0;
+    size_t blocks = 0;
+    size_t totalWords = 0;
+
+    // Packs residuals[0, 128) vertically into 4 * bits words at `out` (zeroed by the caller).
+    static void packBlock(const uint32_t* residuals, unsigned bits, uint32_t* out) {
+        if (bits == 0) {
+            return;   // a constant block has no residual words
+        }
+        for (unsigned i = 0; i < forBlockSize; i++) {
+            unsigned lane = i % 4;
+            unsigned bit = (i / 4) * bits;
+            unsigned word = bit / 32;
+            unsigned shift = bit % 32;
+            out[4 * word + lane] |= residuals[i] << shift;
+            if (shift + bits > 32) {
+                out[4 * (word + 1) + lane] |= residuals[i] >> (32 - shift);
+            }
+        }
+    }
+
+public:
+    FrameOfReferenceArray() = default;
+
+    // Encodes data[0, size). Time Complexity: O(n).
+    FrameOfReferenceArray(const uint32_t* data, size_t size)
+        : count(size), blocks((size + forBlockSize - 1) / forBlockSize) {
+        headers.reset(new ForBlockHeader[blocks]);
+
+        uint32_t values[forBlockSize];
+        uint32_t forResiduals[forBlockSize];
+        uint32_t deltaResiduals[forBlockSize];
+
+        // First pass: choose each block's mode and width, so the words can be allocated once.
+        for (size_t b = 0; b < blocks; b++) {
+            size_t start = b * forBlockSize;
+            for (size_t i = 0; i < forBlockSize; i++) {
+                values[i] = start + i < size ? data[start + i] : data[size - 1];
+            }
+            uint32_t minimum = values[0];
+            uint32_t maximum = values[0];
+            bool nonDecreasing = true;
+            for (size_t i = 1; i < forBlockSize; i++) {
+                minimum = values[i] < minimum ? values[i] : minimum;
+                maximum = values[i] > maximum ? values[i] : maximum;
+                nonDecreasing = nonDecreasing && values[i] >= values[i - 1];
+            }
+
+            unsigned forBits = bitWidth(maximum - minimum);
+            unsigned deltaBits = 33;
+            if (nonDecreasing) {
+                uint32_t widest = 0;
+                for (size_t i = 0; i < forBlockSize; i++) {
+                    uint32_t delta = values[i] - (i < 4 ? values[0] : values[i - 4]);
+                    widest = delta > widest ? delta : widest;
+                }
+                deltaBits = bitWidth(widest);
+            }
+
+            ForBlockHeader& header = headers[b];
+            header.delta = deltaBits < forBits ? 1 : 0;
+            header.bits = static_cast<uint8_t>(header.delta ? deltaBits : forBits);
+            header.reference = header.delta ? values[0] : minimum;
+            header.maxValue = maximum;
+            header.wordOffset = static_cast<uint32_t>(totalWords);
+            totalWords += 4 * header.bits;
+        }
+
+        // Second pass: pack the residuals.
+        words.reset(new uint32_t[totalWords]());
+        for (size_t b = 0; b < blocks; b++) {
+            size_t start = b * forBlockSize;
+            const ForBlockHeader& header = headers[b];
+            for (size_t i = 0; i < forBlockSize; i++) {
+                values[i] = start + i < size ? data[start + i] : data[size - 1];
+            }
+            for (size_t i = 0; i < forBlockSize; i++) {
+                forResiduals[i] = values[i] - header.reference;
+                deltaResiduals[i] = values[i] - (i < 4 ? header.reference : values[i - 4]);
+            }
+            packBlock(header.delta ? deltaResiduals : forResiduals, header.bits, words.get() + header.wordOffset);
+        }
+    }
+
+    FrameOfReferenceArray(FrameOfReferenceArray&&) = default;
+    FrameOfReferenceArray& operator=(FrameOfReferenceArray&&) = default;
+
+    size_t size() const { return count; }
+    size_t blockCount() const { return blocks; }
+    const ForBlockHeader& blockHeader(size_t block) const { return headers[block]; }
+
+    // Bytes used by the encoded data (headers + residual words).
+    size_t bytes() const { return blocks * sizeof(ForBlockHeader) + totalWords * sizeof(uint32_t); }
+
+    // Decodes block `block` into out[0, 128). Time Complexity: O(128 / 4) vector operations.
+    void decodeBlock(size_t block, uint32_t* out) const {
+        decodeForBlock(headers[block], words.get() + headers[block].wordOffset, out);
+    }
+
+    // Decodes the whole array into out[0, size()).
+    void decode(uint32_t* out) const {
+        uint32_t buffer[forBlockSize];
+        for (size_t b = 0; b < blocks; b++) {
+            size_t start = b * forBlockSize;
+            size_t length = count - start < forBlockSize ? count - start : forBlockSize;
+            decodeBlock(b, buffer);
+            std::memcpy(out + start, buffer, length * sizeof(uint32_t));
+        }
+    }
+
+    // Element `index`, unchecked. FOR blocks read one field; delta blocks add up the lane's rows.
+    uint32_t at(size_t index) const {
+        const ForBlockHeader& header = headers[index / forBlockSize];
+        const uint32_t* block = words.get() + header.wordOffset;
+        unsigned lane = static_cast<unsigned>(index % 4);
+        unsigned lastRow = static_cast<unsigned>(index % forBlockSize) / 4;
+        unsigned firstRow = header.delta ? 0 : lastRow;
+        uint32_t value = header.reference;
+        if (header.bits == 0) {
+            return value;
+        }
+        const uint32_t mask = header.bits == 32 ? 0xFFFFFFFFu : (1u << header.bits) - 1;
+        for (unsigned row = firstRow; row <= lastRow; row++) {
+            unsigned bit = row * header.bits;
+            unsigned word = bit / 32;
+            unsigned shift = bit % 32;
+            uint32_t residual = block[4 * word + lane] >> shift;
+            if (shift + header.bits > 32) {
+                residual |= block[4 * (word + 1) + lane] << (32 - shift);
+            }
+            value += residual & mask;
+        }
+        return value;
+    }
+};
+
+// Searches the encoded array: blocks whose [reference, maxValue] range excludes the target are
+// skipped from the header alone; the others are decoded into an L1-resident buffer and scanned with
+// linearSearchSimd. Time Complexity: O(n) worst case, O(n / 128) when the target's range is narrow.
+inline ptrdiff_t linearSearch(const FrameOfReferenceArray& arr, uint32_t target) {
+    alignas(16) uint32_t buffer[forBlockSize];
+    for (size_t b = 0; b < arr.blockCount(); b++) {
+        const ForBlockHeader& header = arr.blockHeader(b);
+        if (target < header.reference || target > header.maxValue) {   // the reference is the block minimum in both modes
+            continue;
+        }
+        arr.decodeBlock(b, buffer);
+        ptrdiff_t hit = linearSearchSimd(reinterpret_cast<const int*>(buffer), forBlockSize, static_cast<int>(target));
+        if (hit >= 0) {
+            // Padding repeats the last value, which is found at its real position first.
+            return static_cast<ptrdiff_t>(b * forBlockSize) + hit;
+        }
+    }
+    return -1;
+}
+
+template <typename T, size_t N>
+void printArray(const StaticArray<T, N>& arr) {
+    printf("[");
+    for (size_t i = 0; i < arr.size(); i++) {
+        printf(i == 0 ? "%d" : ", %d", arr[i]);
+    }
+    printf("]");
 }
 
 int main() {
     // Static array - size fixed at compile time
     int scores[5];  // Uninitialized (garbage values)
-
-    int ages[10] = { 21, 25, 30, 19, 45 };  // Initialized [ Capacity 10, size 5 ]
+    (void)scores;
 
     int temps[5] = { 32, 45 };  // Partially initialized
     // temps = {32, 45, 0, 0, 0}
+    (void)temps;
 
     int numbers[] = { 10, 20, 30 };  // Size inferred (3 elements)
 
+    // Get size (only works for static arrays in same scope)
+    size_t numbersSize = sizeof(numbers) / sizeof(numbers[0]);  // 3
+    printf("Expected : 3 | Result : %zu\n", numbersSize);
+
+    StaticArray<int, 10> ages = { { 21, 25, 30, 19, 45 }, 5 };  // [ Capacity 10, size 5 ]
+
     // Access elements
-    cout << ages[0] << endl;  // 21 (first element)
-    cout << ages[4] << endl;  // 45 (last element)
+    printf("\n==== Access ====\n");
+    printf("Expected : 21 | Result : %d\n", ages[0]);  // first element
+    printf("Expected : 45 | Result : %d\n", ages[4]);  // last element
 
     // Modify elements
     ages[2] = 31;
+    printf("Expected : 31 | Result : %d\n", ages[2]);
+    demonstrateAccess();
 
-    // Get size (only works for static arrays in same scope)
-    int size = sizeof(ages) / sizeof(ages[0]);  // 5
+    printf("\n==== Linear Search ====\n");
+    printf("Expected : 3 | Result : %td\n", linearSearch(ages, 19));
+    printf("Expected : -1 | Result : %td\n", linearSearch(ages, 99));
+
+    printf("\n==== Sentinel, SIMD & Batch Search ====\n");
+    printf("Expected : 3 | Result : %td\n", linearSearchSentinel(ages, 19));
+    printf("Expected : 4 (target is the last element) | Result : %td\n", linearSearchSentinel(ages, 45));
+    printf("Expected : -1 | Result : %td\n", linearSearchSentinel(ages, 99));
+    printf("Expected : 45 (last element restored) | Result : %d\n", ages[4]);
+
+    StaticArray<int, 1000> table = {};
+    for (size_t i = 0; i < table.capacity(); i++) {
+        table.elements[i] = static_cast<int>(i * 3);
+    }
+    table.count = table.capacity();
+    printf("Expected : 333 | Result : %td\n", linearSearchSimd(table, 999));
+    printf("Expected : 999 (in the scalar tail) | Result : %td\n", linearSearchSimd(table, 2997));
+    printf("Expected : -1 | Result : %td\n", linearSearchSimd(table, 1000));
+
+    int queries[] = { 0, 2997, 1000, 1500, 31 };
+    ptrdiff_t answers[5];
+    size_t found = linearSearchMany(table, queries, 5, answers);
+    printf("Expected : 3 found [0, 999, -1, 500, -1] | Result : %zu found [%td, %td, %td, %td, %td]\n",
+        found, answers[0], answers[1], answers[2], answers[3], answers[4]);
+
+    printf("\n==== Insert (Checked) ====\n");
+    ArrayStatus status = insertAt<Checked>(ages, 2, 99);
+    printf("Expected : Ok [21, 25, 99, 31, 19, 45] | Result : %s ", statusName(status));
+    printArray(ages);
+    printf("\n");
+
+    status = insertAt<Checked>(ages, ages.size(), 50);
+    printf("Expected : Ok (insert at end) | Result : %s\n", statusName(status));
+
+    status = insertAt<Checked>(ages, 20, 1);
+    printf("Expected : InvalidIndex | Result : %s\n", statusName(status));
+
+    while (insertAt<Checked>(ages, 0, 7) == ArrayStatus::Ok) {}
+    printf("Expected : 10 (filled to capacity) | Result : %zu\n", ages.size());
+    printf("Expected : Full | Result : %s\n", statusName(insertAt<Checked>(ages, 0, 7)));
+
+    printf("\n==== Delete (Checked) ====\n");
+    StaticArray<int, 6> values = { { 10, 20, 30, 40, 50, 60 }, 6 };
+    status = deleteAt<Checked>(values, 2);
+    printf("Expected : Ok [10, 20, 40, 50, 60] | Result : %s ", statusName(status));
+    printArray(values);
+    printf("\n");
+
+    status = deleteAt<Checked>(values, values.size() - 1);
+    printf("Expected : Ok [10, 20, 40, 50] | Result : %s ", statusName(status));
+    printArray(values);
+    printf("\n");
+
+    status = deleteAt<Checked>(values, 4);
+    printf("Expected : InvalidIndex | Result : %s\n", statusName(status));
+
+    printf("\n==== Unchecked Mode ====\n");
+    StaticArray<int, 5> fast = { { 1, 2, 4 }, 3 };
+    insertAt<Unchecked>(fast, 2, 3);
+    deleteAt<Unchecked>(fast, 0);
+    printf("Expected : [2, 3, 4] | Result : ");
+    printArray(fast);
+    printf("\n");
+
+    printf("\n==== Compile-Time Array ====\n");
+    constexpr StaticArray<int, 5> built = buildAtCompileTime();
+    printf("Expected : [5, 10, 15, 20] | Result : ");
+    printArray(built);
+    printf("\n");
+
+    printf("\n==== Packed & Compressed Arrays ====\n");
+    PackedArray<12, 1000> packed = {};
+    for (uint32_t i = 0; i < 1000; i++) {
+        pushBack(packed, (i * 37) % 4096);
+    }
+    printf("Expected : 1504 bytes (vs 4000 for int[1000]) | Result : %zu bytes\n", packed.bytes());
+    printf("Expected : 370 (element 10, straddles two words) | Result : %u\n", packed.get(10));
+    printf("Expected : ValueTooWide | Result : %s\n", statusName(setAt<Checked>(packed, 10, 5000)));
+    setAt<Checked>(packed, 10, 4095);
+    printf("Expected : 4095 | Result : %u\n", packed.get(10));
+    printf("Expected : 100 | Result : %td\n", linearSearch(packed, (100 * 37) % 4096));
+
+    PackedArray<8, 1000> bytesWide = {};
+    for (uint32_t i = 0; i < 1000; i++) {
+        pushBack(bytesWide, i % 200);
+    }
+    printf("Expected : 199 (SWAR, 8 fields per word) | Result : %td\n", linearSearch(bytesWide, 199));
+    printf("Expected : -1 | Result : %td\n", linearSearch(bytesWide, 250));
+
+    const size_t idCount = 100000;
+    static uint32_t sortedIds[idCount];
+    static uint32_t decoded[idCount];
+    for (size_t i = 0; i < idCount; i++) {
+        sortedIds[i] = static_cast<uint32_t>(1000000 + i * 3 + (i % 7 == 0 ? 1 : 0));
+    }
+    FrameOfReferenceArray idColumn(sortedIds, idCount);
+    printf("Expected : delta mode, 4 bits (each id is ~12 above the one 4 back) | Result : %s mode, %u bits\n",
+        idColumn.blockHeader(0).delta ? "delta" : "FOR", idColumn.blockHeader(0).bits);
+    printf("Expected : 62560 bytes (vs 400000 raw) | Result : %zu bytes\n", idColumn.bytes());
+    idColumn.decode(decoded);
+    printf("Expected : decode round-trips | Result : %s\n",
+        memcmp(decoded, sortedIds, sizeof(sortedIds)) == 0 ? "decode round-trips" : "MISMATCH");
+    printf("Expected : %u | Result : %u\n", sortedIds[54321], idColumn.at(54321));
+    printf("Expected : 54321 | Result : %td\n", linearSearch(idColumn, sortedIds[54321]));
+    printf("Expected : -1 (below every block) | Result : %td\n", linearSearch(idColumn, 5));
+
+    uint32_t readings[300];
+    for (uint32_t i = 0; i < 300; i++) {
+        readings[i] = 70000 + (i * 2654435761u) % 500;   // unsorted, narrow range
+    }
+    FrameOfReferenceArray sensor(readings, 300);
+    printf("Expected : FOR mode, 9 bits | Result : %s mode, %u bits\n",
+        sensor.blockHeader(0).delta ? "delta" : "FOR", sensor.blockHeader(0).bits);
+    printf("Expected : %u | Result : %u\n", readings[299], sensor.at(299));
+    ptrdiff_t firstEqual = 0;
+    while (readings[firstEqual] != readings[299]) {
+        firstEqual++;
+    }
+    printf("Expected : %td (first equal reading) | Result : %td\n", firstEqual, linearSearch(sensor, readings[299]));
 
     return 0;
-}
\ No newline at end of file
+}
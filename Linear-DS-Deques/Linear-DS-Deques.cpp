@@ -1,20 +1,771 @@
-// Linear-DS-Deques.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
-
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/**
+* **DEQUES - DOUBLE-ENDED QUEUES**
+*
+*   PushFront(5) -> PushBack(10) -> PushFront(1)
+*
+*   Front -> [1][5][10] <- Back
+*
+* This file has two deques:
+*
+* * Deque<T, BlockSize> - a "map of blocks", the layout std::deque uses. Elements
+*   live in fixed-size blocks and a small array of block pointers (the map) lists
+*   them in order. Push and pop at either end are O(1), element i is found with a
+*   shift and a mask (no O(n) walk), and a block is never moved once allocated, so
+*   references to elements stay valid while the deque grows at either end.
+*
+*   map:    [ null | ●  | ●  | ●  | null ]
+*                    │    │    │
+*   blocks:      [_ _ 1 5][10 11 12 13][14 _ _ _]
+*                     ↑ front                ↑ back
+*
+* * WorkStealingDeque<T> - the Chase-Lev deque used by work-stealing thread pools.
+*   The owning thread pushes and pops tasks at the bottom (LIFO, cache-warm);
+*   any other thread may steal from the top (FIFO, oldest task) without locks.
+*/
+
+// ***************  SEGMENTED DEQUE  ****************
+
+// Default block size: about 512 bytes of elements, and at least 16 elements.
+template <typename T>
+constexpr size_t defaultDequeBlockSize() {
+    size_t n = 512 / sizeof(T);
+    size_t power = 16;
+    while (power < n) power <<= 1;
+    return power;
+}
+
+constexpr size_t log2Exact(size_t n) {
+    return n <= 1 ? 0 : 1 + log2Exact(n / 2);
+}
+
+/**
+* @brief A double-ended queue stored as a map of fixed-size blocks.
+*
+* Positions are absolute slot numbers across the map: element i lives at
+* position front + i, which is slot (p & mask) of block (p >> shift). Blocks are
+* allocated when an end reaches them and freed when an end leaves them (one empty
+* block is cached so that a push/pop oscillating over a block boundary does not
+* allocate each time). When an end runs out of map slots, only the map of block
+* pointers is reallocated. It is re-centered so that both ends have room again.
+*
+* Time Complexity:
+*   pushFront / pushBack / popFront / popBack   O(1) (amortized for the map growth)
+*   operator[] / at                             O(1)
+*
+* @tparam T          The element type.
+* @tparam BlockSize  Elements per block (a power of two).
+*/
+template <typename T, size_t BlockSize = defaultDequeBlockSize<T>()>
+class Deque {
+    static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+    static constexpr size_t shift = log2Exact(BlockSize);
+    static constexpr size_t mask = BlockSize - 1;
+
+    T** map = nullptr;
+    size_t mapCapacity = 0;
+    size_t front = 0;    // absolute position of the first element
+    size_t count = 0;
+    T* spare = nullptr;  // one cached empty block
+
+    T& slot(size_t position) { return map[position >> shift][position & mask]; }
+    const T& slot(size_t position) const { return map[position >> shift][position & mask]; }
+
+    void ensureBlock(size_t block) {
+        if (!map[block]) {
+            map[block] = spare ? spare : std::allocator<T>().allocate(BlockSize);
+            spare = nullptr;
+        }
+    }
+
+    void releaseBlock(size_t block) {
+        if (!spare) spare = map[block];
+        else std::allocator<T>().deallocate(map[block], BlockSize);
+        map[block] = nullptr;
+    }
+
+    /**
+     * @brief Allocates a fresh map and moves the block pointers to its middle.
+     *
+     * Only pointers are copied; the blocks (and so the elements) stay where
+     * they are. The new map has room for at least one more block at both ends.
+     *
+     * An empty deque has no blocks to keep, and its front may sit one past the
+     * map's last block (a FIFO that drained at the end of the map). It is moved
+     * to the middle of the map it already has instead: the block under the old
+     * front, if still allocated, becomes the spare, and nothing is copied.
+     */
+    void growMap() {
+        if (map && count == 0) {
+            size_t block = front >> shift;
+            if (block < mapCapacity && map[block]) releaseBlock(block);
+            front = (mapCapacity / 2) << shift;
+            return;
+        }
+
+        size_t firstBlock = front >> shift;
+        size_t lastBlock = count ? (front + count - 1) >> shift : firstBlock;
+        size_t usedBlocks = lastBlock - firstBlock + 1;
+
+        size_t newCapacity = mapCapacity < 8 ? 8 : mapCapacity;
+        while (newCapacity < 2 * (usedBlocks + 1)) newCapacity *= 2;
+
+        T** fresh = new T*[newCapacity]();
+        size_t newFirst = (newCapacity - usedBlocks) / 2;
+        if (map) {
+            std::memcpy(fresh + newFirst, map + firstBlock, usedBlocks * sizeof(T*));
+            delete[] map;
+        }
+        map = fresh;
+        mapCapacity = newCapacity;
+        front = (newFirst << shift) + (front & mask);
+    }
+
+    // Returns the position of a new slot at the back, with its block allocated.
+    size_t prepareBack() {
+        if (map == nullptr || ((front + count) >> shift) >= mapCapacity) growMap();
+        size_t position = front + count;
+        ensureBlock(position >> shift);
+        return position;
+    }
+
+    // Returns the position of a new slot in front of the first element, with its block allocated.
+    size_t prepareFront() {
+        if (map == nullptr || front == 0) growMap();
+        size_t position = front - 1;
+        ensureBlock(position >> shift);
+        return position;
+    }
+
+    void checkNotEmpty() const {
+        if (count == 0) throw std::runtime_error("Deque is empty");
+    }
+
+    void freeAll() {
+        clear();
+        if (map) {
+            for (size_t i = 0; i < mapCapacity; i++) {
+                if (map[i]) std::allocator<T>().deallocate(map[i], BlockSize);
+            }
+            delete[] map;
+        }
+        if (spare) std::allocator<T>().deallocate(spare, BlockSize);
+        map = nullptr;
+        spare = nullptr;
+        mapCapacity = front = 0;
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    /**
+     * @brief Random-access iterator: an element index plus the deque it points into.
+     */
+    template <typename DequePtr, typename Ref>
+    class IndexIterator {
+        DequePtr deque = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = remove_reference_t<Ref>*;
+        using reference = Ref;
+
+        IndexIterator() = default;
+        IndexIterator(DequePtr deque, size_t index) : deque(deque), index(index) {}
+
+        reference operator*() const { return (*deque)[index]; }
+        pointer operator->() const { return &(*deque)[index]; }
+        reference operator[](difference_type n) const { return (*deque)[index + n]; }
+
+        IndexIterator& operator++() { index++; return *this; }
+        IndexIterator& operator--() { index--; return *this; }
+        IndexIterator operator++(int) { IndexIterator previous = *this; index++; return previous; }
+        IndexIterator operator--(int) { IndexIterator previous = *this; index--; return previous; }
+        IndexIterator& operator+=(difference_type n) { index += n; return *this; }
+        IndexIterator& operator-=(difference_type n) { index -= n; return *this; }
+        IndexIterator operator+(difference_type n) const { return IndexIterator(deque, index + n); }
+        IndexIterator operator-(difference_type n) const { return IndexIterator(deque, index - n); }
+        friend IndexIterator operator+(difference_type n, const IndexIterator& it) { return it + n; }
+        difference_type operator-(const IndexIterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const IndexIterator& other) const { return index == other.index; }
+        bool operator!=(const IndexIterator& other) const { return index != other.index; }
+        bool operator<(const IndexIterator& other) const { return index < other.index; }
+        bool operator>(const IndexIterator& other) const { return index > other.index; }
+        bool operator<=(const IndexIterator& other) const { return index <= other.index; }
+        bool operator>=(const IndexIterator& other) const { return index >= other.index; }
+    };
+
+    using iterator = IndexIterator<Deque*, T&>;
+    using const_iterator = IndexIterator<const Deque*, const T&>;
+
+    Deque() = default;
+
+    Deque(const Deque& other) {
+        try {
+            for (size_t i = 0; i < other.count; i++) pushBack(other[i]);
+        }
+        catch (...) {
+            freeAll();   // no destructor runs for a constructor that throws
+            throw;
+        }
+    }
+
+    Deque(Deque&& other) noexcept
+        : map(other.map), mapCapacity(other.mapCapacity), front(other.front), count(other.count), spare(other.spare) {
+        other.map = nullptr;
+        other.spare = nullptr;
+        other.mapCapacity = other.front = other.count = 0;
+    }
+
+    Deque& operator=(Deque other) noexcept {
+        std::swap(map, other.map);
+        std::swap(mapCapacity, other.mapCapacity);
+        std::swap(front, other.front);
+        std::swap(count, other.count);
+        std::swap(spare, other.spare);
+        return *this;
+    }
+
+    ~Deque() { freeAll(); }
+
+    /**
+     * @brief Appends a value at the back.
+     *
+     * Constructs in the last block, allocating a new block when the back
+     * crosses a block boundary. Existing elements never move.
+     *
+     * Time Complexity  : O(1) (amortized when the map grows)
+     *
+     * Example:
+     *   deque = [1, 5]
+     *   deque.pushBack(10)  ->  [1, 5, 10]
+     */
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        size_t position = prepareBack();
+        T* place = &slot(position);
+        try {
+            ::new (static_cast<void*>(place)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            if ((position & mask) == 0) releaseBlock(position >> shift);   // the block was fetched for this element alone
+            throw;
+        }
+        count++;
+        return *place;
+    }
+
+    void pushBack(const T& value) { emplaceBack(value); }
+    void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+    /**
+     * @brief Inserts a value at the front.
+     *
+     * Time Complexity  : O(1) (amortized when the map grows)
+     *
+     * Example:
+     *   deque = [5, 10]
+     *   deque.pushFront(1)  ->  [1, 5, 10]
+     */
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        size_t position = prepareFront();
+        T* place = &slot(position);
+        try {
+            ::new (static_cast<void*>(place)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            if ((position & mask) == mask) releaseBlock(position >> shift);   // the block was fetched for this element alone
+            throw;
+        }
+        front = position;
+        count++;
+        return *place;
+    }
+
+    void pushFront(const T& value) { emplaceFront(value); }
+    void pushFront(T&& value) { emplaceFront(std::move(value)); }
+
+    /**
+     * @brief Removes the last element; frees its block if it became empty.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the deque is empty.
+     */
+    void popBack() {
+        checkNotEmpty();
+        size_t position = front + count - 1;
+        slot(position).~T();
+        count--;
+        if ((position & mask) == 0) releaseBlock(position >> shift);
+    }
+
+    /**
+     * @brief Removes the first element; frees its block if it became empty.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the deque is empty.
+     */
+    void popFront() {
+        checkNotEmpty();
+        size_t position = front;
+        slot(position).~T();
+        front++;
+        count--;
+        if ((front & mask) == 0) releaseBlock(position >> shift);
+    }
+
+    /**
+     * @brief Returns the element at `index` without bounds checking.
+     *
+     * One add, one shift and one mask to find the block and slot: O(1) however
+     * large the deque is.
+     *
+     * Time Complexity  : O(1)
+     */
+    T& operator[](size_t index) { return slot(front + index); }
+    const T& operator[](size_t index) const { return slot(front + index); }
+
+    /**
+     * @brief Returns the element at `index`.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws out_of_range if index >= size().
+     */
+    T& at(size_t index) {
+        if (index >= count) throw out_of_range("Index out of bounds");
+        return slot(front + index);
+    }
+
+    const T& at(size_t index) const {
+        if (index >= count) throw out_of_range("Index out of bounds");
+        return slot(front + index);
+    }
+
+    T& peekFront() { checkNotEmpty(); return slot(front); }
+    const T& peekFront() const { checkNotEmpty(); return slot(front); }
+    T& peekBack() { checkNotEmpty(); return slot(front + count - 1); }
+    const T& peekBack() const { checkNotEmpty(); return slot(front + count - 1); }
+
+    // Destroys all elements. The map and one block are kept.
+    void clear() {
+        while (count > 0) popBack();
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    static constexpr size_t blockSize() { return BlockSize; }
+
+    void display() const {
+        cout << "[";
+        for (size_t i = 0; i < count; i++) {
+            cout << (*this)[i];
+            if (i + 1 < count) cout << ", ";
+        }
+        cout << "]" << endl;
+    }
+};
+
+// ***************  WORK-STEALING DEQUE (CHASE-LEV)  ****************
+
+/**
+* @brief A lock-free work-stealing deque (Chase & Lev, with the C11 memory orderings of Le et al.).
+*
+*          top (thieves steal here, oldest first)
+*           ↓
+*   [ t0 ][ t1 ][ t2 ][ t3 ][    ][    ]
+*                             ↑
+*                           bottom (owner pushes and pops here, newest first)
+*
+* Exactly one thread, the owner, may call push() and tryPop(); any thread may
+* call trySteal(). The owner works LIFO on its own end, so it keeps running the
+* task whose data is still in its cache; thieves take the oldest task, which
+* tends to be the biggest piece of remaining work.
+*
+* push() and tryPop() do not use a CAS, except when tryPop() and a thief race for
+* the very last element. trySteal() does one CAS on `top`, and a thief that loses
+* the race simply returns false and tries elsewhere.
+*
+* The ring buffer doubles when full. The old buffer cannot be freed right away,
+* because a thief may still be reading it, so replaced buffers are kept until the deque is destroyed.
+*
+* @tparam T  The task type; must be trivially copyable (typically a pointer or an index).
+*/
+template <typename T>
+class WorkStealingDeque {
+    static_assert(is_trivially_copyable<T>::value, "WorkStealingDeque elements must be trivially copyable");
+
+    struct Ring {
+        int64_t capacity;
+        int64_t mask;
+        atomic<T>* slots;
+        Ring* retired;    // the ring this one replaced
+
+        explicit Ring(int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), slots(new atomic<T>[static_cast<size_t>(capacity)]), retired(nullptr) {}
+        ~Ring() { delete[] slots; }
+
+        T get(int64_t i) const { return slots[i & mask].load(memory_order_relaxed); }
+        void put(int64_t i, T value) { slots[i & mask].store(value, memory_order_relaxed); }
+    };
+
+    alignas(64) atomic<int64_t> top{ 0 };
+    alignas(64) atomic<int64_t> bottom{ 0 };
+    alignas(64) atomic<Ring*> ring;
+
+    Ring* grow(Ring* old, int64_t b, int64_t t) {
+        Ring* bigger = new Ring(old->capacity * 2);
+        for (int64_t i = t; i < b; i++) bigger->put(i, old->get(i));
+        bigger->retired = old;
+        ring.store(bigger, memory_order_release);
+        return bigger;
+    }
+
+public:
+    /**
+     * @brief Creates an empty deque with room for `initialCapacity` tasks (rounded up to a power of two).
+     */
+    explicit WorkStealingDeque(size_t initialCapacity = 64) {
+        int64_t capacity = 2;
+        while (capacity < static_cast<int64_t>(initialCapacity)) capacity *= 2;
+        ring.store(new Ring(capacity), memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque() {
+        Ring* r = ring.load(memory_order_relaxed);
+        while (r) {
+            Ring* older = r->retired;
+            delete r;
+            r = older;
+        }
+    }
+
+    /**
+     * @brief Pushes a task at the bottom. Owner thread only.
+     *
+     * Time Complexity  : O(1) amortized (the ring doubles when full)
+     */
+    void push(T value) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        Ring* r = ring.load(memory_order_relaxed);
+        if (b - t > r->capacity - 1) r = grow(r, b, t);
+        r->put(b, value);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pops the newest task from the bottom. Owner thread only.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @return false if the deque is empty (or a thief took the last task).
+     */
+    bool tryPop(T& out) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        Ring* r = ring.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);   // was already empty
+            return false;
+        }
+        out = r->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            bottom.store(b + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Steals the oldest task from the top. Any thread.
+     *
+     * Time Complexity  : O(1), lock-free
+     *
+     * @return false if the deque is empty or another thread won the race for the task.
+     */
+    bool trySteal(T& out) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) return false;
+
+        Ring* r = ring.load(memory_order_acquire);
+        T value = r->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return false;
+        out = value;
+        return true;
+    }
+
+    // A snapshot; exact only when no thread is running.
+    size_t sizeApprox() const {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool isEmptyApprox() const { return sizeApprox() == 0; }
+};
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test Deque: both ends
+    // ---------------------------------------------------------------
+    cout << "=== Deque ===" << endl;
+    Deque<int> deque;
+    deque.pushFront(5);
+    deque.pushBack(10);
+    deque.pushFront(1);
+    cout << "pushFront/pushBack -> Expected : [1, 5, 10] | Result : "; deque.display();
+    cout << "peekFront/peekBack -> Expected : 1 / 10 | Result : " << deque.peekFront() << " / " << deque.peekBack() << endl;
+    deque.popFront();
+    cout << "popFront()         -> Expected : [5, 10] | Result : "; deque.display();
+    deque.popBack();
+    cout << "popBack()          -> Expected : [5] | Result : "; deque.display();
+    deque.popBack();
+    try {
+        deque.popFront();
+    }
+    catch (const runtime_error& e) {
+        cout << "popFront() on empty deque correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test Deque: O(1) random access across many blocks
+    // ---------------------------------------------------------------
+    cout << "\n=== Random Access & Blocks ===" << endl;
+    Deque<int, 4> small;   // 4 elements per block, so indices cross many blocks
+    for (int i = 0; i < 10; i++) small.pushBack(i);
+    for (int i = 1; i <= 5; i++) small.pushFront(-i);
+    cout << "15 elements        -> Expected : [-5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9] | Result : "; small.display();
+    cout << "small[0], [7], [14]-> Expected : -5, 2, 9 | Result : " << small[0] << ", " << small[7] << ", " << small[14] << endl;
+    small[7] = 70;
+    cout << "at(7) after write  -> Expected : 70 | Result : " << small.at(7) << endl;
+    try {
+        small.at(15);
+    }
+    catch (const out_of_range& e) {
+        cout << "at(15) correctly threw: " << e.what() << endl;
+    }
+
+    sort(small.begin(), small.end(), std::greater<int>());
+    cout << "std::sort (desc)   -> Expected : [70, 9, 8, 7, 6, 5, 4, 3, 1, 0, -1, -2, -3, -4, -5] | Result : "; small.display();
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test Deque: references stay valid while it grows
+    // ---------------------------------------------------------------
+    cout << "\n=== Reference Stability ===" << endl;
+    Deque<string> names;
+    names.pushBack("middle");
+    string* pinned = &names[0];
+    for (int i = 0; i < 5000; i++) {
+        names.pushBack("back");
+        names.pushFront("front");
+    }
+    cout << "size               -> Expected : 10001 | Result : " << names.size() << endl;
+    cout << "pinned reference   -> Expected : middle (same address) | Result : " << *pinned
+         << (pinned == &names[5000] ? " (same address)" : " (moved!)") << endl;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    Deque<string> namesCopy = names;
+    names.clear();
+    cout << "copy independent   -> Expected : 10001 / 0 | Result : " << namesCopy.size() << " / " << names.size() << endl;
+    cout << "default block size -> Expected : 128 ints | Result : " << Deque<int>::blockSize() << endl;
+
+    // ---------------------------------------------------------------
+    // Test Deque: used as a FIFO, draining and refilling past the map's ends
+    // ---------------------------------------------------------------
+    cout << "\n=== FIFO Cycling ===" << endl;
+    Deque<int, 4> drained;
+    for (int i = 0; i < 20; i++) {   // empties exactly at the end of the 8-block map
+        drained.pushBack(i);
+        drained.popFront();
+    }
+    drained.pushBack(1);
+    drained.pushBack(2);
+    cout << "drain at map end   -> Expected : [1, 2] | Result : "; drained.display();
+
+    Deque<int> fifo;
+    long long fifoSum = 0;
+    for (int i = 0; i < 100000; i++) {
+        fifo.pushBack(i);
+        fifoSum += fifo.peekFront();
+        fifo.popFront();
+    }
+    cout << "100000 push/pop    -> Expected : sum 4999950000, empty | Result : sum " << fifoSum
+         << (fifo.isEmpty() ? ", empty" : ", not empty") << endl;
+
+    Deque<int, 4> window;
+    bool ordered = true;
+    for (int i = 0; i < 10000; i++) {
+        window.pushBack(i);
+        if (window.size() > 3) {   // a FIFO of 3, refilled until it empties every 100 rounds
+            ordered = ordered && window.peekFront() == i - 3;
+            window.popFront();
+        }
+        if (i % 100 == 99) {
+            while (!window.isEmpty()) window.popFront();
+        }
+    }
+    Deque<int, 4> stackAtFront;
+    for (int i = 0; i < 10000; i++) {   // the mirror image: empties at the start of the map
+        stackAtFront.pushFront(i);
+        stackAtFront.popBack();
+    }
+    stackAtFront.pushFront(7);
+    cout << "window / mirrored  -> Expected : in order, [7] | Result : " << (ordered ? "in order" : "out of order") << ", ";
+    stackAtFront.display();
+
+    struct ThrowsOnZero {
+        int value;
+        explicit ThrowsOnZero(int v) : value(v) {
+            if (v == 0) throw invalid_argument("zero");
+        }
+    };
+    Deque<ThrowsOnZero, 4> guarded;
+    for (int i = 1; i <= 4; i++) guarded.emplaceBack(i);   // back block full: the next element needs a new one
+    try {
+        guarded.emplaceBack(0);
+    }
+    catch (const invalid_argument&) {
+    }
+    try {
+        guarded.emplaceFront(0);
+    }
+    catch (const invalid_argument&) {
+    }
+    guarded.popFront();
+    for (int i = 5; i <= 64; i++) guarded.emplaceBack(i);   // grows the map, which keeps only the blocks in use
+    cout << "throwing emplace   -> Expected : size 63, front 2, back 64 (no block leaked) | Result : size " << guarded.size()
+         << ", front " << guarded.peekFront().value << ", back " << guarded.peekBack().value << endl;
+
+    struct CopyThrowsOnNegative {
+        int value;
+        int* alive;
+        CopyThrowsOnNegative(int v, int* counter) : value(v), alive(counter) { ++*alive; }
+        CopyThrowsOnNegative(const CopyThrowsOnNegative& other) : value(other.value), alive(other.alive) {
+            if (value < 0) throw invalid_argument("negative");
+            ++*alive;
+        }
+        ~CopyThrowsOnNegative() { --*alive; }
+    };
+    int alive = 0;
+    {
+        Deque<CopyThrowsOnNegative, 4> source;
+        for (int i = 1; i <= 10; i++) source.emplaceBack(i == 7 ? -i : i, &alive);   // the copy fails in its second block
+        try {
+            Deque<CopyThrowsOnNegative, 4> copy(source);
+        }
+        catch (const invalid_argument&) {
+            cout << "throwing copy      -> Expected : 10 alive | Result : " << alive << " alive" << endl;
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // Test WorkStealingDeque: LIFO owner, FIFO thieves
+    // ---------------------------------------------------------------
+    cout << "\n=== Work-Stealing Deque ===" << endl;
+    WorkStealingDeque<int> work(2);
+    for (int i = 1; i <= 5; i++) work.push(i);
+    int task = 0;
+    work.tryPop(task);
+    cout << "owner tryPop()     -> Expected : 5 (newest) | Result : " << task << endl;
+    work.trySteal(task);
+    cout << "thief trySteal()   -> Expected : 1 (oldest) | Result : " << task << endl;
+    cout << "sizeApprox()       -> Expected : 3 | Result : " << work.sizeApprox() << endl;
+    while (work.tryPop(task)) {}
+    cout << "trySteal on empty  -> Expected : false | Result : " << (work.trySteal(task) ? "true" : "false") << endl;
+
+    // One owner pushing and popping, three thieves stealing: every task runs exactly once.
+    const int tasks = 200000;
+    WorkStealingDeque<int> pool(64);
+    atomic<long long> executedSum{ 0 };
+    atomic<int> executed{ 0 };
+    atomic<bool> done{ false };
+    thread thieves[3];
+    for (thread& thief : thieves) {
+        thief = thread([&] {
+            int stolen;
+            long long localSum = 0;
+            int localCount = 0;
+            while (!done.load(memory_order_acquire)) {
+                if (pool.trySteal(stolen)) {
+                    localSum += stolen;
+                    localCount++;
+                }
+            }
+            while (pool.trySteal(stolen)) {
+                localSum += stolen;
+                localCount++;
+            }
+            executedSum += localSum;
+            executed += localCount;
+        });
+    }
+    long long ownerSum = 0;
+    int ownerCount = 0;
+    for (int i = 1; i <= tasks; i++) {
+        pool.push(i);
+        if (i % 3 == 0 && pool.tryPop(task)) {
+            ownerSum += task;
+            ownerCount++;
+        }
+    }
+    while (pool.tryPop(task)) {
+        ownerSum += task;
+        ownerCount++;
+    }
+    done.store(true, memory_order_release);
+    for (thread& thief : thieves) thief.join();
+    executedSum += ownerSum;
+    executed += ownerCount;
+    cout << "200000 tasks, 1 owner + 3 thieves -> Expected count / sum : " << tasks << " / "
+         << static_cast<long long>(tasks) * (tasks + 1) / 2
+         << " | Result : " << executed.load() << " / " << executedSum.load() << endl;
+
+    return 0;
+}
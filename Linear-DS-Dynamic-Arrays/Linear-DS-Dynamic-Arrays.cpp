@@ -1,678 +1,3679 @@
-﻿#include <iostream>
+﻿#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && __has_include(<span>)
+#include <span>
+#define DS_HAS_STD_SPAN 1
+#else
+#define DS_HAS_STD_SPAN 0
+#endif
+
+// Compile with -DDS_INSTRUMENT to count reallocations, shifted elements and heap traffic
+// (see INSTRUMENTATION below). Without it the counters and their hooks compile to nothing.
+#if defined(DS_INSTRUMENT)
+#define DS_DYNAMIC_ARRAYS_INSTRUMENT 1
+#else
+#define DS_DYNAMIC_ARRAYS_INSTRUMENT 0
+#endif
 using namespace std;
 
+// ***************  GROWTH POLICIES  ****************
+//
+// A growth policy decides the next capacity when the array is full.
+// Each one exposes:  static size_t nextCapacity(size_t capacity, size_t required)
+// and must return a value >= required.
+
+/**
+* @brief Doubles the capacity on every growth (the classic strategy).
+*
+* Fewest reallocations: n inserts cost about log2(n) resizes.
+* Downside: the new block is always larger than all previous blocks combined,
+* so the allocator can never reuse the memory freed by earlier resizes.
+*/
+struct DoublingGrowth {
+    static size_t nextCapacity(size_t capacity, size_t required) {
+        size_t next = (capacity == 0) ? 1 : capacity * 2;
+        return (next < required) ? required : next;
+    }
+};
+
+/**
+* @brief Grows the capacity by 1.5x on every growth.
+*
+* Slightly more reallocations than doubling, but because 1.5 < golden ratio,
+* after a few resizes the blocks freed earlier add up to enough space for the
+* next one, so the allocator can reuse them instead of always asking for new memory.
+*/
+struct OneAndHalfGrowth {
+    static size_t nextCapacity(size_t capacity, size_t required) {
+        size_t next = capacity + capacity / 2;
+        if (next <= capacity) next = capacity + 1;   // capacity 0 or 1
+        return (next < required) ? required : next;
+    }
+};
+
+/**
+* @brief Grows the capacity by a fixed number of slots on every growth.
+*
+* Bounded memory overhead (at most Chunk - 1 unused slots), but n inserts
+* cost O(n / Chunk) resizes, so pushBack is O(n) amortized — only use it when
+* the final size is roughly known or memory is tight.
+*
+* @tparam Chunk  The number of slots added per growth (must be > 0).
+*/
+template <size_t Chunk>
+struct FixedChunkGrowth {
+    static_assert(Chunk > 0, "FixedChunkGrowth needs a positive chunk size");
+
+    static size_t nextCapacity(size_t capacity, size_t required) {
+        size_t next = capacity + Chunk;
+        return (next < required) ? required : next;
+    }
+};
+
+// ***************  REALLOC-CAPABLE ALLOCATOR  ****************
+
+/**
+* @brief An allocator backed by malloc/realloc/free.
+*
+* Besides the standard allocate()/deallocate(), it offers reallocate(), which
+* DynamicArray uses to grow or shrink buffers of trivially copyable T in place:
+* realloc can extend the block without moving it, and for very large blocks
+* glibc serves realloc with mremap, remapping the pages instead of copying them.
+*
+* @tparam T  The element type.
+*/
 template <typename T>
+struct ReallocAllocator {
+    using value_type = T;
+
+    ReallocAllocator() = default;
+    template <typename U>
+    ReallocAllocator(const ReallocAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* p = std::malloc(n * sizeof(T));
+        if (!p && n > 0) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) { std::free(p); }
+
+    // On failure the original block is left untouched and bad_alloc is thrown.
+    T* reallocate(T* p, size_t /*oldCount*/, size_t newCount) {
+        void* q = std::realloc(p, newCount * sizeof(T));
+        if (!q && newCount > 0) throw std::bad_alloc();
+        return static_cast<T*>(q);
+    }
+
+    bool operator==(const ReallocAllocator&) const { return true; }
+    bool operator!=(const ReallocAllocator&) const { return false; }
+};
+
+// Detects whether Alloc provides reallocate(T*, size_t, size_t).
+template <typename Alloc, typename T, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Alloc, typename T>
+struct HasReallocate<Alloc, T, std::void_t<decltype(
+    std::declval<Alloc&>().reallocate(std::declval<T*>(), size_t(), size_t()))>> : std::true_type {};
+
+// ***************  SORTING KERNELS  ****************
+//
+// Free functions over raw [first, last) ranges, used by DynamicArray::sortInPlace().
+// They only move-assign and swap already-constructed elements, except
+// mergeRunsInto(), which placement-constructs into raw output storage.
+
+// Partitions at or below this size are finished with insertion sort.
+constexpr int insertionSortCutoff = 16;
+
+// Integral arrays at or above this size use radix sort instead of introsort.
+constexpr int radixSortCutoff = 256;
 
 /**
-* @brief A dynamic array implementation in C++.
-* 
-* This class mimics the behavior of std::vector but is built from scratch
-* to demonstrate the underlying mechanics of a resizable array data structure.
-* The DynamicArray class manages its own memory, allowing it to grow as elements
-* are added. It provides methods for inserting, deleting, and accessing elements,
-* as well as utility functions to check size, capacity, and display contents.
-* The internal array is stored on the heap, and the class handles resizing when
-* the number of elements exceeds the current capacity. This implementation is
-* intended for educational purposes to illustrate how dynamic arrays work under the hood,
-* and is not optimized for performance or feature-completeness like std::vector.
-* 
-* Note: This implementation does not seperate the logic from the container itself (Like std::vector) and is not designed for production use.
-*       It focuses on clarity and educational value.
+* @brief Insertion sort on [first, last). Fast for tiny or nearly sorted ranges.
 *
-* @tparam T  The type of elements stored in the array.
+* Time Complexity  : O(n^2) worst, O(n) on sorted input
+* Space Complexity : O(1)
+*/
+template <typename T, typename Compare>
+void insertionSortRange(T* first, T* last, Compare& comp) {
+    if (last - first < 2) return;
+
+    for (T* i = first + 1; i < last; ++i) {
+        T value = std::move(*i);
+        T* j = i;
+        while (j > first && comp(value, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(value);
+    }
+}
+
+// Restores the max-heap property for the subtree rooted at root (heap of n elements).
+template <typename T, typename Compare>
+void siftDown(T* base, ptrdiff_t root, ptrdiff_t n, Compare& comp) {
+    T value = std::move(base[root]);
+    while (true) {
+        ptrdiff_t child = 2 * root + 1;
+        if (child >= n) break;
+        if (child + 1 < n && comp(base[child], base[child + 1])) child++;
+        if (!comp(value, base[child])) break;
+        base[root] = std::move(base[child]);
+        root = child;
+    }
+    base[root] = std::move(value);
+}
+
+/**
+* @brief Heap sort on [first, last). Introsort's fallback when quicksort degenerates.
 *
-* Example usage:
-*   DynamicArray<int> arr;
-*   arr.pushBack(10);
-*   arr.pushBack(20);
-*   arr.insert(1, 15); // arr now contains [10, 15, 20]
+* Time Complexity  : O(n log n) guaranteed
+* Space Complexity : O(1)
+*/
+template <typename T, typename Compare>
+void heapSortRange(T* first, T* last, Compare& comp) {
+    using std::swap;
+    ptrdiff_t n = last - first;
+
+    for (ptrdiff_t i = n / 2 - 1; i >= 0; i--) {
+        siftDown(first, i, n, comp);
+    }
+    for (ptrdiff_t end = n - 1; end > 0; end--) {
+        swap(first[0], first[end]);
+        siftDown(first, 0, end, comp);
+    }
+}
+
+// Moves the median of *a, *b, *c into *result (median-of-three pivot selection).
+template <typename T, typename Compare>
+void moveMedianToFirst(T* result, T* a, T* b, T* c, Compare& comp) {
+    using std::swap;
+    if (comp(*a, *b)) {
+        if (comp(*b, *c))      swap(*result, *b);
+        else if (comp(*a, *c)) swap(*result, *c);
+        else                   swap(*result, *a);
+    }
+    else if (comp(*a, *c))     swap(*result, *a);
+    else if (comp(*b, *c))     swap(*result, *c);
+    else                       swap(*result, *b);
+}
+
+// Hoare partition of [lo, hi) around *pivot. The median-of-three guarantees
+// an element on each side that stops the scans, so no bounds checks are needed.
+template <typename T, typename Compare>
+T* unguardedPartition(T* lo, T* hi, T* pivot, Compare& comp) {
+    using std::swap;
+    while (true) {
+        while (comp(*lo, *pivot)) ++lo;
+        --hi;
+        while (comp(*pivot, *hi)) --hi;
+        if (!(lo < hi)) return lo;
+        swap(*lo, *hi);
+        ++lo;
+    }
+}
+
+/**
+* @brief Introsort on [first, last): quicksort with a median-of-three pivot,
+* switching to heap sort when the recursion gets too deep and to insertion
+* sort for small partitions.
+*
+* Recurses on the right side and loops on the left, so stack depth stays
+* bounded by depthLimit.
+*
+* Time Complexity  : O(n log n) guaranteed
+* Space Complexity : O(log n) — recursion
+*/
+template <typename T, typename Compare>
+void introsortRange(T* first, T* last, int depthLimit, Compare& comp) {
+    while (last - first > insertionSortCutoff) {
+        if (depthLimit == 0) {
+            heapSortRange(first, last, comp);
+            return;
+        }
+        --depthLimit;
+
+        T* mid = first + (last - first) / 2;
+        moveMedianToFirst(first, first + 1, mid, last - 1, comp);
+        T* cut = unguardedPartition(first + 1, last, first, comp);
+
+        introsortRange(cut, last, depthLimit, comp);
+        last = cut;
+    }
+    insertionSortRange(first, last, comp);
+}
+
+// 2 * floor(log2(n)) — the usual introsort recursion budget.
+inline int introsortDepthLimit(ptrdiff_t n) {
+    int depth = 0;
+    while (n > 1) {
+        n >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+/**
+* @brief LSD radix sort on n integers, one byte per pass.
+*
+* Signed values are ordered correctly by flipping the sign bit of each key.
+* A pass is skipped when every key has the same byte there (common for small
+* values in wide types), so sorting small ints costs only one or two passes.
+*
+* @param first    The integers to sort (ascending).
+* @param n        The number of integers.
+* @param scratch  Raw storage for n elements.
+*
+* Time Complexity  : O(n * sizeof(T))
+* Space Complexity : O(n) — the scratch buffer
+*/
+template <typename T>
+void radixSortRange(T* first, size_t n, T* scratch) {
+    using Key = typename make_unsigned<T>::type;
+    constexpr Key signFlip = is_signed<T>::value ? Key(Key(1) << (sizeof(T) * 8 - 1)) : Key(0);
+
+    T* src = first;
+    T* dst = scratch;
+
+    for (size_t pass = 0; pass < sizeof(T); pass++) {
+        const int shift = static_cast<int>(pass * 8);
+        size_t count[256] = {};
+
+        for (size_t i = 0; i < n; i++) {
+            count[((Key(src[i]) ^ signFlip) >> shift) & 0xFF]++;
+        }
+        if (count[((Key(src[0]) ^ signFlip) >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[count[((Key(src[i]) ^ signFlip) >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != first) {
+        std::memcpy(first, src, n * sizeof(T));
+    }
+}
+
+// True when sortInPlace() may replace the comparison sort with radix sort.
+template <typename T, typename Compare>
+constexpr bool useRadixSort =
+    is_integral<T>::value && !is_same<T, bool>::value && is_same<Compare, std::less<T>>::value;
+
+// First position in [first, last) whose element is not less than value.
+template <typename T, typename Compare>
+T* lowerBoundIn(T* first, T* last, const T& value, Compare& comp) {
+    ptrdiff_t count = last - first;
+    while (count > 0) {
+        ptrdiff_t half = count / 2;
+        if (comp(first[half], value)) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+/**
+* @brief Merges the sorted runs [a, aEnd) and [b, bEnd) into raw storage at out.
+*
+* Elements are move-constructed into out; the sources are left moved-from.
+* When depth > 0 and the runs are large, the merge itself is split in two:
+* the middle of the longer run is located in the shorter one by binary search,
+* and the two halves are merged concurrently on separate threads.
+*
+* Time Complexity  : O(n) work, O(n / 2^depth + log^2 n) span
+* Space Complexity : O(depth) threads
+*/
+template <typename T, typename Compare>
+void mergeRunsInto(T* a, T* aEnd, T* b, T* bEnd, T* out, Compare& comp, int depth) {
+    constexpr ptrdiff_t parallelMergeGrain = 1 << 14;
+
+    if (depth > 0 && (aEnd - a) + (bEnd - b) >= parallelMergeGrain) {
+        if (aEnd - a < bEnd - b) {
+            std::swap(a, b);
+            std::swap(aEnd, bEnd);
+        }
+        T* aMid = a + (aEnd - a) / 2;
+        T* bMid = lowerBoundIn(b, bEnd, *aMid, comp);
+        T* outMid = out + (aMid - a) + (bMid - b);
+
+        std::thread left([&] { mergeRunsInto(a, aMid, b, bMid, out, comp, depth - 1); });
+        mergeRunsInto(aMid, aEnd, bMid, bEnd, outMid, comp, depth - 1);
+        left.join();
+        return;
+    }
+
+    while (a != aEnd && b != bEnd) {
+        if (comp(*b, *a)) ::new (static_cast<void*>(out++)) T(std::move(*b++));
+        else              ::new (static_cast<void*>(out++)) T(std::move(*a++));
+    }
+    while (a != aEnd) ::new (static_cast<void*>(out++)) T(std::move(*a++));
+    while (b != bEnd) ::new (static_cast<void*>(out++)) T(std::move(*b++));
+}
+
+/**
+* @brief Selects sequential sorting (the default for every sort method).
+*/
+struct SequentialExecution {};
+
+/**
+* @brief Selects multi-threaded sorting.
+*
+* threadCount = 0 means "use std::thread::hardware_concurrency()".
+* The comparator is called concurrently from several threads and must not throw.
+*/
+struct ParallelExecution {
+    unsigned threadCount = 0;
+};
+
+// ***************  SIMD SCAN KERNELS  ****************
+//
+// Vectorized find / findAll / min / max for int, float and double arrays.
+// One kernel per instruction set; the best one the CPU supports is picked at
+// run time (see simdLevel()), so the same binary runs on any x86-64 and uses
+// AVX2 where available. Compile with -DDS_DISABLE_SIMD to force the scalar loops.
+//
+//   AVX2   : 8 x int/float or 4 x double per compare, movemask to locate hits,
+//            findAll compress-stores hit indices through a permutation table.
+//   SSE4.2 : 4 x int/float or 2 x double per compare.
+//   NEON   : 4 x int/float or 2 x double per compare (AArch64).
+//
+// min/max keep the scalar semantics exactly: an element replaces the current
+// best only if it compares strictly greater (or less), so NaNs after the first
+// element are skipped, just like in the scalar loop.
+
+#if defined(DS_DISABLE_SIMD)
+#define DS_SIMD_X86 0
+#define DS_SIMD_NEON 0
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DS_SIMD_X86 1
+#define DS_SIMD_NEON 0
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DS_SIMD_X86 0
+#define DS_SIMD_NEON 1
+#else
+#define DS_SIMD_X86 0
+#define DS_SIMD_NEON 0
+#endif
+
+#if DS_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DS_TARGET_AVX2
+#define DS_TARGET_SSE42
+#else
+#define DS_TARGET_AVX2  __attribute__((target("avx2")))
+#define DS_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#elif DS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+static_assert(sizeof(int) == 4, "SIMD int kernels assume a 32-bit int");
+
+enum class SimdLevel { Scalar, SSE42, AVX2, NEON };
+
+// Asks the CPU (and OS, for AVX register state) which instruction sets are usable.
+inline SimdLevel detectSimdLevel() {
+#if DS_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse42 = (info[2] & (1 << 20)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool sse42 = __builtin_cpu_supports("sse4.2");
+#endif
+    if (avx2) return SimdLevel::AVX2;
+    if (sse42) return SimdLevel::SSE42;
+    return SimdLevel::Scalar;
+#elif DS_SIMD_NEON
+    return SimdLevel::NEON;   // NEON is mandatory on AArch64
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Detected once, on first use.
+inline SimdLevel simdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// Index of the lowest set bit (m != 0).
+inline int lowestBit(unsigned m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, m);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+// Index of the lowest set bit of a 64-bit word (m != 0).
+inline int lowestBit64(unsigned long long m) {
+    unsigned low = static_cast<unsigned>(m);
+    return low ? lowestBit(low) : 32 + lowestBit(static_cast<unsigned>(m >> 32));
+}
+
+inline int bitCount(unsigned m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int count = 0;
+    for (; m; m &= m - 1) count++;
+    return count;
+#else
+    return __builtin_popcount(m);
+#endif
+}
+
+// True for the element types that have SIMD kernels.
+template <typename T>
+constexpr bool hasSimdScan = is_same<T, int>::value || is_same<T, float>::value || is_same<T, double>::value;
+
+// findAll() scans in blocks of this many elements, writing hit indices to a stack buffer.
+constexpr int simdScanBlock = 256;
+
+// ---- Scalar reference kernels (also used for tails and unsupported CPUs) ----
+
+template <typename T>
+int scalarFind(const T* p, int n, T key) {
+    for (int i = 0; i < n; i++) {
+        if (p[i] == key) return i;
+    }
+    return -1;
+}
+
+template <typename T>
+int scalarFindAllBlock(const T* p, int n, T key, int baseIndex, int* out) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (p[i] == key) out[count++] = baseIndex + i;
+    }
+    return count;
+}
+
+template <bool IsMax, typename T>
+T scalarReduce(const T* p, int n, T best) {
+    for (int i = 0; i < n; i++) {
+        if (IsMax ? (p[i] > best) : (p[i] < best)) best = p[i];
+    }
+    return best;
+}
+
+#if DS_SIMD_X86
+
+// compressTable.lanes[m] lists the set bit positions of the 8-bit mask m, in
+// order; used with _mm256_permutevar8x32_epi32 to pack hit indices together.
+struct CompressTable {
+    alignas(32) int lanes[256][8];
+
+    constexpr CompressTable() : lanes{} {
+        for (int m = 0; m < 256; m++) {
+            int k = 0;
+            for (int b = 0; b < 8; b++) {
+                if (m & (1 << b)) lanes[m][k++] = b;
+            }
+        }
+    }
+};
+
+inline constexpr CompressTable compressTable{};
+
+// ---- AVX2 ----
+
+DS_TARGET_AVX2 inline int avx2Find(const int* p, int n, int key) {
+    const __m256i k = _mm256_set1_epi32(key);
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {   // 4 vectors per iteration; locate only on a hit
+        __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), k);
+        __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)), k);
+        __m256i e2 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 16)), k);
+        __m256i e3 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 24)), k);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (!_mm256_testz_si256(any, any)) break;
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), k);
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+DS_TARGET_AVX2 inline int avx2Find(const float* p, int n, float key) {
+    const __m256 k = _mm256_set1_ps(key);
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 e0 = _mm256_cmp_ps(_mm256_loadu_ps(p + i), k, _CMP_EQ_OQ);
+        __m256 e1 = _mm256_cmp_ps(_mm256_loadu_ps(p + i + 8), k, _CMP_EQ_OQ);
+        __m256 e2 = _mm256_cmp_ps(_mm256_loadu_ps(p + i + 16), k, _CMP_EQ_OQ);
+        __m256 e3 = _mm256_cmp_ps(_mm256_loadu_ps(p + i + 24), k, _CMP_EQ_OQ);
+        if (_mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(e0, e1), _mm256_or_ps(e2, e3)))) break;
+    }
+    for (; i + 8 <= n; i += 8) {
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), k, _CMP_EQ_OQ)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+DS_TARGET_AVX2 inline int avx2Find(const double* p, int n, double key) {
+    const __m256d k = _mm256_set1_pd(key);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256d e0 = _mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ);
+        __m256d e1 = _mm256_cmp_pd(_mm256_loadu_pd(p + i + 4), k, _CMP_EQ_OQ);
+        __m256d e2 = _mm256_cmp_pd(_mm256_loadu_pd(p + i + 8), k, _CMP_EQ_OQ);
+        __m256d e3 = _mm256_cmp_pd(_mm256_loadu_pd(p + i + 12), k, _CMP_EQ_OQ);
+        if (_mm256_movemask_pd(_mm256_or_pd(_mm256_or_pd(e0, e1), _mm256_or_pd(e2, e3)))) break;
+    }
+    for (; i + 4 <= n; i += 4) {
+        unsigned m = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+// Packs the indices of the lanes set in mask m (in order) to out; returns how many.
+DS_TARGET_AVX2 inline int avx2CompressIndices(unsigned m, __m256i indices, int* out) {
+    __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(compressTable.lanes[m]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(indices, perm));
+    return bitCount(m);
+}
+
+DS_TARGET_AVX2 inline int avx2FindAllBlock(const int* p, int n, int key, int baseIndex, int* out) {
+    const __m256i k = _mm256_set1_epi32(key);
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i indices = _mm256_add_epi32(_mm256_set1_epi32(baseIndex), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    int count = 0;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), k);
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        if (m) count += avx2CompressIndices(m, indices, out + count);
+        indices = _mm256_add_epi32(indices, step);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+DS_TARGET_AVX2 inline int avx2FindAllBlock(const float* p, int n, float key, int baseIndex, int* out) {
+    const __m256 k = _mm256_set1_ps(key);
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i indices = _mm256_add_epi32(_mm256_set1_epi32(baseIndex), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    int count = 0;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), k, _CMP_EQ_OQ)));
+        if (m) count += avx2CompressIndices(m, indices, out + count);
+        indices = _mm256_add_epi32(indices, step);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+DS_TARGET_AVX2 inline int avx2FindAllBlock(const double* p, int n, double key, int baseIndex, int* out) {
+    const __m256d k = _mm256_set1_pd(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned m = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ)));
+        for (; m; m &= m - 1) out[count++] = baseIndex + i + lowestBit(m);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+// Lane-wise max/min with 4 independent accumulators, then a horizontal reduction.
+// The new value goes first: max_ps(v, acc) returns acc when v is NaN.
+template <bool IsMax>
+DS_TARGET_AVX2 inline int avx2Reduce(const int* p, int n) {
+    int i = 0;
+    int best = p[0];
+    if (n >= 32) {
+        __m256i a0 = _mm256_set1_epi32(best), a1 = a0, a2 = a0, a3 = a0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8));
+            __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 16));
+            __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 24));
+            if constexpr (IsMax) {
+                a0 = _mm256_max_epi32(a0, v0); a1 = _mm256_max_epi32(a1, v1);
+                a2 = _mm256_max_epi32(a2, v2); a3 = _mm256_max_epi32(a3, v3);
+            }
+            else {
+                a0 = _mm256_min_epi32(a0, v0); a1 = _mm256_min_epi32(a1, v1);
+                a2 = _mm256_min_epi32(a2, v2); a3 = _mm256_min_epi32(a3, v3);
+            }
+        }
+        alignas(32) int lanes[8];
+        if constexpr (IsMax) a0 = _mm256_max_epi32(_mm256_max_epi32(a0, a1), _mm256_max_epi32(a2, a3));
+        else                 a0 = _mm256_min_epi32(_mm256_min_epi32(a0, a1), _mm256_min_epi32(a2, a3));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), a0);
+        best = scalarReduce<IsMax>(lanes, 8, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+DS_TARGET_AVX2 inline float avx2Reduce(const float* p, int n) {
+    int i = 0;
+    float best = p[0];
+    if (n >= 32) {
+        __m256 a0 = _mm256_set1_ps(best), a1 = a0, a2 = a0, a3 = a0;
+        for (; i + 32 <= n; i += 32) {
+            __m256 v0 = _mm256_loadu_ps(p + i),      v1 = _mm256_loadu_ps(p + i + 8);
+            __m256 v2 = _mm256_loadu_ps(p + i + 16), v3 = _mm256_loadu_ps(p + i + 24);
+            if constexpr (IsMax) {
+                a0 = _mm256_max_ps(v0, a0); a1 = _mm256_max_ps(v1, a1);
+                a2 = _mm256_max_ps(v2, a2); a3 = _mm256_max_ps(v3, a3);
+            }
+            else {
+                a0 = _mm256_min_ps(v0, a0); a1 = _mm256_min_ps(v1, a1);
+                a2 = _mm256_min_ps(v2, a2); a3 = _mm256_min_ps(v3, a3);
+            }
+        }
+        alignas(32) float lanes[32];
+        _mm256_store_ps(lanes, a0);      _mm256_store_ps(lanes + 8, a1);
+        _mm256_store_ps(lanes + 16, a2); _mm256_store_ps(lanes + 24, a3);
+        best = scalarReduce<IsMax>(lanes, 32, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+DS_TARGET_AVX2 inline double avx2Reduce(const double* p, int n) {
+    int i = 0;
+    double best = p[0];
+    if (n >= 16) {
+        __m256d a0 = _mm256_set1_pd(best), a1 = a0, a2 = a0, a3 = a0;
+        for (; i + 16 <= n; i += 16) {
+            __m256d v0 = _mm256_loadu_pd(p + i),     v1 = _mm256_loadu_pd(p + i + 4);
+            __m256d v2 = _mm256_loadu_pd(p + i + 8), v3 = _mm256_loadu_pd(p + i + 12);
+            if constexpr (IsMax) {
+                a0 = _mm256_max_pd(v0, a0); a1 = _mm256_max_pd(v1, a1);
+                a2 = _mm256_max_pd(v2, a2); a3 = _mm256_max_pd(v3, a3);
+            }
+            else {
+                a0 = _mm256_min_pd(v0, a0); a1 = _mm256_min_pd(v1, a1);
+                a2 = _mm256_min_pd(v2, a2); a3 = _mm256_min_pd(v3, a3);
+            }
+        }
+        alignas(32) double lanes[16];
+        _mm256_store_pd(lanes, a0);     _mm256_store_pd(lanes + 4, a1);
+        _mm256_store_pd(lanes + 8, a2); _mm256_store_pd(lanes + 12, a3);
+        best = scalarReduce<IsMax>(lanes, 16, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+// ---- SSE4.2 ----
+
+DS_TARGET_SSE42 inline int sse42Find(const int* p, int n, int key) {
+    const __m128i k = _mm_set1_epi32(key);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), k);
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+DS_TARGET_SSE42 inline int sse42Find(const float* p, int n, float key) {
+    const __m128 k = _mm_set1_ps(key);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), k)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+DS_TARGET_SSE42 inline int sse42Find(const double* p, int n, double key) {
+    const __m128d k = _mm_set1_pd(key);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        unsigned m = static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), k)));
+        if (m) return i + lowestBit(m);
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+DS_TARGET_SSE42 inline int sse42FindAllBlock(const int* p, int n, int key, int baseIndex, int* out) {
+    const __m128i k = _mm_set1_epi32(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), k);
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        for (; m; m &= m - 1) out[count++] = baseIndex + i + lowestBit(m);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+DS_TARGET_SSE42 inline int sse42FindAllBlock(const float* p, int n, float key, int baseIndex, int* out) {
+    const __m128 k = _mm_set1_ps(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), k)));
+        for (; m; m &= m - 1) out[count++] = baseIndex + i + lowestBit(m);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+DS_TARGET_SSE42 inline int sse42FindAllBlock(const double* p, int n, double key, int baseIndex, int* out) {
+    const __m128d k = _mm_set1_pd(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        unsigned m = static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), k)));
+        for (; m; m &= m - 1) out[count++] = baseIndex + i + lowestBit(m);
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+template <bool IsMax>
+DS_TARGET_SSE42 inline int sse42Reduce(const int* p, int n) {
+    int i = 0;
+    int best = p[0];
+    if (n >= 4) {
+        __m128i acc = _mm_set1_epi32(best);
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            acc = IsMax ? _mm_max_epi32(acc, v) : _mm_min_epi32(acc, v);
+        }
+        alignas(16) int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        best = scalarReduce<IsMax>(lanes, 4, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+DS_TARGET_SSE42 inline float sse42Reduce(const float* p, int n) {
+    int i = 0;
+    float best = p[0];
+    if (n >= 4) {
+        __m128 acc = _mm_set1_ps(best);
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(p + i);
+            acc = IsMax ? _mm_max_ps(v, acc) : _mm_min_ps(v, acc);
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, acc);
+        best = scalarReduce<IsMax>(lanes, 4, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+DS_TARGET_SSE42 inline double sse42Reduce(const double* p, int n) {
+    int i = 0;
+    double best = p[0];
+    if (n >= 2) {
+        __m128d acc = _mm_set1_pd(best);
+        for (; i + 2 <= n; i += 2) {
+            __m128d v = _mm_loadu_pd(p + i);
+            acc = IsMax ? _mm_max_pd(v, acc) : _mm_min_pd(v, acc);
+        }
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, acc);
+        best = scalarReduce<IsMax>(lanes, 2, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+#endif // DS_SIMD_X86
+
+#if DS_SIMD_NEON
+
+// ---- NEON (AArch64) ----
+
+inline int neonFind(const int* p, int n, int key) {
+    const int32x4_t k = vdupq_n_s32(key);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_s32(vld1q_s32(p + i), k))) break;
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+inline int neonFind(const float* p, int n, float key) {
+    const float32x4_t k = vdupq_n_f32(key);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_f32(vld1q_f32(p + i), k))) break;
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+inline int neonFind(const double* p, int n, double key) {
+    const float64x2_t k = vdupq_n_f64(key);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        if (vmaxvq_u32(vreinterpretq_u32_u64(vceqq_f64(vld1q_f64(p + i), k)))) break;
+    }
+    int tail = scalarFind(p + i, n - i, key);
+    return tail < 0 ? -1 : i + tail;
+}
+
+inline int neonFindAllBlock(const int* p, int n, int key, int baseIndex, int* out) {
+    const int32x4_t k = vdupq_n_s32(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_s32(vld1q_s32(p + i), k))) {
+            count += scalarFindAllBlock(p + i, 4, key, baseIndex + i, out + count);
+        }
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+inline int neonFindAllBlock(const float* p, int n, float key, int baseIndex, int* out) {
+    const float32x4_t k = vdupq_n_f32(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_f32(vld1q_f32(p + i), k))) {
+            count += scalarFindAllBlock(p + i, 4, key, baseIndex + i, out + count);
+        }
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+inline int neonFindAllBlock(const double* p, int n, double key, int baseIndex, int* out) {
+    const float64x2_t k = vdupq_n_f64(key);
+    int count = 0;
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        if (vmaxvq_u32(vreinterpretq_u32_u64(vceqq_f64(vld1q_f64(p + i), k)))) {
+            count += scalarFindAllBlock(p + i, 2, key, baseIndex + i, out + count);
+        }
+    }
+    return count + scalarFindAllBlock(p + i, n - i, key, baseIndex + i, out + count);
+}
+
+// Select-on-compare instead of vmaxq/vminq, which would propagate NaNs.
+template <bool IsMax>
+inline int neonReduce(const int* p, int n) {
+    int i = 0;
+    int best = p[0];
+    if (n >= 4) {
+        int32x4_t acc = vdupq_n_s32(best);
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t v = vld1q_s32(p + i);
+            acc = IsMax ? vmaxq_s32(acc, v) : vminq_s32(acc, v);
+        }
+        best = IsMax ? vmaxvq_s32(acc) : vminvq_s32(acc);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+inline float neonReduce(const float* p, int n) {
+    int i = 0;
+    float best = p[0];
+    if (n >= 4) {
+        float32x4_t acc = vdupq_n_f32(best);
+        for (; i + 4 <= n; i += 4) {
+            float32x4_t v = vld1q_f32(p + i);
+            uint32x4_t better = IsMax ? vcgtq_f32(v, acc) : vcltq_f32(v, acc);
+            acc = vbslq_f32(better, v, acc);
+        }
+        float lanes[4];
+        vst1q_f32(lanes, acc);
+        best = scalarReduce<IsMax>(lanes, 4, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+template <bool IsMax>
+inline double neonReduce(const double* p, int n) {
+    int i = 0;
+    double best = p[0];
+    if (n >= 2) {
+        float64x2_t acc = vdupq_n_f64(best);
+        for (; i + 2 <= n; i += 2) {
+            float64x2_t v = vld1q_f64(p + i);
+            uint64x2_t better = IsMax ? vcgtq_f64(v, acc) : vcltq_f64(v, acc);
+            acc = vbslq_f64(better, v, acc);
+        }
+        double lanes[2];
+        vst1q_f64(lanes, acc);
+        best = scalarReduce<IsMax>(lanes, 2, best);
+    }
+    return scalarReduce<IsMax>(p + i, n - i, best);
+}
+
+#endif // DS_SIMD_NEON
+
+// ---- Dispatchers (T = int, float or double) ----
+//
+// The kernels count in int; the size_t entry points below walk arrays longer
+// than that in chunks of simdChunk elements.
+
+constexpr size_t simdChunk = size_t(1) << 30;
+
+/**
+* @brief Index of the first element equal to key in p[0, n), or -1 (n <= simdChunk).
+*/
+template <typename T>
+int simdFindChunk(const T* p, int n, T key) {
+    switch (simdLevel()) {
+#if DS_SIMD_X86
+    case SimdLevel::AVX2:  return avx2Find(p, n, key);
+    case SimdLevel::SSE42: return sse42Find(p, n, key);
+#elif DS_SIMD_NEON
+    case SimdLevel::NEON:  return neonFind(p, n, key);
+#endif
+    default:               return scalarFind(p, n, key);
+    }
+}
+
+/**
+* @brief Index of the first element equal to key in p[0, n), or n if there is none.
+*/
+template <typename T>
+size_t simdFind(const T* p, size_t n, T key) {
+    for (size_t base = 0; base < n; base += simdChunk) {
+        int chunk = static_cast<int>((n - base < simdChunk) ? n - base : simdChunk);
+        int index = simdFindChunk(p + base, chunk, key);
+        if (index >= 0) return base + index;
+    }
+    return n;
+}
+
+/**
+* @brief Writes baseIndex + i for every p[i] == key (i < n <= simdScanBlock) to out.
+* @return The number of indices written.
 */
+template <typename T>
+int simdFindAllBlock(const T* p, int n, T key, int baseIndex, int* out) {
+    switch (simdLevel()) {
+#if DS_SIMD_X86
+    case SimdLevel::AVX2:  return avx2FindAllBlock(p, n, key, baseIndex, out);
+    case SimdLevel::SSE42: return sse42FindAllBlock(p, n, key, baseIndex, out);
+#elif DS_SIMD_NEON
+    case SimdLevel::NEON:  return neonFindAllBlock(p, n, key, baseIndex, out);
+#endif
+    default:               return scalarFindAllBlock(p, n, key, baseIndex, out);
+    }
+}
+
+/**
+* @brief Largest (IsMax) or smallest element of p[0, n), 1 <= n <= simdChunk.
+*/
+template <bool IsMax, typename T>
+T simdReduceChunk(const T* p, int n) {
+    switch (simdLevel()) {
+#if DS_SIMD_X86
+    case SimdLevel::AVX2:  return avx2Reduce<IsMax>(p, n);
+    case SimdLevel::SSE42: return sse42Reduce<IsMax>(p, n);
+#elif DS_SIMD_NEON
+    case SimdLevel::NEON:  return neonReduce<IsMax>(p, n);
+#endif
+    default:               return scalarReduce<IsMax>(p + 1, n - 1, p[0]);
+    }
+}
+
+/**
+* @brief Largest (IsMax) or smallest element of p[0, n), n >= 1.
+*/
+template <bool IsMax, typename T>
+T simdReduce(const T* p, size_t n) {
+    T best = simdReduceChunk<IsMax>(p, static_cast<int>((n < simdChunk) ? n : simdChunk));
+    for (size_t base = simdChunk; base < n; base += simdChunk) {
+        int chunk = static_cast<int>((n - base < simdChunk) ? n - base : simdChunk);
+        T chunkBest = simdReduceChunk<IsMax>(p + base, chunk);
+        best = scalarReduce<IsMax>(&chunkBest, 1, best);
+    }
+    return best;
+}
+
+// ***************  SPAN VIEW  ****************
+//
+// Span<T> is a non-owning (pointer, size) view of contiguous elements. Under
+// C++20 it is std::span<T>; in C++17 builds it is the minimal stand-in below,
+// which offers the same member names, so code written against it compiles
+// unchanged in both modes.
+
+#if DS_HAS_STD_SPAN
+
+template <typename T>
+using Span = std::span<T>;
+
+#else
+
+template <typename T>
+class Span {
+private:
+    T* start;
+    size_t length;
+
+public:
+    using element_type    = T;
+    using value_type      = typename remove_cv<T>::type;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer         = T*;
+    using reference       = T&;
+    using iterator        = T*;
+
+    constexpr Span() noexcept : start(nullptr), length(0) {}
+    constexpr Span(T* data, size_t size) noexcept : start(data), length(size) {}
+
+    // Span<T> converts to Span<const T>.
+    template <typename U, typename = typename enable_if<is_convertible<U(*)[], T(*)[]>::value>::type>
+    constexpr Span(const Span<U>& other) noexcept : start(other.data()), length(other.size()) {}
+
+    constexpr T* data() const noexcept { return start; }
+    constexpr size_t size() const noexcept { return length; }
+    constexpr size_t size_bytes() const noexcept { return length * sizeof(T); }
+    constexpr bool empty() const noexcept { return length == 0; }
+
+    constexpr T& operator[](size_t index) const { return start[index]; }
+    constexpr T& front() const { return start[0]; }
+    constexpr T& back() const { return start[length - 1]; }
+
+    constexpr T* begin() const noexcept { return start; }
+    constexpr T* end() const noexcept { return start + length; }
+
+    constexpr Span first(size_t n) const { return Span(start, n); }
+    constexpr Span last(size_t n) const { return Span(start + length - n, n); }
+    constexpr Span subspan(size_t offset) const { return Span(start + offset, length - offset); }
+    constexpr Span subspan(size_t offset, size_t n) const { return Span(start + offset, n); }
+};
+
+#endif
+
+// ***************  INLINE STORAGE  ****************
+//
+// Raw, uninitialized room for N elements inside the array object itself.
+// DynamicArray inherits from it, so with N = 0 (the default) the empty base
+// adds nothing to sizeof(DynamicArray).
+
+template <typename T, size_t N>
+struct InlineStorage {
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+
+    T* inlineSlots() noexcept { return reinterpret_cast<T*>(bytes); }
+    const T* inlineSlots() const noexcept { return reinterpret_cast<const T*>(bytes); }
+};
+
+template <typename T>
+struct InlineStorage<T, 0> {
+    T* inlineSlots() noexcept { return nullptr; }
+    const T* inlineSlots() const noexcept { return nullptr; }
+};
+
+// ***************  INSTRUMENTATION  ****************
+//
+// Opt-in counters for finding the call sites that pay for growth and shifting,
+// instead of guessing from the complexity tables. Built with -DDS_INSTRUMENT,
+// every DynamicArray counts its own reallocations and moved elements (stats()),
+// and AllocationTracker adds up the heap traffic of all of them. Without it the
+// array has no counter member and every hook is an empty inline function.
+
+/**
+* @brief What one DynamicArray has done since it was constructed (or since resetStats()).
+*
+*   reallocations    new buffers: growth, reserve(), shrinkToFit()
+*   elementsMoved    elements carried into a new buffer by those reallocations
+*   elementsShifted  elements moved inside the buffer: insert(), removeAt(), the range
+*                    operations, and the slides that make room for push() / pushBack()
+*   largestShift     the most elements one shift moved; close to size() means an O(n) call site
+*   bytesCopied      (elementsMoved + elementsShifted) * sizeof(T)
+*
+* A realloc() growth (ReallocAllocator) counts as a reallocation that moved nothing:
+* whether the block was copied is up to the allocator. All fields stay 0 when
+* instrumentation is compiled out.
+*/
+struct DynamicArrayStats {
+    size_t reallocations = 0;
+    size_t elementsMoved = 0;
+    size_t elementsShifted = 0;
+    size_t largestShift = 0;
+    size_t bytesCopied = 0;
+};
+
+// A snapshot of AllocationTracker.
+struct AllocationCounts {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesAllocated = 0;
+    size_t bytesFreed = 0;
+    size_t liveBytes = 0;     // allocated and not yet freed
+    size_t peakBytes = 0;     // the most liveBytes has been since the last reset()
+};
+
+/**
+* @brief Heap traffic of every DynamicArray in the program, whatever its allocator.
+*
+* Counts the element buffers the arrays allocate and free, and the scratch buffers of
+* sortInPlace() / parallel sort. An inline buffer is not heap memory and is not counted.
+* The counters are relaxed atomics, so arrays on any thread are tracked together.
+* Without -DDS_INSTRUMENT the record functions are empty and snapshot() is all zeros.
+*
+* Example:
+*   AllocationTracker::reset();
+*   runRequest();
+*   AllocationTracker::snapshot().peakBytes   // the request's high-water mark
+*/
+class AllocationTracker {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+    inline static atomic<size_t> allocations{ 0 };
+    inline static atomic<size_t> deallocations{ 0 };
+    inline static atomic<size_t> bytesAllocated{ 0 };
+    inline static atomic<size_t> bytesFreed{ 0 };
+    inline static atomic<size_t> liveBytes{ 0 };
+    inline static atomic<size_t> peakBytes{ 0 };
+#endif
+
+public:
+    static void recordAllocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        allocations.fetch_add(1, memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, memory_order_relaxed);
+        size_t live = liveBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+        size_t peak = peakBytes.load(memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+#endif
+    }
+
+    static void recordDeallocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        deallocations.fetch_add(1, memory_order_relaxed);
+        bytesFreed.fetch_add(bytes, memory_order_relaxed);
+        liveBytes.fetch_sub(bytes, memory_order_relaxed);
+#endif
+    }
+
+    static AllocationCounts snapshot() noexcept {
+        AllocationCounts counts;
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        counts.allocations = allocations.load(memory_order_relaxed);
+        counts.deallocations = deallocations.load(memory_order_relaxed);
+        counts.bytesAllocated = bytesAllocated.load(memory_order_relaxed);
+        counts.bytesFreed = bytesFreed.load(memory_order_relaxed);
+        counts.liveBytes = liveBytes.load(memory_order_relaxed);
+        counts.peakBytes = peakBytes.load(memory_order_relaxed);
+#endif
+        return counts;
+    }
+
+    // Zeroes the counts. Buffers that are still allocated stay live, so the peak restarts from them.
+    static void reset() noexcept {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        allocations.store(0, memory_order_relaxed);
+        deallocations.store(0, memory_order_relaxed);
+        bytesAllocated.store(0, memory_order_relaxed);
+        bytesFreed.store(0, memory_order_relaxed);
+        peakBytes.store(liveBytes.load(memory_order_relaxed), memory_order_relaxed);
+#endif
+    }
+};
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          size_t InlineCapacity = 0>
+
+/**
+* @brief A dynamic array implementation in C++.
+*
+* This class mimics the behavior of std::vector but is built from scratch
+* to demonstrate the underlying mechanics of a resizable array data structure.
+* The DynamicArray class manages its own memory, allowing it to grow as elements
+* are added. It provides methods for inserting, deleting, and accessing elements,
+* as well as utility functions to check size, capacity, and display contents.
+* The internal array is stored on the heap, and the class handles resizing when
+* the number of elements exceeds the current capacity. This implementation is
+* intended for educational purposes to illustrate how dynamic arrays work under the hood,
+* and is not optimized for performance or feature-completeness like std::vector.
+*
+* Note: This implementation does not seperate the logic from the container itself (Like std::vector) and is not designed for production use.
+*       It focuses on clarity and educational value.
+*
+* Memory model: the buffer is raw, uninitialized storage obtained from the
+* allocator. Only the live slots hold constructed objects; free slots are
+* never constructed. This means T does not need a default constructor, and
+* unused capacity costs no constructor calls.
+*
+* Layout: the live elements do not have to start at the beginning of the
+* buffer. `storage` is the start of the allocation and `items` points at
+* element 0, so there can be free headroom before the first element:
+*
+*   storage          items
+*      ↓               ↓
+*     [ __ ][ __ ][ __ ][ 10 ][ 20 ][ 30 ][ __ ][ __ ]
+*      <- front room ->  <-- size = 3 -->  <- back room ->
+*
+* push() and pop() grow and shrink the front room, so working at the front is
+* amortized O(1) just like at the back, while operator[] stays a single
+* `items + index`. insert() / removeAt() shift whichever side is shorter.
+*
+* @tparam T          The type of elements stored in the array.
+* @tparam Allocator  Supplies the raw storage (std::allocator<T> by default).
+*                    Any allocator usable through std::allocator_traits works,
+*                    e.g. an arena, pool or huge-page allocator. If it also has
+*                    reallocate() (see ReallocAllocator) and T is trivially
+*                    copyable, growth is done with realloc instead of a copy.
+* @tparam GrowthPolicy  Picks the next capacity when full: DoublingGrowth
+*                    (default), OneAndHalfGrowth or FixedChunkGrowth<N>.
+* @tparam InlineCapacity  Slots stored inside the object itself (0 by default).
+*                    While the array fits in them nothing is allocated; it
+*                    spills to the allocator only past InlineCapacity
+*                    elements. See SmallDynamicArray.
+*
+* Example usage:
+*   DynamicArray<int> arr;
+*   arr.pushBack(10);
+*   arr.pushBack(20);
+*   arr.insert(1, 15); // arr now contains [10, 15, 20]
+*/
+
+class DynamicArray : private InlineStorage<T, InlineCapacity> {
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using InlineStorage<T, InlineCapacity>::inlineSlots;
+
+    size_t capacity;      // Total allocated space (front room + elements + back room)
+    size_t currentSize;   // Current number of elements
+    T* storage;           // Start of the raw allocation
+    T* items;             // Element 0; only items[0, currentSize) is constructed
+    Allocator alloc;      // Source of the raw storage
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+    DynamicArrayStats counters;   // see stats()
+#endif
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+
+    // Free slots before the first element.
+    size_t frontRoom() const { return static_cast<size_t>(items - storage); }
+
+    // Free slots after the last element.
+    size_t backRoom() const { return capacity - frontRoom() - currentSize; }
+
+    // Instrumentation hooks; empty unless built with -DDS_INSTRUMENT.
+    void noteReallocation([[maybe_unused]] size_t moved) {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        counters.reallocations++;
+        counters.elementsMoved += moved;
+        counters.bytesCopied += moved * sizeof(T);
+#endif
+    }
+
+    void noteShift([[maybe_unused]] size_t shifted) {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        counters.elementsShifted += shifted;
+        counters.bytesCopied += shifted * sizeof(T);
+        if (shifted > counters.largestShift) counters.largestShift = shifted;
+#endif
+    }
+
+    /**
+    * @brief Destroys the constructed elements in [first, last).
+    *
+    * Does not release any memory — the slots go back to being raw storage.
+    *
+    * Time Complexity  : O(n) — O(1) for trivially destructible T
+    */
+    void destroyRange(T* first, T* last) {
+        for (; first != last; ++first) {
+            AllocTraits::destroy(alloc, first);
+        }
+    }
+
+    // True while the elements live in the inline buffer (never when InlineCapacity == 0).
+    bool isInline() const { return InlineCapacity > 0 && storage == inlineSlots(); }
+
+    /**
+    * @brief Gets a raw buffer of at least n slots.
+    *
+    * Requests that fit the inline buffer get the inline buffer (and n is
+    * raised to InlineCapacity); larger ones come from the allocator.
+    * Returns nullptr for n == 0 when there is no inline buffer.
+    * The caller must make sure the inline buffer is not in use.
+    */
+    T* acquire(size_t& n) {
+        if (InlineCapacity > 0 && n <= InlineCapacity) {
+            n = InlineCapacity;
+            return inlineSlots();
+        }
+        if (n == 0) return nullptr;
+        T* buffer = AllocTraits::allocate(alloc, n);
+        AllocationTracker::recordAllocation(n * sizeof(T));
+        return buffer;
+    }
+
+    // Gives a buffer obtained from acquire() back; the inline buffer is not freed.
+    void release(T* buffer, size_t n) {
+        if (buffer && buffer != inlineSlots()) {
+            AllocTraits::deallocate(alloc, buffer, n);
+            AllocationTracker::recordDeallocation(n * sizeof(T));
+        }
+    }
+
+    // Points the array at its inline buffer (or at nothing if there is none), empty.
+    void resetToInline() {
+        storage = items = inlineSlots();
+        capacity = InlineCapacity;
+        currentSize = 0;
+    }
+
+    /**
+    * @brief Destroys every live element and gives the buffer back to the allocator.
+    *
+    * Leaves storage and items dangling — the caller must assign a new buffer
+    * (or call resetToInline()).
+    */
+    void releaseStorage() {
+        destroyRange(items, items + currentSize);
+        release(storage, capacity);
+    }
+
+    /**
+    * @brief Moves the elements of an array that lives in its inline buffer into this one's.
+    *
+    * An inline buffer cannot change owner, so moving such an array moves its
+    * elements instead. Requires this array to be empty and in its own inline
+    * buffer; other is left empty (still inline).
+    */
+    void moveInlineFrom(DynamicArray& other) {
+        for (size_t i = 0; i < other.currentSize; i++) {
+            AllocTraits::construct(alloc, items + i, std::move(other.items[i]));
+            currentSize++;
+        }
+        other.clear();
+    }
+
+    /**
+    * @brief Copy-constructs every element of other into this array's raw buffer.
+    *
+    * Places the elements at the start of the buffer (no front room).
+    * Requires capacity >= other.currentSize and currentSize == 0. If a copy
+    * throws, the elements built so far are destroyed and the exception propagates.
+    */
+    void copyConstructFrom(const DynamicArray& other) {
+        items = storage;
+        size_t built = 0;
+        try {
+            for (; built < other.currentSize; built++) {
+                AllocTraits::construct(alloc, items + built, other.items[built]);
+            }
+        }
+        catch (...) {
+            destroyRange(items, items + built);
+            throw;
+        }
+        currentSize = other.currentSize;
+    }
+
+    /**
+    * @brief Moves the live elements into a fresh buffer of newCapacity slots.
+    *
+    * Elements are move-constructed with std::move_if_noexcept: types with a
+    * noexcept move (std::string, DynamicArray, ...) are moved, so growth costs
+    * pointer swaps instead of deep copies. Types whose move may throw are
+    * copied instead, and if a copy throws the new buffer is released and this
+    * array is left exactly as it was.
+    *
+    * Fast path: when T is trivially copyable and the allocator has
+    * reallocate(), the buffer is resized with realloc — often in place, and
+    * without touching the elements at all for large blocks (mremap).
+    *
+    * @param newCapacity   Slots in the new buffer.
+    * @param newFrontRoom  Free slots to leave before element 0 in the new buffer.
+    *
+    * Requires newFrontRoom + currentSize <= newCapacity.
+    *
+    * Time Complexity  : O(n) — O(1) when realloc extends the block in place
+    * Space Complexity : O(n)
+    */
+    void reallocate(size_t newCapacity, size_t newFrontRoom = 0) {
+        if (isInline() && newCapacity <= InlineCapacity) {
+            slideTo(newFrontRoom);   // already in the smallest buffer there is
+            return;
+        }
+
+        if constexpr (is_trivially_copyable<T>::value && HasReallocate<Allocator, T>::value) {
+            if (storage && !isInline() && newCapacity > InlineCapacity) {
+                // Slide left before a shrinking realloc could cut elements off,
+                // slide right after a growing one has made the room.
+                if (newFrontRoom < frontRoom()) slideTo(newFrontRoom);
+                size_t oldFrontRoom = frontRoom();
+                storage = alloc.reallocate(storage, capacity, newCapacity);
+                AllocationTracker::recordDeallocation(capacity * sizeof(T));
+                AllocationTracker::recordAllocation(newCapacity * sizeof(T));
+                noteReallocation(0);
+                items = storage + oldFrontRoom;
+                capacity = newCapacity;
+                slideTo(newFrontRoom);
+                return;
+            }
+        }
+
+        T* newStorage = acquire(newCapacity);
+        T* newData = newStorage + newFrontRoom;
+
+        size_t built = 0;
+        try {
+            for (; built < currentSize; built++) {
+                AllocTraits::construct(alloc, newData + built, std::move_if_noexcept(items[built]));
+            }
+        }
+        catch (...) {
+            destroyRange(newData, newData + built);
+            release(newStorage, newCapacity);
+            throw;
+        }
+
+        noteReallocation(currentSize);
+        releaseStorage();
+        storage = newStorage;
+        items = newData;
+        capacity = newCapacity;
+    }
+
+    /**
+    * @brief Moves the n live elements starting at first so that they start at target instead.
+    *
+    * Every destination slot outside [first, first + n) must be raw storage.
+    * Slots that become live are move-constructed (if they were raw) or
+    * move-assigned (if they overlap the old range); slots that stop being
+    * live are destroyed. Trivially copyable types use a single memmove.
+    *
+    * This is the one primitive behind slideTo() and every range operation:
+    * opening a gap, closing a gap and sliding the whole array are all a
+    * single relocate() of the elements on one side of the gap.
+    *
+    * Time Complexity  : O(n)
+    */
+    void relocate(T* first, size_t n, T* target) {
+        if (target == first || n == 0) return;
+        noteShift(n);
+
+        if constexpr (is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(target), static_cast<const void*>(first), n * sizeof(T));
+        }
+        else if (target < first) {
+            for (size_t i = 0; i < n; i++) {
+                if (target + i < first) AllocTraits::construct(alloc, target + i, std::move(first[i]));
+                else                    target[i] = std::move(first[i]);
+            }
+            destroyRange((target + n > first) ? target + n : first, first + n);
+        }
+        else {
+            for (size_t i = n; i-- > 0;) {
+                if (target + i >= first + n) AllocTraits::construct(alloc, target + i, std::move(first[i]));
+                else                         target[i] = std::move(first[i]);
+            }
+            destroyRange(first, (target < first + n) ? target : first + n);
+        }
+    }
+
+    /**
+    * @brief Moves the elements inside the current buffer so that element 0
+    *        sits newFrontRoom slots after the start of the allocation.
+    *
+    * Requires newFrontRoom + currentSize <= capacity.
+    *
+    * Time Complexity  : O(n)
+    */
+    void slideTo(size_t newFrontRoom) {
+        relocate(items, currentSize, storage + newFrontRoom);
+        items = storage + newFrontRoom;
+    }
+
+    /**
+    * @brief Grows the internal array capacity when the array is full.
+    *
+    * Asks GrowthPolicy for the next capacity (twice the current one by
+    * default), moves all existing elements into a buffer of that size, frees
+    * the old memory, and redirects the internal pointer to the new allocation
+    * (see reallocate()).
+    *
+    * An array with capacity 0 (e.g. a moved-from one) grows to capacity 1.
+    *
+    * @param roomAtFront  false: all new free slots go after the last element.
+    *                     true : they are split evenly around the elements, so
+    *                            the following push() calls are O(1).
+    *
+    * This is called automatically by insertion methods — never call it manually.
+    *
+    * Time Complexity  : O(n)
+    * Space Complexity : O(n)
+    */
+    void resize(bool roomAtFront = false) {
+        size_t newCapacity = GrowthPolicy::nextCapacity(capacity, currentSize + 1);
+        size_t free = newCapacity - currentSize;
+        reallocate(newCapacity, roomAtFront ? free - free / 2 : 0);
+    }
+
+    /**
+    * @brief Guarantees at least one free slot before the first element.
+    *
+    * If at least half as many slots as there are elements are free, the
+    * elements are slid right inside the current buffer, keeping half of the
+    * free space in front; otherwise the buffer grows with room on both sides.
+    * Either way the next ~n/4 push() calls need no shifting at all, which is
+    * what makes push() amortized O(1).
+    *
+    * Time Complexity  : O(n) when it has to move elements, amortized O(1) per push
+    */
+    void makeFrontRoom() {
+        size_t free = capacity - currentSize;
+        if (free > 0 && 2 * free >= currentSize) slideTo(free - free / 2);
+        else resize(true);
+    }
+
+    /**
+    * @brief Guarantees at least one free slot after the last element.
+    *
+    * Mirror of makeFrontRoom(): reuses free front room (left by pop() or
+    * push()) by sliding the elements left when there is enough of it, and
+    * grows the buffer otherwise. A plain pushBack-only array never has front
+    * room, so it always goes straight to resize().
+    *
+    * Time Complexity  : O(n) when it has to move elements, amortized O(1) per pushBack
+    */
+    void makeBackRoom() {
+        size_t free = capacity - currentSize;
+        if (free > 0 && 2 * free >= currentSize) slideTo(free / 2);
+        else resize();
+    }
+
+    /**
+    * @brief Opens a gap at index by shifting [index, currentSize) one slot right.
+    *
+    * The last element is move-constructed into the raw slot at currentSize,
+    * the rest are move-assigned one place to the right. items[index] is left
+    * holding a moved-from (but still constructed) object, ready to be assigned.
+    * Does not change currentSize.
+    *
+    * Requires: backRoom() > 0 and 0 <= index < currentSize.
+    *
+    * Time Complexity  : O(n - index)
+    */
+    void shiftRightFrom(size_t index) {
+        noteShift(currentSize - index);
+        AllocTraits::construct(alloc, items + currentSize, std::move(items[currentSize - 1]));
+
+        for (size_t i = currentSize - 1; i > index; i--) {
+            items[i] = std::move(items[i - 1]);
+        }
+    }
+
+    /**
+    * @brief Opens a gap at index by shifting [0, index) one slot left, into the front room.
+    *
+    * After the call items points one slot earlier, so the old elements keep
+    * their positions relative to each other, and items[index] holds a
+    * moved-from (but still constructed) object, ready to be assigned.
+    * Does not change currentSize.
+    *
+    * Requires: frontRoom() > 0 and 0 < index <= currentSize.
+    *
+    * Time Complexity  : O(index)
+    */
+    void shiftLeftBefore(size_t index) {
+        noteShift(index);
+        AllocTraits::construct(alloc, items - 1, std::move(items[0]));
+
+        for (size_t i = 1; i < index; i++) {
+            items[i - 1] = std::move(items[i]);
+        }
+        items--;
+    }
+
+    /**
+    * @brief Guarantees at least count free slots after the last element.
+    *
+    * Grows the buffer once — to GrowthPolicy's next capacity, or straight to
+    * currentSize + count if that is more — when the total free space is too
+    * small; otherwise slides the elements to the front of the buffer. Either
+    * way a batch of count elements then fits without any further resize.
+    *
+    * Time Complexity  : O(n) when it has to move elements, O(1) otherwise
+    */
+    void reserveBack(size_t count) {
+        if (backRoom() >= count) return;
+
+        size_t required = currentSize + count;
+        if (required > capacity) reallocate(GrowthPolicy::nextCapacity(capacity, required));
+        else                     slideTo(0);
+    }
+
+    /**
+    * @brief Checks whether p points at one of this array's live elements.
+    *
+    * Range operations use it to notice a source range that lives inside the
+    * array itself (e.g. arr.append(&arr[0], arr.size())), which a resize or
+    * a shift would otherwise pull out from under them.
+    */
+    bool ownsElement(const T* p) const {
+        std::less<const T*> before;
+        return currentSize > 0 && !before(p, items) && before(p, items + currentSize);
+    }
+
+    /**
+    * @brief Copy-constructs count elements read from first into the raw slots at dest.
+    *
+    * Trivially copyable T read through a plain pointer is copied with a single
+    * memcpy. If a copy throws, the elements built so far are destroyed and the
+    * exception propagates.
+    */
+    template <typename ForwardIt>
+    void constructRange(T* dest, ForwardIt first, size_t count) {
+        if constexpr (is_trivially_copyable<T>::value &&
+                      is_pointer<ForwardIt>::value &&
+                      is_same<typename remove_cv<typename remove_pointer<ForwardIt>::type>::type, T>::value) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+            }
+        }
+        else {
+            size_t built = 0;
+            try {
+                for (; built < count; ++built, ++first) {
+                    AllocTraits::construct(alloc, dest + built, *first);
+                }
+            }
+            catch (...) {
+                destroyRange(dest, dest + built);
+                throw;
+            }
+        }
+    }
+
+    /**
+    * @brief Calls onMatch(i) for every index i with items[i] == key, in order.
+    *
+    * Shared by all findAll() overloads. For int, float and double arrays the
+    * scan is vectorized: each block of 256 elements is compared 8 at a time
+    * and the hit offsets within the block are compress-stored into a stack
+    * buffer, then handed to the callback as base + offset.
+    *
+    * Time Complexity  : O(n)
+    */
+    template <typename Callback>
+    void forEachMatch(const T& key, Callback&& onMatch) const
+    {
+        if constexpr (hasSimdScan<T>)
+        {
+            int hits[simdScanBlock];
+            for (size_t base = 0; base < currentSize; base += simdScanBlock)
+            {
+                int blockSize = static_cast<int>((currentSize - base < simdScanBlock) ? currentSize - base : simdScanBlock);
+                int count = simdFindAllBlock(items + base, blockSize, key, 0, hits);
+                for (int h = 0; h < count; h++)
+                    onMatch(base + hits[h]);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < currentSize; i++)
+            {
+                if (items[i] == key)
+                    onMatch(i);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs a new DynamicArray with a given initial capacity.
+     *
+     * Allocates raw storage on the heap for the specified capacity.
+     * No elements are constructed — the array starts empty (currentSize = 0).
+     * With an inline buffer (InlineCapacity > 0), a capacity that fits in it
+     * uses it instead and nothing is allocated.
+     *
+     * @param initialCapacity  The number of elements to pre-allocate space for.
+     *                         Defaults to 5 if not specified.
+     * @param allocator        The allocator used for all of this array's storage.
+     *
+     * Example:
+     *   DynamicArray<int> arr;       // capacity = 5
+     *   DynamicArray<int> arr(10);   // capacity = 10
+     */
+    DynamicArray(size_t initialCapacity = 5, const Allocator& allocator = Allocator())
+        : capacity(initialCapacity), currentSize(0), storage(nullptr), items(nullptr), alloc(allocator)
+    {
+        storage = items = acquire(capacity);
+    }
+
+    /**
+     * @brief Destructor — destroys the live elements and frees the buffer.
+     *
+     * Called automatically when the object goes out of scope.
+     * Only the elements in [0, currentSize) are destroyed, then the memory
+     * allocated in the constructor or after any resize() is released,
+     * preventing memory leaks.
+     */
+    ~DynamicArray() {
+        releaseStorage();
+    }
+
+    /**
+     * @brief Copy constructor — creates a deep copy of another DynamicArray.
+     *
+     * Allocates a brand new buffer and copy-constructs all elements from the source.
+     * This ensures both objects own completely separate memory and modifying
+     * one won't affect the other (deep copy, not shallow copy).
+     *
+     * @param other  The DynamicArray to copy from.
+     *
+     * Example:
+     *   DynamicArray<int> arr2 = arr1;  // triggers copy constructor
+     */
+    DynamicArray(const DynamicArray& other)
+        : capacity(other.capacity), currentSize(0), storage(nullptr), items(nullptr),
+          alloc(AllocTraits::select_on_container_copy_construction(other.alloc))
+    {
+        storage = items = acquire(capacity);
+
+        try {
+            copyConstructFrom(other);
+        }
+        catch (...) {
+            release(storage, capacity);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy assignment operator — replaces this array's content with a deep copy.
+     *
+     * Destroys the current elements, then copy-constructs all elements from
+     * the right-hand side object. The existing buffer is reused when it is
+     * large enough; otherwise it is freed and a new one is allocated.
+     * Includes a self-assignment guard to handle the case: arr = arr;
+     *
+     * @param other  The DynamicArray to copy from.
+     * @return       A reference to this object (enables chaining: a = b = c).
+     *
+     * Example:
+     *   arr1 = arr2;  // triggers copy assignment operator
+     */
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            clear();
+
+            bool switchAllocator = false;
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                switchAllocator = !(alloc == other.alloc);
+            }
+
+            if (switchAllocator || capacity < other.currentSize) {
+                releaseStorage();
+                resetToInline();
+
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                    alloc = other.alloc;
+                }
+
+                size_t newCapacity = other.capacity;
+                T* newStorage = acquire(newCapacity);
+                storage = items = newStorage;
+                capacity = newCapacity;
+            }
+
+            copyConstructFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move constructor — takes ownership of another DynamicArray's buffer.
+     *
+     * Steals the heap pointer, size and capacity from the source instead of
+     * copying its elements. The source is left as a valid empty array
+     * (no allocation; capacity 0, or its inline buffer) that can be reused or
+     * safely destroyed. A source that still lives in its inline buffer has its elements moved
+     * one by one instead (O(InlineCapacity) at most).
+     *
+     * This is what makes returning arrays by value (sort(), merge(), reverse(),
+     * findAll()) and storing them inside other containers cheap.
+     *
+     * @param other  The DynamicArray to move from.
+     *
+     * Time Complexity  : O(1)
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   DynamicArray<int> arr2 = std::move(arr1);  // arr1 is now empty
+     */
+    DynamicArray(DynamicArray&& other) noexcept(InlineCapacity == 0 || is_nothrow_move_constructible<T>::value)
+        : capacity(other.capacity), currentSize(other.currentSize), storage(other.storage), items(other.items),
+          alloc(std::move(other.alloc))
+    {
+        if (other.isInline()) {
+            resetToInline();
+            moveInlineFrom(other);
+            return;
+        }
+        other.resetToInline();
+    }
+
+    /**
+     * @brief Move assignment operator — releases this buffer and takes over another one.
+     *
+     * Destroys the current elements and frees the buffer, then steals the
+     * source's heap pointer, size and capacity. The source is left as a valid
+     * empty array. A source in its inline buffer has its elements moved
+     * instead. If the two allocators are unequal and the allocator does
+     * not propagate on move, the buffer cannot change owner, so the elements
+     * are moved one by one into storage from this array's own allocator.
+     * Includes a self-assignment guard to handle the case: arr = std::move(arr);
+     *
+     * @param other  The DynamicArray to move from.
+     * @return       A reference to this object.
+     *
+     * Time Complexity  : O(1) — plus destroying this array's old elements
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr1 = arr2.sort();  // the temporary's buffer is moved, not copied
+     */
+    DynamicArray& operator=(DynamicArray&& other)
+        noexcept((AllocTraits::propagate_on_container_move_assignment::value ||
+                  AllocTraits::is_always_equal::value) &&
+                 (InlineCapacity == 0 || is_nothrow_move_constructible<T>::value))
+    {
+        if (this == &other) return *this;
+
+        constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+
+        if ((propagate || alloc == other.alloc) && !other.isInline()) {
+            releaseStorage();
+
+            if constexpr (propagate) {
+                alloc = std::move(other.alloc);
+            }
+            capacity = other.capacity;
+            currentSize = other.currentSize;
+            storage = other.storage;
+            items = other.items;
+
+            other.resetToInline();
+        }
+        else {
+            clear();
+            if constexpr (propagate) {
+                if (!(alloc == other.alloc)) {   // other is inline; adopt its allocator anyway
+                    releaseStorage();
+                    resetToInline();
+                    alloc = std::move(other.alloc);
+                }
+            }
+            if (capacity < other.currentSize) {
+                reallocate(other.currentSize);
+            }
+            for (size_t i = 0; i < other.currentSize; i++) {
+                AllocTraits::construct(alloc, items + i, std::move(other.items[i]));
+                currentSize++;
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Inserts an element at the beginning of the array.
+     *
+     * Constructs the new element in the free slot just before the current
+     * first element and moves the start of the array back by one — nothing is
+     * shifted. When there is no front room left, makeFrontRoom() slides the
+     * elements (or grows the buffer) so that the next ~n/4 pushes are free.
+     *
+     * @param value  The element to insert at the front.
+     *
+     * Time Complexity  : O(1) amortized — O(n) only when front room has to be made
+     * Space Complexity : O(1) — O(n) only if resize is triggered
+     *
+     * Example:
+     *   arr = [10, 20, 30]
+     *   arr.push(5)  ->  [5, 10, 20, 30]
+     */
+    void push(const T& value)
+    {
+        T copy(value);   // value may alias an element that is about to move
+
+    	if (frontRoom() == 0)
+    		makeFrontRoom();
+
+    	AllocTraits::construct(alloc, items - 1, std::move(copy));
+    	items--;
+    	currentSize++;
+    }
+
+    /**
+     * @brief Appends an element to the end of the array.
+     *
+     * Constructs the new element in the next available (raw) slot after the
+     * last element. Resizes the array first if it is at full capacity.
+     *
+     * @param value  The element to append.
+     *
+     * Time Complexity  : O(1) amortized — O(n) only when resize is triggered
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30]
+     *   arr.pushBack(40) ->  [10, 20, 30, 40]
+     */
+    void pushBack(const T& value) {
+        if (backRoom() == 0) {
+            T copy(value);   // value may live inside the buffer resize() frees
+            makeBackRoom();
+            AllocTraits::construct(alloc, items + currentSize, std::move(copy));
+        }
+        else {
+            AllocTraits::construct(alloc, items + currentSize, value);
+        }
+        currentSize++;
+    }
+
+    /**
+     * @brief Appends an element to the end of the array by moving it in.
+     *
+     * Same as pushBack(const T&), but steals the contents of a temporary
+     * (or std::move'd) value instead of copying it. For heap-owning types
+     * like std::string this avoids an allocation per insert.
+     *
+     * @param value  The element to move to the end.
+     *
+     * Time Complexity  : O(1) amortized — O(n) only when resize is triggered
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   string s = "hello";
+     *   words.pushBack(std::move(s)) ->  s is left empty, no copy made
+     */
+    void pushBack(T&& value) {
+        if (backRoom() == 0) {
+            T tmp(std::move(value));   // value may live inside the buffer resize() frees
+            makeBackRoom();
+            AllocTraits::construct(alloc, items + currentSize, std::move(tmp));
+        }
+        else {
+            AllocTraits::construct(alloc, items + currentSize, std::move(value));
+        }
+        currentSize++;
+    }
+
+    /**
+     * @brief Constructs a new element directly in the slot after the last element.
+     *
+     * Forwards the arguments to T's constructor via placement construction,
+     * so no temporary is created when there is spare capacity.
+     *
+     * @param args  Arguments forwarded to T's constructor.
+     * @return      A reference to the newly added element.
+     *
+     * Time Complexity  : O(1) amortized — O(n) only when resize is triggered
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   DynamicArray<string> words;
+     *   words.emplaceBack(3, 'a')  ->  ["aaa"]
+     */
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        if (backRoom() == 0) {
+            T value(std::forward<Args>(args)...);   // args may refer into the old buffer
+            makeBackRoom();
+            AllocTraits::construct(alloc, items + currentSize, std::move(value));
+        }
+        else {
+            AllocTraits::construct(alloc, items + currentSize, std::forward<Args>(args)...);
+        }
+        return items[currentSize++];
+    }
+
+    /**
+    * @brief Appends n elements read from values to the end of the array.
+    *
+    * Reserves room for the whole batch once, then copies it in — a single
+    * memcpy for trivially copyable T. n pushBack() calls would instead check
+    * the capacity n times and could resize several times on the way.
+    *
+    * values may point into this array itself (e.g. to duplicate it).
+    * If a copy throws, the array keeps its old elements.
+    *
+    * @param values  Pointer to the first element to copy.
+    * @param n       Number of elements to copy.
+    *
+    * Time Complexity  : O(n) amortized — plus O(size) if the one resize happens
+    * Space Complexity : O(1) — O(size + n) only if resize is triggered
+    *
+    * Example:
+    *   int batch[] = {4, 5, 6};
+    *   arr = [1, 2, 3]
+    *   arr.append(batch, 3)  ->  [1, 2, 3, 4, 5, 6]
+    */
+    void append(const T* values, size_t n) {
+        if (n == 0) return;
+
+        if (ownsElement(values)) {
+            size_t offset = static_cast<size_t>(values - items);
+            reserveBack(n);
+            values = items + offset;   // the elements may have moved
+        }
+        else {
+            reserveBack(n);
+        }
+
+        constructRange(items + currentSize, values, n);
+        currentSize += n;
+    }
+
+    /**
+    * @brief Inserts an element at a specific index, shifting the shorter side.
+    *
+    * If the index is in the back half, all elements from the given index
+    * onward are shifted one position to the right; if it is in the front
+    * half, the elements before it are shifted one position to the left into
+    * the front room. Then the new element is placed at the target index.
+    * Makes room (or resizes) first if the chosen side is full.
+    *
+    * @param index  The position at which to insert (0-based).
+    *               Valid range: [0, currentSize]
+    * @param value  The element to insert.
+    *
+    * @throws std::out_of_range  If index > currentSize.
+    *
+    * Time Complexity  : O(min(index, n - index)) amortized — due to shifting the shorter side
+    * Space Complexity : O(1) — O(n) only if resize is triggered
+    *
+    * Example:
+    *   arr = [10, 20, 30]
+    *   arr.insert(1, 99)  ->  [10, 99, 20, 30]
+    */
+    void insert(size_t index, const T& value) {
+        if (index > currentSize) {
+            throw out_of_range("Index out of bounds");
+        }
+
+        T copy(value);   // value may alias an element that is about to shift
+
+        if (index < currentSize / 2 || (index == 0 && currentSize < 2)) {
+            if (frontRoom() == 0) {
+                makeFrontRoom();
+            }
+
+            if (index == 0) {
+                AllocTraits::construct(alloc, items - 1, std::move(copy));
+                items--;
+            }
+            else {
+                shiftLeftBefore(index);
+                items[index] = std::move(copy);
+            }
+        }
+        else {
+            if (backRoom() == 0) {
+                makeBackRoom();
+            }
+
+            if (index == currentSize) {
+                AllocTraits::construct(alloc, items + currentSize, std::move(copy));
+            }
+            else {
+                shiftRightFrom(index);
+                items[index] = std::move(copy);
+            }
+        }
+        currentSize++;
+    }
+
+    /**
+    * @brief Inserts the elements of [first, last) at a specific index, in order.
+    *
+    * Opens one gap of the right size and copies the whole range into it,
+    * instead of shifting the tail once per element as repeated insert()
+    * calls would. If the front room already fits the range and the index is
+    * in the front half, the elements before it are shifted left; otherwise
+    * room is reserved at the back once and the elements from index onward
+    * are shifted right. For trivially copyable T the shift is one memmove
+    * and the copy one memcpy.
+    *
+    * The range may point into this array itself.
+    * If a copy throws, the gap is closed again and the array keeps its old elements.
+    *
+    * @param index  The position at which to insert (0-based).
+    *               Valid range: [0, currentSize]
+    * @param first  Forward iterator (or pointer) to the first element to insert.
+    * @param last   One past the last element to insert.
+    *
+    * @throws std::out_of_range  If index > currentSize.
+    *
+    * Time Complexity  : O(k + min(index, n - index)) amortized — k = range length
+    * Space Complexity : O(1) — O(n + k) only if resize is triggered
+    *
+    * Example:
+    *   int batch[] = {7, 8};
+    *   arr = [10, 20, 30]
+    *   arr.insertRange(1, batch, batch + 2)  ->  [10, 7, 8, 20, 30]
+    */
+    template <typename ForwardIt>
+    void insertRange(size_t index, ForwardIt first, ForwardIt last) {
+        if (index > currentSize) {
+            throw out_of_range("Index out of bounds");
+        }
+
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) return;
+
+        if constexpr (is_pointer<ForwardIt>::value) {
+            if (ownsElement(first)) {
+                // Opening the gap would move the source; insert a copy instead.
+                DynamicArray copy(count, AllocTraits::select_on_container_copy_construction(alloc));
+                copy.append(first, count);
+                insertRange(index, copy.items, copy.items + count);
+                return;
+            }
+        }
+
+        bool shiftFront = index < currentSize - index && frontRoom() >= count;
+        if (shiftFront) {
+            relocate(items, index, items - count);
+            items -= count;
+        }
+        else {
+            reserveBack(count);
+            relocate(items + index, currentSize - index, items + index + count);
+        }
+
+        try {
+            constructRange(items + index, first, count);
+        }
+        catch (...) {
+            if (shiftFront) {
+                relocate(items, index, items + count);
+                items += count;
+            }
+            else {
+                relocate(items + index + count, currentSize - index, items + index);
+            }
+            throw;
+        }
+        currentSize += count;
+    }
+
+    /**
+     * @brief Removes the first element of the array.
+     *
+     * Destroys the first element and moves the start of the array forward by
+     * one — nothing is shifted, the freed slot becomes front room that a later
+     * push() (or a slide in pushBack()) can reuse. When the array becomes
+     * empty the start is reset to the beginning of the buffer.
+     * Does nothing if the array is empty.
+     *
+     * Time Complexity  : O(1)
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30]
+     *   arr.pop()  ->  [20, 30]
+     */
+    void pop()
+    {
+	    if (currentSize == 0) return;
+
+        AllocTraits::destroy(alloc, items);
+        items++;
+        currentSize--;
+
+        if (currentSize == 0)
+            items = storage;
+    }
+
+    /**
+     * @brief Removes the last element of the array.
+     *
+     * Destroys the last element and decrements currentSize — no shifting needed.
+     * The slot goes back to raw storage and will be constructed again on the
+     * next insert.
+     * Does nothing if the array is empty.
+     *
+     * Time Complexity  : O(1)
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30]
+     *   arr.popBack()  ->  [10, 20]
+     */
+    void popBack() {
+        if (currentSize > 0) {
+            AllocTraits::destroy(alloc, items + currentSize - 1);
+            currentSize--;
+        }
+    }
+
+    /**
+     * @brief Removes the element at a specific index, shifting the shorter side.
+     *
+     * If the index is in the back half, all elements after it are shifted one
+     * position to the left to fill the gap and the now-duplicate last slot is
+     * destroyed; if it is in the front half, the elements before it are shifted
+     * one position to the right and the first slot becomes front room.
+     * Then currentSize is decremented.
+     *
+     * @param index  The position of the element to remove (0-based).
+     *               Valid range: [0, currentSize - 1]
+     *
+     * @throws std::out_of_range  If index >= currentSize.
+     *
+     * Time Complexity  : O(min(index, n - index)) — due to shifting the shorter side
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30, 40]
+     *   arr.removeAt(1)  ->  [10, 30, 40]
+     */
+    void removeAt(size_t index) {
+        if (index >= currentSize) {
+            throw out_of_range("Index out of bounds");
+        }
+
+        if (index < currentSize / 2) {
+            noteShift(index);
+            for (size_t i = index; i > 0; i--) {
+                items[i] = std::move(items[i - 1]);
+            }
+
+            AllocTraits::destroy(alloc, items);
+            items++;
+        }
+        else {
+            noteShift(currentSize - 1 - index);
+            for (size_t i = index; i < currentSize - 1; i++) {
+                items[i] = std::move(items[i + 1]);
+            }
+
+            AllocTraits::destroy(alloc, items + currentSize - 1);
+        }
+        currentSize--;
+    }
+
+    /**
+     * @brief Removes the elements at indices [first, last), shifting the shorter side once.
+     *
+     * Destroys the whole range, then closes the gap with a single move of
+     * either the elements before it (which leaves front room behind) or the
+     * elements after it — one memmove for trivially copyable T, instead of
+     * one full shift per removed element.
+     *
+     * @param first  Index of the first element to remove.
+     * @param last   One past the index of the last element to remove.
+     *               Valid range: first <= last <= currentSize
+     *
+     * @throws std::out_of_range  If the range is not inside the array.
+     *
+     * Time Complexity  : O(k + min(first, n - last)) — k = last - first
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30, 40, 50]
+     *   arr.removeRange(1, 3)  ->  [10, 40, 50]
+     */
+    void removeRange(size_t first, size_t last) {
+        if (last > currentSize || first > last) {
+            throw out_of_range("Index out of bounds");
+        }
+
+        size_t count = last - first;
+        if (count == 0) return;
+
+        destroyRange(items + first, items + last);
+        if (first < currentSize - last) {
+            relocate(items, first, items + count);
+            items += count;
+        }
+        else {
+            relocate(items + last, currentSize - last, items + first);
+        }
+        currentSize -= count;
+
+        if (currentSize == 0)
+            items = storage;
+    }
+
+    /**
+     * @brief Returns a reference to the element at the given index, with bounds checking.
+     *
+     * Unlike operator[], this method validates the index before accessing memory.
+     * Use this when you want a safe access that throws on invalid input.
+     *
+     * @param index  The position of the element to access (0-based).
+     * @return       A reference to the element at the given index.
+     *
+     * @throws std::out_of_range  If index >= currentSize.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   arr.at(2)  ->  returns reference to element at index 2
+     */
+    T& at(size_t index) {
+        if (index >= currentSize) {
+            throw out_of_range("Index out of bounds");
+        }
+        return items[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= currentSize) {
+            throw out_of_range("Index out of bounds");
+        }
+        return items[index];
+    }
+
+    /**
+     * @brief Overloads the [] operator for direct index access without bounds checking (like STL).
+     *
+     * Mimics the behavior of a raw array or std::vector's operator[].
+     * Faster than at() since it skips validation, but accessing an
+     * out-of-range index leads to undefined behavior.
+     *
+     * @param index  The position of the element to access (0-based).
+     * @return       A reference to the element at the given index.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   arr[2]  ->  returns reference to element at index 2
+     */
+    T& operator[](size_t index) {
+        return items[index];
+    }
 
-class DynamicArray {
-private:
-    int capacity;      // Total allocated space
-    int currentSize;   // Current number of elements
-    T* data;           // Pointer to heap-allocated array
+    const T& operator[](size_t index) const {
+        return items[index];
+    }
 
     /**
-    * @brief Doubles the internal array capacity when the array is full.
-    *
-    * Allocates a new array with twice the current capacity, copies all
-    * existing elements into it, frees the old memory, and redirects
-    * the internal pointer to the new allocation.
-    *
-    * This is called automatically by insertion methods — never call it manually.
-    *
-    * Time Complexity  : O(n)
-    * Space Complexity : O(n)
-    */
-    void resize() {
-        capacity *= 2; 
-        T* newData = new T[capacity];
+     * @brief Pointer to element 0 — the elements are contiguous in [data(), data() + size()).
+     *
+     * Lets the buffer be handed to C APIs, SIMD loops or serializers without
+     * copying. The pointer is invalidated by anything that may reallocate or
+     * slide the elements (inserts, push, reserve, shrinkToFit, ...).
+     * May be nullptr when the capacity is 0.
+     *
+     * Example:
+     *   std::fwrite(arr.data(), sizeof(int), arr.size(), file);
+     */
+    T* data() noexcept { return items; }
+    const T* data() const noexcept { return items; }
 
-        for (int i = 0; i < currentSize; i++) {
-            newData[i] = data[i];
-        }
+    /**
+     * @brief Contiguous random-access iterators over the elements.
+     *
+     * The iterators are plain pointers, so every std:: algorithm — including
+     * the parallel ones and anything that requires contiguous iterators —
+     * accepts them, and range-based for works. Invalidated like data().
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   for (int x : arr) sum += x;
+     *   std::sort(std::execution::par, arr.begin(), arr.end());
+     */
+    iterator begin() noexcept { return items; }
+    iterator end() noexcept { return items + currentSize; }
+    const_iterator begin() const noexcept { return items; }
+    const_iterator end() const noexcept { return items + currentSize; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-        delete[] data;
-        data = newData;
-    }
+    /**
+     * @brief A non-owning view of the elements (std::span under C++20, Span otherwise).
+     *
+     * No copy is made — the view aliases this array's buffer and is
+     * invalidated like data().
+     *
+     * Example:
+     *   Span<const int> view = arr.span();
+     *   serialize(view.data(), view.size_bytes());
+     */
+    Span<T> span() noexcept { return Span<T>(items, currentSize); }
+    Span<const T> span() const noexcept { return Span<const T>(items, currentSize); }
 
-public:
     /**
-     * @brief Constructs a new DynamicArray with a given initial capacity.
+     * @brief Removes every element but keeps the allocated buffer.
      *
-     * Allocates an array on the heap with the specified capacity.
-     * The array starts empty (currentSize = 0).
+     * Destroys the live elements, resets currentSize to 0 and moves the start
+     * of the array back to the beginning of the buffer. The capacity
+     * (and the memory behind it) is kept, so refilling the array up to the
+     * previous size costs no allocations — useful when the same array is
+     * refilled in a loop.
      *
-     * @param initialCapacity  The number of elements to pre-allocate space for.
-     *                         Defaults to 4 if not specified.
+     * Time Complexity  : O(n) — O(1) for trivially destructible T
+     * Space Complexity : O(1)
      *
      * Example:
-     *   DynamicArray<int> arr;       // capacity = 5
-     *   DynamicArray<int> arr(10);   // capacity = 10
+     *   arr = [10, 20, 30], capacity = 5
+     *   arr.clear()  ->  arr is now [], capacity is still 5
      */
-    DynamicArray(int initialCapacity = 5) {
-        capacity = initialCapacity;
+    void clear()
+    {
+        destroyRange(items, items + currentSize);
         currentSize = 0;
-        data = new T[capacity];
+        items = storage;
     }
 
     /**
-     * @brief Destructor — frees the heap-allocated array.
+     * @brief Makes sure the array can hold at least newCapacity elements without resizing.
      *
-     * Called automatically when the object goes out of scope.
-     * Releases the memory allocated in the constructor or after any resize(),
-     * preventing memory leaks.
+     * If newCapacity is larger than the current capacity, the buffer is
+     * reallocated to exactly newCapacity slots. If the capacity is enough but
+     * part of it is front room, the elements are slid to the front of the
+     * buffer instead. Otherwise nothing happens. Call it before a batch of
+     * pushBack calls of known size so that none of them trigger a resize.
+     *
+     * @param newCapacity  The minimum number of slots wanted.
+     *
+     * Time Complexity  : O(n) if a reallocation happens, O(1) otherwise
+     * Space Complexity : O(newCapacity)
+     *
+     * Example:
+     *   DynamicArray<int> arr;
+     *   arr.reserve(1000);  // the next 1000 pushBack calls never resize
      */
-    ~DynamicArray() {
-        delete[] data;
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity) {
+            reallocate(newCapacity);
+        }
+        else if (newCapacity > capacity - frontRoom()) {
+            slideTo(0);
+        }
     }
 
     /**
-     * @brief Copy constructor — creates a deep copy of another DynamicArray.
+     * @brief Releases unused capacity so that capacity == size.
      *
-     * Allocates a brand new array and copies all elements from the source.
-     * This ensures both objects own completely separate memory and modifying
-     * one won't affect the other (deep copy, not shallow copy).
+     * Reallocates the buffer to exactly currentSize slots (or frees it
+     * entirely if the array is empty), giving the extra memory — front room
+     * included — back to the allocator.
      *
-     * @param other  The DynamicArray to copy from.
+     * Time Complexity  : O(n) — O(1) when realloc shrinks the block in place
+     * Space Complexity : O(n)
      *
      * Example:
-     *   DynamicArray<int> arr2 = arr1;  // triggers copy constructor
+     *   arr = [1, 2, 3], capacity = 8
+     *   arr.shrinkToFit()  ->  capacity = 3
      */
-    DynamicArray(const DynamicArray& other) {
-        capacity = other.capacity;
-        currentSize = other.currentSize;
-        data = new T[capacity];
-
-        for (int i = 0; i < currentSize; i++) {
-            data[i] = other.data[i];
+    void shrinkToFit() {
+        if (capacity > currentSize) {
+            reallocate(currentSize);
         }
     }
 
     /**
-     * @brief Copy assignment operator — replaces this array's content with a deep copy.
-     *
-     * Frees the current array's memory, then allocates a new one and copies
-     * all elements from the right-hand side object.
-     * Includes a self-assignment guard to handle the case: arr = arr;
-     *
-     * @param other  The DynamicArray to copy from.
-     * @return       A reference to this object (enables chaining: a = b = c).
+     * @brief Returns a copy of the allocator used by this array.
      *
      * Example:
-     *   arr1 = arr2;  // triggers copy assignment operator
+     *   auto a = arr.getAllocator();
      */
-    DynamicArray& operator=(const DynamicArray& other) {
-        if (this != &other) { 
-            delete[] data; 
+    Allocator getAllocator() const { return alloc; }
 
-            capacity = other.capacity;
-            currentSize = other.currentSize;
-            data = new T[capacity];
+    /**
+     * @brief Reallocation and shift counters of this array (see DynamicArrayStats).
+     *
+     * Only counted when built with -DDS_INSTRUMENT; otherwise every field is 0.
+     * A copy or a move starts its own counters at 0.
+     *
+     * Example (instrumented):
+     *   DynamicArray<int> arr(1);
+     *   pushBack 1, 2, ..., 8  ->  reallocations 3 (capacity 1 -> 2 -> 4 -> 8), elementsMoved 1 + 2 + 4 = 7
+     *   arr.removeAt(4)        ->  elementsShifted 3 (the back half closes the gap)
+     */
+    DynamicArrayStats stats() const {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        return counters;
+#else
+        return {};
+#endif
+    }
 
-            for (int i = 0; i < currentSize; i++) {
-                data[i] = other.data[i];
-            }
-        }
-        return *this;
+    void resetStats() {
+#if DS_DYNAMIC_ARRAYS_INSTRUMENT
+        counters = {};
+#endif
     }
 
     /**
-     * @brief Inserts an element at the beginning of the array.
+     * @brief Searches for the first occurrence of a value and returns its index.
      *
-     * Shifts all existing elements one position to the right to make room
-     * at index 0, then places the new element there.
-     * Resizes the array first if it is at full capacity.
+     * Performs a linear scan from index 0 and returns the index of the first
+     * element that matches the given key.
      *
-     * @param value  The element to insert at the front.
+     * Use this when a missing key is a bug. When "not found" is a normal
+     * outcome, use tryFind() or contains() instead — they report a miss
+     * without throwing, so the miss costs nothing extra.
      *
-     * Time Complexity  : O(n) — due to shifting all elements right
-     * Space Complexity : O(1) — O(n) only if resize is triggered
+     * @param key  The value to search for.
+     * @return     The index of the first matching element.
+     *
+     * @throws std::out_of_range  If the element is not found.
+     *
+     * Time Complexity  : O(n)
+     * Space Complexity : O(1)
      *
      * Example:
      *   arr = [10, 20, 30]
-     *   arr.push(5)  ->  [5, 10, 20, 30]
+     *   arr.find(20)  ->  returns 1
+     *   arr.find(99)  ->  throws out_of_range
      */
-    void push(const T& value)
+    size_t find(const T& key) const
     {
-    	if (currentSize == capacity)
-    		resize();
-
-    	for (int i = currentSize - 1; i >= 0; i--)
-    	{
-    		data[i + 1] = data[i];
-    	}
-
-    	data[0] = value;
-
-    	currentSize++;
+        std::optional<size_t> index = tryFind(key);
+        if (!index) throw out_of_range("Element not found");
+        return *index;
     }
 
     /**
-     * @brief Appends an element to the end of the array.
+     * @brief Searches for the first occurrence of a value without throwing.
      *
-     * Places the new element at the next available position after the last
-     * element. Resizes the array first if it is at full capacity.
+     * Same scan as find(), but a miss is reported through the return value.
      *
-     * @param value  The element to append.
+     * For int, float and double arrays the scan is vectorized (AVX2 / SSE4.2 /
+     * NEON, picked at run time): 8 elements are compared per instruction and
+     * a movemask locates the first hit.
      *
-     * Time Complexity  : O(1) amortized — O(n) only when resize is triggered
+     * @param key  The value to search for.
+     * @return     The index of the first matching element, or std::nullopt if there is none.
+     *
+     * Time Complexity  : O(n)
      * Space Complexity : O(1)
      *
      * Example:
      *   arr = [10, 20, 30]
-     *   arr.pushBack(40) ->  [10, 20, 30, 40]
+     *   arr.tryFind(20)  ->  returns 1
+     *   arr.tryFind(99)  ->  returns std::nullopt
      */
-    void pushBack(const T& value) {
-        if (currentSize == capacity) {
-            resize();
+    std::optional<size_t> tryFind(const T& key) const
+    {
+        if constexpr (hasSimdScan<T>)
+        {
+            size_t index = simdFind(items, currentSize, key);
+            if (index == currentSize) return std::nullopt;
+            return index;
+        }
+
+        for (size_t i = 0; i < currentSize; i++)
+        {
+            if (items[i] == key)
+                return i;
         }
-        data[currentSize++] = value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Checks whether at least one element equals key.
+     *
+     * Stops at the first match.
+     *
+     * Time Complexity  : O(n)
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   arr = [10, 20, 30]
+     *   arr.contains(20)  ->  true
+     *   arr.contains(99)  ->  false
+     */
+    bool contains(const T& key) const
+    {
+        return tryFind(key).has_value();
+    }
+
+    /**
+    * @brief Returns the indices of ALL occurrences of a given value.
+    *
+    * Scans the entire array and collects the index of every element
+    * that matches the key into a new DynamicArray<size_t>, which is returned.
+    * Returns an empty array if no match is found — the result starts with
+    * capacity 0, so a scan with no hits allocates nothing.
+    *
+    * To avoid allocating a fresh result on every call, pass an output
+    * array to reuse (findAll(key, out)) or a callback (findAll(key, onMatch)).
+    *
+    * @param key  The value to search for.
+    * @return     A DynamicArray<size_t> containing all matching indices.
+    *
+    * Time Complexity  : O(n)
+    * Space Complexity : O(k) — where k is the number of matches
+    *
+    * Example:
+    *   arr = [10, 20, 10, 30, 10]
+    *   arr.findAll(10)  ->  returns [0, 2, 4]
+    *   arr.findAll(99)  ->  returns []
+    */
+    DynamicArray<size_t> findAll(const T& key) const
+    {
+        DynamicArray<size_t> indices(0);
+        forEachMatch(key, [&indices](size_t i) { indices.pushBack(i); });
+        return indices;
     }
-    
+
     /**
-    * @brief Inserts an element at a specific index, shifting subsequent elements right.
+    * @brief Writes the indices of ALL occurrences of a given value into out.
     *
-    * All elements from the given index onward are shifted one position to
-    * the right before placing the new element at the target index.
-    * Resizes the array first if it is at full capacity.
+    * Replaces the contents of out with the matching indices. out keeps its
+    * buffer between calls (clear() does not free it), so calling this in a
+    * loop with the same output array stops allocating once out is big enough.
     *
-    * @param index  The position at which to insert (0-based).
-    *               Valid range: [0, currentSize]
-    * @param value  The element to insert.
+    * @param key  The value to search for.
+    * @param out  Receives the indices; must not be this array.
+    * @return     The number of matches.
+    *
+    * Time Complexity  : O(n)
+    * Space Complexity : O(1) — beyond growing out
     *
-    * @throws std::out_of_range  If index < 0 or index > currentSize.
+    * Example:
+    *   DynamicArray<size_t> hits;
+    *   arr.findAll(10, hits);  // hits = [0, 2, 4], reused on the next call
     *
-    * Time Complexity  : O(n) — due to shifting elements right
-    * Space Complexity : O(1) — O(n) only if resize is triggered
+    *   SmallDynamicArray<size_t, 16> few;
+    *   arr.findAll(10, few);   // up to 16 hits without touching the heap
+    */
+    template <typename OutAllocator, typename OutGrowth, size_t OutInline>
+    size_t findAll(const T& key, DynamicArray<size_t, OutAllocator, OutGrowth, OutInline>& out) const
+    {
+        out.clear();
+        forEachMatch(key, [&out](size_t i) { out.pushBack(i); });
+        return out.size();
+    }
+
+    /**
+    * @brief Calls onMatch(index) for every element equal to key, in index order.
+    *
+    * Nothing is allocated — the indices are handed to the callback as they
+    * are found.
+    *
+    * @param key      The value to search for.
+    * @param onMatch  Callable taking a size_t index.
+    *
+    * Time Complexity  : O(n)
+    * Space Complexity : O(1)
     *
     * Example:
-    *   arr = [10, 20, 30]
-    *   arr.insert(1, 99)  ->  [10, 99, 20, 30]
+    *   int hits = 0;
+    *   arr.findAll(10, [&](size_t) { hits++; });
     */
-    void insert(int index, const T& value) {
-        if (index < 0 || index > currentSize) {
-            throw out_of_range("Index out of bounds");
+    template <typename Callback>
+    void findAll(const T& key, Callback&& onMatch) const
+    {
+        forEachMatch(key, onMatch);
+    }
+
+    /**
+     * @brief Returns the current number of elements in the array.
+     *
+     * @return  The number of elements currently stored (not the capacity).
+     *
+     * Example:
+     *   arr = [10, 20, 30]  ->  arr.size() returns 3
+     */
+    size_t size() const { return currentSize; }
+
+    /**
+     * @brief Returns the total allocated capacity of the internal array.
+     *
+     * Capacity is always >= size and counts every allocated slot, including
+     * any free front room. When size reaches capacity, the array
+     * automatically resizes and capacity doubles.
+     *
+     * @return  The total number of elements the array can hold before resizing.
+     *
+     * Example:
+     *   arr = [10, 20, 30], capacity = 4  ->  arr.getCapacity() returns 4
+     */
+    size_t getCapacity() const { return capacity; }
+
+    /**
+     * @brief Checks whether the array has no elements.
+     *
+     * @return  true if currentSize == 0, false otherwise.
+     *
+     * Example:
+     *   DynamicArray<int> arr;  ->  arr.isEmpty() returns true
+     *   arr.pushBack(1);        ->  arr.isEmpty() returns false
+     */
+    bool isEmpty() const { return currentSize == 0; }
+
+    /**
+     * @brief Prints all elements in the array to standard output.
+     *
+     * Outputs elements in the format: [e1, e2, e3]
+     * Prints [] if the array is empty.
+     *
+     * Time Complexity  : O(n)
+     *
+     * Example:
+     *   arr = [10, 20, 30]  ->  prints "[10, 20, 30]"
+     */
+    void display() const {
+        cout << "[";
+        for (size_t i = 0; i < currentSize; i++) {
+            cout << items[i];
+            if (i < currentSize - 1) cout << ", ";
+        }
+        cout << "]" << endl;
+    }
+
+    /**
+     * @brief Sorts the array in place, in ascending order according to comp.
+     *
+     * Uses introsort: quicksort with a median-of-three pivot, falling back to
+     * heap sort if the recursion gets too deep (so the worst case stays
+     * O(n log n)), and insertion sort for partitions of 16 elements or fewer.
+     *
+     * Fast path: for integral T with the default comparator and at least
+     * 256 elements, an LSD radix sort is used instead (O(n) per byte of T).
+     *
+     * Not stable — equal elements may end up in any order.
+     *
+     * @param comp  Strict weak ordering; comp(a, b) is true if a goes before b.
+     *              Defaults to std::less<T> (operator<).
+     *
+     * Time Complexity  : O(n log n) — O(n * sizeof(T)) on the radix path
+     * Space Complexity : O(log n)   — O(n) scratch on the radix path
+     *
+     * Example:
+     *   arr = [5, 3, 8, 1]
+     *   arr.sortInPlace()                  ->  arr is now [1, 3, 5, 8]
+     *   arr.sortInPlace(std::greater<>())  ->  arr is now [8, 5, 3, 1]
+     */
+    template <typename Compare = std::less<T>>
+    void sortInPlace(Compare comp = Compare())
+    {
+        if (currentSize < 2) return;
+
+        if constexpr (useRadixSort<T, Compare>) {
+            if (currentSize >= radixSortCutoff) {
+                T* scratch = AllocTraits::allocate(alloc, currentSize);
+                AllocationTracker::recordAllocation(currentSize * sizeof(T));
+                radixSortRange(items, static_cast<size_t>(currentSize), scratch);
+                AllocTraits::deallocate(alloc, scratch, currentSize);
+                AllocationTracker::recordDeallocation(currentSize * sizeof(T));
+                return;
+            }
+        }
+
+        introsortRange(items, items + currentSize, introsortDepthLimit(currentSize), comp);
+    }
+
+    /**
+     * @brief Same as sortInPlace(comp); the policy tag selects sequential execution.
+     */
+    template <typename Compare = std::less<T>>
+    void sortInPlace(SequentialExecution, Compare comp = Compare())
+    {
+        sortInPlace(comp);
+    }
+
+    /**
+     * @brief Sorts the array in place using several threads.
+     *
+     * The array is split into one chunk per thread; each chunk is sorted
+     * concurrently with sortInPlace's algorithm. The sorted chunks are then
+     * merged pairwise, level by level, into a scratch buffer — all pairs of a
+     * level in parallel, and each large merge itself split across threads
+     * (see mergeRunsInto()). Arrays under 32768 elements are sorted sequentially,
+     * since thread start-up would cost more than it saves.
+     *
+     * @param policy  Thread count (0 = hardware concurrency).
+     * @param comp    Strict weak ordering; must be safe to call concurrently and must not throw.
+     *
+     * Time Complexity  : O(n log n) work, about O((n / p) log n + n) wall time on p threads
+     * Space Complexity : O(n) — the merge buffer
+     *
+     * Example:
+     *   big.sortInPlace(ParallelExecution{});     // all cores
+     *   big.sortInPlace(ParallelExecution{4});    // 4 threads
+     */
+    template <typename Compare = std::less<T>>
+    void sortInPlace(ParallelExecution policy, Compare comp = Compare())
+    {
+        constexpr size_t parallelSortCutoff = 1 << 15;
+
+        size_t threads = policy.threadCount ? policy.threadCount : std::thread::hardware_concurrency();
+        if (threads > currentSize / (parallelSortCutoff / 2)) threads = currentSize / (parallelSortCutoff / 2);
+        if (threads < 2 || currentSize < parallelSortCutoff) {
+            sortInPlace(comp);
+            return;
+        }
+
+        // Run boundaries: run r is [bounds[r], bounds[r + 1]).
+        DynamicArray<size_t> bounds(threads + 1);
+        for (size_t r = 0; r <= threads; r++) {
+            bounds.pushBack(currentSize / threads * r + currentSize % threads * r / threads);
         }
 
-        if (currentSize == capacity) {
-            resize();
-        }
+        DynamicArray<std::thread> workers(threads);
+        for (size_t r = 0; r < threads; r++) {
+            workers.emplaceBack([this, &bounds, &comp, r] {
+                T* first = items + bounds[r];
+                T* last = items + bounds[r + 1];
+                if constexpr (useRadixSort<T, Compare>) {
+                    // Radix needs scratch; per-run scratch keeps the threads independent.
+                    ptrdiff_t n = last - first;
+                    if (n >= radixSortCutoff) {
+                        Allocator localAlloc(alloc);
+                        T* scratch = AllocTraits::allocate(localAlloc, n);
+                        AllocationTracker::recordAllocation(static_cast<size_t>(n) * sizeof(T));
+                        radixSortRange(first, static_cast<size_t>(n), scratch);
+                        AllocTraits::deallocate(localAlloc, scratch, n);
+                        AllocationTracker::recordDeallocation(static_cast<size_t>(n) * sizeof(T));
+                        return;
+                    }
+                }
+                introsortRange(first, last, introsortDepthLimit(last - first), comp);
+            });
+        }
+        for (size_t r = 0; r < threads; r++) workers[r].join();
+
+        T* buffer = AllocTraits::allocate(alloc, currentSize);
+        AllocationTracker::recordAllocation(currentSize * sizeof(T));
+        size_t runs = threads;
+        while (runs > 1) {
+            size_t pairs = runs / 2;
+            int mergeDepth = 0;
+            while ((pairs << (mergeDepth + 1)) <= threads) mergeDepth++;
+
+            workers.clear();
+            for (size_t p = 0; p < pairs; p++) {
+                workers.emplaceBack([this, &bounds, &comp, buffer, p, mergeDepth] {
+                    size_t lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+                    mergeRunsInto(items + lo, items + mid, items + mid, items + hi, buffer + lo, comp, mergeDepth);
+                    for (size_t i = lo; i < hi; i++) {
+                        items[i] = std::move(buffer[i]);
+                        AllocTraits::destroy(alloc, buffer + i);
+                    }
+                });
+            }
+            for (size_t p = 0; p < pairs; p++) workers[p].join();
 
-        for (int i = currentSize; i > index; i--) {
-            data[i] = data[i - 1];
+            // Merged pair p becomes run p; an odd last run is carried over unchanged.
+            size_t kept = 0;
+            for (size_t r = 0; r <= runs; r += 2) bounds[kept++] = bounds[r];
+            if (runs % 2 == 1) bounds[kept++] = bounds[runs];
+            while (bounds.size() > kept) bounds.popBack();
+            runs = kept - 1;
         }
-
-        data[index] = value;
-        currentSize++;
+        AllocTraits::deallocate(alloc, buffer, currentSize);
+        AllocationTracker::recordDeallocation(currentSize * sizeof(T));
     }
 
     /**
-     * @brief Removes the first element of the array.
+     * @brief Returns a new sorted copy of the array.
      *
-     * Shifts all remaining elements one position to the left to fill the gap
-     * left by removing index 0, then decrements currentSize.
-     * Does nothing if the array is empty.
+     * Does not modify the original array. Creates a copy internally,
+     * sorts it in ascending order with sortInPlace(), and returns it.
      *
-     * Time Complexity  : O(n) — due to shifting all elements left
-     * Space Complexity : O(1)
+     * For numeric types (int, float, double, etc.): sorts by value.
+     * For strings: sorts lexicographically (alphabetical order).
+     *
+     * @return  A new DynamicArray containing all elements in sorted order.
+     *
+     * Time Complexity  : O(n log n) — introsort (radix sort for large integral arrays)
+     * Space Complexity : O(n)       — due to the copy
      *
      * Example:
-     *   arr = [10, 20, 30]
-     *   arr.pop()  ->  [20, 30]
+     *   arr = [5, 3, 8, 1]
+     *   arr.sort()  ->  returns [1, 3, 5, 8], original unchanged
      */
-    void pop()
+    DynamicArray sort() const
     {
-	    if (currentSize == 0) return;
-
-	    for (int i = 0; i < currentSize - 1; i++)
-		    data[i] = data[i + 1];
-
-        currentSize--;
+		DynamicArray sorted(*this);
+        sorted.sortInPlace();
+        return sorted;
     }
 
     /**
-     * @brief Removes the last element of the array.
+     * @brief Returns a new sorted copy of the array, sorted using several threads.
      *
-     * Simply decrements currentSize — no shifting needed.
-     * The value at the old last index remains in memory but is
-     * considered out of bounds and will be overwritten on the next insert.
-     * Does nothing if the array is empty.
+     * Same as sort(), but the copy is sorted with sortInPlace(ParallelExecution).
      *
-     * Time Complexity  : O(1)
-     * Space Complexity : O(1)
+     * @param policy  Thread count (0 = hardware concurrency).
+     * @return        A new DynamicArray containing all elements in sorted order.
      *
      * Example:
-     *   arr = [10, 20, 30]
-     *   arr.popBack()  ->  [10, 20]
+     *   DynamicArray<int> sorted = arr.sort(ParallelExecution{});
      */
-    void popBack() {
-        if (currentSize > 0) {
-            currentSize--;
-        }
+    DynamicArray sort(ParallelExecution policy) const
+    {
+        DynamicArray sorted(*this);
+        sorted.sortInPlace(policy);
+        return sorted;
     }
 
     /**
-     * @brief Removes the element at a specific index, shifting subsequent elements left.
-     *
-     * All elements after the given index are shifted one position to the left
-     * to fill the gap, then currentSize is decremented.
+     * @brief Returns a new array containing all elements of this array followed by all elements of another.
      *
-     * @param index  The position of the element to remove (0-based).
-     *               Valid range: [0, currentSize - 1]
+     * Does not modify either original array. Allocates the result at its
+     * final size up front and copies both arrays into it — one memcpy each
+     * for trivially copyable T, and no resize on the way.
      *
-     * @throws std::out_of_range  If index < 0 or index >= currentSize.
+     * @param other  The array whose elements will be appended.
+     * @return       A new DynamicArray with combined elements.
      *
-     * Time Complexity  : O(n) — due to shifting elements left
-     * Space Complexity : O(1)
+     * Time Complexity  : O(n + m) — n = this size, m = other size
+     * Space Complexity : O(n + m)
      *
      * Example:
-     *   arr = [10, 20, 30, 40]
-     *   arr.removeAt(1)  ->  [10, 30, 40]
+     *   arr1 = [1, 2, 3]
+     *   arr2 = [4, 5, 6]
+     *   arr1.merge(arr2)  ->  returns [1, 2, 3, 4, 5, 6], both originals unchanged
      */
-    void removeAt(int index) {
-        if (index < 0 || index >= currentSize) {
-            throw out_of_range("Index out of bounds");
-        }
-
-        for (int i = index; i < currentSize - 1; i++) {
-            data[i] = data[i + 1];
-        }
-
-        currentSize--;
+    DynamicArray merge(const DynamicArray& other) const
+    {
+        DynamicArray merged(currentSize + other.currentSize,
+                            AllocTraits::select_on_container_copy_construction(alloc));
+        merged.append(items, currentSize);
+        merged.append(other.items, other.currentSize);
+		return merged;
     }
 
     /**
-     * @brief Returns a reference to the element at the given index, with bounds checking.
+     * @brief Appends every element of another array to this one, in place.
      *
-     * Unlike operator[], this method validates the index before accessing memory.
-     * Use this when you want a safe access that throws on invalid input.
+     * The in-place counterpart of merge(): no third array is built, room is
+     * reserved once and the other array is copied in with append().
      *
-     * @param index  The position of the element to access (0-based).
-     * @return       A reference to the element at the given index.
+     * @param other  The array whose elements will be appended (may be *this).
      *
-     * @throws std::out_of_range  If index < 0 or index >= currentSize.
+     * Time Complexity  : O(m) amortized — m = other size
+     * Space Complexity : O(1) — O(n + m) only if resize is triggered
      *
-     * Time Complexity  : O(1)
+     * Example:
+     *   arr1 = [1, 2, 3]
+     *   arr2 = [4, 5, 6]
+     *   arr1.mergeInto(arr2)  ->  arr1 is now [1, 2, 3, 4, 5, 6]
+     */
+    void mergeInto(const DynamicArray& other)
+    {
+        append(other.items, other.currentSize);
+    }
+
+    /**
+     * @brief Moves every element of another array to the end of this one.
+     *
+     * Same as mergeInto(const DynamicArray&), but the elements are moved
+     * instead of copied — for std::string that is a pointer swap per element.
+     * other is left empty (its buffer is kept).
+     *
+     * Time Complexity  : O(m) amortized — m = other size
+     * Space Complexity : O(1) — O(n + m) only if resize is triggered
      *
      * Example:
-     *   arr.at(2)  ->  returns reference to element at index 2
+     *   arr1.mergeInto(std::move(arr2))  ->  arr2 is now []
      */
-    T& at(int index) {
-        if (index < 0 || index >= currentSize) {
-            throw out_of_range("Index out of bounds");
+    void mergeInto(DynamicArray&& other)
+    {
+        if (&other == this) return;
+
+        reserveBack(other.currentSize);
+        for (size_t i = 0; i < other.currentSize; i++) {
+            AllocTraits::construct(alloc, items + currentSize, std::move_if_noexcept(other.items[i]));
+            currentSize++;
         }
-        return data[index];
+        other.clear();
     }
 
     /**
-     * @brief Overloads the [] operator for direct index access without bounds checking (like STL).
+     * @brief Returns a new array with all elements in reverse order.
      *
-     * Mimics the behavior of a raw array or std::vector's operator[].
-     * Faster than at() since it skips validation, but accessing an
-     * out-of-range index leads to undefined behavior.
+     * Does not modify the original array. Creates a copy and fills it
+     * by reading the original from back to front.
      *
-     * @param index  The position of the element to access (0-based).
-     * @return       A reference to the element at the given index.
+     * @return  A new DynamicArray with elements in reversed order.
      *
-     * Time Complexity  : O(1)
+     * Time Complexity  : O(n)
+     * Space Complexity : O(n) — due to the copy
      *
      * Example:
-     *   arr[2]  ->  returns reference to element at index 2
+     *   arr = [1, 2, 3, 4]
+     *   arr.reverse()  ->  returns [4, 3, 2, 1], original unchanged
      */
-    T& operator[](int index) {
-        return data[index];
+    DynamicArray reverse() const
+    {
+		DynamicArray reversed(*this);
+
+        for(size_t i = 0; i < currentSize; i++)
+        {
+            reversed.items[i] = items[currentSize - i - 1];
+		}
+
+		return reversed;
     }
 
     /**
-     * @brief Resets the array to its initial empty state.
+     * @brief Returns the maximum element in the array.
+     *
+     * Behavior depends on type T:
+     * - Numeric types (int, float, double, etc.): returns the largest value.
+     *   int, float and double use a vectorized lane-wise reduction.
+     * - std::string: returns the longest string (by character count).
      *
-     * Frees the currently allocated memory, resets currentSize to 0,
-     * resets capacity back to the default (5), and allocates a fresh array.
-     * After calling clear(), the object is in the same state as a newly constructed one.
+     * @return  The maximum element of type T.
      *
-     * Time Complexity  : O(1)
+     * @throws std::runtime_error  If the array is empty.
+     *
+     * Time Complexity  : O(n)
      * Space Complexity : O(1)
      *
-     * Example:
-     *   arr = [10, 20, 30]
-     *   arr.clear()  ->  arr is now []
+     * Example (numeric):
+     *   arr = [3, 7, 1, 9, 2]
+     *   arr.max()  ->  returns 9
+     *
+     * Example (string):
+     *   arr = ["hi", "hello", "hey"]
+     *   arr.max()  ->  returns "hello"  (longest)
      */
-    void clear()
+    T max() const
     {
-        delete[] data;
-        capacity = 5;
-        currentSize = 0;
-        data = new T[capacity];
+        if (isEmpty()) throw std::runtime_error("Array is empty");
+
+        if constexpr (hasSimdScan<T>)
+            return simdReduce<true>(items, currentSize);
+
+        T maxValue = items[0];
+
+        if constexpr (is_arithmetic<T>::value) 
+        {
+            for (size_t i = 1; i < currentSize; i++)
+            {
+                if(items[i] > maxValue)
+					maxValue = items[i];
+            }
+        }
+		else if constexpr (is_same<T, string>::value)
+        {
+            for (size_t i = 1; i < currentSize; i++)
+            {
+				if (items[i].length() > maxValue.length())
+					maxValue = items[i];
+            }
+        }
+
+        return maxValue;
     }
 
     /**
-     * @brief Searches for the first occurrence of a value and returns its index.
+     * @brief Returns the minimum element in the array.
      *
-     * Performs a linear scan from index 0 and returns the index of the first
-     * element that matches the given key.
+     * Behavior depends on type T:
+     * - Numeric types (int, float, double, etc.): returns the smallest value.
+     *   int, float and double use a vectorized lane-wise reduction.
+     * - std::string: returns the shortest string (by character count).
      *
-     * @param key  The value to search for.
-     * @return     The index of the first matching element.
+     * @return  The minimum element of type T.
      *
-     * @throws std::out_of_range  If the element is not found.
+     * @throws std::runtime_error  If the array is empty.
      *
      * Time Complexity  : O(n)
      * Space Complexity : O(1)
      *
-     * Example:
-     *   arr = [10, 20, 30]
-     *   arr.find(20)  ->  returns 1
-     *   arr.find(99)  ->  throws out_of_range
+     * Example (numeric):
+     *   arr = [3, 7, 1, 9, 2]
+     *   arr.min()  ->  returns 1
+     *
+     * Example (string):
+     *   arr = ["hi", "hello", "hey"]
+     *   arr.min()  ->  returns "hi"  (shortest)
      */
-    int find(const T& key) const
+    T min() const
     {
-        for (int i = 0; i < currentSize; i++)
+        if (isEmpty()) throw std::runtime_error("Array is empty");
+
+        if constexpr (hasSimdScan<T>)
+            return simdReduce<false>(items, currentSize);
+
+        T minValue = items[0];
+
+        if constexpr (is_arithmetic<T>::value)
         {
-            if (data[i] == key)
-                return i;
+            for (size_t i = 1; i < currentSize; i++)
+            {
+                if (items[i] < minValue)
+                    minValue = items[i];
+            }
+        }
+        else if constexpr (is_same<T, string>::value)
+        {
+            for (size_t i = 1; i < currentSize; i++)
+            {
+                if (items[i].length() < minValue.length())
+                    minValue = items[i];
+            }
+        }
+
+        return minValue;
+    }
+
+
+};
+
+
+/**
+* @brief A DynamicArray that keeps up to N elements inside the object itself.
+*
+* Short arrays — the common case for per-request scratch lists, hit lists,
+* small adjacency lists — then cost no malloc/free pair at all: the first
+* heap allocation happens when the (N + 1)-th element arrives, and
+* shrinkToFit() moves the elements back inline once they fit again.
+*
+* Trade-offs: the object is N * sizeof(T) bytes bigger, and moving an
+* inline array moves its elements (O(N)) instead of swapping a pointer.
+*
+* Example usage:
+*   SmallDynamicArray<int, 16> ids;   // no allocation
+*   for (int i = 0; i < 16; i++) ids.pushBack(i);   // still none
+*   ids.pushBack(16);                 // spills to the heap here
+*/
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+using SmallDynamicArray = DynamicArray<T, Allocator, GrowthPolicy, N>;
+
+// ***************  SORTED ARRAY  ****************
+
+/**
+* @brief How SortedDynamicArray answers lowerBound() / upperBound() / contains().
+*
+*   Binary      — textbook binary search on the sorted elements.
+*   Branchless  — same probes, but the "go left / go right" step is a
+*                 conditional move instead of a branch, so a search costs no
+*                 branch mispredictions (about half the probes in a plain
+*                 binary search are mispredicted on random keys).
+*   Eytzinger   — branchless search over a second copy of the elements laid
+*                 out in BFS order (root at 1, children of k at 2k and 2k+1).
+*                 The next levels of the search are contiguous in memory, so
+*                 they can be prefetched; fastest on arrays that do not fit in
+*                 cache. The copy is rebuilt lazily after every modification.
+*/
+enum class SortedSearch { Binary, Branchless, Eytzinger };
+
+/**
+* @brief A DynamicArray that keeps its elements sorted and searches in O(log n).
+*
+* Wraps a DynamicArray<T, Allocator>: the elements live in one contiguous,
+* ascending run (by Compare), so lowerBound() / upperBound() / equalRange()
+* / contains() are binary searches instead of the O(n) scan of find().
+*
+* Inserts come in two flavours:
+*   insert(value)        — places the value immediately (O(n) shift).
+*   insertSorted(value)  — appends it to an unsorted pending buffer in O(1).
+*                          The buffer is sorted and merged into the elements
+*                          (O(n + k log k) for k pending values) on the next
+*                          query, so loading k values costs one merge instead
+*                          of k shifts.
+*
+* Queries are const but may perform that pending merge (and rebuild the
+* Eytzinger copy), so a SortedDynamicArray must not be queried from several
+* threads at once without external locking.
+*
+* @tparam T          Element type; must be copy-constructible.
+* @tparam Compare    Strict weak ordering (std::less<T> by default).
+* @tparam Allocator  Passed through to the underlying DynamicArray.
+*
+* Example usage:
+*   SortedDynamicArray<int> ids;
+*   ids.insertSorted(30); ids.insertSorted(10); ids.insertSorted(20);
+*   ids.contains(20);     // true — the three inserts are merged here, once
+*   ids.lowerBound(15);   // 1
+*/
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+class SortedDynamicArray {
+private:
+    using Array = DynamicArray<T, Allocator>;
+
+    mutable Array elements;              // Sorted run
+    mutable Array pending;               // Unsorted inserts waiting to be merged
+    mutable Array eytzinger;             // elements in BFS order, slot 0 unused (see SortedSearch)
+    mutable DynamicArray<size_t> eytzingerRank;  // eytzinger[k] == elements[eytzingerRank[k]]
+    mutable bool eytzingerValid;
+    Compare comp;
+    SortedSearch strategy;
+
+    /**
+    * @brief Merges two sorted arrays into a new one in O(n + m).
+    *
+    * On ties the element from a comes first. With Move the elements are
+    * moved out of a and b instead of copied.
+    */
+    template <bool Move>
+    Array mergeRuns(Array& a, Array& b) const {
+        using Source = typename conditional<Move, T&&, const T&>::type;
+
+        Array out(a.size() + b.size(), a.getAllocator());
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (comp(b[j], a[i])) out.pushBack(static_cast<Source>(b[j++]));
+            else                  out.pushBack(static_cast<Source>(a[i++]));
         }
-        throw out_of_range("Element not found");
+        for (; i < a.size(); i++) out.pushBack(static_cast<Source>(a[i]));
+        for (; j < b.size(); j++) out.pushBack(static_cast<Source>(b[j]));
+        return out;
     }
 
     /**
-    * @brief Returns the indices of ALL occurrences of a given value.
+    * @brief Sorts the pending inserts and merges them into the elements.
     *
-    * Scans the entire array and collects the index of every element
-    * that matches the key into a new DynamicArray<int>, which is returned.
-    * Returns an empty array if no match is found.
+    * Called at the start of every query; does nothing when there are no
+    * pending inserts.
     *
-    * @param key  The value to search for.
-    * @return     A DynamicArray<int> containing all matching indices.
+    * Time Complexity  : O(n + k log k) — k = pending inserts
+    */
+    void flush() const {
+        if (pending.isEmpty()) return;
+
+        pending.sortInPlace(comp);
+        elements = mergeRuns<true>(elements, pending);
+        pending.clear();
+        eytzingerValid = false;
+    }
+
+    /**
+    * @brief Fills eytzingerRank[k] with the sorted index of BFS slot k, by in-order traversal.
+    */
+    size_t assignRanks(size_t k, size_t next) const {
+        size_t n = elements.size();
+        if (k > n) return next;
+
+        next = assignRanks(2 * k, next);
+        eytzingerRank[k] = next++;
+        return assignRanks(2 * k + 1, next);
+    }
+
+    /**
+    * @brief Rebuilds the BFS-ordered copy of the elements if it is stale.
     *
     * Time Complexity  : O(n)
-    * Space Complexity : O(k) — where k is the number of matches
+    */
+    void buildEytzinger() const {
+        if (eytzingerValid) return;
+
+        size_t n = elements.size();
+        eytzinger.clear();
+        eytzingerRank.clear();
+        eytzinger.reserve(n + 1);
+        eytzingerRank.reserve(n + 1);
+        for (size_t k = 0; k <= n; k++) eytzingerRank.pushBack(0);
+        assignRanks(1, 0);
+
+        if (n > 0) eytzinger.pushBack(elements[0]);   // slot 0 is a placeholder
+        for (size_t k = 1; k <= n; k++) eytzinger.pushBack(elements[eytzingerRank[k]]);
+        eytzingerValid = true;
+    }
+
+    /**
+    * @brief Index of the first element e for which goesRight(e) is false.
     *
-    * Example:
-    *   arr = [10, 20, 10, 30, 10]
-    *   arr.findAll(10)  ->  returns [0, 2, 4]
-    *   arr.findAll(99)  ->  returns []
+    * goesRight must be true for a prefix of the elements and false after it:
+    * comp(e, key) for lowerBound, !comp(key, e) for upperBound.
     */
-    DynamicArray<int> findAll(const T& key) const
-    {
-        DynamicArray<int> indices;
+    template <typename GoesRight>
+    size_t partitionPoint(GoesRight goesRight) const {
+        flush();
+        size_t n = elements.size();
+        if (n == 0) return 0;
 
-        for (int i = 0; i < currentSize; i++)
-        {
-            if (data[i] == key)
-                indices.pushBack(i);
+        switch (strategy) {
+        case SortedSearch::Eytzinger: {
+            buildEytzinger();
+            const T* tree = &eytzinger[0];
+            const size_t stride = (sizeof(T) < 64) ? 64 / sizeof(T) : 1;
+            size_t k = 1;
+            while (k <= n) {
+#if defined(__GNUC__) || defined(__clang__)
+                // The 16 (for int) descendants four levels down share one cache line.
+                size_t ahead = k * stride;
+                __builtin_prefetch(tree + (ahead <= n ? ahead : 0));
+#endif
+                k = 2 * k + (goesRight(tree[k]) ? 1 : 0);
+            }
+            // Undo the trailing right turns (and the last left one) to get the answer's slot.
+            k >>= lowestBit64(~static_cast<unsigned long long>(k)) + 1;
+            return (k == 0) ? n : eytzingerRank[k];
+        }
+        case SortedSearch::Branchless: {
+            const T* base = &elements[0];
+            size_t len = n;
+            while (len > 1) {
+                size_t half = len / 2;
+                base = goesRight(base[half - 1]) ? base + half : base;
+                len -= half;
+            }
+            return static_cast<size_t>(base - &elements[0]) + (goesRight(*base) ? 1 : 0);
+        }
+        default: {
+            size_t low = 0, high = n;
+            while (low < high) {
+                size_t mid = low + (high - low) / 2;
+                if (goesRight(elements[mid])) low = mid + 1;
+                else                          high = mid;
+            }
+            return low;
+        }
         }
-
-        return indices;
     }
 
+public:
     /**
-     * @brief Returns the current number of elements in the array.
-     *
-     * @return  The number of elements currently stored (not the capacity).
+     * @brief Constructs an empty sorted array.
      *
-     * Example:
-     *   arr = [10, 20, 30]  ->  arr.size() returns 3
+     * @param compare   The ordering to keep the elements in.
+     * @param strategy  How lookups search (see SortedSearch).
+     * @param allocator Allocator for the underlying arrays.
      */
-    int size() const { return currentSize; }
+    explicit SortedDynamicArray(const Compare& compare = Compare(),
+                                SortedSearch strategy = SortedSearch::Binary,
+                                const Allocator& allocator = Allocator())
+        : elements(0, allocator), pending(0, allocator), eytzinger(0, allocator), eytzingerRank(0),
+          eytzingerValid(false), comp(compare), strategy(strategy) {}
 
     /**
-     * @brief Returns the total allocated capacity of the internal array.
+     * @brief Builds a sorted array from an unsorted one.
      *
-     * Capacity is always >= size. When size reaches capacity, the array
-     * automatically resizes and capacity doubles.
+     * Takes values by value, so passing an rvalue sorts it in place without copying.
      *
-     * @return  The total number of elements the array can hold before resizing.
+     * Time Complexity  : O(n log n)
      *
      * Example:
-     *   arr = [10, 20, 30], capacity = 4  ->  arr.getCapacity() returns 4
+     *   SortedDynamicArray<int> s(std::move(arr));
      */
-    int getCapacity() const { return capacity; }
+    explicit SortedDynamicArray(Array values, const Compare& compare = Compare(),
+                                SortedSearch strategy = SortedSearch::Binary)
+        : elements(std::move(values)), pending(0, elements.getAllocator()), eytzinger(0, elements.getAllocator()),
+          eytzingerRank(0), eytzingerValid(false), comp(compare), strategy(strategy)
+    {
+        elements.sortInPlace(comp);
+    }
 
     /**
-     * @brief Checks whether the array has no elements.
-     *
-     * @return  true if currentSize == 0, false otherwise.
+     * @brief Picks the search algorithm used by subsequent lookups.
      *
      * Example:
-     *   DynamicArray<int> arr;  ->  arr.isEmpty() returns true
-     *   arr.pushBack(1);        ->  arr.isEmpty() returns false
+     *   s.setSearchStrategy(SortedSearch::Eytzinger);
      */
-    bool isEmpty() const { return currentSize == 0; }
+    void setSearchStrategy(SortedSearch newStrategy) { strategy = newStrategy; }
+
+    SortedSearch searchStrategy() const { return strategy; }
 
     /**
-     * @brief Prints all elements in the array to standard output.
+     * @brief Inserts a value at its sorted position right away.
      *
-     * Outputs elements in the format: [e1, e2, e3]
-     * Prints [] if the array is empty.
+     * Equal values are inserted after the existing ones.
+     * Prefer insertSorted() when adding many values before the next lookup.
      *
-     * Time Complexity  : O(n)
+     * Time Complexity  : O(n) — O(log n) search plus shifting the shorter side
      *
      * Example:
-     *   arr = [10, 20, 30]  ->  prints "[10, 20, 30]"
+     *   s = [10, 30]
+     *   s.insert(20)  ->  [10, 20, 30]
      */
-    void display() const {
-        cout << "[";
-        for (int i = 0; i < currentSize; i++) {
-            cout << data[i];
-            if (i < currentSize - 1) cout << ", ";
-        }
-        cout << "]" << endl;
+    void insert(const T& value) {
+        elements.insert(upperBound(value), value);
+        eytzingerValid = false;
     }
 
     /**
-     * @brief Returns a new sorted copy of the array using bubble sort.
-     *
-     * Does not modify the original array. Creates a copy internally,
-     * sorts it in ascending order, and returns it.
+     * @brief Buffers a value; it is merged in on the next query.
      *
-     * For numeric types (int, float, double, etc.): sorts by value.
-     * For strings: sorts lexicographically (alphabetical order).
-     *
-     * @return  A new DynamicArray containing all elements in sorted order.
-     *
-     * Time Complexity  : O(n^2) — bubble sort
-     * Space Complexity : O(n)   — due to the copy
+     * Time Complexity  : O(1) amortized (the merge is paid once per batch)
      *
      * Example:
-     *   arr = [5, 3, 8, 1]
-     *   arr.sort()  ->  returns [1, 3, 5, 8], original unchanged
+     *   for (int id : incoming) s.insertSorted(id);   // no shifting here
+     *   s.contains(42);                               // one merge, then O(log n)
      */
-    DynamicArray sort() const
-    {
-		DynamicArray sorted(*this);
-
-        for (int i = 0; i < currentSize - 1; i++)
-        {
-            for (int j = 0; j < currentSize - i - 1; j++)
-            {
-                if (sorted[j] > sorted[j + 1])
-                {
-					T temp = sorted[j];
-					sorted[j] = sorted[j + 1];
-					sorted[j + 1] = temp;
-                }
-            }
-        }
+    void insertSorted(const T& value) {
+        pending.pushBack(value);
+    }
 
-        return sorted;
+    /**
+     * @brief Buffers n values at once; they are merged in on the next query.
+     *
+     * Time Complexity  : O(n) amortized
+     */
+    void insertSorted(const T* values, size_t n) {
+        pending.append(values, n);
     }
 
     /**
-     * @brief Returns a new array containing all elements of this array followed by all elements of another.
+     * @brief Removes one element equal to key, if any.
      *
-     * Does not modify either original array. Creates a copy of this array
-     * and appends every element from the other array to it.
+     * @return  true if an element was removed.
      *
-     * @param other  The array whose elements will be appended.
-     * @return       A new DynamicArray with combined elements.
+     * Time Complexity  : O(n) — O(log n) search plus shifting the shorter side
+     */
+    bool remove(const T& key) {
+        size_t index = lowerBound(key);
+        if (index == elements.size() || comp(key, elements[index])) return false;
+
+        elements.removeAt(index);
+        eytzingerValid = false;
+        return true;
+    }
+
+    /**
+     * @brief Index of the first element not less than key (size() if there is none).
      *
-     * Time Complexity  : O(n + m) — n = this size, m = other size
-     * Space Complexity : O(n + m)
+     * Time Complexity  : O(log n) — plus a pending merge, if any
      *
      * Example:
-     *   arr1 = [1, 2, 3]
-     *   arr2 = [4, 5, 6]
-     *   arr1.merge(arr2)  ->  returns [1, 2, 3, 4, 5, 6], both originals unchanged
+     *   s = [10, 20, 20, 30]
+     *   s.lowerBound(20)  ->  1
+     *   s.lowerBound(25)  ->  3
      */
-    DynamicArray merge(const DynamicArray& other) const
-    {
-		DynamicArray merged(*this);
-
-        for (int i = 0; i < other.size(); i++)
-        {
-            merged.pushBack(other.data[i]);
-        }
-		return merged;
+    size_t lowerBound(const T& key) const {
+        return partitionPoint([this, &key](const T& e) { return comp(e, key); });
     }
 
     /**
-     * @brief Returns a new array with all elements in reverse order.
+     * @brief Index of the first element greater than key (size() if there is none).
      *
-     * Does not modify the original array. Creates a copy and fills it
-     * by reading the original from back to front.
+     * Time Complexity  : O(log n) — plus a pending merge, if any
      *
-     * @return  A new DynamicArray with elements in reversed order.
+     * Example:
+     *   s = [10, 20, 20, 30]
+     *   s.upperBound(20)  ->  3
+     */
+    size_t upperBound(const T& key) const {
+        return partitionPoint([this, &key](const T& e) { return !comp(key, e); });
+    }
+
+    /**
+     * @brief The index range [first, second) of the elements equal to key.
      *
-     * Time Complexity  : O(n)
-     * Space Complexity : O(n) — due to the copy
+     * Time Complexity  : O(log n)
      *
      * Example:
-     *   arr = [1, 2, 3, 4]
-     *   arr.reverse()  ->  returns [4, 3, 2, 1], original unchanged
+     *   s = [10, 20, 20, 30]
+     *   s.equalRange(20)  ->  {1, 3}
+     *   s.equalRange(25)  ->  {3, 3}
      */
-    DynamicArray reverse() const
-    {
-		DynamicArray reversed(*this);
-
-        for(int i = 0; i < currentSize; i++)
-        {
-            reversed.data[i] = data[currentSize - i - 1];
-		}
-
-		return reversed;
+    std::pair<size_t, size_t> equalRange(const T& key) const {
+        return { lowerBound(key), upperBound(key) };
     }
 
     /**
-     * @brief Returns the maximum element in the array.
-     *
-     * Behavior depends on type T:
-     * - Numeric types (int, float, double, etc.): returns the largest value.
-     * - std::string: returns the longest string (by character count).
+     * @brief Checks whether an element equal to key exists.
      *
-     * @return  The maximum element of type T.
+     * Time Complexity  : O(log n)
+     */
+    bool contains(const T& key) const {
+        return tryFind(key).has_value();
+    }
+
+    /**
+     * @brief Index of the first element equal to key, or std::nullopt.
      *
-     * @throws std::runtime_error  If the array is empty.
+     * Time Complexity  : O(log n)
+     */
+    std::optional<size_t> tryFind(const T& key) const {
+        size_t index = lowerBound(key);
+        if (index == size() || comp(key, elements[index])) return std::nullopt;
+        return index;
+    }
+
+    /**
+     * @brief Merges two sorted arrays into a new sorted array in O(n + m).
      *
-     * Time Complexity  : O(n)
-     * Space Complexity : O(1)
+     * Unlike DynamicArray::merge(), the result is sorted: the two runs are
+     * interleaved in one pass, no re-sort needed. Neither original is modified.
+     * The result uses this array's ordering and search strategy.
      *
-     * Example (numeric):
-     *   arr = [3, 7, 1, 9, 2]
-     *   arr.max()  ->  returns 9
+     * Time Complexity  : O(n + m)
+     * Space Complexity : O(n + m)
      *
-     * Example (string):
-     *   arr = ["hi", "hello", "hey"]
-     *   arr.max()  ->  returns "hello"  (longest)
+     * Example:
+     *   a = [1, 4, 7],  b = [2, 3, 9]
+     *   a.merge(b)  ->  [1, 2, 3, 4, 7, 9]
      */
-    T max() const
-    {
-        if (isEmpty()) throw std::runtime_error("Array is empty");
-
-        T maxValue = data[0];
-
-        if constexpr (is_arithmetic<T>::value) 
-        {
-            for (int i = 1; i < currentSize; i++)
-            {
-                if(data[i] > maxValue)
-					maxValue = data[i];
-            }
-        }
-		else if constexpr (is_same<T, string>::value)
-        {
-            for (int i = 1; i < currentSize; i++)
-            {
-				if (data[i].length() > maxValue.length())
-					maxValue = data[i];
-            }
-        }
+    SortedDynamicArray merge(const SortedDynamicArray& other) const {
+        flush();
+        other.flush();
 
-        return maxValue;
+        SortedDynamicArray merged(comp, strategy, elements.getAllocator());
+        merged.elements = mergeRuns<false>(elements, other.elements);
+        return merged;
     }
 
     /**
-     * @brief Returns the minimum element in the array.
-     *
-     * Behavior depends on type T:
-     * - Numeric types (int, float, double, etc.): returns the smallest value.
-     * - std::string: returns the shortest string (by character count).
-     *
-     * @return  The minimum element of type T.
-     *
-     * @throws std::runtime_error  If the array is empty.
-     *
-     * Time Complexity  : O(n)
-     * Space Complexity : O(1)
+     * @brief Bounds-checked read access to the i-th smallest element.
      *
-     * Example (numeric):
-     *   arr = [3, 7, 1, 9, 2]
-     *   arr.min()  ->  returns 1
+     * @throws std::out_of_range  If index >= size().
+     */
+    const T& at(size_t index) const {
+        flush();
+        return elements.at(index);
+    }
+
+    /**
+     * @brief Unchecked read access to the i-th smallest element.
      *
-     * Example (string):
-     *   arr = ["hi", "hello", "hey"]
-     *   arr.min()  ->  returns "hi"  (shortest)
+     * No mutable access is offered — writing through it could break the order.
      */
-    T min() const
-    {
-        if (isEmpty()) throw std::runtime_error("Array is empty");
+    const T& operator[](size_t index) const {
+        flush();
+        return elements[index];
+    }
 
-        T minValue = data[0];
+    /**
+     * @brief The underlying sorted DynamicArray (pending inserts merged first).
+     */
+    const Array& sortedElements() const {
+        flush();
+        return elements;
+    }
 
-        if constexpr (is_arithmetic<T>::value)
-        {
-            for (int i = 1; i < currentSize; i++)
-            {
-                if (data[i] < minValue)
-                    minValue = data[i];
-            }
-        }
-        else if constexpr (is_same<T, string>::value)
-        {
-            for (int i = 1; i < currentSize; i++)
-            {
-                if (data[i].length() < minValue.length())
-                    minValue = data[i];
-            }
-        }
+    size_t size() const { return elements.size() + pending.size(); }
 
-        return minValue;
+    bool isEmpty() const { return size() == 0; }
+
+    void display() const {
+        flush();
+        elements.display();
     }
+};
+
+
+// ---------------------------------------------------------------
+// Helpers for the storage & allocator tests in main()
+// ---------------------------------------------------------------
+
+// No default constructor; counts how many instances are currently alive.
+struct Tracked {
+    static inline int alive = 0;
+    int value;
+
+    explicit Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& other) : value(other.value) { alive++; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { alive++; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { alive--; }
+};
+
+// Minimal allocator that forwards to operator new and counts allocations.
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    static inline int allocations = 0;
 
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
 
+    T* allocate(size_t n) {
+        allocations++;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p); }
+
+    bool operator==(const CountingAllocator&) const { return true; }
+    bool operator!=(const CountingAllocator&) const { return false; }
 };
 
 
@@ -724,6 +3725,17 @@ int main() {
         cout << "find(999) correctly threw: " << e.what() << endl;
     }
 
+    // ---------------------------------------------------------------
+    // Test tryFind & contains
+    // ---------------------------------------------------------------
+    cout << "\n=== TryFind & Contains ===" << endl;
+    std::optional<size_t> hit = arr.tryFind(99);
+    std::optional<size_t> miss = arr.tryFind(999);
+    cout << "tryFind(99)   -> Expected : 2       | Result : " << (hit ? to_string(*hit) : "nullopt") << endl;
+    cout << "tryFind(999)  -> Expected : nullopt | Result : " << (miss ? to_string(*miss) : "nullopt") << endl;
+    cout << "contains(40)  -> Expected : true    | Result : " << (arr.contains(40) ? "true" : "false") << endl;
+    cout << "contains(999) -> Expected : false   | Result : " << (arr.contains(999) ? "true" : "false") << endl;
+
     // ---------------------------------------------------------------
     // Test findAll
     // ---------------------------------------------------------------
@@ -739,6 +3751,17 @@ int main() {
     cout << "Result   : "; arr2.findAll(10).display();
     cout << "Expected : []" << endl;
     cout << "Result   : "; arr2.findAll(999).display();
+    cout << "Empty result capacity -> Expected : 0 | Result : " << arr2.findAll(999).getCapacity() << endl;
+
+    DynamicArray<size_t> reusedHits;
+    size_t hitCount = arr2.findAll(10, reusedHits);
+    cout << "Into output array -> Expected : 3 hits [0, 2, 4] | Result : " << hitCount << " hits "; reusedHits.display();
+    arr2.findAll(20, reusedHits);
+    cout << "Reused for 20     -> Expected : [1] | Result : "; reusedHits.display();
+
+    size_t callbackSum = 0;
+    arr2.findAll(10, [&callbackSum](size_t index) { callbackSum += index; });
+    cout << "Callback (sum of indices) -> Expected : 6 | Result : " << callbackSum << endl;
 
     // ---------------------------------------------------------------
     // Test sort
@@ -755,6 +3778,71 @@ int main() {
     cout << "Result   : "; unsorted.sort().display();
     cout << "Original unchanged: "; unsorted.display();
 
+    // ---------------------------------------------------------------
+    // Test sortInPlace (introsort, comparator, radix, parallel)
+    // ---------------------------------------------------------------
+    cout << "\n=== SortInPlace ===" << endl;
+    DynamicArray<string> names;
+    names.pushBack("pear"); names.pushBack("apple"); names.pushBack("fig"); names.pushBack("kiwi");
+    names.sortInPlace();
+    cout << "Expected : [apple, fig, kiwi, pear]" << endl;
+    cout << "Result   : "; names.display();
+    names.sortInPlace(std::greater<string>());
+    cout << "Expected : [pear, kiwi, fig, apple]" << endl;
+    cout << "Result   : "; names.display();
+
+    // Large inputs: pseudo-random values with negatives and duplicates.
+    auto makeNoise = [](int n) {
+        DynamicArray<int> noise(n);
+        unsigned state = 12345;
+        for (int i = 0; i < n; i++) {
+            state = state * 1103515245u + 12345u;
+            noise.pushBack(static_cast<int>(state >> 8) % 20001 - 10000);
+        }
+        return noise;
+    };
+    auto isSorted = [](DynamicArray<int>& values) {
+        for (size_t i = 1; i < values.size(); i++) {
+            if (values[i] < values[i - 1]) return false;
+        }
+        return true;
+    };
+
+    DynamicArray<int> radixInput = makeNoise(5000);
+    radixInput.sortInPlace();
+    cout << "Radix path, 5000 ints     -> Expected sorted : true | Result : " << (isSorted(radixInput) ? "true" : "false") << endl;
+
+    DynamicArray<int> introInput = makeNoise(5000);
+    introInput.sortInPlace([](int x, int y) { return x < y; });
+    cout << "Introsort path, 5000 ints -> Expected sorted : true | Result : " << (isSorted(introInput) ? "true" : "false") << endl;
+
+    DynamicArray<int> parallelInput = makeNoise(200000);
+    DynamicArray<int> parallelSorted = parallelInput.sort(ParallelExecution{4});
+    cout << "Parallel, 200000 ints     -> Expected sorted : true | Result : " << (isSorted(parallelSorted) ? "true" : "false")
+         << "  (size " << parallelSorted.size() << ")" << endl;
+
+    // ---------------------------------------------------------------
+    // Test vectorized find / findAll / max / min
+    // ---------------------------------------------------------------
+    cout << "\n=== SIMD Scans ===" << endl;
+    static const char* levelNames[] = { "Scalar", "SSE4.2", "AVX2", "NEON" };
+    cout << "Kernel level : " << levelNames[static_cast<int>(simdLevel())] << endl;
+
+    DynamicArray<int> telemetry;
+    for (int i = 0; i < 1000; i++) telemetry.pushBack(i % 100);
+    telemetry[517] = -5;
+    telemetry[999] = 5000;
+    cout << "find(-5)       -> Expected : 517 | Result : " << telemetry.find(-5) << endl;
+    cout << "findAll(42)    -> Expected : 10 hits, first 42, last 942 | Result : "
+         << telemetry.findAll(42).size() << " hits, first " << telemetry.findAll(42)[0]
+         << ", last " << telemetry.findAll(42)[9] << endl;
+    cout << "max / min      -> Expected : 5000 / -5 | Result : " << telemetry.max() << " / " << telemetry.min() << endl;
+
+    DynamicArray<double> readings;
+    for (int i = 0; i < 37; i++) readings.pushBack(i * 0.5);
+    cout << "double find(18) -> Expected : 36 | Result : " << readings.find(18.0) << endl;
+    cout << "double max/min  -> Expected : 18 / 0 | Result : " << readings.max() << " / " << readings.min() << endl;
+
     // ---------------------------------------------------------------
     // Test merge
     // ---------------------------------------------------------------
@@ -768,6 +3856,75 @@ int main() {
     cout << "Result   : "; a.merge(b).display();
     cout << "a unchanged: "; a.display();
 
+    // ---------------------------------------------------------------
+    // Test bulk & range operations
+    // ---------------------------------------------------------------
+    cout << "\n=== Bulk & Range Operations ===" << endl;
+    int batch[] = { 7, 8, 9 };
+    DynamicArray<int> bulk(3);
+    bulk.append(batch, 3);
+    cout << "append(batch, 3)        -> Expected : [7, 8, 9] | Result : "; bulk.display();
+    bulk.append(&bulk[0], bulk.size());
+    cout << "append(self)            -> Expected : [7, 8, 9, 7, 8, 9] | Result : "; bulk.display();
+
+    bulk.insertRange(1, batch, batch + 2);
+    cout << "insertRange(1, {7, 8})  -> Expected : [7, 7, 8, 8, 9, 7, 8, 9] | Result : "; bulk.display();
+    bulk.removeRange(1, 5);
+    cout << "removeRange(1, 5)       -> Expected : [7, 7, 8, 9] | Result : "; bulk.display();
+    bulk.removeRange(0, 2);
+    cout << "removeRange(0, 2)       -> Expected : [8, 9] | Result : "; bulk.display();
+
+    DynamicArray<int> merged = a;
+    merged.mergeInto(b);
+    cout << "mergeInto(b)            -> Expected : [1, 2, 3, 4, 5, 6] | Result : "; merged.display();
+
+    DynamicArray<string> guests, extra;
+    guests.pushBack("ann"); guests.pushBack("dan");
+    extra.pushBack("bob"); extra.pushBack("cat");
+    guests.insertRange(1, &extra[0], &extra[0] + extra.size());
+    cout << "insertRange (string)    -> Expected : [ann, bob, cat, dan] | Result : "; guests.display();
+    guests.mergeInto(std::move(extra));
+    cout << "mergeInto(move(extra))  -> Expected : [ann, bob, cat, dan, bob, cat] | Result : "; guests.display();
+    cout << "extra after move        -> Expected : 0 | Result : " << extra.size() << endl;
+
+    try {
+        bulk.removeRange(1, 5);
+    }
+    catch (const out_of_range& e) {
+        cout << "removeRange(1, 5) on size 2 correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test SortedDynamicArray
+    // ---------------------------------------------------------------
+    cout << "\n=== Sorted Array ===" << endl;
+    SortedDynamicArray<int> sortedIds;
+    int incoming[] = { 40, 10, 30, 20, 20 };
+    for (int id : incoming) sortedIds.insertSorted(id);
+    cout << "insertSorted x5 (merged lazily) -> Expected : [10, 20, 20, 30, 40] | Result : "; sortedIds.display();
+    sortedIds.insert(25);
+    cout << "insert(25)      -> Expected : [10, 20, 20, 25, 30, 40] | Result : "; sortedIds.display();
+    cout << "lowerBound(20)  -> Expected : 1 | Result : " << sortedIds.lowerBound(20) << endl;
+    cout << "upperBound(20)  -> Expected : 3 | Result : " << sortedIds.upperBound(20) << endl;
+    std::pair<size_t, size_t> range = sortedIds.equalRange(20);
+    cout << "equalRange(20)  -> Expected : {1, 3} | Result : {" << range.first << ", " << range.second << "}" << endl;
+    cout << "contains(30)    -> Expected : true  | Result : " << (sortedIds.contains(30) ? "true" : "false") << endl;
+    cout << "contains(35)    -> Expected : false | Result : " << (sortedIds.contains(35) ? "true" : "false") << endl;
+
+    const SortedSearch strategies[] = { SortedSearch::Binary, SortedSearch::Branchless, SortedSearch::Eytzinger };
+    const char* strategyNames[] = { "Binary", "Branchless", "Eytzinger" };
+    for (int i = 0; i < 3; i++) {
+        sortedIds.setSearchStrategy(strategies[i]);
+        cout << strategyNames[i] << " lowerBound(26) -> Expected : 4 | Result : " << sortedIds.lowerBound(26)
+             << ", upperBound(40) -> Expected : 6 | Result : " << sortedIds.upperBound(40) << endl;
+    }
+
+    SortedDynamicArray<int> otherIds;
+    otherIds.insertSorted(15); otherIds.insertSorted(35);
+    cout << "merge (sorted)  -> Expected : [10, 15, 20, 20, 25, 30, 35, 40] | Result : "; sortedIds.merge(otherIds).display();
+    sortedIds.remove(20);
+    cout << "remove(20)      -> Expected : [10, 20, 25, 30, 40] | Result : "; sortedIds.display();
+
     // ---------------------------------------------------------------
     // Test reverse
     // ---------------------------------------------------------------
@@ -782,6 +3939,30 @@ int main() {
     cout << "Result   : "; toReverse.reverse().display();
     cout << "Original unchanged: "; toReverse.display();
 
+    // ---------------------------------------------------------------
+    // Test iterators, data() and span views
+    // ---------------------------------------------------------------
+    cout << "\n=== Iterators & Span ===" << endl;
+    int iteratorSum = 0;
+    for (int value : toReverse) iteratorSum += value;
+    cout << "range-for sum      -> Expected : 10 | Result : " << iteratorSum << endl;
+
+    cout << "rbegin..rend       -> Expected : 4 3 2 1 | Result :";
+    for (auto it = toReverse.rbegin(); it != toReverse.rend(); ++it) cout << " " << *it;
+    cout << endl;
+
+    for (int& value : toReverse) value *= 10;
+    cout << "write through it   -> Expected : [10, 20, 30, 40] | Result : "; toReverse.display();
+
+    cout << "end() - begin()    -> Expected : 4 | Result : " << (toReverse.end() - toReverse.begin()) << endl;
+    cout << "data() == &arr[0]  -> Expected : true | Result : " << (toReverse.data() == &toReverse[0] ? "true" : "false") << endl;
+
+    Span<const int> view = toReverse.span();
+    Span<const int> middle = view.subspan(1, 2);
+    cout << "span size / bytes  -> Expected : 4 / 16 | Result : " << view.size() << " / " << view.size_bytes() << endl;
+    cout << "subspan(1, 2)      -> Expected : 20 30 | Result : " << middle[0] << " " << middle[1] << endl;
+    cout << "span aliases array -> Expected : true | Result : " << (view.data() == toReverse.data() ? "true" : "false") << endl;
+
     // ---------------------------------------------------------------
     // Test max & min (numeric)
     // ---------------------------------------------------------------
@@ -805,6 +3986,27 @@ int main() {
     cout << "Expected max (longest) : hello or howdy  |  Result : " << words.max() << endl;
     cout << "Expected min (shortest): hi              |  Result : " << words.min() << endl;
 
+    // ---------------------------------------------------------------
+    // Test move constructor, move assignment & emplaceBack
+    // ---------------------------------------------------------------
+    cout << "\n=== Move Semantics ===" << endl;
+    DynamicArray<string> source;
+    source.pushBack(string(32, 'x'));
+    source.emplaceBack(3, 'a');
+    string word = "moved";
+    source.pushBack(std::move(word));
+    cout << "Source   : "; source.display();
+    DynamicArray<string> stolen(std::move(source));
+    cout << "Expected : [" << string(32, 'x') << ", aaa, moved]" << endl;
+    cout << "Result   : "; stolen.display();
+    cout << "Moved-from source size : " << source.size() << " (expected 0)" << endl;
+    source.pushBack("reused");
+    cout << "Moved-from source reused : "; source.display();
+    DynamicArray<string> assigned;
+    assigned = stolen.reverse();
+    cout << "Expected : [moved, aaa, " << string(32, 'x') << "]" << endl;
+    cout << "Result   : "; assigned.display();
+
     // ---------------------------------------------------------------
     // Test clear
     // ---------------------------------------------------------------
@@ -816,6 +4018,146 @@ int main() {
     cout << "After clear  : "; toClear.display();
     cout << "isEmpty      : " << (toClear.isEmpty() ? "true" : "false") << endl;
     cout << "size         : " << toClear.size() << endl;
+    cout << "capacity kept: " << toClear.getCapacity() << " (expected 5)" << endl;
+
+    // ---------------------------------------------------------------
+    // Test raw storage & custom allocator
+    // ---------------------------------------------------------------
+    cout << "\n=== Raw Storage & Allocator ===" << endl;
+    {
+        DynamicArray<Tracked> tracked(100);
+        cout << "Alive after reserving 100 slots : " << Tracked::alive << " (expected 0)" << endl;
+        tracked.emplaceBack(1);
+        tracked.emplaceBack(2);
+        tracked.pushBack(Tracked(3));
+        cout << "Alive after 3 inserts           : " << Tracked::alive << " (expected 3)" << endl;
+        tracked.removeAt(0);
+        tracked.popBack();
+        cout << "Alive after 2 removals          : " << Tracked::alive << " (expected 1)" << endl;
+        tracked.clear();
+        cout << "Alive after clear               : " << Tracked::alive << " (expected 0)" << endl;
+    }
+
+    DynamicArray<int, CountingAllocator<int>> counted;
+    for (int i = 0; i < 5; i++) counted.pushBack(i);
+    for (int round = 0; round < 3; round++) {
+        counted.clear();
+        for (int i = 0; i < 5; i++) counted.pushBack(i);
+    }
+    cout << "Allocations for 4 fill/clear rounds : " << CountingAllocator<int>::allocations << " (expected 1)" << endl;
+    cout << "Result   : "; counted.display();
+
+    // ---------------------------------------------------------------
+    // Test small-buffer arrays (inline capacity)
+    // ---------------------------------------------------------------
+    cout << "\n=== Small Buffer (SmallDynamicArray) ===" << endl;
+    {
+        int before = CountingAllocator<int>::allocations;
+        SmallDynamicArray<int, 16, CountingAllocator<int>> small;
+        for (int i = 0; i < 16; i++) small.pushBack(i);
+        cout << "16 pushBacks, inline 16 -> Expected : 0 allocations | Result : "
+             << CountingAllocator<int>::allocations - before << " allocations, capacity " << small.getCapacity() << endl;
+        small.pushBack(16);
+        cout << "17th pushBack spills    -> Expected : 1 allocation  | Result : "
+             << CountingAllocator<int>::allocations - before << " allocation, capacity " << small.getCapacity() << endl;
+        while (small.size() > 4) small.popBack();
+        small.shrinkToFit();
+        cout << "shrinkToFit at size 4   -> Expected : capacity 16 (back inline) | Result : capacity " << small.getCapacity() << endl;
+        cout << "Result   : "; small.display();
+
+        SmallDynamicArray<string, 4> words;
+        words.pushBack("alpha"); words.pushBack("beta");
+        SmallDynamicArray<string, 4> movedWords(std::move(words));
+        cout << "Move of inline array    -> Expected : [alpha, beta], source size 0 | Result : ";
+        cout << "[" << movedWords[0] << ", " << movedWords[1] << "], source size " << words.size() << endl;
+
+        DynamicArray<int> haystack;
+        for (int i = 0; i < 50; i++) haystack.pushBack(i % 10);
+        SmallDynamicArray<size_t, 16, CountingAllocator<size_t>> hits;
+        int hitAllocations = CountingAllocator<size_t>::allocations;
+        haystack.findAll(7, hits);
+        cout << "findAll into inline out -> Expected : 5 hits, 0 allocations | Result : " << hits.size() << " hits, "
+             << CountingAllocator<size_t>::allocations - hitAllocations << " allocations" << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test O(1) front operations (front room)
+    // ---------------------------------------------------------------
+    cout << "\n=== Front Room (push / pop) ===" << endl;
+    DynamicArray<int, CountingAllocator<int>> window;
+    int windowAllocations = CountingAllocator<int>::allocations;
+    for (int i = 0; i < 100000; i++) {
+        window.pushBack(i);
+        if (window.size() > 8) window.pop();   // sliding window of 8 elements
+    }
+    cout << "Sliding window -> Expected : [99992, 99993, 99994, 99995, 99996, 99997, 99998, 99999]" << endl;
+    cout << "Result         -> "; window.display();
+    cout << "Allocations for 100000 slides -> Expected : 2 | Result : "
+         << CountingAllocator<int>::allocations - windowAllocations << endl;
+
+    DynamicArray<int> frontHeavy;
+    for (int i = 1; i <= 6; i++) frontHeavy.push(i);
+    frontHeavy.insert(1, 99);    // front half: shifts the prefix left
+    frontHeavy.insert(6, 77);    // back half: shifts the suffix right
+    frontHeavy.removeAt(2);      // front half: shifts the prefix right
+    cout << "Expected : [6, 99, 4, 3, 2, 77, 1]" << endl;
+    cout << "Result   : "; frontHeavy.display();
+
+    // ---------------------------------------------------------------
+    // Test growth policies, reserve & shrinkToFit
+    // ---------------------------------------------------------------
+    cout << "\n=== Growth Policy, Reserve & ShrinkToFit ===" << endl;
+    DynamicArray<int, std::allocator<int>, OneAndHalfGrowth> oneAndHalf(4);
+    for (int i = 0; i < 5; i++) oneAndHalf.pushBack(i);
+    cout << "1.5x growth from 4  -> Expected capacity : 6  | Result : " << oneAndHalf.getCapacity() << endl;
+
+    DynamicArray<int, std::allocator<int>, FixedChunkGrowth<16>> chunked(4);
+    for (int i = 0; i < 5; i++) chunked.pushBack(i);
+    cout << "+16 growth from 4   -> Expected capacity : 20 | Result : " << chunked.getCapacity() << endl;
+
+    DynamicArray<int, CountingAllocator<int>> reserved;
+    int allocationsBefore = CountingAllocator<int>::allocations;
+    reserved.reserve(1000);
+    for (int i = 0; i < 1000; i++) reserved.pushBack(i);
+    cout << "reserve(1000) + 1000 pushBack -> Expected allocations : 1 | Result : "
+         << CountingAllocator<int>::allocations - allocationsBefore << endl;
+
+    reserved.removeAt(999);
+    reserved.shrinkToFit();
+    cout << "shrinkToFit -> Expected capacity : 999 | Result : " << reserved.getCapacity() << endl;
+
+    DynamicArray<int, ReallocAllocator<int>> reallocated;
+    for (int i = 0; i < 100000; i++) reallocated.pushBack(i);
+    reallocated.shrinkToFit();
+    cout << "realloc path -> Expected [99999] = 99999, capacity 100000 | Result : "
+         << reallocated[99999] << ", capacity " << reallocated.getCapacity() << endl;
+
+    // ---------------------------------------------------------------
+    // Test instrumentation (every counter is 0 unless built with -DDS_INSTRUMENT)
+    // ---------------------------------------------------------------
+    const bool instrumented = DS_DYNAMIC_ARRAYS_INSTRUMENT != 0;
+    cout << "\n=== Instrumentation (DS_INSTRUMENT " << (instrumented ? "on" : "off") << ") ===" << endl;
+    AllocationTracker::reset();
+    size_t liveBefore = AllocationTracker::snapshot().liveBytes;   // the arrays of the tests above
+    {
+        DynamicArray<int> measured(1);
+        for (int i = 1; i <= 8; i++) measured.pushBack(i);
+        DynamicArrayStats grown = measured.stats();
+        cout << "pushBack 1..8 from capacity 1 -> Expected : " << (instrumented ? 3 : 0) << " reallocations, "
+             << (instrumented ? 7 : 0) << " moved | Result : " << grown.reallocations << " reallocations, "
+             << grown.elementsMoved << " moved" << endl;
+
+        measured.removeAt(4);
+        DynamicArrayStats shifted = measured.stats();
+        cout << "removeAt(4) of 8              -> Expected : " << (instrumented ? 3 : 0) << " shifted, "
+             << (instrumented ? 40 : 0) << " bytes copied | Result : " << shifted.elementsShifted << " shifted, "
+             << shifted.bytesCopied << " bytes copied" << endl;
+    }
+    AllocationCounts heap = AllocationTracker::snapshot();
+    cout << "Heap after the array is gone  -> Expected : " << (instrumented ? 4 : 0) << " allocations, "
+         << (instrumented ? 4 : 0) << " frees, peak +" << (instrumented ? 48 : 0) << " bytes, live +0 | Result : "
+         << heap.allocations << " allocations, " << heap.deallocations << " frees, peak +"
+         << heap.peakBytes - liveBefore << " bytes, live +" << heap.liveBytes - liveBefore << endl;
 
     // ---------------------------------------------------------------
     // Test size and capacity
@@ -1,20 +1,1776 @@
-// Linear-DS-Linked-Lists.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
-
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/**
+* **LINKED LISTS WITHOUT ONE `new` PER NODE**
+*
+* A textbook linked list calls `new Node` for every element. Each node ends up
+* wherever the heap put it, every traversal step is a likely cache miss, and on
+* a 64-bit machine a doubly linked node spends 16 bytes on its two pointers.
+*
+* The lists in this file keep the same logic (head, tail, next/prev links) but
+* store their nodes in a NodePool:
+*
+* * Nodes live in slabs of 256 slots. Nodes created one after another sit side by side.
+* * Links are 32-bit slot indices instead of pointers (8 bytes for next + prev, not 16).
+* * Erased nodes go onto a free list and their slots are reused by the next insert.
+* * Several lists can share one pool, so moving nodes between them (splice) is O(1).
+*
+*   Pool slots:   [0: 10 | next 1] [1: 20 | next 3] [2: free | next -] [3: 30 | next -]
+*   List:         head = 0  ->  0 -> 1 -> 3
+*
+* A node handle (NodeIndex) stays valid until that node is erased, however much
+* the pool grows, because slabs are never moved.
+*
+* For traversal-heavy workloads, UnrolledLinkedList stores up to
+* BlockCapacity elements per node. A scan then touches one node per block
+* instead of one node per element.
+*
+* IntrusiveList goes one step further: the links live inside the user's own
+* object, so there is no separate node at all, and an object found through
+* another structure (a hash table, say) can be unlinked or moved in O(1).
+*/
+
+// ***************  NODE POOL  ****************
+
+// A node handle: the index of the node's slot in its pool.
+using NodeIndex = uint32_t;
+
+// The "null pointer" of index links.
+constexpr NodeIndex nullNode = UINT32_MAX;
+
+// Link fields stored in front of each payload. The free list reuses `next`.
+struct SinglyLinks {
+    NodeIndex next = nullNode;
+};
+
+struct DoublyLinks {
+    NodeIndex next = nullNode;
+    NodeIndex prev = nullNode;
+};
+
+constexpr size_t log2Exact(size_t n) {
+    return n <= 1 ? 0 : 1 + log2Exact(n / 2);
+}
+
+/**
+* @brief A slab allocator for list nodes, addressed by 32-bit indices.
+*
+* Memory is requested in slabs of SlabSize slots. A slab is never moved or freed
+* before the pool itself, so node handles and references to payloads stay valid
+* while the pool grows. Erased slots form a free list through their `next` link,
+* so create() after destroy() allocates nothing.
+*
+* The pool only allocates and constructs. The lists that use it destroy their
+* own payloads (in clear() and their destructors), so a shared pool must outlive
+* every list built on it.
+*
+* Time Complexity  : create / destroy / value O(1)
+*
+* @tparam Payload   The value stored in each node.
+* @tparam Links     SinglyLinks or DoublyLinks.
+* @tparam SlabSize  Slots per slab (a power of two).
+*/
+template <typename Payload, typename Links, size_t SlabSize = 256>
+class NodePool {
+    static_assert(SlabSize > 0 && (SlabSize & (SlabSize - 1)) == 0, "SlabSize must be a power of two");
+
+    struct Slot {
+        Links links;
+        alignas(Payload) unsigned char bytes[sizeof(Payload)];
+    };
+
+    static constexpr size_t slabShift = log2Exact(SlabSize);
+
+    Slot** slabs = nullptr;
+    size_t slabCount = 0;
+    size_t slabTableCapacity = 0;
+    NodeIndex highWater = 0;        // slots [0, highWater) have been handed out at least once
+    NodeIndex freeHead = nullNode;
+    size_t live = 0;
+
+    Slot& slot(NodeIndex index) { return slabs[index >> slabShift][index & (SlabSize - 1)]; }
+    const Slot& slot(NodeIndex index) const { return slabs[index >> slabShift][index & (SlabSize - 1)]; }
+
+    void addSlab() {
+        if (slabCount == slabTableCapacity) {
+            size_t newCapacity = slabTableCapacity == 0 ? 4 : slabTableCapacity * 2;
+            Slot** table = new Slot*[newCapacity];
+            if (slabCount > 0) std::memcpy(table, slabs, slabCount * sizeof(Slot*));
+            delete[] slabs;
+            slabs = table;
+            slabTableCapacity = newCapacity;
+        }
+        slabs[slabCount] = std::allocator<Slot>().allocate(SlabSize);
+        slabCount++;
+    }
+
+    void releaseSlabs() {
+        for (size_t i = 0; i < slabCount; i++) {
+            std::allocator<Slot>().deallocate(slabs[i], SlabSize);
+        }
+        delete[] slabs;
+        slabs = nullptr;
+        slabCount = slabTableCapacity = 0;
+        highWater = 0;
+        freeHead = nullNode;
+        live = 0;
+    }
+
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept
+        : slabs(other.slabs), slabCount(other.slabCount), slabTableCapacity(other.slabTableCapacity),
+          highWater(other.highWater), freeHead(other.freeHead), live(other.live) {
+        other.slabs = nullptr;
+        other.slabCount = other.slabTableCapacity = 0;
+        other.highWater = 0;
+        other.freeHead = nullNode;
+        other.live = 0;
+    }
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            releaseSlabs();
+            std::swap(slabs, other.slabs);
+            std::swap(slabCount, other.slabCount);
+            std::swap(slabTableCapacity, other.slabTableCapacity);
+            std::swap(highWater, other.highWater);
+            std::swap(freeHead, other.freeHead);
+            std::swap(live, other.live);
+        }
+        return *this;
+    }
+
+    ~NodePool() { releaseSlabs(); }
+
+    /**
+     * @brief Constructs a payload in a free slot and returns its handle.
+     *
+     * Reuses the most recently freed slot if there is one, otherwise takes the
+     * next untouched slot (adding a slab when the current ones are used up).
+     * The new node's links are reset. If the payload constructor throws, the
+     * pool is left unchanged.
+     *
+     * Time Complexity : O(1) (amortized when a slab is added)
+     *
+     * @throws length_error if all 2^32 - 1 indices are in use.
+     */
+    template <typename... Args>
+    NodeIndex create(Args&&... args) {
+        bool fromFreeList = freeHead != nullNode;
+        NodeIndex index = freeHead;
+        if (!fromFreeList) {
+            if (highWater == nullNode) throw length_error("NodePool is full");
+            if ((static_cast<size_t>(highWater) >> slabShift) >= slabCount) addSlab();
+            index = highWater;
+        }
+
+        Slot& s = slot(index);
+        ::new (static_cast<void*>(s.bytes)) Payload(std::forward<Args>(args)...);
+
+        if (fromFreeList) freeHead = s.links.next;
+        else highWater++;
+        s.links = Links{};
+        live++;
+        return index;
+    }
+
+    /**
+     * @brief Destroys the payload of a node and puts its slot on the free list.
+     *
+     * Time Complexity : O(1)
+     */
+    void destroy(NodeIndex index) {
+        Slot& s = slot(index);
+        std::launder(reinterpret_cast<Payload*>(s.bytes))->~Payload();
+        s.links.next = freeHead;
+        freeHead = index;
+        live--;
+    }
+
+    Payload& value(NodeIndex index) { return *std::launder(reinterpret_cast<Payload*>(slot(index).bytes)); }
+    const Payload& value(NodeIndex index) const { return *std::launder(reinterpret_cast<const Payload*>(slot(index).bytes)); }
+
+    Links& links(NodeIndex index) { return slot(index).links; }
+    const Links& links(NodeIndex index) const { return slot(index).links; }
+
+    // Adds slabs until at least n slots exist, so the next n creates never allocate.
+    void reserve(size_t n) {
+        while (capacity() < n) addSlab();
+    }
+
+    size_t size() const { return live; }
+    size_t capacity() const { return slabCount * SlabSize; }
+    size_t slabsAllocated() const { return slabCount; }
+};
+
+// ***************  LIST ITERATOR  ****************
+
+/**
+* @brief Forward iterator over the nodes of a pooled list.
+*
+* Counts down the remaining elements instead of looking for nullNode, so the
+* same iterator walks singly, doubly and circular lists (whose tail links back
+* to the head). handle() returns the current node, for insertAfter()/erase().
+*/
+template <typename Pool, typename T>
+class ListIterator {
+    Pool* pool = nullptr;
+    NodeIndex node = nullNode;
+    size_t remaining = 0;
+
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = remove_const_t<T>;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    ListIterator() = default;
+    ListIterator(Pool* pool, NodeIndex node, size_t remaining) : pool(pool), node(node), remaining(remaining) {}
+
+    reference operator*() const { return pool->value(node); }
+    pointer operator->() const { return &pool->value(node); }
+
+    ListIterator& operator++() {
+        node = pool->links(node).next;
+        remaining--;
+        return *this;
+    }
+
+    ListIterator operator++(int) {
+        ListIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const ListIterator& other) const { return remaining == other.remaining; }
+    bool operator!=(const ListIterator& other) const { return remaining != other.remaining; }
+
+    NodeIndex handle() const { return node; }
+};
+
+// ***************  POOLED LIST BASE  ****************
+
+/**
+* @brief State and operations shared by the singly, doubly and circular lists.
+*
+* Holds head, tail and element count, plus the pool the nodes live in. By default
+* each list owns a private pool. A list constructed from a NodePool& uses that pool
+* instead, so lists sharing it can splice nodes between each other.
+*
+* @tparam T         The element type.
+* @tparam Links     SinglyLinks or DoublyLinks.
+* @tparam Circular  Whether the tail links back to the head.
+*/
+template <typename T, typename Links, bool Circular>
+class PooledListBase {
+public:
+    using Pool = NodePool<T, Links>;
+    using iterator = ListIterator<Pool, T>;
+    using const_iterator = ListIterator<const Pool, const T>;
+
+protected:
+    static constexpr bool hasPrev = is_same<Links, DoublyLinks>::value;
+
+    unique_ptr<Pool> ownedPool;
+    Pool* pool = nullptr;
+    NodeIndex head = nullNode;
+    NodeIndex tail = nullNode;
+    size_t count = 0;
+
+    // The pool, created on first use by a default-constructed or moved-from list.
+    Pool& nodes() {
+        if (!pool) {
+            ownedPool = make_unique<Pool>();
+            pool = ownedPool.get();
+        }
+        return *pool;
+    }
+
+    Links& linksOf(NodeIndex node) { return pool->links(node); }
+
+    // Links a fresh node in front of the head.
+    void linkFront(NodeIndex node) {
+        if (count == 0) {
+            head = tail = node;
+        }
+        else {
+            linksOf(node).next = head;
+            if constexpr (hasPrev) linksOf(head).prev = node;
+            head = node;
+        }
+        if constexpr (Circular) linksOf(tail).next = head;
+        count++;
+    }
+
+    // Links a fresh node after the tail.
+    void linkBack(NodeIndex node) {
+        if (count == 0) {
+            head = tail = node;
+        }
+        else {
+            linksOf(tail).next = node;
+            if constexpr (hasPrev) linksOf(node).prev = tail;
+            tail = node;
+        }
+        if constexpr (Circular) linksOf(tail).next = head;
+        count++;
+    }
+
+    // Links a fresh node after `position` (which must be in this list).
+    void linkAfter(NodeIndex position, NodeIndex node) {
+        if (position == tail) {
+            linkBack(node);
+            return;
+        }
+        NodeIndex next = linksOf(position).next;
+        linksOf(node).next = next;
+        linksOf(position).next = node;
+        if constexpr (hasPrev) {
+            linksOf(node).prev = position;
+            linksOf(next).prev = node;
+        }
+        count++;
+    }
+
+    // Removes the node after `position` from the chain and returns it (not destroyed).
+    NodeIndex unlinkAfter(NodeIndex position) {
+        NodeIndex node = linksOf(position).next;
+        NodeIndex next = linksOf(node).next;
+        linksOf(position).next = next;
+        if constexpr (hasPrev) {
+            if (node != tail) linksOf(next).prev = position;
+        }
+        if (node == tail) tail = position;
+        if (node == head) head = next;   // circular, erasing after the tail
+        count--;
+        return node;
+    }
+
+    void copyFrom(const PooledListBase& other) {
+        for (const T& value : other) {
+            NodeIndex node = nodes().create(value);
+            linkBack(node);
+        }
+    }
+
+    void takeFrom(PooledListBase& other) noexcept {
+        ownedPool = std::move(other.ownedPool);
+        pool = other.pool;
+        head = other.head;
+        tail = other.tail;
+        count = other.count;
+        other.pool = nullptr;
+        other.head = other.tail = nullNode;
+        other.count = 0;
+    }
+
+    void checkNotEmpty() const {
+        if (count == 0) throw std::runtime_error("List is empty");
+    }
+
+public:
+    /**
+     * @brief Creates an empty list with its own node pool.
+     *
+     * Time Complexity  : O(1) (no nodes are allocated until the first insert)
+     */
+    PooledListBase() = default;
+
+    /**
+     * @brief Creates an empty list whose nodes come from `shared`.
+     *
+     * Lists that share a pool can splice nodes between each other in O(1).
+     * The pool must outlive the list.
+     */
+    explicit PooledListBase(Pool& shared) : pool(&shared) {}
+
+    // A copy uses the same shared pool as `other`, or a new private pool if `other` owns its own.
+    PooledListBase(const PooledListBase& other) : pool(other.ownedPool ? nullptr : other.pool) {
+        copyFrom(other);
+    }
+
+    PooledListBase(PooledListBase&& other) noexcept { takeFrom(other); }
+
+    PooledListBase& operator=(const PooledListBase& other) {
+        if (this != &other) {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    PooledListBase& operator=(PooledListBase&& other) noexcept {
+        if (this != &other) {
+            clear();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~PooledListBase() { clear(); }
+
+    /**
+     * @brief Inserts a value at the front of the list.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [20, 30]
+     *   list.pushFront(10)  ->  [10, 20, 30]
+     */
+    NodeIndex pushFront(const T& value) {
+        NodeIndex node = nodes().create(value);
+        linkFront(node);
+        return node;
+    }
+
+    NodeIndex pushFront(T&& value) {
+        NodeIndex node = nodes().create(std::move(value));
+        linkFront(node);
+        return node;
+    }
+
+    /**
+     * @brief Appends a value at the end of the list and returns its handle.
+     *
+     * O(1) thanks to the tail index; the node comes from the pool's free list
+     * or the current slab, not from a separate heap allocation.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [10, 20]
+     *   list.pushBack(30)  ->  [10, 20, 30]
+     */
+    NodeIndex pushBack(const T& value) {
+        NodeIndex node = nodes().create(value);
+        linkBack(node);
+        return node;
+    }
+
+    NodeIndex pushBack(T&& value) {
+        NodeIndex node = nodes().create(std::move(value));
+        linkBack(node);
+        return node;
+    }
+
+    template <typename... Args>
+    NodeIndex emplaceBack(Args&&... args) {
+        NodeIndex node = nodes().create(std::forward<Args>(args)...);
+        linkBack(node);
+        return node;
+    }
+
+    /**
+     * @brief Inserts a value right after the node `position` and returns its handle.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [10, 30], h = handle of 10
+     *   list.insertAfter(h, 20)  ->  [10, 20, 30]
+     */
+    NodeIndex insertAfter(NodeIndex position, const T& value) {
+        NodeIndex node = nodes().create(value);
+        linkAfter(position, node);
+        return node;
+    }
+
+    /**
+     * @brief Removes the first element. Its slot returns to the pool's free list.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the list is empty.
+     */
+    void popFront() {
+        checkNotEmpty();
+        NodeIndex node = head;
+        if (count == 1) {
+            head = tail = nullNode;
+            count = 0;
+        }
+        else {
+            head = linksOf(node).next;
+            if constexpr (hasPrev) linksOf(head).prev = nullNode;
+            if constexpr (Circular) linksOf(tail).next = head;
+            count--;
+        }
+        pool->destroy(node);
+    }
+
+    /**
+     * @brief Removes the node after `position`.
+     *
+     * In a circular list, erasing after the tail removes the head.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws out_of_range if `position` has no successor.
+     */
+    void eraseAfter(NodeIndex position) {
+        if (count == 0 || (!Circular && position == tail) || (Circular && count == 1)) {
+            throw out_of_range("No node after the given position");
+        }
+        pool->destroy(unlinkAfter(position));
+    }
+
+    /**
+     * @brief Returns the handle of the first node holding `value`, or nullNode.
+     *
+     * Time Complexity  : O(n)
+     */
+    NodeIndex find(const T& value) const {
+        for (const_iterator it = begin(); it != end(); ++it) {
+            if (*it == value) return it.handle();
+        }
+        return nullNode;
+    }
+
+    bool contains(const T& value) const { return find(value) != nullNode; }
+
+    // Access to the value of a node by handle. O(1).
+    T& value(NodeIndex node) { return pool->value(node); }
+    const T& value(NodeIndex node) const { return pool->value(node); }
+
+    T& front() { checkNotEmpty(); return pool->value(head); }
+    const T& front() const { checkNotEmpty(); return pool->value(head); }
+    T& back() { checkNotEmpty(); return pool->value(tail); }
+    const T& back() const { checkNotEmpty(); return pool->value(tail); }
+
+    NodeIndex headNode() const { return head; }
+    NodeIndex tailNode() const { return tail; }
+
+    /**
+     * @brief Destroys all elements and returns their slots to the pool.
+     *
+     * Slabs are kept, so refilling the list allocates nothing.
+     *
+     * Time Complexity  : O(n)
+     */
+    void clear() {
+        NodeIndex node = head;
+        for (size_t i = 0; i < count; i++) {
+            NodeIndex next = linksOf(node).next;
+            pool->destroy(node);
+            node = next;
+        }
+        head = tail = nullNode;
+        count = 0;
+    }
+
+    iterator begin() { return iterator(pool, head, count); }
+    iterator end() { return iterator(pool, nullNode, 0); }
+    const_iterator begin() const { return const_iterator(pool, head, count); }
+    const_iterator end() const { return const_iterator(pool, nullNode, 0); }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    // True if both lists draw nodes from the same pool (so splicing between them is O(1)).
+    bool sharesPoolWith(const PooledListBase& other) const { return pool != nullptr && pool == other.pool; }
+
+    void display() const {
+        cout << "[";
+        bool first = true;
+        for (const T& value : *this) {
+            if (!first) cout << ", ";
+            cout << value;
+            first = false;
+        }
+        cout << "]" << endl;
+    }
+};
+
+// ***************  SINGLY LINKED LIST  ****************
+
+/**
+* @brief A singly linked list whose nodes live in a NodePool.
+*
+*   [10 | •]──▶[20 | •]──▶[30 | •]──▶[40 | null]
+*
+* Each node costs sizeof(T) + 4 bytes (one 32-bit index) instead of
+* sizeof(T) + 8 for a next pointer, plus no per-node heap header.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class SinglyLinkedList : public PooledListBase<T, SinglyLinks, false> {
+    using Base = PooledListBase<T, SinglyLinks, false>;
+
+public:
+    using Base::Base;
+
+    /**
+     * @brief Reverses the list in place by re-pointing every `next` link.
+     *
+     * Time Complexity  : O(n)
+     * Space Complexity : O(1)
+     *
+     * Example:
+     *   list = [10, 20, 30]
+     *   list.reverse()  ->  [30, 20, 10]
+     */
+    void reverse() {
+        NodeIndex previous = nullNode;
+        NodeIndex node = this->head;
+        while (node != nullNode) {
+            NodeIndex next = this->linksOf(node).next;
+            this->linksOf(node).next = previous;
+            previous = node;
+            node = next;
+        }
+        std::swap(this->head, this->tail);
+    }
+};
+
+// ***************  DOUBLY LINKED LIST  ****************
+
+/**
+* @brief A doubly linked list whose nodes live in a NodePool.
+*
+*   null◀─[• | 10 | •]⟷[• | 20 | •]⟷[• | 30 | •]──▶null
+*
+* The two links are 32-bit indices: 8 bytes per node instead of 16. With the
+* node handle returned by every insert, erase() and splice() are O(1) with no
+* traversal. Lists constructed from the same NodePool can splice nodes
+* between each other, since a handle means the same slot in both.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class DoublyLinkedList : public PooledListBase<T, DoublyLinks, false> {
+    using Base = PooledListBase<T, DoublyLinks, false>;
+
+    // Detaches `node` from this list without destroying it.
+    void unlink(NodeIndex node) {
+        DoublyLinks& links = this->linksOf(node);
+        if (links.prev != nullNode) this->linksOf(links.prev).next = links.next;
+        else this->head = links.next;
+        if (links.next != nullNode) this->linksOf(links.next).prev = links.prev;
+        else this->tail = links.prev;
+        links.next = links.prev = nullNode;
+        this->count--;
+    }
+
+    // Links a detached `node` in front of `position` (nullNode = at the end).
+    void linkBefore(NodeIndex position, NodeIndex node) {
+        if (position == nullNode) {
+            this->linkBack(node);
+        }
+        else if (position == this->head) {
+            this->linkFront(node);
+        }
+        else {
+            this->linkAfter(this->linksOf(position).prev, node);
+        }
+    }
+
+public:
+    using Base::Base;
+
+    /**
+     * @brief Removes the last element.
+     *
+     * Time Complexity  : O(1) (the tail's prev link finds the new tail)
+     *
+     * @throws runtime_error if the list is empty.
+     */
+    void popBack() {
+        this->checkNotEmpty();
+        NodeIndex node = this->tail;
+        unlink(node);
+        this->pool->destroy(node);
+    }
+
+    /**
+     * @brief Inserts a value in front of the node `position` (nullNode appends).
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [10, 30], h = handle of 30
+     *   list.insertBefore(h, 20)  ->  [10, 20, 30]
+     */
+    NodeIndex insertBefore(NodeIndex position, const T& value) {
+        NodeIndex node = this->nodes().create(value);
+        linkBefore(position, node);
+        return node;
+    }
+
+    /**
+     * @brief Removes the node `node` by handle.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [10, 20, 30], h = handle of 20
+     *   list.erase(h)  ->  [10, 30]
+     */
+    void erase(NodeIndex node) {
+        unlink(node);
+        this->pool->destroy(node);
+    }
+
+    /**
+     * @brief Moves node `node` of `other` in front of `position` in this list.
+     *
+     * Nothing is copied or allocated, only links change; the
+     * handle stays valid and now belongs to this list. `other` may be *this
+     * (e.g. splice(headNode(), *this, h) moves h to the front).
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if the lists do not share a node pool.
+     */
+    void splice(NodeIndex position, DoublyLinkedList& other, NodeIndex node) {
+        if (&other != this && !this->sharesPoolWith(other)) {
+            throw invalid_argument("Lists do not share a node pool");
+        }
+        if (node == position) return;
+        other.unlink(node);
+        linkBefore(position, node);
+    }
+
+    /**
+     * @brief Moves every node of `other` in front of `position`, leaving `other` empty.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   a = [1, 4], b = [2, 3] (same pool), h = handle of 4
+     *   a.splice(h, b)  ->  a = [1, 2, 3, 4], b = []
+     *
+     * @throws invalid_argument if the lists do not share a node pool.
+     */
+    void splice(NodeIndex position, DoublyLinkedList& other) {
+        if (&other == this || other.count == 0) return;
+        if (!this->sharesPoolWith(other)) throw invalid_argument("Lists do not share a node pool");
+
+        NodeIndex first = other.head;
+        NodeIndex last = other.tail;
+        NodeIndex before = (position == nullNode) ? this->tail : this->linksOf(position).prev;
+
+        this->linksOf(first).prev = before;
+        this->linksOf(last).next = position;
+        if (before == nullNode) this->head = first;
+        else this->linksOf(before).next = first;
+        if (position == nullNode) this->tail = last;
+        else this->linksOf(position).prev = last;
+
+        this->count += other.count;
+        other.head = other.tail = nullNode;
+        other.count = 0;
+    }
+};
+
+// ***************  CIRCULAR LINKED LIST  ****************
+
+/**
+* @brief A singly linked circular list whose nodes live in a NodePool.
+*
+*   [10 | •]──▶[20 | •]──▶[30 | •]──▶(back to 10)
+*
+* The tail's next link is the head, so rotate() advances the ring in O(1),
+* which is all a round-robin scheduler needs.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class CircularLinkedList : public PooledListBase<T, SinglyLinks, true> {
+    using Base = PooledListBase<T, SinglyLinks, true>;
+
+public:
+    using Base::Base;
+
+    /**
+     * @brief Moves the head to the next node: the old head becomes the tail.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   ring = [10, 20, 30]
+     *   ring.rotate()  ->  [20, 30, 10]
+     */
+    void rotate() {
+        if (this->count < 2) return;
+        this->tail = this->head;
+        this->head = this->linksOf(this->head).next;
+    }
+};
+
+// ***************  INTRUSIVE LINKED LIST  ****************
+
+/**
+* @brief The link fields an object carries to be a member of an IntrusiveList.
+*
+* Derive from it (once per list the object may be in, each with its own Tag):
+*
+*   struct Page : IntrusiveListHook<> { int id; ... };
+*
+* A copied object starts out unlinked; the links describe a position in a
+* list, not a part of the value.
+*
+* @tparam Tag  Distinguishes several hooks in one class.
+*/
+template <typename Tag = void>
+struct IntrusiveListHook {
+    IntrusiveListHook* next = nullptr;
+    IntrusiveListHook* prev = nullptr;
+
+    IntrusiveListHook() = default;
+    IntrusiveListHook(const IntrusiveListHook&) {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+    bool isLinked() const { return next != nullptr; }
+};
+
+/**
+* @brief A doubly linked list of objects that carry their own links.
+*
+*   sentinel ⟷ [Page 7 | hook] ⟷ [Page 3 | hook] ⟷ [Page 9 | hook] ⟷ sentinel
+*
+* The list never allocates or copies: pushing links the object's own hook,
+* and popping unlinks it and hands the object back. Because the hook is inside the
+* object, an object reached any other way (through a hash table, say) can be
+* unlinked or moved in O(1) with no search and no separate node to look up.
+* This is the shape of an LRU cache: a hash table finds the entry, and
+* moveToFront() / popBack() maintain the recency order.
+*
+* The list is circular around a sentinel hook, so no operation tests for null.
+* It does not own the objects, and an object must be unlinked before it is destroyed.
+* Destroying or clearing the list unlinks every member.
+*
+* @tparam T    The element type; must derive from IntrusiveListHook<Tag>.
+* @tparam Tag  Selects which hook of T this list uses.
+*/
+template <typename T, typename Tag = void>
+class IntrusiveList {
+    using Hook = IntrusiveListHook<Tag>;
+    static_assert(is_base_of<Hook, T>::value, "T must derive from IntrusiveListHook<Tag>");
+
+    Hook sentinel;
+    size_t count = 0;
+
+    static Hook& hookOf(T& object) { return static_cast<Hook&>(object); }
+    static T& objectOf(Hook* hook) { return static_cast<T&>(*hook); }
+
+    void linkBefore(Hook& position, Hook& hook) {
+        hook.next = &position;
+        hook.prev = position.prev;
+        position.prev->next = &hook;
+        position.prev = &hook;
+        count++;
+    }
+
+    void unlinkHook(Hook& hook) {
+        hook.prev->next = hook.next;
+        hook.next->prev = hook.prev;
+        hook.next = hook.prev = nullptr;
+        count--;
+    }
+
+    void checkNotEmpty() const {
+        if (count == 0) throw runtime_error("List is empty");
+    }
+
+    static void checkUnlinked(T& object) {
+        if (hookOf(object).isLinked()) throw invalid_argument("Object is already in a list");
+    }
+
+    static void checkLinked(T& object) {
+        if (!hookOf(object).isLinked()) throw invalid_argument("Object is not in a list");
+    }
+
+public:
+    /**
+     * @brief Bidirectional iterator over the member objects.
+     */
+    template <typename Ref>
+    class HookIterator {
+        Hook* hook = nullptr;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = remove_reference_t<Ref>*;
+        using reference = Ref;
+
+        HookIterator() = default;
+        explicit HookIterator(Hook* hook) : hook(hook) {}
+
+        reference operator*() const { return objectOf(hook); }
+        pointer operator->() const { return &objectOf(hook); }
+        HookIterator& operator++() { hook = hook->next; return *this; }
+        HookIterator& operator--() { hook = hook->prev; return *this; }
+        HookIterator operator++(int) { HookIterator previous = *this; hook = hook->next; return previous; }
+        HookIterator operator--(int) { HookIterator previous = *this; hook = hook->prev; return previous; }
+        bool operator==(const HookIterator& other) const { return hook == other.hook; }
+        bool operator!=(const HookIterator& other) const { return hook != other.hook; }
+    };
+
+    using iterator = HookIterator<T&>;
+    using const_iterator = HookIterator<const T&>;
+
+    IntrusiveList() { sentinel.next = sentinel.prev = &sentinel; }
+
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    // Takes over the members of `other`; only the two end hooks are re-pointed.
+    IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList() {
+        if (other.count == 0) return;
+        sentinel.next = other.sentinel.next;
+        sentinel.prev = other.sentinel.prev;
+        sentinel.next->prev = &sentinel;
+        sentinel.prev->next = &sentinel;
+        count = other.count;
+        other.sentinel.next = other.sentinel.prev = &other.sentinel;
+        other.count = 0;
+    }
+
+    ~IntrusiveList() { clear(); }
+
+    /**
+     * @brief Links `object` at the front.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if the object is already in a list.
+     */
+    void pushFront(T& object) {
+        checkUnlinked(object);
+        linkBefore(*sentinel.next, hookOf(object));
+    }
+
+    /**
+     * @brief Links `object` at the back.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if the object is already in a list.
+     */
+    void pushBack(T& object) {
+        checkUnlinked(object);
+        linkBefore(sentinel, hookOf(object));
+    }
+
+    /**
+     * @brief Links `object` in front of `position`, a member of this list.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if the object is already in a list.
+     */
+    void insertBefore(T& position, T& object) {
+        checkUnlinked(object);
+        linkBefore(hookOf(position), hookOf(object));
+    }
+
+    /**
+     * @brief Unlinks and returns the first object.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the list is empty.
+     */
+    T& popFront() {
+        checkNotEmpty();
+        Hook* first = sentinel.next;
+        unlinkHook(*first);
+        return objectOf(first);
+    }
+
+    /**
+     * @brief Unlinks and returns the last object (the eviction victim in an LRU).
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the list is empty.
+     */
+    T& popBack() {
+        checkNotEmpty();
+        Hook* last = sentinel.prev;
+        unlinkHook(*last);
+        return objectOf(last);
+    }
+
+    /**
+     * @brief Unlinks `object`, a member of this list, wherever it is.
+     *
+     * The object's own hook knows its neighbours, so there is nothing to search.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [a, b, c]
+     *   list.unlink(b)  ->  [a, c]
+     *
+     * @throws invalid_argument if the object is not in a list.
+     */
+    void unlink(T& object) {
+        checkLinked(object);
+        unlinkHook(hookOf(object));
+    }
+
+    /**
+     * @brief Moves `object`, a member of this list, to the front (a cache hit in an LRU).
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   list = [a, b, c]
+     *   list.moveToFront(c)  ->  [c, a, b]
+     *
+     * @throws invalid_argument if the object is not in a list.
+     */
+    void moveToFront(T& object) {
+        checkLinked(object);
+        Hook& hook = hookOf(object);
+        if (sentinel.next == &hook) return;
+        unlinkHook(hook);
+        linkBefore(*sentinel.next, hook);
+    }
+
+    /**
+     * @brief Moves `object`, a member of this list, to the back.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if the object is not in a list.
+     */
+    void moveToBack(T& object) {
+        checkLinked(object);
+        Hook& hook = hookOf(object);
+        if (sentinel.prev == &hook) return;
+        unlinkHook(hook);
+        linkBefore(sentinel, hook);
+    }
+
+    T& front() { checkNotEmpty(); return objectOf(sentinel.next); }
+    T& back() { checkNotEmpty(); return objectOf(sentinel.prev); }
+
+    static bool isLinked(const T& object) { return static_cast<const Hook&>(object).isLinked(); }
+
+    // Unlinks every member; the objects themselves are untouched.
+    void clear() {
+        Hook* hook = sentinel.next;
+        while (hook != &sentinel) {
+            Hook* next = hook->next;
+            hook->next = hook->prev = nullptr;
+            hook = next;
+        }
+        sentinel.next = sentinel.prev = &sentinel;
+        count = 0;
+    }
+
+    iterator begin() { return iterator(sentinel.next); }
+    iterator end() { return iterator(&sentinel); }
+    const_iterator begin() const { return const_iterator(sentinel.next); }
+    const_iterator end() const { return const_iterator(const_cast<Hook*>(&sentinel)); }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    void display() const {
+        cout << "[";
+        for (const_iterator it = begin(); it != end();) {
+            cout << *it;
+            if (++it != end()) cout << ", ";
+        }
+        cout << "]" << endl;
+    }
+};
+
+// ***************  UNROLLED LINKED LIST  ****************
+
+// Default elements per unrolled node: about 128 bytes of payload, at least 4 elements.
+template <typename T>
+constexpr size_t defaultUnrolledCapacity() {
+    return sizeof(T) >= 32 ? 4 : 128 / sizeof(T);
+}
+
+/**
+* @brief One node of an UnrolledLinkedList: a small array of up to Capacity elements.
+*
+* Slots [0, count) are constructed; the rest is raw storage.
+*/
+template <typename T, size_t Capacity>
+struct UnrolledBlock {
+    size_t count;
+    alignas(T) unsigned char bytes[Capacity * sizeof(T)];
+
+    UnrolledBlock() : count(0) {}   // leaves the element storage uninitialized
+
+    T* items() { return std::launder(reinterpret_cast<T*>(bytes)); }
+    const T* items() const { return std::launder(reinterpret_cast<const T*>(bytes)); }
+};
+
+/**
+* @brief A linked list of small arrays (an "unrolled" list).
+*
+*   [10 20 30 40 | •]──▶[50 60 _ _ | •]──▶[70 80 90 _ | null]
+*
+* Each node holds up to BlockCapacity elements side by side. A traversal then
+* follows one link per block instead of one per element, and every element it
+* reads after the first in a block is already in cache. Inserts and removes shift at
+* most one block. A full block is split in half; a block that drops below half
+* full is merged with its successor when both fit in one block.
+*
+* Blocks live in a NodePool, like the nodes of the other lists.
+*
+* Time Complexity:
+*   pushBack / pushFront      O(1) amortized
+*   at / insert / removeAt    O(n / B + B)
+*   traversal                 O(n), with n / B link hops
+*
+* @tparam T              The element type.
+* @tparam BlockCapacity  Elements per block.
+*/
+template <typename T, size_t BlockCapacity = defaultUnrolledCapacity<T>()>
+class UnrolledLinkedList {
+    static_assert(BlockCapacity >= 2, "An unrolled block needs room for at least two elements");
+
+    using Block = UnrolledBlock<T, BlockCapacity>;
+    using Pool = NodePool<Block, SinglyLinks>;
+
+    Pool pool;
+    NodeIndex head = nullNode;
+    NodeIndex tail = nullNode;
+    size_t count = 0;
+    size_t blocks = 0;
+
+    Block& block(NodeIndex node) { return pool.value(node); }
+    const Block& block(NodeIndex node) const { return pool.value(node); }
+    NodeIndex nextOf(NodeIndex node) const { return pool.links(node).next; }
+
+    // Creates an empty block after `position` (nullNode = at the front).
+    NodeIndex newBlockAfter(NodeIndex position) {
+        NodeIndex node = pool.create();
+        if (position == nullNode) {
+            pool.links(node).next = head;
+            head = node;
+            if (tail == nullNode) tail = node;
+        }
+        else {
+            pool.links(node).next = nextOf(position);
+            pool.links(position).next = node;
+            if (tail == position) tail = node;
+        }
+        blocks++;
+        return node;
+    }
+
+    // Unlinks and frees an empty block; `previous` is its predecessor (or nullNode).
+    void freeBlock(NodeIndex previous, NodeIndex node) {
+        NodeIndex next = nextOf(node);
+        if (previous == nullNode) head = next;
+        else pool.links(previous).next = next;
+        if (tail == node) tail = previous;
+        pool.destroy(node);
+        blocks--;
+    }
+
+    // Opens a gap at `pos` inside a block that has room, then constructs value there.
+    template <typename U>
+    static void insertIntoBlock(Block& b, size_t pos, U&& value) {
+        T* items = b.items();
+        if (pos == b.count) {
+            ::new (static_cast<void*>(items + pos)) T(std::forward<U>(value));
+        }
+        else {
+            T temp(std::forward<U>(value));   // value may alias an element of this block
+            ::new (static_cast<void*>(items + b.count)) T(std::move_if_noexcept(items[b.count - 1]));
+            std::move_backward(items + pos, items + b.count - 1, items + b.count);
+            items[pos] = std::move(temp);
+        }
+        b.count++;
+    }
+
+    // Moves elements [from, count) of `source` to the end of `target`.
+    static void moveTail(Block& source, size_t from, Block& target) {
+        T* src = source.items();
+        T* dst = target.items() + target.count;
+        for (size_t i = from; i < source.count; i++) {
+            ::new (static_cast<void*>(dst++)) T(std::move_if_noexcept(src[i]));
+            src[i].~T();
+        }
+        target.count += source.count - from;
+        source.count = from;
+    }
+
+    // Finds the block holding element `index`; `offset` receives its position inside the block.
+    NodeIndex locate(size_t index, size_t& offset, NodeIndex* previous = nullptr) const {
+        NodeIndex prev = nullNode;
+        NodeIndex node = head;
+        while (index >= block(node).count) {
+            index -= block(node).count;
+            prev = node;
+            node = nextOf(node);
+        }
+        if (previous) *previous = prev;
+        offset = index;
+        return node;
+    }
+
+    void copyFrom(const UnrolledLinkedList& other) {
+        for (NodeIndex node = other.head; node != nullNode; node = other.nextOf(node)) {
+            const Block& source = other.block(node);
+            NodeIndex copy = newBlockAfter(tail);
+            Block& target = block(copy);
+            for (size_t i = 0; i < source.count; i++) {
+                ::new (static_cast<void*>(target.items() + i)) T(source.items()[i]);
+                target.count++;
+                count++;
+            }
+        }
+    }
+
+    template <typename U>
+    void insertValue(size_t index, U&& value) {
+        if (index > count) throw out_of_range("Index out of bounds");
+        if (index == count) {
+            NodeIndex previousTail = tail;
+            bool fresh = tail == nullNode || block(tail).count == BlockCapacity;
+            if (fresh) newBlockAfter(tail);
+            try {
+                insertIntoBlock(block(tail), block(tail).count, std::forward<U>(value));
+            }
+            catch (...) {
+                if (fresh) freeBlock(previousTail, tail);   // never leave an empty block behind
+                throw;
+            }
+            count++;
+            return;
+        }
+
+        size_t offset;
+        NodeIndex node = locate(index, offset);
+        if (block(node).count < BlockCapacity) {
+            insertIntoBlock(block(node), offset, std::forward<U>(value));
+            count++;
+            return;
+        }
+
+        // Split: the upper half moves to a new block right after this one.
+        // Copy the value first, since it may refer to an element that is about to move.
+        T temp(std::forward<U>(value));
+        NodeIndex upper = newBlockAfter(node);
+        moveTail(block(node), BlockCapacity / 2, block(upper));
+        if (offset > BlockCapacity / 2) {
+            offset -= BlockCapacity / 2;
+            node = upper;
+        }
+        insertIntoBlock(block(node), offset, std::move(temp));
+        count++;
+    }
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief Forward iterator: walks the elements of a block, then follows its link.
+     */
+    template <typename ListPtr, typename Ref>
+    class BlockIterator {
+        ListPtr list = nullptr;
+        NodeIndex node = nullNode;
+        size_t offset = 0;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = remove_reference_t<Ref>*;
+        using reference = Ref;
+
+        BlockIterator() = default;
+        BlockIterator(ListPtr list, NodeIndex node) : list(list), node(node) {}
+
+        reference operator*() const { return list->block(node).items()[offset]; }
+        pointer operator->() const { return &**this; }
+
+        BlockIterator& operator++() {
+            if (++offset == list->block(node).count) {
+                node = list->nextOf(node);
+                offset = 0;
+            }
+            return *this;
+        }
+
+        BlockIterator operator++(int) {
+            BlockIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const BlockIterator& other) const { return node == other.node && offset == other.offset; }
+        bool operator!=(const BlockIterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = BlockIterator<UnrolledLinkedList*, T&>;
+    using const_iterator = BlockIterator<const UnrolledLinkedList*, const T&>;
+
+    UnrolledLinkedList() = default;
+
+    UnrolledLinkedList(const UnrolledLinkedList& other) { copyFrom(other); }
+
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept
+        : pool(std::move(other.pool)), head(other.head), tail(other.tail), count(other.count), blocks(other.blocks) {
+        other.head = other.tail = nullNode;
+        other.count = other.blocks = 0;
+    }
+
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other) {
+        if (this != &other) {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            pool = std::move(other.pool);
+            head = other.head;
+            tail = other.tail;
+            count = other.count;
+            blocks = other.blocks;
+            other.head = other.tail = nullNode;
+            other.count = other.blocks = 0;
+        }
+        return *this;
+    }
+
+    ~UnrolledLinkedList() { clear(); }
+
+    /**
+     * @brief Appends a value, opening a new block only when the last one is full.
+     *
+     * Time Complexity  : O(1) amortized
+     *
+     * Example:
+     *   list = [10, 20]
+     *   list.pushBack(30)  ->  [10, 20, 30]
+     */
+    void pushBack(const T& value) { insertValue(count, value); }
+    void pushBack(T&& value) { insertValue(count, std::move(value)); }
+
+    /**
+     * @brief Inserts a value at the front, shifting only the first block.
+     *
+     * Time Complexity  : O(B)
+     */
+    void pushFront(const T& value) {
+        if (head != nullNode && block(head).count < BlockCapacity) {
+            insertIntoBlock(block(head), 0, value);
+        }
+        else {
+            newBlockAfter(nullNode);
+            try {
+                insertIntoBlock(block(head), 0, value);
+            }
+            catch (...) {
+                freeBlock(nullNode, head);
+                throw;
+            }
+        }
+        count++;
+    }
+
+    /**
+     * @brief Inserts a value at a specific index.
+     *
+     * Skips whole blocks to find the position, then shifts inside one block.
+     * A full block is split in half first.
+     *
+     * Time Complexity  : O(n / B + B)
+     *
+     * Example:
+     *   list = [10, 20, 40]
+     *   list.insert(2, 30)  ->  [10, 20, 30, 40]
+     *
+     * @throws out_of_range if index > size().
+     */
+    void insert(size_t index, const T& value) { insertValue(index, value); }
+
+    /**
+     * @brief Removes the element at a specific index.
+     *
+     * Shifts inside one block. A block that becomes empty is freed. A block
+     * that falls below half full absorbs its successor when they fit together,
+     * so blocks stay dense and traversal stays cheap.
+     *
+     * Time Complexity  : O(n / B + B)
+     *
+     * Example:
+     *   list = [10, 20, 30]
+     *   list.removeAt(1)  ->  [10, 30]
+     *
+     * @throws out_of_range if index >= size().
+     */
+    void removeAt(size_t index) {
+        if (index >= count) throw out_of_range("Index out of bounds");
+
+        size_t offset;
+        NodeIndex previous;
+        NodeIndex node = locate(index, offset, &previous);
+        Block& b = block(node);
+        T* items = b.items();
+        std::move(items + offset + 1, items + b.count, items + offset);
+        items[b.count - 1].~T();
+        b.count--;
+        count--;
+
+        if (b.count == 0) {
+            freeBlock(previous, node);
+            return;
+        }
+        NodeIndex next = nextOf(node);
+        if (b.count < BlockCapacity / 2 && next != nullNode && b.count + block(next).count <= BlockCapacity) {
+            moveTail(block(next), 0, b);
+            freeBlock(node, next);
+        }
+    }
+
+    /**
+     * @brief Returns a reference to the element at `index`.
+     *
+     * Time Complexity  : O(n / B)
+     *
+     * @throws out_of_range if index >= size().
+     */
+    T& at(size_t index) {
+        if (index >= count) throw out_of_range("Index out of bounds");
+        size_t offset;
+        NodeIndex node = locate(index, offset);
+        return block(node).items()[offset];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= count) throw out_of_range("Index out of bounds");
+        size_t offset;
+        NodeIndex node = locate(index, offset);
+        return block(node).items()[offset];
+    }
+
+    /**
+     * @brief Returns the index of the first element equal to `value`, or -1.
+     *
+     * Scans each block as a plain array.
+     *
+     * Time Complexity  : O(n)
+     */
+    ptrdiff_t find(const T& value) const {
+        size_t base = 0;
+        for (NodeIndex node = head; node != nullNode; node = nextOf(node)) {
+            const Block& b = block(node);
+            for (size_t i = 0; i < b.count; i++) {
+                if (b.items()[i] == value) return static_cast<ptrdiff_t>(base + i);
+            }
+            base += b.count;
+        }
+        return -1;
+    }
+
+    bool contains(const T& value) const { return find(value) >= 0; }
+
+    // Destroys all elements and frees every block back to the pool (slabs are kept).
+    void clear() {
+        NodeIndex node = head;
+        while (node != nullNode) {
+            NodeIndex next = nextOf(node);
+            Block& b = block(node);
+            for (size_t i = 0; i < b.count; i++) b.items()[i].~T();
+            pool.destroy(node);
+            node = next;
+        }
+        head = tail = nullNode;
+        count = blocks = 0;
+    }
+
+    iterator begin() { return iterator(this, head); }
+    iterator end() { return iterator(this, nullNode); }
+    const_iterator begin() const { return const_iterator(this, head); }
+    const_iterator end() const { return const_iterator(this, nullNode); }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    size_t blockCount() const { return blocks; }
+    static constexpr size_t blockCapacity() { return BlockCapacity; }
+
+    void display() const {
+        cout << "[";
+        bool first = true;
+        for (const T& value : *this) {
+            if (!first) cout << ", ";
+            cout << value;
+            first = false;
+        }
+        cout << "]" << endl;
+    }
+};
+
+// Demo objects for IntrusiveList: a cache page that can sit in two lists at once.
+struct RecencyTag {};
+struct DirtyTag {};
+
+struct CachePage : IntrusiveListHook<RecencyTag>, IntrusiveListHook<DirtyTag> {
+    int key = -1;
+    string data;
+};
+
+ostream& operator<<(ostream& out, const CachePage& page) {
+    return out << page.key;
+}
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test SinglyLinkedList
+    // ---------------------------------------------------------------
+    cout << "=== Singly Linked List ===" << endl;
+    SinglyLinkedList<int> singly;
+    singly.pushBack(20);
+    singly.pushBack(40);
+    singly.pushFront(10);
+    cout << "pushBack/pushFront -> Expected : [10, 20, 40] | Result : "; singly.display();
+    NodeIndex twenty = singly.find(20);
+    singly.insertAfter(twenty, 30);
+    cout << "insertAfter(20, 30) -> Expected : [10, 20, 30, 40] | Result : "; singly.display();
+    singly.eraseAfter(twenty);
+    cout << "eraseAfter(20)      -> Expected : [10, 20, 40] | Result : "; singly.display();
+    singly.reverse();
+    cout << "reverse()           -> Expected : [40, 20, 10] | Result : "; singly.display();
+    singly.popFront();
+    cout << "popFront()          -> Expected : [20, 10] | Result : "; singly.display();
+    cout << "front / back        -> Expected : 20 / 10 | Result : " << singly.front() << " / " << singly.back() << endl;
+    cout << "contains(40)        -> Expected : false | Result : " << (singly.contains(40) ? "true" : "false") << endl;
+
+    try {
+        singly.eraseAfter(singly.tailNode());
+    }
+    catch (const out_of_range& e) {
+        cout << "eraseAfter(tail) correctly threw: " << e.what() << endl;
+    }
+
+    SinglyLinkedList<int> empty;
+    try {
+        empty.popFront();
+    }
+    catch (const runtime_error& e) {
+        cout << "popFront() on empty list correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test DoublyLinkedList
+    // ---------------------------------------------------------------
+    cout << "\n=== Doubly Linked List ===" << endl;
+    DoublyLinkedList<string> doubly;
+    NodeIndex a = doubly.pushBack("a");
+    NodeIndex c = doubly.pushBack("c");
+    doubly.insertBefore(c, "b");
+    doubly.pushBack("d");
+    cout << "insertBefore(c, b)  -> Expected : [a, b, c, d] | Result : "; doubly.display();
+    doubly.erase(c);
+    cout << "erase(c) by handle  -> Expected : [a, b, d] | Result : "; doubly.display();
+    doubly.popBack();
+    cout << "popBack()           -> Expected : [a, b] | Result : "; doubly.display();
+    doubly.splice(doubly.headNode(), doubly, doubly.tailNode());
+    cout << "splice(tail->front) -> Expected : [b, a] | Result : "; doubly.display();
+    cout << "handle still valid  -> Expected : a | Result : " << doubly.value(a) << endl;
+
+    DoublyLinkedList<string> copy = doubly;
+    copy.pushBack("z");
+    cout << "copy + pushBack(z)  -> Expected : [b, a, z] | Result : "; copy.display();
+    cout << "original unchanged  -> Expected : [b, a] | Result : "; doubly.display();
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test O(1) splice between lists sharing a pool
+    // ---------------------------------------------------------------
+    cout << "\n=== Splice (shared NodePool) ===" << endl;
+    NodePool<int, DoublyLinks> shared;
+    DoublyLinkedList<int> ready(shared), waiting(shared);
+    ready.pushBack(1);
+    NodeIndex four = ready.pushBack(4);
+    waiting.pushBack(2);
+    NodeIndex three = waiting.pushBack(3);
+    waiting.pushBack(9);
+    ready.splice(four, waiting, three);
+    cout << "splice one node     -> Expected : [1, 3, 4] | Result : "; ready.display();
+    cout << "source list         -> Expected : [2, 9] | Result : "; waiting.display();
+    ready.splice(nullNode, waiting);
+    cout << "splice whole list   -> Expected : [1, 3, 4, 2, 9] | Result : "; ready.display();
+    cout << "source now empty    -> Expected : 0 | Result : " << waiting.size() << endl;
+    cout << "pool live nodes     -> Expected : 5 | Result : " << shared.size() << endl;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    DoublyLinkedList<int> separate;
+    separate.pushBack(7);
+    try {
+        ready.splice(nullNode, separate, separate.headNode());
+    }
+    catch (const invalid_argument& e) {
+        cout << "splice across pools correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test CircularLinkedList
+    // ---------------------------------------------------------------
+    cout << "\n=== Circular Linked List ===" << endl;
+    CircularLinkedList<int> ring;
+    ring.pushBack(10);
+    ring.pushBack(20);
+    ring.pushBack(30);
+    cout << "pushBack x3         -> Expected : [10, 20, 30] | Result : "; ring.display();
+    ring.rotate();
+    cout << "rotate()            -> Expected : [20, 30, 10] | Result : "; ring.display();
+    ring.eraseAfter(ring.tailNode());
+    cout << "eraseAfter(tail)    -> Expected : [30, 10] | Result : "; ring.display();
+    ring.pushFront(5);
+    cout << "pushFront(5)        -> Expected : [5, 30, 10] | Result : "; ring.display();
+
+    // ---------------------------------------------------------------
+    // Test NodePool slot reuse and link size
+    // ---------------------------------------------------------------
+    cout << "\n=== Node Pool ===" << endl;
+    DoublyLinkedList<int> reuse;
+    reuse.pushBack(1);
+    NodeIndex middle = reuse.pushBack(2);
+    reuse.pushBack(3);
+    reuse.erase(middle);
+    NodeIndex recycled = reuse.pushBack(4);
+    cout << "freed slot reused   -> Expected : true | Result : " << (recycled == middle ? "true" : "false") << endl;
+    cout << "index links bytes   -> Expected : 8 (vs 16 for two pointers) | Result : " << sizeof(DoublyLinks) << endl;
+
+    NodePool<int, SinglyLinks> bulk;
+    SinglyLinkedList<int> big(bulk);
+    for (int i = 0; i < 1000; i++) big.pushBack(i);
+    cout << "1000 nodes -> slabs -> Expected : 4 | Result : " << bulk.slabsAllocated() << endl;
+    big.clear();
+    for (int i = 0; i < 1000; i++) big.pushBack(i);
+    cout << "refill after clear  -> Expected : 4 (no new slabs) | Result : " << bulk.slabsAllocated() << endl;
+
+    // ---------------------------------------------------------------
+    // Test UnrolledLinkedList
+    // ---------------------------------------------------------------
+    cout << "\n=== Unrolled Linked List ===" << endl;
+    UnrolledLinkedList<int, 4> unrolled;
+    for (int i = 1; i <= 10; i++) unrolled.pushBack(i * 10);
+    cout << "pushBack x10        -> Expected : [10, 20, 30, 40, 50, 60, 70, 80, 90, 100] | Result : "; unrolled.display();
+    cout << "blocks (capacity 4) -> Expected : 3 | Result : " << unrolled.blockCount() << endl;
+    unrolled.insert(2, 25);
+    cout << "insert(2, 25) split -> Expected : [10, 20, 25, 30, 40, 50, 60, 70, 80, 90, 100] | Result : "; unrolled.display();
+    cout << "blocks after split  -> Expected : 4 | Result : " << unrolled.blockCount() << endl;
+    cout << "at(6)               -> Expected : 60 | Result : " << unrolled.at(6) << endl;
+    cout << "find(90)            -> Expected : 9 | Result : " << unrolled.find(90) << endl;
+    cout << "find(35)            -> Expected : -1 | Result : " << unrolled.find(35) << endl;
+    unrolled.removeAt(0);
+    unrolled.removeAt(0);
+    cout << "removeAt(0) x2      -> Expected : [25, 30, 40, 50, 60, 70, 80, 90, 100] | Result : "; unrolled.display();
+    cout << "blocks after merge  -> Expected : 3 | Result : " << unrolled.blockCount() << endl;
+    unrolled.pushFront(5);
+    cout << "pushFront(5)        -> Expected : [5, 25, 30, 40, 50, 60, 70, 80, 90, 100] | Result : "; unrolled.display();
+
+    long long sum = 0;
+    for (int value : unrolled) sum += value;
+    cout << "range-for sum       -> Expected : 550 | Result : " << sum << endl;
+
+    try {
+        unrolled.at(50);
+    }
+    catch (const out_of_range& e) {
+        cout << "at(50) correctly threw: " << e.what() << endl;
+    }
+
+    UnrolledLinkedList<string> words;
+    words.pushBack("beta");
+    words.pushFront("alpha");
+    words.pushBack("gamma");
+    UnrolledLinkedList<string> wordsMoved = std::move(words);
+    cout << "moved string list   -> Expected : [alpha, beta, gamma] | Result : "; wordsMoved.display();
+    cout << "source after move   -> Expected : 0 | Result : " << words.size() << endl;
+    cout << "default block size  -> Expected : 32 ints | Result : " << UnrolledLinkedList<int>::blockCapacity() << endl;
+
+    // ---------------------------------------------------------------
+    // Test IntrusiveList
+    // ---------------------------------------------------------------
+    cout << "\n=== Intrusive Linked List ===" << endl;
+    CachePage page1, page2, page3;
+    page1.key = 1; page2.key = 2; page3.key = 3;
+    IntrusiveList<CachePage, RecencyTag> recency;
+    recency.pushBack(page1);
+    recency.pushBack(page2);
+    recency.pushBack(page3);
+    cout << "pushBack 1, 2, 3    -> Expected : [1, 2, 3] | Result : "; recency.display();
+    recency.moveToFront(page3);
+    cout << "moveToFront(3)      -> Expected : [3, 1, 2] | Result : "; recency.display();
+    recency.unlink(page1);
+    cout << "unlink(1)           -> Expected : [3, 2] | Result : "; recency.display();
+    cout << "1 still linked?     -> Expected : false | Result : "
+         << (IntrusiveList<CachePage, RecencyTag>::isLinked(page1) ? "true" : "false") << endl;
+    cout << "popBack()           -> Expected : 2 | Result : " << recency.popBack().key << endl;
+
+    IntrusiveList<CachePage, DirtyTag> dirty;
+    dirty.pushBack(page3);   // page 3 is now in both lists through its two hooks
+    cout << "one page, 2 lists   -> Expected : 1 / 1 | Result : " << recency.size() << " / " << dirty.size() << endl;
+    try {
+        recency.pushBack(page3);
+    }
+    catch (const invalid_argument& e) {
+        cout << "pushBack(3) twice correctly threw: " << e.what() << endl;
+    }
+    recency.clear();
+    dirty.clear();
+
+    // An LRU cache of 3 pages. The pages are preallocated, a direct-mapped
+    // table stands in for the hash table, and the list keeps the recency order.
+    CachePage frames[3];
+    CachePage* byKey[10] = {};
+    size_t framesUsed = 0;
+    IntrusiveList<CachePage, RecencyTag> lru;
+    string trace;
+    auto access = [&](int key) {
+        if (CachePage* hit = byKey[key]) {
+            lru.moveToFront(*hit);
+            trace += "H";
+            return;
+        }
+        CachePage* frame;
+        if (framesUsed < 3) {
+            frame = &frames[framesUsed++];
+        }
+        else {
+            frame = &lru.popBack();   // evict the least recently used page
+            byKey[frame->key] = nullptr;
+        }
+        frame->key = key;
+        frame->data = "page " + to_string(key);
+        byKey[key] = frame;
+        lru.pushFront(*frame);
+        trace += "M";
+    };
+    for (int key : { 1, 2, 3, 1, 4, 2, 1, 5 }) access(key);
+    cout << "LRU(3) on 1 2 3 1 4 2 1 5 -> Expected : MMMHMMHM, [5, 1, 2] | Result : " << trace << ", ";
+    lru.display();
+
+    return 0;
+}
@@ -1,20 +1,1349 @@
-// Linear-DS-Queues.cpp : This file contains the 'main' function. Program execution begins and ends there.
+#include <atomic>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+using namespace std;
+
+/**
+* **QUEUES - FIFO: FIRST IN, FIRST OUT**
+*
+*   Enqueue 10 -> Enqueue 20 -> Enqueue 30
+*
+*   Front -> [10][20][30] <- Back
+*
+*   Dequeue -> returns 10
+*
+* This file has three ring-buffer queues:
+*
+* * CircularQueue<T> - single-threaded, grows on demand. Head and tail wrap around
+*   the buffer, so space freed at the front is reused (no "false full").
+* * SpscQueue<T>     - bounded, lock-free, for exactly one producer thread and one
+*   consumer thread. Each side owns one index; the only synchronization is one
+*   acquire load and one release store per operation (or per batch).
+* * MpmcQueue<T>     - bounded, lock-free, any number of producers and consumers.
+*   Every slot carries a sequence number that says whose turn it is (Dmitry Vyukov's design).
+*
+* The concurrent queues report "full" and "empty" through their bool return
+* values instead of throwing, since both are normal states between threads.
+*/
+
+// Assumed cache-line size. Indices written by different threads are kept this far
+// apart so that a write by one thread does not invalidate the other's cache line (false sharing).
+constexpr size_t cacheLineSize = 64;
+
+// Smallest power of two >= n (n >= 1).
+inline size_t roundUpToPowerOfTwo(size_t n) {
+    size_t power = 1;
+    while (power < n) {
+        if (power > (SIZE_MAX >> 1)) throw length_error("Queue capacity too large");
+        power <<= 1;
+    }
+    return power;
+}
+
+// ***************  CIRCULAR QUEUE  ****************
+
+/**
+* @brief A growable FIFO queue on a circular buffer.
+*
+*   capacity 8, head = 6, size = 4:
+*
+*   Index:  0    1    2    3    4    5    6    7
+*   Array: [30] [40] [ ]  [ ]  [ ]  [ ]  [10] [20]
+*                                         ↑ head
+*
+* Elements [head, head + size) live at index (i & mask); enqueue and dequeue
+* move no elements. When the buffer is full it doubles, and the elements are moved
+* into the new buffer in order, starting at index 0.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class CircularQueue {
+    T* slots = nullptr;
+    size_t capacity = 0;   // always 0 or a power of two
+    size_t head = 0;
+    size_t count = 0;
+
+    size_t mask() const { return capacity - 1; }
+
+    void grow() {
+        size_t newCapacity = capacity == 0 ? 8 : capacity * 2;
+        T* fresh = std::allocator<T>().allocate(newCapacity);
+        size_t moved = 0;
+        try {
+            for (; moved < count; moved++) {
+                ::new (static_cast<void*>(fresh + moved)) T(std::move_if_noexcept(slots[(head + moved) & mask()]));
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < moved; i++) fresh[i].~T();
+            std::allocator<T>().deallocate(fresh, newCapacity);
+            throw;
+        }
+        destroyAll();
+        if (slots) std::allocator<T>().deallocate(slots, capacity);
+        slots = fresh;
+        capacity = newCapacity;
+        head = 0;
+    }
+
+    void destroyAll() {
+        for (size_t i = 0; i < count; i++) slots[(head + i) & mask()].~T();
+    }
+
+public:
+    CircularQueue() = default;
+
+    /**
+     * @brief Creates an empty queue with room for at least initialCapacity elements.
+     */
+    explicit CircularQueue(size_t initialCapacity) {
+        if (initialCapacity > 0) {
+            capacity = roundUpToPowerOfTwo(initialCapacity);
+            slots = std::allocator<T>().allocate(capacity);
+        }
+    }
+
+    CircularQueue(const CircularQueue& other) : CircularQueue(other.count) {
+        for (size_t i = 0; i < other.count; i++) enqueue(other.slots[(other.head + i) & other.mask()]);
+    }
+
+    CircularQueue(CircularQueue&& other) noexcept
+        : slots(other.slots), capacity(other.capacity), head(other.head), count(other.count) {
+        other.slots = nullptr;
+        other.capacity = other.head = other.count = 0;
+    }
+
+    CircularQueue& operator=(CircularQueue other) noexcept {
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~CircularQueue() {
+        destroyAll();
+        if (slots) std::allocator<T>().deallocate(slots, capacity);
+    }
+
+    /**
+     * @brief Adds a value at the back of the queue.
+     *
+     * Time Complexity  : O(1) amortized (O(n) when the buffer doubles)
+     *
+     * Example:
+     *   queue = [10, 20]
+     *   queue.enqueue(30)  ->  [10, 20, 30]
+     */
+    void enqueue(const T& value) {
+        if (count == capacity) {
+            T copy(value);   // value may be an element of this queue
+            grow();
+            ::new (static_cast<void*>(slots + ((head + count) & mask()))) T(std::move(copy));
+        }
+        else {
+            ::new (static_cast<void*>(slots + ((head + count) & mask()))) T(value);
+        }
+        count++;
+    }
+
+    void enqueue(T&& value) {
+        if (count == capacity) {
+            T moved(std::move(value));   // value may be an element of this queue
+            grow();
+            ::new (static_cast<void*>(slots + ((head + count) & mask()))) T(std::move(moved));
+        }
+        else {
+            ::new (static_cast<void*>(slots + ((head + count) & mask()))) T(std::move(value));
+        }
+        count++;
+    }
+
+    /**
+     * @brief Removes and returns the front element.
+     *
+     * Time Complexity  : O(1)
+     *
+     * Example:
+     *   queue = [10, 20, 30]
+     *   queue.dequeue()  ->  returns 10, queue = [20, 30]
+     *
+     * @throws runtime_error if the queue is empty.
+     */
+    T dequeue() {
+        if (count == 0) throw std::runtime_error("Queue is empty");
+        T& front = slots[head];
+        T value(std::move(front));
+        front.~T();
+        head = (head + 1) & mask();
+        count--;
+        return value;
+    }
+
+    /**
+     * @brief Returns the front element without removing it.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the queue is empty.
+     */
+    T& peek() {
+        if (count == 0) throw std::runtime_error("Queue is empty");
+        return slots[head];
+    }
+
+    const T& peek() const {
+        if (count == 0) throw std::runtime_error("Queue is empty");
+        return slots[head];
+    }
+
+    // Destroys all elements and keeps the buffer.
+    void clear() {
+        destroyAll();
+        head = count = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+    bool isEmpty() const { return count == 0; }
+
+    void display() const {
+        cout << "[";
+        for (size_t i = 0; i < count; i++) {
+            cout << slots[(head + i) & mask()];
+            if (i + 1 < count) cout << ", ";
+        }
+        cout << "]" << endl;
+    }
+};
+
+// ***************  SPSC RING BUFFER  ****************
+
+/**
+* @brief A bounded lock-free queue for one producer thread and one consumer thread.
+*
+*   producer owns tail ──▶ [ ][ ][x][x][x][x][ ][ ] ◀── consumer owns head
+*
+* head and tail are ever-increasing counters (slot = counter & mask), so
+* "full" is tail - head == capacity and no slot is wasted. Each counter sits on its own
+* cache line. Each side also keeps a private copy of the other side's counter,
+* which it reloads only when the queue looks full (producer) or empty (consumer).
+* In steady state an operation touches no shared cache line except the slot itself.
+*
+* enqueueBulk/dequeueBulk move a whole batch with a single release store, which
+* is where most of the throughput comes from.
+*
+* Only one thread may call the producer methods (tryEnqueue, tryEmplace, enqueueBulk)
+* and only one thread the consumer methods (tryDequeue, dequeueBulk, front).
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class SpscQueue {
+    T* const slots;
+    const size_t capacity;
+    const size_t mask;
+
+    alignas(cacheLineSize) atomic<size_t> tail{ 0 };   // written by the producer
+    size_t headCache = 0;                               // producer's copy of head
+
+    alignas(cacheLineSize) atomic<size_t> head{ 0 };   // written by the consumer
+    size_t tailCache = 0;                               // consumer's copy of tail
+
+    alignas(cacheLineSize) char padding = 0;            // keeps the next object off the consumer's line
+
+    // Free slots as seen by the producer, reloading head only if fewer than `wanted`.
+    size_t freeSlots(size_t currentTail, size_t wanted) {
+        size_t free = capacity - (currentTail - headCache);
+        if (free < wanted) {
+            headCache = head.load(memory_order_acquire);
+            free = capacity - (currentTail - headCache);
+        }
+        return free;
+    }
+
+    // Filled slots as seen by the consumer, reloading tail only if fewer than `wanted`.
+    size_t filledSlots(size_t currentHead, size_t wanted) {
+        size_t filled = tailCache - currentHead;
+        if (filled < wanted) {
+            tailCache = tail.load(memory_order_acquire);
+            filled = tailCache - currentHead;
+        }
+        return filled;
+    }
+
+public:
+    /**
+     * @brief Creates a queue holding up to `minCapacity` elements (rounded up to a power of two).
+     */
+    explicit SpscQueue(size_t minCapacity)
+        : slots(std::allocator<T>().allocate(roundUpToPowerOfTwo(minCapacity < 2 ? 2 : minCapacity))),
+          capacity(roundUpToPowerOfTwo(minCapacity < 2 ? 2 : minCapacity)),
+          mask(capacity - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        size_t h = head.load(memory_order_relaxed);
+        size_t t = tail.load(memory_order_relaxed);
+        for (; h != t; h++) slots[h & mask].~T();
+        std::allocator<T>().deallocate(slots, capacity);
+    }
+
+    /**
+     * @brief Constructs an element at the back. Producer thread only.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @return false if the queue is full (nothing is constructed).
+     */
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (freeSlots(t, 1) == 0) return false;
+        ::new (static_cast<void*>(slots + (t & mask))) T(std::forward<Args>(args)...);
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool tryEnqueue(const T& value) { return tryEmplace(value); }
+    bool tryEnqueue(T&& value) { return tryEmplace(std::move(value)); }
+
+    /**
+     * @brief Copies up to `count` elements to the back and publishes them at once. Producer thread only.
+     *
+     * Time Complexity  : O(k) for k enqueued, with one atomic store for the whole batch
+     *
+     * Example:
+     *   int batch[] = { 1, 2, 3 };
+     *   queue.enqueueBulk(batch, 3)  ->  3 (or fewer if the queue fills up)
+     *
+     * @return The number of elements enqueued (0 if the queue is full).
+     */
+    size_t enqueueBulk(const T* values, size_t count) {
+        size_t t = tail.load(memory_order_relaxed);
+        size_t free = freeSlots(t, count);
+        size_t n = count < free ? count : free;
+        size_t i = 0;
+        try {
+            for (; i < n; i++) ::new (static_cast<void*>(slots + ((t + i) & mask))) T(values[i]);
+        }
+        catch (...) {
+            tail.store(t + i, memory_order_release);   // publish what was constructed
+            throw;
+        }
+        tail.store(t + n, memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Moves the front element into `out`. Consumer thread only.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @return false if the queue is empty (`out` is untouched).
+     */
+    bool tryDequeue(T& out) {
+        size_t h = head.load(memory_order_relaxed);
+        if (filledSlots(h, 1) == 0) return false;
+        T& slot = slots[h & mask];
+        out = std::move(slot);
+        slot.~T();
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves up to `maxCount` front elements into `out` and frees their slots at once.
+     * Consumer thread only.
+     *
+     * Time Complexity  : O(k) for k dequeued, with one atomic store for the whole batch
+     *
+     * @return The number of elements dequeued (0 if the queue is empty).
+     */
+    size_t dequeueBulk(T* out, size_t maxCount) {
+        size_t h = head.load(memory_order_relaxed);
+        size_t filled = filledSlots(h, maxCount);
+        size_t n = maxCount < filled ? maxCount : filled;
+        for (size_t i = 0; i < n; i++) {
+            T& slot = slots[(h + i) & mask];
+            out[i] = std::move(slot);
+            slot.~T();
+        }
+        head.store(h + n, memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Returns the front element without removing it, or nullptr if empty. Consumer thread only.
+     */
+    T* front() {
+        size_t h = head.load(memory_order_relaxed);
+        if (filledSlots(h, 1) == 0) return nullptr;
+        return slots + (h & mask);
+    }
+
+    // A snapshot; exact only when neither side is running.
+    size_t sizeApprox() const {
+        size_t t = tail.load(memory_order_acquire);
+        size_t h = head.load(memory_order_acquire);
+        return t - h;
+    }
+
+    size_t getCapacity() const { return capacity; }
+};
+
+// ***************  MPMC RING BUFFER  ****************
+
+/**
+* @brief A bounded lock-free queue for any number of producers and consumers.
+*
+* Each cell has a sequence number that acts as a turn ticket:
+*
+*   sequence == pos            free, waiting for the producer that claims ticket pos
+*   sequence == pos + 1        full, waiting for the consumer that claims ticket pos
+*   sequence == pos + capacity free again, for the producer one lap later
+*
+* A producer claims ticket pos with one CAS on enqueuePos, writes the cell, then
+* stores sequence = pos + 1 (release). A consumer that sees that value claims the
+* same ticket with a CAS on dequeuePos, reads the cell and hands it to the next lap.
+* Contended threads only ever fight over one counter per direction, and no thread
+* ever waits on a lock.
+*
+* T must be nothrow move constructible, since a claimed cell cannot be abandoned.
+* tryEnqueue(const T&) copies before claiming, so a throwing copy constructor is still safe.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class MpmcQueue {
+    static_assert(is_nothrow_move_constructible<T>::value, "MpmcQueue needs a nothrow move constructor");
+
+    struct Cell {
+        atomic<size_t> sequence;
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(bytes)); }
+    };
+
+    Cell* const cells;
+    const size_t capacity;
+    const size_t mask;
+
+    alignas(cacheLineSize) atomic<size_t> enqueuePos{ 0 };
+    alignas(cacheLineSize) atomic<size_t> dequeuePos{ 0 };
+    alignas(cacheLineSize) char padding = 0;
+
+    // Claims a cell for writing; returns nullptr if the queue is full.
+    Cell* claimForEnqueue() {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) return &cell;
+            }
+            else if (diff < 0) {
+                return nullptr;   // the cell still holds last lap's element: full
+            }
+            else {
+                pos = enqueuePos.load(memory_order_relaxed);   // another producer took this ticket
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Creates a queue holding up to `minCapacity` elements (rounded up to a power of two, at least 2).
+     */
+    explicit MpmcQueue(size_t minCapacity)
+        : cells(std::allocator<Cell>().allocate(roundUpToPowerOfTwo(minCapacity < 2 ? 2 : minCapacity))),
+          capacity(roundUpToPowerOfTwo(minCapacity < 2 ? 2 : minCapacity)),
+          mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; i++) {
+            ::new (static_cast<void*>(&cells[i].sequence)) atomic<size_t>(i);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue() {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        size_t end = enqueuePos.load(memory_order_relaxed);
+        for (; pos != end; pos++) cells[pos & mask].value()->~T();
+        std::allocator<Cell>().deallocate(cells, capacity);
+    }
+
+    /**
+     * @brief Adds a value at the back. Safe to call from any number of threads.
+     *
+     * Time Complexity  : O(1), lock-free (a CAS retry only when another producer won the same ticket)
+     *
+     * @return false if the queue is full.
+     */
+    bool tryEnqueue(T&& value) {
+        Cell* cell = claimForEnqueue();
+        if (!cell) return false;
+        size_t pos = cell->sequence.load(memory_order_relaxed);
+        ::new (static_cast<void*>(cell->bytes)) T(std::move(value));
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    bool tryEnqueue(const T& value) {
+        if constexpr (is_nothrow_copy_constructible<T>::value) {
+            Cell* cell = claimForEnqueue();
+            if (!cell) return false;
+            size_t pos = cell->sequence.load(memory_order_relaxed);
+            ::new (static_cast<void*>(cell->bytes)) T(value);
+            cell->sequence.store(pos + 1, memory_order_release);
+            return true;
+        }
+        else {
+            T copy(value);
+            return tryEnqueue(std::move(copy));
+        }
+    }
+
+    /**
+     * @brief Moves the front element into `out`. Safe to call from any number of threads.
+     *
+     * Time Complexity  : O(1), lock-free
+     *
+     * @return false if the queue is empty.
+     */
+    bool tryDequeue(T& out) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    T* value = cell.value();
+                    out = std::move(*value);
+                    value->~T();
+                    cell.sequence.store(pos + capacity, memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;   // no producer has filled this ticket yet: empty
+            }
+            else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // A snapshot; exact only when no thread is running.
+    size_t sizeApprox() const {
+        size_t end = enqueuePos.load(memory_order_acquire);
+        size_t pos = dequeuePos.load(memory_order_acquire);
+        return end > pos ? end - pos : 0;
+    }
+
+    size_t getCapacity() const { return capacity; }
+};
+
+// ***************  PRIORITY QUEUES (HEAPS)  ****************
 //
+// Heaps are laid out in a HeapBuffer: a growable array whose storage is
+// aligned to a cache line. The d-ary heaps shift the root so that each group
+// of Arity siblings starts on an Arity-element boundary. For a 4-ary heap of
+// 4-byte keys, all children of a node then share one 16-byte piece of a
+// single cache line.
 
-#include <iostream>
+/**
+* @brief A minimal growable array with cache-line-aligned storage, used by the heaps.
+*
+* The allocation starts with LeadingSlots unused (never constructed) slots, so
+* element i sits at aligned position i + LeadingSlots.
+*
+* @tparam T             The element type.
+* @tparam LeadingSlots  Unused slots in front of element 0.
+*/
+template <typename T, size_t LeadingSlots = 0>
+class HeapBuffer {
+    static constexpr size_t alignment = alignof(T) > cacheLineSize ? alignof(T) : cacheLineSize;
+
+    T* items = nullptr;
+    size_t count = 0;
+    size_t capacity = 0;
+
+    static T* allocate(size_t n) {
+        void* raw = ::operator new((n + LeadingSlots) * sizeof(T), std::align_val_t(alignment));
+        return static_cast<T*>(raw) + LeadingSlots;
+    }
+
+    static void deallocate(T* p) {
+        if (p) ::operator delete(p - LeadingSlots, std::align_val_t(alignment));
+    }
+
+public:
+    HeapBuffer() = default;
+
+    HeapBuffer(const HeapBuffer& other) {
+        reserve(other.count);
+        for (size_t i = 0; i < other.count; i++) pushBack(other.items[i]);
+    }
+
+    HeapBuffer(HeapBuffer&& other) noexcept : items(other.items), count(other.count), capacity(other.capacity) {
+        other.items = nullptr;
+        other.count = other.capacity = 0;
+    }
+
+    HeapBuffer& operator=(HeapBuffer other) noexcept {
+        std::swap(items, other.items);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+        return *this;
+    }
+
+    ~HeapBuffer() {
+        clear();
+        deallocate(items);
+    }
+
+    void reserve(size_t n) {
+        if (n <= capacity) return;
+        T* fresh = allocate(n);
+        size_t moved = 0;
+        try {
+            for (; moved < count; moved++) ::new (static_cast<void*>(fresh + moved)) T(std::move_if_noexcept(items[moved]));
+        }
+        catch (...) {
+            for (size_t i = 0; i < moved; i++) fresh[i].~T();
+            deallocate(fresh);
+            throw;
+        }
+        for (size_t i = 0; i < count; i++) items[i].~T();
+        deallocate(items);
+        items = fresh;
+        capacity = n;
+    }
+
+    template <typename... Args>
+    void emplaceBack(Args&&... args) {
+        if (count == capacity) {
+            T value(std::forward<Args>(args)...);   // args may refer to an element of this buffer
+            reserve(capacity == 0 ? 16 : capacity * 2);
+            ::new (static_cast<void*>(items + count)) T(std::move(value));
+        }
+        else {
+            ::new (static_cast<void*>(items + count)) T(std::forward<Args>(args)...);
+        }
+        count++;
+    }
+
+    void pushBack(const T& value) { emplaceBack(value); }
+    void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+    void popBack() {
+        items[--count].~T();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < count; i++) items[i].~T();
+        count = 0;
+    }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T& back() { return items[count - 1]; }
+    T* data() { return items; }
+    const T* data() const { return items; }
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+};
+
+// Sifts the element at `hole` towards the root. `placed(i)` is called for every slot that receives an element.
+template <size_t Arity, typename T, typename Compare, typename Placed>
+void heapSiftUp(T* heap, size_t hole, const Compare& comp, Placed placed) {
+    if (hole == 0) {
+        placed(hole);
+        return;
+    }
+    T value(std::move(heap[hole]));
+    while (hole > 0) {
+        size_t parent = (hole - 1) / Arity;
+        if (!comp(value, heap[parent])) break;
+        heap[hole] = std::move(heap[parent]);
+        placed(hole);
+        hole = parent;
+    }
+    heap[hole] = std::move(value);
+    placed(hole);
+}
+
+// Sifts the element at `hole` away from the root, among the first `count` slots.
+template <size_t Arity, typename T, typename Compare, typename Placed>
+void heapSiftDown(T* heap, size_t hole, size_t count, const Compare& comp, Placed placed) {
+    T value(std::move(heap[hole]));
+    for (;;) {
+        size_t first = hole * Arity + 1;
+        if (first >= count) break;
+        size_t last = first + Arity < count ? first + Arity : count;
+
+        size_t best = first;
+        for (size_t child = first + 1; child < last; child++) {
+            if (comp(heap[child], heap[best])) best = child;
+        }
+        if (!comp(heap[best], value)) break;
+        heap[hole] = std::move(heap[best]);
+        placed(hole);
+        hole = best;
+    }
+    heap[hole] = std::move(value);
+    placed(hole);
+}
+
+/**
+* @brief A d-ary heap priority queue (4-ary by default).
+*
+* The element for which comp(a, b) holds against every other element is on top,
+* so the default std::less gives a min-heap and std::greater a max-heap.
+*
+*   4-ary heap:              [1]
+*                  /      /       \       \
+*                [3]    [2]      [7]      [4]
+*               / | \ \
+*             [9][5][8][6] ...
+*
+* Compared with a binary heap the tree is half as deep (log4 n levels), so
+* push does half the moves. pop compares up to 4 children per level, but those
+* children are adjacent and aligned, so each level costs one cache line instead
+* of the two lines a binary heap touches over two levels.
+*
+* Time Complexity:
+*   push O(log_d n), pop O(d log_d n), top O(1)
+*
+* @tparam T        The element type.
+* @tparam Arity    Children per node (2 = binary heap).
+* @tparam Compare  comp(a, b) is true if a should come out before b.
+*/
+template <typename T, size_t Arity = 4, typename Compare = std::less<T>>
+class DaryHeap {
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+    // Arity - 1 unused slots before the root, so that each sibling group
+    // (children Arity*i+1 .. Arity*i+Arity) starts on a multiple of Arity.
+    HeapBuffer<T, Arity - 1> slots;
+    Compare comp;
+
+    T* heap() { return slots.data(); }
+    const T* heap() const { return slots.data(); }
+
+    struct NoTracking {
+        void operator()(size_t) const {}
+    };
+
+public:
+    explicit DaryHeap(const Compare& comp = Compare()) : comp(comp) {}
+
+    /**
+     * @brief Adds a value and restores the heap order by sifting it up.
+     *
+     * Time Complexity  : O(log_d n)
+     *
+     * Example:
+     *   heap = {3, 5}
+     *   heap.push(1)  ->  top() = 1
+     */
+    void push(const T& value) {
+        slots.pushBack(value);
+        heapSiftUp<Arity>(heap(), slots.size() - 1, comp, NoTracking());
+    }
+
+    void push(T&& value) {
+        slots.pushBack(std::move(value));
+        heapSiftUp<Arity>(heap(), slots.size() - 1, comp, NoTracking());
+    }
+
+    /**
+     * @brief Returns the top element.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the heap is empty.
+     */
+    const T& top() const {
+        if (slots.isEmpty()) throw std::runtime_error("Heap is empty");
+        return heap()[0];
+    }
+
+    /**
+     * @brief Removes the top element: the last element moves to the root and sifts down.
+     *
+     * Time Complexity  : O(d log_d n)
+     *
+     * @throws runtime_error if the heap is empty.
+     */
+    void pop() {
+        if (slots.isEmpty()) throw std::runtime_error("Heap is empty");
+        size_t last = slots.size() - 1;
+        if (last > 0) heap()[0] = std::move(heap()[last]);
+        slots.popBack();
+        if (last > 1) heapSiftDown<Arity>(heap(), 0, last, comp, NoTracking());
+    }
+
+    // Reserves room for n elements, so n pushes never reallocate.
+    void reserve(size_t n) { slots.reserve(n); }
+
+    void clear() { slots.clear(); }
+
+    size_t size() const { return slots.size(); }
+    bool isEmpty() const { return slots.isEmpty(); }
+};
+
+// The Priority Queue variant of the README: a 4-ary min-heap (use std::greater for a max-heap).
+template <typename T, typename Compare = std::less<T>>
+using PriorityQueue = DaryHeap<T, 4, Compare>;
+
+// A stable reference to an element of an IndexedDaryHeap.
+using HeapHandle = uint32_t;
+
+constexpr HeapHandle nullHeapHandle = UINT32_MAX;
+
+/**
+* @brief A d-ary heap whose elements can be changed or removed through stable handles.
+*
+* push() returns a HeapHandle. It stays valid while the element is in the heap,
+* however the element moves, because a position table maps each handle to its
+* current slot and is updated on every move. With it, decreaseKey() (increase the
+* priority) is just a sift-up: O(log_d n), no search.
+*
+*   slots:      [ (1,h2) (4,h0) (3,h1) ]
+*   positions:  h0 -> 1, h1 -> 2, h2 -> 0
+*
+* Handles of popped or erased elements are recycled by later pushes.
+*
+* This is the heap Dijkstra and schedulers need. Each vertex or task keeps its
+* handle, and when a shorter distance or an earlier deadline shows up the entry is updated in place.
+*
+* @tparam T        The element (priority) type.
+* @tparam Arity    Children per node.
+* @tparam Compare  comp(a, b) is true if a should come out before b.
+*/
+template <typename T, size_t Arity = 4, typename Compare = std::less<T>>
+class IndexedDaryHeap {
+    struct Entry {
+        T value;
+        HeapHandle handle;
+    };
+
+    struct EntryCompare {
+        Compare comp;
+        bool operator()(const Entry& a, const Entry& b) const { return comp(a.value, b.value); }
+    };
+
+    static constexpr size_t notInHeap = SIZE_MAX;
+
+    HeapBuffer<Entry, Arity - 1> entries;
+    HeapBuffer<size_t> positions;        // positions[handle] = slot, or notInHeap
+    HeapBuffer<HeapHandle> freeHandles;
+    EntryCompare comp;
+
+    auto tracker() {
+        return [this](size_t slot) { positions[entries[slot].handle] = slot; };
+    }
+
+    void checkHandle(HeapHandle handle) const {
+        if (!contains(handle)) throw invalid_argument("Handle is not in the heap");
+    }
+
+    // Removes the entry at `slot`, filling the gap with the last entry.
+    void removeSlot(size_t slot) {
+        positions[entries[slot].handle] = notInHeap;
+        freeHandles.pushBack(entries[slot].handle);
+        size_t last = entries.size() - 1;
+        if (slot != last) {
+            entries[slot] = std::move(entries[last]);
+        }
+        entries.popBack();
+        if (slot == last) return;
+
+        // The moved entry may belong above or below its new slot.
+        if (slot > 0 && comp(entries[slot], entries[(slot - 1) / Arity])) {
+            heapSiftUp<Arity>(entries.data(), slot, comp, tracker());
+        }
+        else {
+            heapSiftDown<Arity>(entries.data(), slot, entries.size(), comp, tracker());
+        }
+    }
+
+public:
+    explicit IndexedDaryHeap(const Compare& comp = Compare()) : comp{ comp } {}
+
+    /**
+     * @brief Adds a value and returns its handle.
+     *
+     * Time Complexity  : O(log_d n)
+     *
+     * @throws length_error if 2^32 - 1 handles are in use.
+     */
+    HeapHandle push(const T& value) {
+        bool recycled = !freeHandles.isEmpty();
+        HeapHandle handle;
+        if (recycled) {
+            handle = freeHandles.back();
+        }
+        else {
+            if (positions.size() >= nullHeapHandle) throw length_error("Too many heap handles");
+            handle = static_cast<HeapHandle>(positions.size());
+            positions.pushBack(notInHeap);
+        }
+        entries.pushBack(Entry{ value, handle });
+        if (recycled) freeHandles.popBack();
+        heapSiftUp<Arity>(entries.data(), entries.size() - 1, comp, tracker());
+        return handle;
+    }
+
+    const T& top() const {
+        if (entries.isEmpty()) throw std::runtime_error("Heap is empty");
+        return entries[0].value;
+    }
+
+    HeapHandle topHandle() const {
+        if (entries.isEmpty()) throw std::runtime_error("Heap is empty");
+        return entries[0].handle;
+    }
+
+    /**
+     * @brief Removes the top element. Its handle becomes invalid.
+     *
+     * Time Complexity  : O(d log_d n)
+     *
+     * @throws runtime_error if the heap is empty.
+     */
+    void pop() {
+        if (entries.isEmpty()) throw std::runtime_error("Heap is empty");
+        removeSlot(0);
+    }
+
+    /**
+     * @brief Gives the element `handle` a better (or equal) priority.
+     *
+     * Time Complexity  : O(log_d n)
+     *
+     * Example:
+     *   h = heap.push(9);  heap.push(5);
+     *   heap.decreaseKey(h, 1)  ->  top() = 1, topHandle() = h
+     *
+     * @throws invalid_argument if the handle is not in the heap, or if the new
+     *         value would come out after the current one (use update() for that).
+     */
+    void decreaseKey(HeapHandle handle, const T& value) {
+        checkHandle(handle);
+        size_t slot = positions[handle];
+        if (comp.comp(entries[slot].value, value)) throw invalid_argument("decreaseKey would lower the priority");
+        entries[slot].value = value;
+        heapSiftUp<Arity>(entries.data(), slot, comp, tracker());
+    }
+
+    /**
+     * @brief Changes the value of `handle` in either direction.
+     *
+     * Time Complexity  : O(d log_d n)
+     */
+    void update(HeapHandle handle, const T& value) {
+        checkHandle(handle);
+        size_t slot = positions[handle];
+        bool better = comp.comp(value, entries[slot].value);
+        entries[slot].value = value;
+        if (better) heapSiftUp<Arity>(entries.data(), slot, comp, tracker());
+        else heapSiftDown<Arity>(entries.data(), slot, entries.size(), comp, tracker());
+    }
+
+    /**
+     * @brief Removes the element `handle` from anywhere in the heap.
+     *
+     * Time Complexity  : O(d log_d n)
+     */
+    void erase(HeapHandle handle) {
+        checkHandle(handle);
+        removeSlot(positions[handle]);
+    }
+
+    bool contains(HeapHandle handle) const {
+        return handle < positions.size() && positions[handle] != notInHeap;
+    }
+
+    const T& value(HeapHandle handle) const {
+        checkHandle(handle);
+        return entries[positions[handle]].value;
+    }
+
+    void reserve(size_t n) {
+        entries.reserve(n);
+        positions.reserve(n);
+    }
+
+    size_t size() const { return entries.size(); }
+    bool isEmpty() const { return entries.isEmpty(); }
+};
+
+// Index of the highest set bit (m != 0).
+inline unsigned highestBit64(unsigned long long m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, m);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(m));
+#endif
+}
+
+/**
+* @brief A monotone radix heap for unsigned integer priorities.
+*
+* Works when keys are never smaller than the last key popped. Dijkstra
+* with non-negative weights and event simulation both satisfy this. An entry is kept in
+* bucket b = 1 + (highest bit in which its key differs from the last popped key),
+* or bucket 0 if equal:
+*
+*   last = 8 (0b1000)
+*   key 8  -> bucket 0      key 9  -> bucket 1      key 10..11 -> bucket 2
+*   key 12..15 -> bucket 3  key 16..31 -> bucket 5  ...
+*
+* pop() takes from bucket 0. When it is empty, the smallest key of the first
+* non-empty bucket becomes `last` and that bucket's entries are spread over the
+* lower buckets. Each entry can only move down, at most once per bucket, so a
+* pop costs O(log C) amortized (C = the key range). All work is sequential scans
+* of small arrays: no sifting and no comparisons along a tree path.
+*
+* There is no decreaseKey. Like most radix-heap users, push the entry again with
+* the smaller key and skip stale entries when they come out.
+*
+* @tparam Value  The payload stored with each key.
+* @tparam Key    An unsigned integer type.
+*/
+template <typename Value, typename Key = uint64_t>
+class RadixHeap {
+    static_assert(is_unsigned<Key>::value, "RadixHeap keys must be unsigned integers");
+
+    static constexpr size_t bucketCount = sizeof(Key) * 8 + 1;
+
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+    HeapBuffer<Entry> buckets[bucketCount];
+    Key last = 0;
+    size_t count = 0;
+
+    size_t bucketOf(Key key) const {
+        return key == last ? 0 : 1 + highestBit64(static_cast<unsigned long long>(key ^ last));
+    }
+
+    // Makes bucket 0 non-empty by redistributing the first non-empty bucket.
+    void refill() {
+        if (!buckets[0].isEmpty()) return;
+        size_t b = 1;
+        while (buckets[b].isEmpty()) b++;
+
+        HeapBuffer<Entry>& source = buckets[b];
+        Key smallest = source[0].key;
+        for (size_t i = 1; i < source.size(); i++) {
+            if (source[i].key < smallest) smallest = source[i].key;
+        }
+        last = smallest;
+        for (size_t i = 0; i < source.size(); i++) {
+            buckets[bucketOf(source[i].key)].pushBack(std::move(source[i]));
+        }
+        source.clear();
+    }
+
+public:
+    /**
+     * @brief Adds a value with priority `key`.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws invalid_argument if key is smaller than the last popped key.
+     */
+    void push(Key key, const Value& value) {
+        if (key < last) throw invalid_argument("RadixHeap keys must not decrease below the last popped key");
+        buckets[bucketOf(key)].pushBack(Entry{ key, value });
+        count++;
+    }
+
+    /**
+     * @brief Returns the smallest key (preparing bucket 0 if needed).
+     *
+     * Time Complexity  : O(log C) amortized
+     *
+     * @throws runtime_error if the heap is empty.
+     */
+    Key topKey() {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        refill();
+        return last;
+    }
+
+    const Value& topValue() {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        refill();
+        return buckets[0].back().value;
+    }
+
+    /**
+     * @brief Removes an entry with the smallest key.
+     *
+     * Time Complexity  : O(log C) amortized
+     *
+     * @throws runtime_error if the heap is empty.
+     */
+    void pop() {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        refill();
+        buckets[0].popBack();
+        count--;
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+};
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test CircularQueue
+    // ---------------------------------------------------------------
+    cout << "=== Circular Queue ===" << endl;
+    CircularQueue<int> queue(4);
+    queue.enqueue(10);
+    queue.enqueue(20);
+    queue.enqueue(30);
+    cout << "enqueue x3         -> Expected : [10, 20, 30] | Result : "; queue.display();
+    cout << "dequeue()          -> Expected : 10 | Result : " << queue.dequeue() << endl;
+    cout << "peek()             -> Expected : 20 | Result : " << queue.peek() << endl;
+    queue.enqueue(40);
+    queue.enqueue(50);
+    cout << "wrap around        -> Expected : [20, 30, 40, 50] | Result : "; queue.display();
+    cout << "capacity (no grow) -> Expected : 4 | Result : " << queue.getCapacity() << endl;
+    queue.enqueue(60);
+    cout << "grow when full     -> Expected : [20, 30, 40, 50, 60] | Result : "; queue.display();
+    cout << "capacity           -> Expected : 8 | Result : " << queue.getCapacity() << endl;
+
+    CircularQueue<string> names;
+    names.enqueue("ann");
+    names.enqueue("bob");
+    CircularQueue<string> namesCopy = names;
+    names.dequeue();
+    cout << "copy independent   -> Expected : [ann, bob] | Result : "; namesCopy.display();
+
+    CircularQueue<string> full(2);
+    full.enqueue("first in line");
+    full.enqueue("second in line");
+    full.enqueue(std::move(full.peek()));   // moved out of a slot that grow() relocates
+    full.dequeue();                         // the moved-from front
+    cout << "enqueue own front  -> Expected : [second in line, first in line] | Result : "; full.display();
+
+    CircularQueue<int> emptyQueue;
+    try {
+        emptyQueue.dequeue();
+    }
+    catch (const runtime_error& e) {
+        cout << "dequeue() on empty queue correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test SpscQueue (single thread)
+    // ---------------------------------------------------------------
+    cout << "\n=== SPSC Ring Buffer ===" << endl;
+    SpscQueue<int> spsc(6);
+    cout << "capacity (6 -> 8)  -> Expected : 8 | Result : " << spsc.getCapacity() << endl;
+    int batch[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    cout << "enqueueBulk(10)    -> Expected : 8 (queue full) | Result : " << spsc.enqueueBulk(batch, 10) << endl;
+    cout << "tryEnqueue on full -> Expected : false | Result : " << (spsc.tryEnqueue(11) ? "true" : "false") << endl;
+    int out[8] = {};
+    size_t got = spsc.dequeueBulk(out, 3);
+    cout << "dequeueBulk(3)     -> Expected : 3 [1, 2, 3] | Result : " << got
+         << " [" << out[0] << ", " << out[1] << ", " << out[2] << "]" << endl;
+    int single = 0;
+    spsc.tryDequeue(single);
+    cout << "tryDequeue()       -> Expected : 4 | Result : " << single << endl;
+    cout << "front()            -> Expected : 5 | Result : " << *spsc.front() << endl;
+    got = spsc.dequeueBulk(out, 8);
+    cout << "drain              -> Expected : 4 | Result : " << got << endl;
+    cout << "tryDequeue (empty) -> Expected : false | Result : " << (spsc.tryDequeue(single) ? "true" : "false") << endl;
+
+    // ---------------------------------------------------------------
+    // Test SpscQueue across two threads
+    // ---------------------------------------------------------------
+    const long long messages = 1000000;
+    SpscQueue<long long> pipe(1024);
+    long long consumedSum = 0;
+    thread consumer([&] {
+        long long buffer[64];
+        long long received = 0;
+        while (received < messages) {
+            size_t n = pipe.dequeueBulk(buffer, 64);
+            for (size_t i = 0; i < n; i++) consumedSum += buffer[i];
+            received += static_cast<long long>(n);
+        }
+    });
+    long long chunk[64];
+    for (long long next = 1; next <= messages;) {
+        size_t n = 0;
+        for (; n < 64 && next + static_cast<long long>(n) <= messages; n++) chunk[n] = next + static_cast<long long>(n);
+        size_t sent = 0;
+        while (sent < n) sent += pipe.enqueueBulk(chunk + sent, n - sent);
+        next += static_cast<long long>(n);
+    }
+    consumer.join();
+    cout << "1M messages, 2 threads -> Expected sum : " << messages * (messages + 1) / 2
+         << " | Result : " << consumedSum << endl;
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test MpmcQueue
+    // ---------------------------------------------------------------
+    cout << "\n=== MPMC Ring Buffer ===" << endl;
+    MpmcQueue<string> jobs(2);
+    cout << "tryEnqueue x3 (cap 2) -> Expected : true true false | Result : "
+         << (jobs.tryEnqueue("a") ? "true " : "false ")
+         << (jobs.tryEnqueue(string("b")) ? "true " : "false ")
+         << (jobs.tryEnqueue("c") ? "true" : "false") << endl;
+    string job;
+    jobs.tryDequeue(job);
+    cout << "tryDequeue()          -> Expected : a | Result : " << job << endl;
+    cout << "sizeApprox()          -> Expected : 1 | Result : " << jobs.sizeApprox() << endl;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    const int producers = 4, consumers = 4;
+    const long long perProducer = 250000;
+    MpmcQueue<long long> shared(4096);
+    atomic<long long> mpmcSum{ 0 };
+    atomic<long long> mpmcCount{ 0 };
+    thread workers[producers + consumers];
+    for (int p = 0; p < producers; p++) {
+        workers[p] = thread([&, p] {
+            for (long long i = 1; i <= perProducer; i++) {
+                long long value = p * perProducer + i;
+                while (!shared.tryEnqueue(value)) this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        workers[producers + c] = thread([&] {
+            long long value, localSum = 0;
+            while (mpmcCount.load(memory_order_relaxed) < producers * perProducer) {
+                if (shared.tryDequeue(value)) {
+                    localSum += value;
+                    mpmcCount.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            mpmcSum += localSum;
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    const long long total = producers * perProducer;
+    cout << "4 producers x 4 consumers -> Expected count / sum : " << total << " / " << total * (total + 1) / 2
+         << " | Result : " << mpmcCount.load() << " / " << mpmcSum.load() << endl;
+
+    // ---------------------------------------------------------------
+    // Test DaryHeap / PriorityQueue
+    // ---------------------------------------------------------------
+    cout << "\n=== Priority Queue (4-ary heap) ===" << endl;
+    PriorityQueue<int> minHeap;
+    int priorities[] = { 7, 3, 9, 1, 5, 8, 2, 6, 4 };
+    for (int p : priorities) minHeap.push(p);
+    cout << "pop order (min)    -> Expected : 1 2 3 4 5 6 7 8 9 | Result :";
+    while (!minHeap.isEmpty()) {
+        cout << " " << minHeap.top();
+        minHeap.pop();
+    }
+    cout << endl;
+
+    PriorityQueue<string, std::greater<string>> maxHeap;
+    maxHeap.push("pear");
+    maxHeap.push("apple");
+    maxHeap.push("zucchini");
+    cout << "top (max-heap)     -> Expected : zucchini | Result : " << maxHeap.top() << endl;
+
+    DaryHeap<int, 2> binaryHeap;
+    for (int p : priorities) binaryHeap.push(p);
+    binaryHeap.pop();
+    cout << "binary heap top    -> Expected : 2 | Result : " << binaryHeap.top() << endl;
+
+    try {
+        minHeap.pop();
+    }
+    catch (const runtime_error& e) {
+        cout << "pop() on empty heap correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test IndexedDaryHeap (decreaseKey through handles)
+    // ---------------------------------------------------------------
+    cout << "\n=== Indexed Heap (decreaseKey) ===" << endl;
+    IndexedDaryHeap<int> tasks;
+    HeapHandle taskA = tasks.push(50);
+    HeapHandle taskB = tasks.push(20);
+    HeapHandle taskC = tasks.push(90);
+    cout << "top                -> Expected : 20 | Result : " << tasks.top() << endl;
+    tasks.decreaseKey(taskC, 10);
+    cout << "decreaseKey(C, 10) -> Expected : 10 (handle C) | Result : " << tasks.top()
+         << (tasks.topHandle() == taskC ? " (handle C)" : " (wrong handle)") << endl;
+    tasks.update(taskC, 70);
+    cout << "update(C, 70)      -> Expected : 20 | Result : " << tasks.top() << endl;
+    tasks.erase(taskB);
+    cout << "erase(B)           -> Expected : 50, B gone | Result : " << tasks.top()
+         << (tasks.contains(taskB) ? ", B present" : ", B gone") << endl;
+    cout << "value(C)           -> Expected : 70 | Result : " << tasks.value(taskC) << endl;
+    try {
+        tasks.decreaseKey(taskA, 99);
+    }
+    catch (const invalid_argument& e) {
+        cout << "decreaseKey(A, 99) correctly threw: " << e.what() << endl;
+    }
+    HeapHandle taskD = tasks.push(5);
+    cout << "handle recycled    -> Expected : true | Result : " << (taskD == taskB ? "true" : "false") << endl;
+
+    // ---------------------------------------------------------------
+    // Test RadixHeap
+    // ---------------------------------------------------------------
+    cout << "\n=== Radix Heap ===" << endl;
+    RadixHeap<string, uint32_t> events;
+    events.push(30, "c");
+    events.push(10, "a");
+    events.push(20, "b");
+    events.push(10, "a2");
+    cout << "pop order (keys)   -> Expected : 10 10 20 30 | Result :";
+    while (!events.isEmpty()) {
+        cout << " " << events.topKey();
+        events.pop();
+    }
+    cout << endl;
+    events.push(40, "d");
+    events.topKey();
+    events.pop();
+    try {
+        events.push(35, "late");
+    }
+    catch (const invalid_argument& e) {
+        cout << "push(35) after popping 40 correctly threw: " << e.what() << endl;
+    }
+
+    return 0;
+}
@@ -1,20 +1,635 @@
-// Linear-DS-Stacks.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
-
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/**
+* **STACKS - LAST IN, FIRST OUT**
+*
+*   Push 10 -> Push 20 -> Push 30
+*
+*        [30]  <- top
+*        [20]
+*        [10]
+*        ----
+*
+* This file has three stacks:
+*
+* * ArrayStack<T>    - one contiguous buffer with a `top` pointer. push/pop/peek
+*                      are a pointer bump and a compare; the buffer doubles when full.
+* * ChunkedStack<T>  - a linked list of fixed-size chunks. Growth adds a chunk and
+*                      never copies, so elements never move and a very deep stack
+*                      (an explicit DFS stack, say) never pays an O(n) copy.
+* * TreiberStack<T>  - a bounded lock-free stack for sharing free lists and object
+*                      pools between threads. Its heads are tagged indices, which
+*                      rules out the ABA problem.
+*/
+
+// ***************  ARRAY STACK  ****************
+
+/**
+* @brief A stack on one contiguous, growable buffer.
+*
+*   base                 top        limit
+*    ↓                    ↓          ↓
+*   [10][20][30][40][50][  ][  ][  ]
+*
+* The three pointers are the whole state: push constructs at `top` and bumps it,
+* pop bumps it back. Only a push into a full buffer leaves the fast path. Growth
+* moves the elements with move_if_noexcept, and if a copy throws, the stack keeps
+* its old buffer untouched.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class ArrayStack {
+    T* base = nullptr;
+    T* top = nullptr;
+    T* limit = nullptr;
+
+    static T* acquire(size_t n) { return std::allocator<T>().allocate(n); }
+    static void release(T* p, size_t n) { if (p) std::allocator<T>().deallocate(p, n); }
+
+    /**
+     * @brief Moves the elements into a fresh buffer of newCapacity slots.
+     *
+     * Time Complexity  : O(n)
+     */
+    void reallocate(size_t newCapacity) {
+        size_t count = size();
+        T* fresh = acquire(newCapacity);
+        size_t built = 0;
+        try {
+            for (; built < count; built++) {
+                ::new (static_cast<void*>(fresh + built)) T(std::move_if_noexcept(base[built]));
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < built; i++) fresh[i].~T();
+            release(fresh, newCapacity);
+            throw;
+        }
+        for (T* p = base; p != top; ++p) p->~T();
+        release(base, capacity());
+        base = fresh;
+        top = fresh + count;
+        limit = fresh + newCapacity;
+    }
+
+    // The slow path of emplace(): doubles the buffer.
+    void grow() {
+        size_t current = capacity();
+        reallocate(current < 8 ? 8 : current * 2);
+    }
+
+    void checkNotEmpty() const {
+        if (top == base) throw runtime_error("Stack is empty");
+    }
+
+public:
+    ArrayStack() = default;
+
+    explicit ArrayStack(size_t initialCapacity) { reserve(initialCapacity); }
+
+    ArrayStack(const ArrayStack& other) {
+        reserve(other.size());
+        try {
+            for (const T* p = other.base; p != other.top; ++p) push(*p);
+        }
+        catch (...) {
+            clear();   // no destructor runs for a constructor that throws
+            release(base, capacity());
+            throw;
+        }
+    }
+
+    ArrayStack(ArrayStack&& other) noexcept : base(other.base), top(other.top), limit(other.limit) {
+        other.base = other.top = other.limit = nullptr;
+    }
+
+    ArrayStack& operator=(ArrayStack other) noexcept {
+        std::swap(base, other.base);
+        std::swap(top, other.top);
+        std::swap(limit, other.limit);
+        return *this;
+    }
+
+    ~ArrayStack() {
+        clear();
+        release(base, capacity());
+    }
+
+    /**
+     * @brief Makes room for at least `n` elements, so that the next pushes never reallocate.
+     *
+     * Time Complexity  : O(n) when it reallocates, otherwise O(1)
+     */
+    void reserve(size_t n) {
+        if (n > capacity()) reallocate(n);
+    }
+
+    /**
+     * @brief Pushes a value on top.
+     *
+     * Time Complexity  : O(1) amortized
+     *
+     * Example:
+     *   stack = [10, 20]
+     *   stack.push(30)  ->  [10, 20, 30]
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (top == limit) {
+            T value(std::forward<Args>(args)...);   // the arguments may refer into this buffer
+            grow();
+            T* slot = ::new (static_cast<void*>(top)) T(std::move(value));
+            ++top;
+            return *slot;
+        }
+        T* slot = ::new (static_cast<void*>(top)) T(std::forward<Args>(args)...);
+        ++top;   // only once the element exists, so a throwing constructor leaves the size alone
+        return *slot;
+    }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    /**
+     * @brief Removes and returns the top element.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the stack is empty.
+     */
+    T pop() {
+        checkNotEmpty();
+        --top;
+        T value(std::move(*top));
+        top->~T();
+        return value;
+    }
+
+    /**
+     * @brief Returns the top element without removing it.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the stack is empty.
+     */
+    T& peek() { checkNotEmpty(); return top[-1]; }
+    const T& peek() const { checkNotEmpty(); return top[-1]; }
+
+    // Destroys all elements; the buffer is kept.
+    void clear() {
+        while (top != base) (--top)->~T();
+    }
+
+    size_t size() const { return static_cast<size_t>(top - base); }
+    size_t capacity() const { return static_cast<size_t>(limit - base); }
+    bool isEmpty() const { return top == base; }
+
+    // Prints bottom to top.
+    void display() const {
+        cout << "[";
+        for (const T* p = base; p != top; ++p) {
+            cout << *p;
+            if (p + 1 != top) cout << ", ";
+        }
+        cout << "] <- top" << endl;
+    }
+};
+
+// ***************  CHUNKED STACK  ****************
+
+/**
+* @brief A stack stored in a chain of fixed-size chunks.
+*
+*   [ 1  2  3  4 ] <- [ 5  6  7  8 ] <- [ 9 10 __ __ ]
+*                                              ↑ top
+*
+* A full chunk is never copied: the next push links a new chunk on top. Only the
+* topmost chunk is partially filled, and one empty chunk is cached after a pop
+* leaves it, so a stack that oscillates at a chunk boundary does not allocate on
+* every push. Elements never move, so references to them stay valid until they
+* are popped.
+*
+* @tparam T          The element type.
+* @tparam ChunkSize  Elements per chunk.
+*/
+template <typename T, size_t ChunkSize = (4096 / sizeof(T) > 16 ? 4096 / sizeof(T) : 16)>
+class ChunkedStack {
+    static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+    struct Chunk {
+        Chunk* below;
+        alignas(T) unsigned char bytes[ChunkSize * sizeof(T)];
+
+        Chunk() : below(nullptr) {}  // leaves bytes uninitialised
+        T* slots() { return std::launder(reinterpret_cast<T*>(bytes)); }
+    };
+
+    Chunk* current = nullptr;  // chunk holding the top element
+    Chunk* spare = nullptr;    // one cached empty chunk
+    T* top = nullptr;          // next free slot in `current`
+    T* chunkEnd = nullptr;
+    size_t count = 0;
+
+    void pushChunk() {
+        Chunk* chunk = spare ? spare : new Chunk();
+        spare = nullptr;
+        chunk->below = current;
+        current = chunk;
+        top = chunk->slots();
+        chunkEnd = top + ChunkSize;
+    }
+
+    void popChunk() {
+        Chunk* empty = current;
+        current = empty->below;
+        delete spare;
+        spare = empty;
+        if (current) {
+            top = current->slots() + ChunkSize;
+            chunkEnd = top;
+        }
+        else {
+            top = chunkEnd = nullptr;
+        }
+    }
+
+    void checkNotEmpty() const {
+        if (count == 0) throw runtime_error("Stack is empty");
+    }
+
+public:
+    ChunkedStack() = default;
+    ChunkedStack(const ChunkedStack&) = delete;
+    ChunkedStack& operator=(const ChunkedStack&) = delete;
+
+    ~ChunkedStack() {
+        clear();
+        delete spare;
+    }
+
+    /**
+     * @brief Pushes a value on top; a full chunk gets a new chunk above it.
+     *
+     * Time Complexity  : O(1), never copies existing elements
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        bool fresh = false;
+        if (top == chunkEnd) {
+            pushChunk();
+            fresh = true;
+        }
+        try {
+            ::new (static_cast<void*>(top)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            if (fresh) popChunk();
+            throw;
+        }
+        count++;
+        return *top++;
+    }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    /**
+     * @brief Removes and returns the top element.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the stack is empty.
+     */
+    T pop() {
+        checkNotEmpty();
+        --top;
+        T value(std::move(*top));
+        top->~T();
+        count--;
+        if (top == current->slots()) popChunk();
+        return value;
+    }
+
+    /**
+     * @brief Returns the top element without removing it.
+     *
+     * Time Complexity  : O(1)
+     *
+     * @throws runtime_error if the stack is empty.
+     */
+    T& peek() { checkNotEmpty(); return top[-1]; }
+
+    void clear() {
+        while (count > 0) {
+            (--top)->~T();
+            count--;
+            if (top == current->slots()) popChunk();
+        }
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    static constexpr size_t chunkSize() { return ChunkSize; }
+};
+
+// ***************  TREIBER STACK (LOCK-FREE)  ****************
+
+/**
+* @brief A bounded lock-free LIFO stack (Treiber), with ABA protection by tagged indices.
+*
+* All nodes are preallocated in one array. A node is never freed while the stack
+* lives, so a thread that reads `next` from a node another thread has just popped
+* still reads valid memory. Two lock-free lists thread through the array: the stack
+* itself, and a free list of unused nodes. push() pops a free node, fills it in and
+* then pushes it onto the stack. pop() does the reverse.
+*
+* Each list head is one 64-bit word: a 32-bit node index and a 32-bit tag.
+*
+*   head = [ tag : 32 | index : 32 ]
+*
+* Every successful CAS on a head bumps the tag. The classic ABA failure needs this
+* sequence: a thread reads head A and its next B; other threads pop A, pop B and
+* push A back; then the first thread's stale CAS succeeds and installs B. With the
+* tag, head is no longer the same word, so the stale CAS fails. A 64-bit CAS is
+* lock-free on every mainstream CPU, unlike the 128-bit CAS a tagged pointer needs.
+*
+* @tparam T  The element type.
+*/
+template <typename T>
+class TreiberStack {
+    using Index = uint32_t;
+    static constexpr Index nullIndex = UINT32_MAX;
+
+    struct Node {
+        atomic<Index> next{ nullIndex };
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(bytes)); }
+    };
+
+    static uint64_t pack(uint64_t tag, Index index) { return (tag << 32) | index; }
+    static Index indexOf(uint64_t head) { return static_cast<Index>(head); }
+    static uint64_t tagOf(uint64_t head) { return head >> 32; }
+
+    // Indices are 32-bit and nullIndex is reserved, so the capacity is checked before anything is allocated.
+    static size_t checkedCapacity(size_t capacity) {
+        if (capacity >= nullIndex) throw length_error("TreiberStack capacity too large");
+        return capacity;
+    }
+
+    unique_ptr<Node[]> nodes;
+    size_t nodeCount;
+    alignas(64) atomic<uint64_t> stackHead;
+    alignas(64) atomic<uint64_t> freeHead;
+
+    // Lock-free pop of one node index from the list at `head`.
+    Index take(atomic<uint64_t>& head) {
+        uint64_t old = head.load(memory_order_acquire);
+        for (;;) {
+            Index index = indexOf(old);
+            if (index == nullIndex) return nullIndex;
+            Index next = nodes[index].next.load(memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(tagOf(old) + 1, next),
+                                           memory_order_acq_rel, memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    // Lock-free push of node `index` onto the list at `head`.
+    void give(atomic<uint64_t>& head, Index index) {
+        uint64_t old = head.load(memory_order_relaxed);
+        for (;;) {
+            nodes[index].next.store(indexOf(old), memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(tagOf(old) + 1, index),
+                                           memory_order_release, memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Creates an empty stack that can hold up to `capacity` elements.
+     *
+     * Time Complexity  : O(capacity)
+     */
+    explicit TreiberStack(size_t capacity)
+        : nodes(new Node[checkedCapacity(capacity)]), nodeCount(capacity), stackHead(pack(0, nullIndex)), freeHead(pack(0, nullIndex)) {
+        for (size_t i = 0; i < capacity; i++) {
+            nodes[i].next.store(i + 1 < capacity ? static_cast<Index>(i + 1) : nullIndex, memory_order_relaxed);
+        }
+        freeHead.store(pack(0, capacity ? 0 : nullIndex), memory_order_relaxed);
+    }
+
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    ~TreiberStack() {
+        Index index = indexOf(stackHead.load(memory_order_relaxed));
+        while (index != nullIndex) {
+            nodes[index].value()->~T();
+            index = nodes[index].next.load(memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Pushes a copy of `value`. Safe to call from any thread.
+     *
+     * Time Complexity  : O(1), lock-free
+     *
+     * @return false if all `capacity` nodes are in use.
+     */
+    bool tryPush(const T& value) {
+        Index index = take(freeHead);
+        if (index == nullIndex) return false;
+        try {
+            ::new (static_cast<void*>(nodes[index].bytes)) T(value);
+        }
+        catch (...) {
+            give(freeHead, index);
+            throw;
+        }
+        give(stackHead, index);
+        return true;
+    }
+
+    /**
+     * @brief Pops the most recently pushed value into `out`. Safe to call from any thread.
+     *
+     * Only the thread whose CAS removed the node touches its value, and the node
+     * returns to the free list after the value is moved out.
+     *
+     * Time Complexity  : O(1), lock-free
+     *
+     * @return false if the stack is empty.
+     */
+    bool tryPop(T& out) {
+        Index index = take(stackHead);
+        if (index == nullIndex) return false;
+        T* value = nodes[index].value();
+        out = std::move(*value);
+        value->~T();
+        give(freeHead, index);
+        return true;
+    }
+
+    // A snapshot; exact only when no thread is running.
+    bool isEmptyApprox() const { return indexOf(stackHead.load(memory_order_acquire)) == nullIndex; }
+    size_t getCapacity() const { return nodeCount; }
+};
+
+// Counts live instances; copying a negative value throws.
+struct Fragile {
+    static inline int alive = 0;
+    int value;
+
+    explicit Fragile(int v) : value(v) { alive++; }
+    Fragile(const Fragile& other) : value(other.value) {
+        if (value < 0) throw runtime_error("negative copy");
+        alive++;
+    }
+    Fragile(Fragile&& other) noexcept : value(other.value) { alive++; }
+    Fragile& operator=(const Fragile&) = default;
+    ~Fragile() { alive--; }
+};
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test ArrayStack
+    // ---------------------------------------------------------------
+    cout << "=== ArrayStack ===" << endl;
+    ArrayStack<int> stack;
+    stack.push(10);
+    stack.push(20);
+    stack.push(30);
+    cout << "push 10, 20, 30 -> Expected : [10, 20, 30] <- top | Result : "; stack.display();
+    cout << "peek()          -> Expected : 30 | Result : " << stack.peek() << endl;
+    cout << "pop()           -> Expected : 30 | Result : " << stack.pop() << endl;
+    cout << "size()          -> Expected : 2 | Result : " << stack.size() << endl;
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    stack.reserve(1000);
+    cout << "reserve(1000)   -> Expected : capacity 1000 | Result : capacity " << stack.capacity() << endl;
+    for (int i = 0; i < 998; i++) stack.push(i);
+    cout << "998 more pushes -> Expected : capacity 1000 (no reallocation) | Result : capacity " << stack.capacity() << endl;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    stack.clear();
+    try {
+        stack.pop();
+    }
+    catch (const runtime_error& e) {
+        cout << "pop() on empty stack correctly threw: " << e.what() << endl;
+    }
+
+    ArrayStack<string> words;
+    words.push("alpha");
+    for (int i = 0; i < 7; i++) words.push(words.peek());   // pushes an element of itself across a growth
+    words.push("omega");
+    cout << "self-push growth -> Expected : 9 / alpha under omega | Result : " << words.size() << " / ";
+    words.pop();
+    cout << words.peek() << " under omega" << endl;
+
+    {
+        ArrayStack<Fragile> fragile;
+        for (int v : { 1, 2, -3, 4 }) fragile.emplace(v);
+        try {
+            ArrayStack<Fragile> copy(fragile);
+        }
+        catch (const runtime_error& e) {
+            cout << "copy threw (" << e.what() << ") -> Expected : 4 alive | Result : " << Fragile::alive << " alive" << endl;
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // Test ChunkedStack: a deep DFS without recursion
+    // ---------------------------------------------------------------
+    cout << "\n=== ChunkedStack ===" << endl;
+    ChunkedStack<int, 4> chunked;
+    for (int i = 1; i <= 10; i++) chunked.push(i);
+    int* bottom = &chunked.peek();
+    for (int i = 11; i <= 100; i++) chunked.push(i);
+    cout << "push 1..100     -> Expected : 100 / top 100 | Result : " << chunked.size() << " / top " << chunked.peek() << endl;
+    for (int i = 0; i < 90; i++) chunked.pop();
+    cout << "pop 90 times    -> Expected : 10, same address | Result : " << chunked.peek()
+         << (bottom == &chunked.peek() ? ", same address" : ", moved!") << endl;
+
+    // Visit a binary tree of 2^20 - 1 implicit nodes depth-first: children of n are 2n and 2n + 1.
+    ChunkedStack<uint32_t> dfs;
+    uint64_t visited = 0;
+    size_t deepest = 0;
+    dfs.push(1);
+    while (!dfs.isEmpty()) {
+        uint32_t node = dfs.pop();
+        visited++;
+        if (node < (1u << 19)) {
+            dfs.push(2 * node + 1);
+            dfs.push(2 * node);
+        }
+        if (dfs.size() > deepest) deepest = dfs.size();
+    }
+    cout << "iterative DFS   -> Expected : 1048575 nodes visited | Result : " << visited << " nodes visited (max stack " << deepest << ")" << endl;
+
+    // ---------------------------------------------------------------
+    // Test TreiberStack
+    // ---------------------------------------------------------------
+    cout << "\n=== TreiberStack ===" << endl;
+    TreiberStack<int> lockFree(3);
+    lockFree.tryPush(1);
+    lockFree.tryPush(2);
+    lockFree.tryPush(3);
+    cout << "tryPush when full -> Expected : false | Result : " << (lockFree.tryPush(4) ? "true" : "false") << endl;
+    int out = 0;
+    lockFree.tryPop(out);
+    cout << "tryPop()          -> Expected : 3 | Result : " << out << endl;
+    lockFree.tryPop(out);
+    lockFree.tryPop(out);
+    cout << "tryPop() on empty -> Expected : false | Result : " << (lockFree.tryPop(out) ? "true" : "false") << endl;
+    try {
+        TreiberStack<int> tooLarge(UINT32_MAX);
+    }
+    catch (const length_error& e) {
+        cout << "TreiberStack(UINT32_MAX) correctly threw before allocating: " << e.what() << endl;
+    }
+
+    // An object pool shared by 4 threads: each takes a free slot id, checks that no
+    // one else holds it, and gives it back. An ABA bug would hand one id out twice.
+    const int poolSize = 64;
+    const int rounds = 200000;
+    TreiberStack<int> freeSlots(poolSize);
+    for (int id = 0; id < poolSize; id++) freeSlots.tryPush(id);
+    atomic<int> held[poolSize];
+    for (atomic<int>& h : held) h.store(0);
+    atomic<int> doubleHandouts{ 0 };
+    thread workers[4];
+    for (thread& worker : workers) {
+        worker = thread([&] {
+            for (int r = 0; r < rounds; r++) {
+                int id;
+                if (!freeSlots.tryPop(id)) continue;
+                if (held[id].exchange(1) != 0) doubleHandouts++;
+                held[id].store(0);
+                freeSlots.tryPush(id);
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    int returned = 0;
+    while (freeSlots.tryPop(out)) returned++;
+    cout << "4 threads x 200000 take/give -> Expected : 0 double hand-outs, 64 ids back | Result : "
+         << doubleHandouts.load() << " double hand-outs, " << returned << " ids back" << endl;
+
+    return 0;
+}
@@ -1,20 +1,1875 @@
-// Non-Linear-DS-Graphs.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
-
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Bitset row kernels use SSE2 on x86-64 and NEON on AArch64.
+// Compile with -DDS_DISABLE_SIMD to force the scalar loops.
+#if defined(DS_DISABLE_SIMD)
+#define DS_GRAPHS_SIMD_X86 0
+#define DS_GRAPHS_SIMD_NEON 0
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define DS_GRAPHS_SIMD_X86 1
+#define DS_GRAPHS_SIMD_NEON 0
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DS_GRAPHS_SIMD_X86 0
+#define DS_GRAPHS_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define DS_GRAPHS_SIMD_X86 0
+#define DS_GRAPHS_SIMD_NEON 0
+#endif
+using namespace std;
+
+/**
+* **GRAPHS - COMPRESSED SPARSE ROW**
+*
+* An adjacency list as a vector of vectors spends one heap block (and a 24-byte header)
+* per vertex, and a traversal jumps to a different block for every vertex it expands.
+* CSR keeps the whole graph in three flat arrays:
+*
+*   edges:    0->1  0->2  1->2  2->0  2->3
+*
+*   offsets:  [ 0 | 2 | 3 | 5 | 5 ]            vertex v's edges are [offsets[v], offsets[v + 1])
+*   targets:  [ 1 | 2 | 2 | 0 | 3 ]
+*   weights:  [ w | w | w | w | w ]            parallel to targets
+*
+* The neighbours of a vertex are one contiguous run of `targets`, so expanding it is a
+* sequential read. An edge costs 4 bytes plus its weight, and a vertex 8 bytes of offset.
+*
+* Breadth-first search on such graphs is direction-optimizing. While the frontier is small,
+* it expands the frontier's edges (top-down). Once the frontier's edges outnumber what is
+* left to explore, every unvisited vertex instead looks for any parent in the frontier,
+* held as a bitmap, and stops at the first one it finds (bottom-up).
+*
+* Dense graphs go the other way: an adjacency matrix with one bit per cell, where a
+* vertex's row is a bitset of its neighbours. Common neighbours of u and v are then
+* popcount(row[u] & row[v]): one AND and one popcount per 64 vertices.
+*/
+
+// ***************  EDGE LIST  ****************
+
+// A vertex handle: 0 .. vertexCount - 1.
+using VertexId = uint32_t;
+
+// A position in the edge arrays. 64-bit: a graph may have more than 2^32 edges.
+using EdgeIndex = uint64_t;
+
+// "No vertex", for example the parent of an unreached vertex.
+constexpr VertexId nullVertex = UINT32_MAX;
+
+// One input edge. The weight defaults to 1 for unweighted graphs.
+template <typename W = uint32_t>
+struct Edge {
+    VertexId from;
+    VertexId to;
+    W weight = 1;
+};
+
+enum class EdgeDirection {
+    Directed,     // from -> to only; incoming edges are indexed as well, for bottom-up search
+    Undirected    // stored both ways: from -> to and to -> from
+};
+
+// ***************  CSR GRAPH  ****************
+
+/**
+* @brief An immutable graph in compressed sparse row form: offsets, targets and weights arrays.
+*
+* Built once from an edge list with two counting-sort passes, with no per-vertex
+* allocation. Each vertex's edges keep the order they had in the edge list.
+*
+* A directed graph also stores its incoming edges (an offsets array and a sources array,
+* no weights), so that a search can ask "who points at v?". An undirected graph stores
+* every edge in both directions, and its incoming edges are its outgoing ones.
+*
+* Vertex arguments are not checked: they must be below vertexCount().
+*
+* @tparam W  The edge weight type, trivially copyable. Use a narrow type such as uint8_t
+*            when the weights do not matter: every edge stores one.
+*/
+template <typename W = uint32_t>
+class CsrGraph {
+    static_assert(is_trivially_copyable<W>::value, "CsrGraph stores weights in a flat array: W must be trivially copyable");
+
+public:
+    using Weight = W;
+
+    // A vertex's neighbours: a contiguous run of the targets array.
+    struct NeighborRange {
+        const VertexId* first;
+        const VertexId* last;
+
+        const VertexId* begin() const { return first; }
+        const VertexId* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool isEmpty() const { return first == last; }
+    };
+
+private:
+    VertexId vertices = 0;
+    EdgeIndex edges = 0;                  // stored edges: twice the input edges when undirected
+    bool undirected = false;
+    unique_ptr<EdgeIndex[]> offsets;      // vertices + 1 entries
+    unique_ptr<VertexId[]> targets;
+    unique_ptr<W[]> weights;
+    unique_ptr<EdgeIndex[]> inOffsets;    // directed graphs only
+    unique_ptr<VertexId[]> inSources;
+
+    /**
+     * @brief Turns per-vertex counts (stored at index v + 1) into start offsets.
+     *
+     * Time Complexity  : O(V)
+     */
+    static void prefixSum(EdgeIndex* offs, VertexId n) {
+        for (VertexId v = 0; v < n; v++) offs[v + 1] += offs[v];
+    }
+
+    /**
+     * @brief Undoes the scatter pass: after it, offs[v] holds the end of v's run, which is the start of v + 1's.
+     *
+     * Time Complexity  : O(V)
+     */
+    static void shiftBack(EdgeIndex* offs, VertexId n) {
+        for (VertexId v = n; v > 0; v--) offs[v] = offs[v - 1];
+        offs[0] = 0;
+    }
+
+public:
+    CsrGraph() = default;
+
+    /**
+     * @brief Builds the graph from `edgeCount` edges over vertices 0 .. vertexCount - 1.
+     *
+     * Counts each vertex's edges, turns the counts into offsets with a prefix sum, then
+     * writes every edge straight into its slot: a counting sort by source, O(V + E)
+     * time and no memory beyond the result. Directed graphs repeat this by target for
+     * the incoming index.
+     *
+     * Time Complexity  : O(V + E)
+     * Example:
+     *   edges = {0->1, 0->2, 1->2, 2->0, 2->3}, 4 vertices, Directed
+     *   offsets = [0, 2, 3, 5, 5], targets = [1, 2, 2, 0, 3]
+     *
+     * @throws invalid_argument if an edge names a vertex >= vertexCount, or vertexCount is nullVertex.
+     */
+    CsrGraph(VertexId vertexCount, const Edge<W>* edgeList, size_t edgeCount, EdgeDirection direction)
+        : vertices(vertexCount), undirected(direction == EdgeDirection::Undirected) {
+        if (vertexCount == nullVertex) throw invalid_argument("Too many vertices");
+        for (size_t i = 0; i < edgeCount; i++) {
+            if (edgeList[i].from >= vertexCount || edgeList[i].to >= vertexCount) {
+                throw invalid_argument("Edge endpoint out of range");
+            }
+        }
+        edges = undirected ? 2 * static_cast<EdgeIndex>(edgeCount) : static_cast<EdgeIndex>(edgeCount);
+
+        offsets.reset(new EdgeIndex[static_cast<size_t>(vertices) + 1]());
+        targets.reset(new VertexId[edges]);
+        weights.reset(new W[edges]);
+
+        for (size_t i = 0; i < edgeCount; i++) {
+            offsets[edgeList[i].from + 1]++;
+            if (undirected) offsets[edgeList[i].to + 1]++;
+        }
+        prefixSum(offsets.get(), vertices);
+        for (size_t i = 0; i < edgeCount; i++) {
+            const Edge<W>& e = edgeList[i];
+            EdgeIndex slot = offsets[e.from]++;
+            targets[slot] = e.to;
+            weights[slot] = e.weight;
+            if (undirected) {
+                slot = offsets[e.to]++;
+                targets[slot] = e.from;
+                weights[slot] = e.weight;
+            }
+        }
+        shiftBack(offsets.get(), vertices);
+
+        if (!undirected) {
+            inOffsets.reset(new EdgeIndex[static_cast<size_t>(vertices) + 1]());
+            inSources.reset(new VertexId[edges]);
+            for (size_t i = 0; i < edgeCount; i++) inOffsets[edgeList[i].to + 1]++;
+            prefixSum(inOffsets.get(), vertices);
+            for (size_t i = 0; i < edgeCount; i++) inSources[inOffsets[edgeList[i].to]++] = edgeList[i].from;
+            shiftBack(inOffsets.get(), vertices);
+        }
+    }
+
+    CsrGraph(CsrGraph&&) noexcept = default;
+    CsrGraph& operator=(CsrGraph&&) noexcept = default;
+
+    /**
+     * @brief v's outgoing neighbours, in edge-list order.
+     *
+     * Time Complexity  : O(1)
+     * Example:
+     *   for (VertexId u : graph.neighbors(v)) { ... }
+     */
+    NeighborRange neighbors(VertexId v) const {
+        return NeighborRange{ targets.get() + offsets[v], targets.get() + offsets[v + 1] };
+    }
+
+    /**
+     * @brief The weights of v's outgoing edges: weightsOf(v)[i] belongs to the i-th of neighbors(v).
+     *
+     * Time Complexity  : O(1)
+     */
+    const W* weightsOf(VertexId v) const { return weights.get() + offsets[v]; }
+
+    /**
+     * @brief The vertices with an edge into v. The same as neighbors(v) for an undirected graph.
+     *
+     * Time Complexity  : O(1)
+     */
+    NeighborRange inNeighbors(VertexId v) const {
+        if (undirected) return neighbors(v);
+        return NeighborRange{ inSources.get() + inOffsets[v], inSources.get() + inOffsets[v + 1] };
+    }
+
+    /**
+     * @brief Calls fn(target, weight) for each of v's outgoing edges.
+     *
+     * Time Complexity  : O(degree)
+     */
+    template <typename Fn>
+    void forEachNeighbor(VertexId v, Fn&& fn) const {
+        for (EdgeIndex e = offsets[v]; e < offsets[v + 1]; e++) fn(targets[e], weights[e]);
+    }
+
+    size_t outDegree(VertexId v) const { return static_cast<size_t>(offsets[v + 1] - offsets[v]); }
+    size_t inDegree(VertexId v) const {
+        return undirected ? outDegree(v) : static_cast<size_t>(inOffsets[v + 1] - inOffsets[v]);
+    }
+
+    // Heap bytes held by the arrays.
+    size_t memoryBytes() const {
+        if (!offsets) return 0;
+        size_t offsetBytes = (static_cast<size_t>(vertices) + 1) * sizeof(EdgeIndex);
+        size_t bytes = offsetBytes + edges * (sizeof(VertexId) + sizeof(W));
+        if (!undirected) bytes += offsetBytes + edges * sizeof(VertexId);
+        return bytes;
+    }
+
+    VertexId vertexCount() const { return vertices; }
+    EdgeIndex edgeCount() const { return edges; }
+    bool isUndirected() const { return undirected; }
+};
+
+// ***************  BIT TRICKS  ****************
+
+inline unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+inline unsigned popCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<unsigned>(__popcnt64(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// ***************  BITSET ROW KERNELS  ****************
+
+// Each kernel works on `words` 64-bit words of two bitset rows. SSE2 and NEON take two words per step;
+// the popcount is computed in-register (bit slicing, then a byte sum), so no POPCNT instruction is needed.
+
+/**
+* @brief popcount(a & b): the size of the intersection of two bitsets.
+*
+* Time Complexity  : O(words)
+* Example:
+*   a = 0b1011, b = 0b0110  ->  1
+*/
+inline size_t rowAndCount(const uint64_t* a, const uint64_t* b, size_t words) {
+    size_t i = 0, total = 0;
+#if DS_GRAPHS_SIMD_X86
+    const __m128i m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0F);
+    __m128i sums = _mm_setzero_si128();
+    for (; i + 2 <= words; i += 2) {
+        __m128i x = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+        x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+        x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);   // bits set per byte, 0..8
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    total = static_cast<size_t>(lanes[0] + lanes[1]);
+#elif DS_GRAPHS_SIMD_NEON
+    uint64x2_t sums = vdupq_n_u64(0);
+    for (; i + 2 <= words; i += 2) {
+        uint8x16_t x = vandq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(a + i)),
+                                vld1q_u8(reinterpret_cast<const uint8_t*>(b + i)));
+        sums = vaddq_u64(sums, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(x)))));
+    }
+    total = static_cast<size_t>(vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1));
+#endif
+    for (; i < words; i++) total += popCount(a[i] & b[i]);
+    return total;
+}
+
+/**
+* @brief popcount(a): the number of set bits in a bitset.
+*
+* Time Complexity  : O(words)
+*/
+inline size_t rowCount(const uint64_t* a, size_t words) {
+    return rowAndCount(a, a, words);
+}
+
+/**
+* @brief out = a & b. `out` may be `a` or `b`.
+*
+* Time Complexity  : O(words)
+*/
+inline void rowAnd(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t words) {
+    size_t i = 0;
+#if DS_GRAPHS_SIMD_X86
+    for (; i + 2 <= words; i += 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+    }
+#elif DS_GRAPHS_SIMD_NEON
+    for (; i + 2 <= words; i += 2) vst1q_u64(out + i, vandq_u64(vld1q_u64(a + i), vld1q_u64(b + i)));
+#endif
+    for (; i < words; i++) out[i] = a[i] & b[i];
+}
+
+/**
+* @brief out = a | b. `out` may be `a` or `b`.
+*
+* Time Complexity  : O(words)
+*/
+inline void rowOr(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t words) {
+    size_t i = 0;
+#if DS_GRAPHS_SIMD_X86
+    for (; i + 2 <= words; i += 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+    }
+#elif DS_GRAPHS_SIMD_NEON
+    for (; i + 2 <= words; i += 2) vst1q_u64(out + i, vorrq_u64(vld1q_u64(a + i), vld1q_u64(b + i)));
+#endif
+    for (; i < words; i++) out[i] = a[i] | b[i];
+}
+
+// ***************  ADJACENCY BIT MATRIX  ****************
+
+/**
+* @brief An adjacency matrix with one bit per cell: row u is the bitset of u's neighbours.
+*
+* V * V bits instead of V * V ints, 32 times smaller: a 50000-vertex matrix is 313 MB
+* instead of 10 GB. Neighbourhood questions become row operations: common neighbours
+* of u and v are popcount(row[u] & row[v]), computed 128 vertices per SIMD step over two
+* sequential rows, which runs at memory bandwidth.
+*
+* Rows are padded to whole cache lines (512 vertices) and start on a cache-line boundary.
+* The padding bits are always zero, so kernels can run over full rows.
+*
+* An undirected matrix sets both bits for each edge and stays symmetric. Vertex arguments
+* are not checked: they must be below vertexCount().
+*/
+class AdjacencyBitMatrix {
+    static constexpr size_t rowAlignment = 64;    // bytes: rows are whole cache lines
+
+    struct AlignedDelete {
+        void operator()(uint64_t* p) const { ::operator delete(p, align_val_t(rowAlignment)); }
+    };
+
+    VertexId vertices = 0;
+    size_t stride = 0;                           // words per row
+    size_t edges = 0;                            // set bits: each undirected edge counts once
+    bool undirected = false;
+    unique_ptr<uint64_t[], AlignedDelete> bits;
+
+    uint64_t* rowOf(VertexId v) { return bits.get() + v * stride; }
+    const uint64_t* rowOf(VertexId v) const { return bits.get() + v * stride; }
+
+    // Sets one bit; returns whether it was clear.
+    bool setBit(VertexId u, VertexId v) {
+        uint64_t& word = rowOf(u)[v >> 6];
+        uint64_t bit = uint64_t(1) << (v & 63);
+        bool added = (word & bit) == 0;
+        word |= bit;
+        return added;
+    }
+
+    bool clearBit(VertexId u, VertexId v) {
+        uint64_t& word = rowOf(u)[v >> 6];
+        uint64_t bit = uint64_t(1) << (v & 63);
+        bool removed = (word & bit) != 0;
+        word &= ~bit;
+        return removed;
+    }
+
+public:
+    // Words one row occupies; also the length of the `out` row the set operations expect.
+    size_t rowWords() const { return stride; }
+
+    AdjacencyBitMatrix() = default;
+
+    /**
+     * @brief An empty matrix over vertices 0 .. vertexCount - 1.
+     *
+     * Time Complexity  : O(V^2 / 64)
+     */
+    AdjacencyBitMatrix(VertexId vertexCount, EdgeDirection direction)
+        : vertices(vertexCount),
+          stride((static_cast<size_t>(vertexCount) + 511) / 512 * 8),
+          undirected(direction == EdgeDirection::Undirected) {
+        size_t bytes = stride * vertexCount * sizeof(uint64_t);
+        if (bytes != 0) {
+            bits.reset(static_cast<uint64_t*>(::operator new(bytes, align_val_t(rowAlignment))));
+            memset(bits.get(), 0, bytes);
+        }
+    }
+
+    /**
+     * @brief The same graph as `graph`, as a bit matrix. Parallel edges collapse into one bit.
+     *
+     * Time Complexity  : O(V^2 / 64 + E)
+     */
+    template <typename W>
+    explicit AdjacencyBitMatrix(const CsrGraph<W>& graph)
+        : AdjacencyBitMatrix(graph.vertexCount(), graph.isUndirected() ? EdgeDirection::Undirected : EdgeDirection::Directed) {
+        for (VertexId u = 0; u < vertices; u++) {
+            for (VertexId v : graph.neighbors(u)) {
+                if (setBit(u, v) && (!undirected || u <= v)) edges++;
+            }
+        }
+    }
+
+    AdjacencyBitMatrix(AdjacencyBitMatrix&&) noexcept = default;
+    AdjacencyBitMatrix& operator=(AdjacencyBitMatrix&&) noexcept = default;
+
+    /**
+     * @brief Adds the edge u -> v (and v -> u when undirected); returns false if it was already there.
+     *
+     * Time Complexity  : O(1)
+     */
+    bool addEdge(VertexId u, VertexId v) {
+        bool added = setBit(u, v);
+        if (undirected) setBit(v, u);
+        if (added) edges++;
+        return added;
+    }
+
+    /**
+     * @brief Removes the edge u -> v (and v -> u when undirected); returns whether it was there.
+     *
+     * Time Complexity  : O(1)
+     */
+    bool removeEdge(VertexId u, VertexId v) {
+        bool removed = clearBit(u, v);
+        if (undirected) clearBit(v, u);
+        if (removed) edges--;
+        return removed;
+    }
+
+    bool hasEdge(VertexId u, VertexId v) const {
+        return (rowOf(u)[v >> 6] >> (v & 63)) & 1;
+    }
+
+    // u's row: rowWords() words, bit v of the row set for each edge u -> v.
+    const uint64_t* row(VertexId u) const { return rowOf(u); }
+
+    /**
+     * @brief u's out-degree: the popcount of its row.
+     *
+     * Time Complexity  : O(V / 64)
+     */
+    size_t degree(VertexId u) const { return rowCount(rowOf(u), stride); }
+
+    /**
+     * @brief The number of vertices both u and v have an edge to.
+     *
+     * Time Complexity  : O(V / 64)
+     * Example:
+     *   N(0) = {1, 2, 3}, N(4) = {2, 3, 5}  ->  commonNeighbors(0, 4) = 2
+     */
+    size_t commonNeighbors(VertexId u, VertexId v) const {
+        return rowAndCount(rowOf(u), rowOf(v), stride);
+    }
+
+    /**
+     * @brief Calls fn(w) for each w that both u and v have an edge to, in increasing order.
+     *
+     * Time Complexity  : O(V / 64 + matches)
+     */
+    template <typename Fn>
+    void forEachCommonNeighbor(VertexId u, VertexId v, Fn&& fn) const {
+        const uint64_t* a = rowOf(u);
+        const uint64_t* b = rowOf(v);
+        for (size_t w = 0; w < stride; w++) {
+            uint64_t both = a[w] & b[w];
+            while (both != 0) {
+                fn(static_cast<VertexId>(w * 64 + countTrailingZeros(both)));
+                both &= both - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief out = N(u) & N(v) (the common neighbours) as a bitset of rowWords() words.
+     *
+     * Time Complexity  : O(V / 64)
+     */
+    void intersectRows(VertexId u, VertexId v, uint64_t* out) const { rowAnd(rowOf(u), rowOf(v), out, stride); }
+
+    /**
+     * @brief out = N(u) | N(v) (the vertices adjacent to either) as a bitset of rowWords() words.
+     *
+     * Time Complexity  : O(V / 64)
+     */
+    void uniteRows(VertexId u, VertexId v, uint64_t* out) const { rowOr(rowOf(u), rowOf(v), out, stride); }
+
+    /**
+     * @brief The number of triangles through u: edges among u's neighbours.
+     *
+     * Sums commonNeighbors(u, v) over u's neighbours v; each triangle is then seen from
+     * both of its other corners. Self-loops are ignored. Meant for undirected matrices.
+     *
+     * Time Complexity  : O(degree(u) * V / 64)
+     */
+    size_t trianglesAt(VertexId u) const {
+        const uint64_t* a = rowOf(u);
+        size_t total = 0;
+        for (size_t w = 0; w < stride; w++) {
+            uint64_t neighbours = a[w];
+            while (neighbours != 0) {
+                VertexId v = static_cast<VertexId>(w * 64 + countTrailingZeros(neighbours));
+                neighbours &= neighbours - 1;
+                if (v == u) continue;
+                total += commonNeighbors(u, v) - hasEdge(v, v) - hasEdge(u, u);
+            }
+        }
+        return total / 2;
+    }
+
+    /**
+     * @brief Counts the triangles u < v < w with edges u-v, u-w and v-w.
+     *
+     * For each edge u-v with u < v, counts the common neighbours w > v: the AND of the two
+     * rows from v's word onwards, with the bits up to v masked off in the first word. Every
+     * triangle is counted once, from its smallest vertex, and self-loops never qualify.
+     * On a directed matrix this counts the triples with u -> v, u -> w and v -> w.
+     *
+     * Time Complexity  : O(E * V / 64)
+     * Example:
+     *   K4 (every pair of 4 vertices joined)  ->  4
+     */
+    uint64_t countTriangles() const {
+        uint64_t total = 0;
+        for (VertexId u = 0; u < vertices; u++) {
+            const uint64_t* a = rowOf(u);
+            for (size_t w = (static_cast<size_t>(u) + 1) >> 6; w < stride; w++) {
+                uint64_t later = a[w];
+                if (w == (static_cast<size_t>(u) + 1) >> 6) later &= ~uint64_t(0) << ((u + 1) & 63);
+                while (later != 0) {
+                    VertexId v = static_cast<VertexId>(w * 64 + countTrailingZeros(later));
+                    later &= later - 1;
+                    const uint64_t* b = rowOf(v);
+                    size_t first = v >> 6;
+                    uint64_t above = (v & 63) == 63 ? 0 : ~uint64_t(0) << ((v & 63) + 1);
+                    total += popCount(a[first] & b[first] & above);
+                    total += rowAndCount(a + first + 1, b + first + 1, stride - first - 1);
+                }
+            }
+        }
+        return total;
+    }
+
+    // Heap bytes held by the rows.
+    size_t memoryBytes() const { return stride * vertices * sizeof(uint64_t); }
+
+    VertexId vertexCount() const { return vertices; }
+    size_t edgeCount() const { return edges; }
+    bool isUndirected() const { return undirected; }
+};
+
+// ***************  THREAD BARRIER  ****************
+
+/**
+* @brief Blocks each of `count` threads until all of them have arrived.
+*
+* The last thread to arrive runs a completion function before releasing the others, so
+* serial work between two parallel phases needs no extra synchronization: everything it
+* writes is visible to every thread once they resume.
+*/
+class ThreadBarrier {
+    mutex lock;
+    condition_variable released;
+    const unsigned count;
+    unsigned arrived = 0;
+    uint64_t generation = 0;
+
+public:
+    explicit ThreadBarrier(unsigned threadCount) : count(threadCount) {}
+
+    ThreadBarrier(const ThreadBarrier&) = delete;
+    ThreadBarrier& operator=(const ThreadBarrier&) = delete;
+
+    template <typename Completion>
+    void arriveAndWait(Completion&& completion) {
+        unique_lock<mutex> guard(lock);
+        uint64_t phase = generation;
+        if (++arrived == count) {
+            completion();
+            arrived = 0;
+            generation++;
+            released.notify_all();
+            return;
+        }
+        released.wait(guard, [&] { return generation != phase; });
+    }
+};
+
+// ***************  DIRECTION-OPTIMIZING BFS  ****************
+
+enum class BfsDirection {
+    Auto,       // switch between the two per level
+    TopDown,    // always expand the frontier's edges
+    BottomUp    // always search parents for unvisited vertices
+};
+
+/**
+* @brief Parallel breadth-first search over a CsrGraph, switching between top-down and bottom-up per level.
+*
+* Top-down, threads take chunks of the frontier queue and claim each unvisited neighbour
+* with one atomic OR on the visited bitmap; the winner records the parent and appends the
+* vertex to the next queue through a per-thread buffer.
+*
+* Bottom-up, threads take chunks of 64-vertex bitmap words. For each unvisited vertex they
+* scan its incoming edges for a vertex in the frontier bitmap and stop at the first hit.
+* A thread owns whole words of the visited and next-frontier bitmaps, so this step needs no
+* atomic read-modify-write at all. On a low-diameter graph, most edges are never looked at:
+* a vertex is done as soon as one of its parents is found.
+*
+* Auto mode goes bottom-up once the frontier's outgoing edges exceed 1/alpha of the edges
+* still unexplored. It returns top-down once the frontier shrinks below 1/beta of the vertices.
+*
+* The search owns its depth, parent, queue and bitmap arrays, allocated once in the
+* constructor, so repeated runs allocate nothing. Each run starts a fresh team of
+* threads; the graph must outlive the search.
+*/
+template <typename W>
+class ParallelBfs {
+public:
+    static constexpr uint64_t alpha = 15;
+    static constexpr uint64_t beta = 18;
+
+private:
+    static constexpr size_t topDownChunk = 64;     // frontier vertices per grab
+    static constexpr size_t bottomUpChunk = 16;    // bitmap words (1024 vertices) per grab
+    static constexpr size_t localBufferSize = 256; // discovered vertices a thread batches before appending
+
+    enum class Phase : uint8_t { Reset, ClearBitmap, QueueToBitmap, BitmapToQueue, TopDown, BottomUp, Done };
+
+    const CsrGraph<W>* graph;
+    unsigned threads;
+    size_t words;                                   // ceil(vertices / 64)
+    unique_ptr<int32_t[]> depthOf;                  // -1 when unreached
+    unique_ptr<VertexId[]> parentOf;                // nullVertex when unreached
+    unique_ptr<atomic<uint64_t>[]> visited;
+    unique_ptr<atomic<uint64_t>[]> frontierBits;
+    unique_ptr<atomic<uint64_t>[]> nextBits;
+    unique_ptr<VertexId[]> frontierQueue;
+    unique_ptr<VertexId[]> nextQueue;
+
+    // Shared by the team; the counters are atomic, the rest is only written between phases.
+    atomic<size_t> cursor{ 0 };                     // next chunk of the current phase
+    atomic<size_t> queueTail{ 0 };                  // next free slot of the queue being filled
+    atomic<size_t> found{ 0 };                      // vertices discovered in this step
+    atomic<uint64_t> foundEdges{ 0 };               // and their outgoing edges
+    Phase phase = Phase::Done;
+    BfsDirection mode = BfsDirection::Auto;
+    BfsDirection lastStep = BfsDirection::TopDown;
+    bool frontierIsBitmap = false;
+    VertexId source = nullVertex;
+    int32_t level = 0;                              // depth of the current frontier
+    size_t frontierSize = 0;
+    size_t previousFrontierSize = 0;
+    uint64_t frontierEdges = 0;                     // outgoing edges of the frontier
+    uint64_t unexploredEdges = 0;                   // outgoing edges of unvisited vertices
+    size_t reached = 0;
+    uint32_t topDownCount = 0;
+    uint32_t bottomUpCount = 0;
+
+    // Hands the calling thread the next [begin, end) of `total` items, or returns false when all are taken.
+    bool grab(size_t total, size_t chunk, size_t& begin, size_t& end) {
+        begin = cursor.fetch_add(chunk, memory_order_relaxed);
+        if (begin >= total) return false;
+        end = total - begin < chunk ? total : begin + chunk;
+        return true;
+    }
+
+    // Appends a thread's buffered vertices to `queue` at a reserved range.
+    void flush(VertexId* queue, const VertexId* buffer, size_t& buffered) {
+        if (buffered == 0) return;
+        size_t at = queueTail.fetch_add(buffered, memory_order_relaxed);
+        memcpy(queue + at, buffer, buffered * sizeof(VertexId));
+        buffered = 0;
+    }
+
+    /**
+     * @brief Marks every vertex unreached. Bits past the last vertex start visited, so no step ever picks them.
+     *
+     * Time Complexity  : O(V / threads)
+     */
+    void resetPhase() {
+        const size_t vertices = graph->vertexCount();
+        size_t begin, end;
+        while (grab(words, bottomUpChunk, begin, end)) {
+            for (size_t w = begin; w < end; w++) {
+                size_t first = w * 64, last = first + 64 < vertices ? first + 64 : vertices;
+                for (size_t v = first; v < last; v++) {
+                    depthOf[v] = -1;
+                    parentOf[v] = nullVertex;
+                }
+                visited[w].store(last - first == 64 ? 0 : ~uint64_t(0) << (last - first), memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Expands the frontier queue's edges, claiming unvisited targets with an atomic OR.
+     *
+     * Time Complexity  : O(edges of the frontier / threads)
+     */
+    void topDownPhase() {
+        VertexId buffer[localBufferSize];
+        size_t buffered = 0, count = 0;
+        uint64_t edges = 0;
+        const int32_t nextDepth = level + 1;
+        size_t begin, end;
+        while (grab(frontierSize, topDownChunk, begin, end)) {
+            for (size_t i = begin; i < end; i++) {
+                VertexId u = frontierQueue[i];
+                for (VertexId v : graph->neighbors(u)) {
+                    uint64_t bit = uint64_t(1) << (v & 63);
+                    atomic<uint64_t>& word = visited[v >> 6];
+                    if (word.load(memory_order_relaxed) & bit) continue;           // cheap test before the atomic
+                    if (word.fetch_or(bit, memory_order_relaxed) & bit) continue;  // another thread won it
+                    parentOf[v] = u;
+                    depthOf[v] = nextDepth;
+                    edges += graph->outDegree(v);
+                    count++;
+                    buffer[buffered++] = v;
+                    if (buffered == localBufferSize) flush(nextQueue.get(), buffer, buffered);
+                }
+            }
+        }
+        flush(nextQueue.get(), buffer, buffered);
+        found.fetch_add(count, memory_order_relaxed);
+        foundEdges.fetch_add(edges, memory_order_relaxed);
+    }
+
+    /**
+     * @brief For every unvisited vertex, looks for one parent in the frontier bitmap. Writes whole next-bitmap words.
+     *
+     * Time Complexity  : O((V + edges scanned) / threads)
+     */
+    void bottomUpPhase() {
+        size_t count = 0;
+        uint64_t edges = 0;
+        const int32_t nextDepth = level + 1;
+        size_t begin, end;
+        while (grab(words, bottomUpChunk, begin, end)) {
+            for (size_t w = begin; w < end; w++) {
+                uint64_t seen = visited[w].load(memory_order_relaxed);
+                uint64_t todo = ~seen, claimed = 0;
+                while (todo != 0) {
+                    unsigned bit = countTrailingZeros(todo);
+                    todo &= todo - 1;
+                    VertexId v = static_cast<VertexId>(w * 64 + bit);
+                    for (VertexId u : graph->inNeighbors(v)) {
+                        if ((frontierBits[u >> 6].load(memory_order_relaxed) >> (u & 63)) & 1) {
+                            parentOf[v] = u;
+                            depthOf[v] = nextDepth;
+                            edges += graph->outDegree(v);
+                            claimed |= uint64_t(1) << bit;
+                            break;
+                        }
+                    }
+                }
+                nextBits[w].store(claimed, memory_order_relaxed);
+                if (claimed != 0) visited[w].store(seen | claimed, memory_order_relaxed);
+                count += popCount(claimed);
+            }
+        }
+        found.fetch_add(count, memory_order_relaxed);
+        foundEdges.fetch_add(edges, memory_order_relaxed);
+    }
+
+    void clearBitmapPhase() {
+        size_t begin, end;
+        while (grab(words, bottomUpChunk, begin, end)) {
+            for (size_t w = begin; w < end; w++) frontierBits[w].store(0, memory_order_relaxed);
+        }
+    }
+
+    void queueToBitmapPhase() {
+        size_t begin, end;
+        while (grab(frontierSize, topDownChunk, begin, end)) {
+            for (size_t i = begin; i < end; i++) {
+                VertexId v = frontierQueue[i];
+                frontierBits[v >> 6].fetch_or(uint64_t(1) << (v & 63), memory_order_relaxed);
+            }
+        }
+    }
+
+    void bitmapToQueuePhase() {
+        VertexId buffer[localBufferSize];
+        size_t buffered = 0;
+        size_t begin, end;
+        while (grab(words, bottomUpChunk, begin, end)) {
+            for (size_t w = begin; w < end; w++) {
+                uint64_t bits = frontierBits[w].load(memory_order_relaxed);
+                while (bits != 0) {
+                    buffer[buffered++] = static_cast<VertexId>(w * 64 + countTrailingZeros(bits));
+                    bits &= bits - 1;
+                    if (buffered == localBufferSize) flush(frontierQueue.get(), buffer, buffered);
+                }
+            }
+        }
+        flush(frontierQueue.get(), buffer, buffered);
+    }
+
+    // The direction of the next step, from the frontier's size and edge count (Beamer's heuristic).
+    BfsDirection chooseDirection() const {
+        if (mode != BfsDirection::Auto) return mode;
+        if (lastStep == BfsDirection::TopDown) {
+            return frontierEdges > unexploredEdges / alpha ? BfsDirection::BottomUp : BfsDirection::TopDown;
+        }
+        bool shrinking = frontierSize < previousFrontierSize;
+        return shrinking && frontierSize <= graph->vertexCount() / beta ? BfsDirection::TopDown : BfsDirection::BottomUp;
+    }
+
+    /**
+     * @brief Serial work between phases, run by the last thread to reach the barrier: picks the next phase.
+     *
+     * Time Complexity  : O(1)
+     */
+    void advance() {
+        cursor.store(0, memory_order_relaxed);
+        switch (phase) {
+        case Phase::Reset:
+            visited[source >> 6].fetch_or(uint64_t(1) << (source & 63), memory_order_relaxed);
+            depthOf[source] = 0;
+            parentOf[source] = source;
+            frontierQueue[0] = source;
+            frontierSize = 1;
+            frontierIsBitmap = false;
+            frontierEdges = graph->outDegree(source);
+            unexploredEdges = graph->edgeCount() - frontierEdges;
+            reached = 1;
+            break;
+        case Phase::ClearBitmap:
+            phase = Phase::QueueToBitmap;
+            return;
+        case Phase::QueueToBitmap:
+            frontierIsBitmap = true;
+            phase = Phase::BottomUp;
+            return;
+        case Phase::BitmapToQueue:
+            queueTail.store(0, memory_order_relaxed);
+            frontierIsBitmap = false;
+            phase = Phase::TopDown;
+            return;
+        case Phase::TopDown:
+        case Phase::BottomUp:
+            if (phase == Phase::TopDown) {
+                swap(frontierQueue, nextQueue);
+                frontierIsBitmap = false;
+                lastStep = BfsDirection::TopDown;
+                topDownCount++;
+            }
+            else {
+                swap(frontierBits, nextBits);
+                frontierIsBitmap = true;
+                lastStep = BfsDirection::BottomUp;
+                bottomUpCount++;
+            }
+            previousFrontierSize = frontierSize;
+            frontierSize = found.exchange(0, memory_order_relaxed);
+            frontierEdges = foundEdges.exchange(0, memory_order_relaxed);
+            unexploredEdges -= frontierEdges;
+            queueTail.store(0, memory_order_relaxed);
+            reached += frontierSize;
+            level++;
+            break;
+        case Phase::Done:
+            return;
+        }
+
+        if (frontierSize == 0) {
+            phase = Phase::Done;
+            return;
+        }
+        if (chooseDirection() == BfsDirection::TopDown) {
+            phase = frontierIsBitmap ? Phase::BitmapToQueue : Phase::TopDown;
+        }
+        else {
+            phase = frontierIsBitmap ? Phase::BottomUp : Phase::ClearBitmap;
+        }
+    }
+
+    // One team member: runs phases until the search is done.
+    void work(ThreadBarrier& barrier) {
+        for (;;) {
+            switch (phase) {
+            case Phase::Reset: resetPhase(); break;
+            case Phase::ClearBitmap: clearBitmapPhase(); break;
+            case Phase::QueueToBitmap: queueToBitmapPhase(); break;
+            case Phase::BitmapToQueue: bitmapToQueuePhase(); break;
+            case Phase::TopDown: topDownPhase(); break;
+            case Phase::BottomUp: bottomUpPhase(); break;
+            case Phase::Done: return;
+            }
+            barrier.arriveAndWait([this] { advance(); });
+        }
+    }
+
+public:
+    /**
+     * @brief Prepares a search over `graph` with `threadCount` threads (0 = one per hardware thread).
+     *
+     * Allocates every array a run needs: 8 bytes per vertex for depths and parents, 8 for
+     * the two queues, and three bits for the bitmaps.
+     *
+     * Time Complexity  : O(V)
+     */
+    explicit ParallelBfs(const CsrGraph<W>& g, unsigned threadCount = 0)
+        : graph(&g),
+          threads(threadCount != 0 ? threadCount : (thread::hardware_concurrency() != 0 ? thread::hardware_concurrency() : 1)),
+          words((static_cast<size_t>(g.vertexCount()) + 63) / 64),
+          depthOf(new int32_t[g.vertexCount()]),
+          parentOf(new VertexId[g.vertexCount()]),
+          visited(new atomic<uint64_t>[words]),
+          frontierBits(new atomic<uint64_t>[words]),
+          nextBits(new atomic<uint64_t>[words]),
+          frontierQueue(new VertexId[g.vertexCount()]),
+          nextQueue(new VertexId[g.vertexCount()]) {
+        for (size_t w = 0; w < words; w++) {
+            visited[w].store(~uint64_t(0), memory_order_relaxed);   // nothing reached before the first run
+            frontierBits[w].store(0, memory_order_relaxed);
+            nextBits[w].store(0, memory_order_relaxed);
+        }
+        for (VertexId v = 0; v < g.vertexCount(); v++) {
+            depthOf[v] = -1;
+            parentOf[v] = nullVertex;
+        }
+    }
+
+    ParallelBfs(const ParallelBfs&) = delete;
+    ParallelBfs& operator=(const ParallelBfs&) = delete;
+
+    /**
+     * @brief Searches from `source`; returns the number of vertices reached, the source included.
+     *
+     * Every reached vertex gets its depth (edges from the source) and a parent one level
+     * closer. Depths are the same whatever the direction or thread count. Parents may
+     * differ between runs when a vertex has several parents in the frontier.
+     * Graphs of fewer than 1024 vertices per thread use fewer threads.
+     *
+     * Time Complexity  : O(V + E) work, over `threads` threads
+     * Example:
+     *   path 0 - 1 - 2 - 3, run(0)  ->  4, depth(3) = 3, parent(3) = 2
+     *
+     * @throws out_of_range if source is not a vertex of the graph.
+     */
+    size_t run(VertexId source, BfsDirection direction = BfsDirection::Auto) {
+        if (source >= graph->vertexCount()) throw out_of_range("Source vertex out of range");
+        this->source = source;
+        mode = direction;
+        lastStep = BfsDirection::TopDown;
+        phase = Phase::Reset;
+        level = 0;
+        frontierSize = previousFrontierSize = 0;
+        reached = 0;
+        topDownCount = bottomUpCount = 0;
+        cursor.store(0, memory_order_relaxed);
+        queueTail.store(0, memory_order_relaxed);
+        found.store(0, memory_order_relaxed);
+        foundEdges.store(0, memory_order_relaxed);
+
+        size_t chunks = (words + bottomUpChunk - 1) / bottomUpChunk;
+        unsigned team = chunks < threads ? static_cast<unsigned>(chunks) : threads;
+        if (team == 0) team = 1;
+        ThreadBarrier barrier(team);
+        unique_ptr<thread[]> helpers(new thread[team - 1]);
+        for (unsigned t = 0; t + 1 < team; t++) helpers[t] = thread([this, &barrier] { work(barrier); });
+        work(barrier);
+        for (unsigned t = 0; t + 1 < team; t++) helpers[t].join();
+        return reached;
+    }
+
+    // Edges on a shortest path from the last source to v, or -1 when v was not reached.
+    int32_t depth(VertexId v) const { return depthOf[v]; }
+
+    // v's predecessor on a shortest path (the source is its own parent), or nullVertex when not reached.
+    VertexId parent(VertexId v) const { return parentOf[v]; }
+
+    bool isReached(VertexId v) const { return depthOf[v] >= 0; }
+
+    // The whole depth array, vertexCount() entries.
+    const int32_t* depths() const { return depthOf.get(); }
+
+    size_t reachedCount() const { return reached; }
+
+    // Distinct depths in the last run: the deepest vertex's depth plus one.
+    uint32_t levels() const { return static_cast<uint32_t>(level); }
+
+    uint32_t topDownSteps() const { return topDownCount; }
+    uint32_t bottomUpSteps() const { return bottomUpCount; }
+    unsigned threadCount() const { return threads; }
+};
+
+// ***************  SHORTEST PATHS  ****************
+
+// The type of path lengths over weights W: wide enough that a long path does not overflow.
+template <typename W>
+using PathLength = conditional_t<is_floating_point<W>::value, double,
+                                 conditional_t<is_signed<W>::value, int64_t, uint64_t>>;
+
+/**
+* @brief A growable array of trivially copyable values. clear() keeps the storage.
+*/
+template <typename T>
+class GrowableBuffer {
+    static_assert(is_trivially_copyable<T>::value, "GrowableBuffer copies with memcpy: T must be trivially copyable");
+
+    unique_ptr<T[]> items;
+    size_t count = 0;
+    size_t capacity = 0;
+
+public:
+    void reserve(size_t n) {
+        if (n <= capacity) return;
+        size_t grown = capacity * 2 > n ? capacity * 2 : n;
+        unique_ptr<T[]> fresh(new T[grown]);
+        if (count != 0) memcpy(fresh.get(), items.get(), count * sizeof(T));
+        items = std::move(fresh);
+        capacity = grown;
+    }
+
+    void pushBack(const T& value) {
+        if (count == capacity) reserve(count < 16 ? 16 : count + 1);
+        items[count++] = value;
+    }
+
+    // Sets the size to n; new elements are uninitialized.
+    void resize(size_t n) {
+        reserve(n);
+        count = n;
+    }
+
+    void clear() { count = 0; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T* data() { return items.get(); }
+    const T* data() const { return items.get(); }
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+};
+
+/**
+* @brief The per-query state of a shortest-path search, allocated once and reused by every query.
+*
+* Distances, parents and the heap are sized for the graph up front. A new query does not
+* clear them: each vertex carries the number of the search that last wrote it (a stamp),
+* and a vertex whose stamp is not the current search's counts as unreached. Starting a
+* query is then one increment, however large the graph. Only when the 32-bit counter wraps,
+* once in four billion queries, are the stamps cleared.
+*
+* One workspace serves one query at a time. Give each thread its own workspace to run
+* queries on the same graph in parallel.
+*/
+template <typename W>
+class SearchWorkspace {
+public:
+    using Distance = PathLength<W>;
+    static constexpr Distance unreachable = numeric_limits<Distance>::has_infinity
+        ? numeric_limits<Distance>::infinity() : numeric_limits<Distance>::max();
+
+private:
+    template <typename> friend class ShortestPaths;
+
+    static constexpr uint32_t settled = UINT32_MAX;   // heapSlot of a vertex that has left the heap
+    static constexpr size_t heapArity = 4;
+    static constexpr size_t heapAlignment = 64;
+
+    struct HeapEntry {
+        Distance key;
+        VertexId vertex;
+    };
+
+    struct AlignedDelete {
+        void operator()(HeapEntry* p) const {
+            ::operator delete(p - (heapArity - 1), align_val_t(heapAlignment));
+        }
+    };
+
+    VertexId vertices;
+    uint32_t epoch = 0;
+    unique_ptr<atomic<uint32_t>[]> stamp;       // == epoch once the vertex has a distance in this search
+    unique_ptr<atomic<Distance>[]> dist;
+    unique_ptr<VertexId[]> parentOf;
+    unique_ptr<uint32_t[]> heapSlot;            // Dijkstra: the vertex's slot in the heap, or settled
+    unique_ptr<atomic<uint8_t>[]> locks;        // delta-stepping: one spinlock byte per vertex
+
+    // A 4-ary min-heap of (distance, vertex). Three unused slots in front of the root make
+    // each group of four siblings start on a 64-byte boundary: one cache line per level.
+    unique_ptr<HeapEntry[], AlignedDelete> heap;
+    size_t heapSize = 0;
+
+    GrowableBuffer<VertexId> frontier;          // delta-stepping: the bucket being relaxed
+    unique_ptr<GrowableBuffer<VertexId>[]> bins;   // binThreads x binRing per-thread buckets
+    unique_ptr<size_t[]> binOffsets;            // where each thread's bucket goes in `frontier`
+    unsigned binThreads = 0;
+    size_t binRing = 0;
+
+    size_t settledCount = 0;
+
+    // Starts a new search: every vertex becomes unreached in O(1).
+    void begin() {
+        if (++epoch == 0) {
+            for (VertexId v = 0; v < vertices; v++) stamp[v].store(0, memory_order_relaxed);
+            epoch = 1;
+        }
+        heapSize = 0;
+        settledCount = 0;
+    }
+
+    // Makes room for `threads` threads with `ring` buckets each. Grows only.
+    void prepareBins(unsigned threads, size_t ring) {
+        if (threads <= binThreads && ring <= binRing) return;
+        unsigned t = threads > binThreads ? threads : binThreads;
+        size_t r = ring > binRing ? ring : binRing;
+        bins.reset(new GrowableBuffer<VertexId>[t * r]);
+        binOffsets.reset(new size_t[t]);
+        binThreads = t;
+        binRing = r;
+    }
+
+public:
+    /**
+     * @brief A workspace for graphs of up to `vertexCount` vertices.
+     *
+     * About 37 bytes per vertex with 64-bit distances, the heap included.
+     *
+     * Time Complexity  : O(V)
+     */
+    explicit SearchWorkspace(VertexId vertexCount)
+        : vertices(vertexCount),
+          stamp(new atomic<uint32_t>[vertexCount]),
+          dist(new atomic<Distance>[vertexCount]),
+          parentOf(new VertexId[vertexCount]),
+          heapSlot(new uint32_t[vertexCount]),
+          locks(new atomic<uint8_t>[vertexCount]) {
+        void* raw = ::operator new((static_cast<size_t>(vertexCount) + heapArity - 1) * sizeof(HeapEntry),
+                                   align_val_t(heapAlignment));
+        heap.reset(static_cast<HeapEntry*>(raw) + (heapArity - 1));
+        for (VertexId v = 0; v < vertexCount; v++) {
+            stamp[v].store(0, memory_order_relaxed);
+            locks[v].store(0, memory_order_relaxed);
+        }
+    }
+
+    SearchWorkspace(const SearchWorkspace&) = delete;
+    SearchWorkspace& operator=(const SearchWorkspace&) = delete;
+
+    // Whether the last search reached v.
+    bool isReached(VertexId v) const { return stamp[v].load(memory_order_relaxed) == epoch; }
+
+    /**
+     * @brief v's distance from the last search's source, or `unreachable`.
+     *
+     * After a Dijkstra query with a target, only settled vertices (the target among them)
+     * have final distances; the others hold the best found so far.
+     */
+    Distance distance(VertexId v) const { return isReached(v) ? dist[v].load(memory_order_relaxed) : unreachable; }
+
+    // v's predecessor on its shortest path (the source is its own parent), or nullVertex.
+    VertexId parent(VertexId v) const { return isReached(v) ? parentOf[v] : nullVertex; }
+
+    /**
+     * @brief Writes the path source .. target into `out` and returns its vertex count, or 0 if target was not reached.
+     *
+     * `out` needs room for the path: at most vertexCount() vertices.
+     *
+     * Time Complexity  : O(path length)
+     * Example:
+     *   edges 0->2, 2->3 on the shortest path  ->  pathTo(3, out) = 3, out = [0, 2, 3]
+     */
+    size_t pathTo(VertexId target, VertexId* out) const {
+        if (!isReached(target)) return 0;
+        size_t length = 1;
+        for (VertexId v = target; parentOf[v] != v; v = parentOf[v]) length++;
+        size_t i = length;
+        VertexId v = target;
+        for (;;) {
+            out[--i] = v;
+            if (parentOf[v] == v) break;
+            v = parentOf[v];
+        }
+        return length;
+    }
+
+    // Vertices the last search settled (Dijkstra) or reached (delta-stepping).
+    size_t settledVertices() const { return settledCount; }
+
+    VertexId vertexCount() const { return vertices; }
+};
+
+/**
+* @brief Single-source shortest paths over a CsrGraph with non-negative weights.
+*
+* dijkstra() is the sequential algorithm on the workspace's 4-ary heap, with an early
+* exit when a target is given. For the short point-to-point queries that dominate
+* routing workloads, it touches only the vertices it settles: with a reused workspace,
+* neither the setup nor the search costs anything proportional to the whole graph.
+*
+* deltaStepping() settles whole distance buckets [i * delta, (i + 1) * delta) in
+* parallel. Threads take chunks of the current bucket, relax their edges, and put
+* improved vertices into per-thread buckets. A barrier then gathers the next non-empty
+* bucket. On low-diameter graphs each bucket holds thousands of vertices, enough work to
+* keep every thread busy, where Dijkstra can only settle one vertex at a time.
+*
+* The engine holds no per-query state: any number of threads may run queries at once,
+* each with its own SearchWorkspace.
+*/
+template <typename W>
+class ShortestPaths {
+public:
+    using Distance = PathLength<W>;
+    using Workspace = SearchWorkspace<W>;
+
+private:
+    using HeapEntry = typename Workspace::HeapEntry;
+    static constexpr size_t arity = Workspace::heapArity;
+    static constexpr size_t relaxChunk = 64;       // bucket vertices per grab
+
+    const CsrGraph<W>* graph;
+    Distance heaviest = Distance();                // the largest edge weight
+    Distance defaultDelta = Distance(1);
+
+    // Shared state of one delta-stepping run. Written only between phases, except for the atomics.
+    struct DeltaRun {
+        enum class Step : uint8_t { Relax, Gather, Done };
+
+        Workspace& ws;
+        Distance delta;
+        size_t ring;                               // live buckets always lie in [current, current + ring)
+        Step step = Step::Relax;
+        size_t current = 0;                        // index of the bucket being relaxed
+        atomic<size_t> cursor{ 0 };
+        atomic<size_t> reached{ 1 };
+
+        DeltaRun(Workspace& workspace, Distance d, size_t r) : ws(workspace), delta(d), ring(r) {}
+    };
+
+    void checkQuery(VertexId source, const Workspace& ws) const {
+        if (source >= graph->vertexCount()) throw out_of_range("Source vertex out of range");
+        if (ws.vertexCount() < graph->vertexCount()) throw invalid_argument("Workspace is smaller than the graph");
+    }
+
+    static void siftUp(Workspace& ws, size_t hole) {
+        HeapEntry* heap = ws.heap.get();
+        HeapEntry entry = heap[hole];
+        while (hole > 0) {
+            size_t parent = (hole - 1) / arity;
+            if (!(entry.key < heap[parent].key)) break;
+            heap[hole] = heap[parent];
+            ws.heapSlot[heap[hole].vertex] = static_cast<uint32_t>(hole);
+            hole = parent;
+        }
+        heap[hole] = entry;
+        ws.heapSlot[entry.vertex] = static_cast<uint32_t>(hole);
+    }
+
+    static void siftDown(Workspace& ws, size_t hole) {
+        HeapEntry* heap = ws.heap.get();
+        const size_t count = ws.heapSize;
+        HeapEntry entry = heap[hole];
+        for (;;) {
+            size_t first = hole * arity + 1;
+            if (first >= count) break;
+            size_t last = first + arity < count ? first + arity : count;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; child++) {
+                if (heap[child].key < heap[best].key) best = child;
+            }
+            if (!(heap[best].key < entry.key)) break;
+            heap[hole] = heap[best];
+            ws.heapSlot[heap[hole].vertex] = static_cast<uint32_t>(hole);
+            hole = best;
+        }
+        heap[hole] = entry;
+        ws.heapSlot[entry.vertex] = static_cast<uint32_t>(hole);
+    }
+
+    static void reach(Workspace& ws, VertexId v, Distance d, VertexId parent) {
+        ws.dist[v].store(d, memory_order_relaxed);
+        ws.parentOf[v] = parent;
+        ws.stamp[v].store(ws.epoch, memory_order_release);
+    }
+
+    static size_t bucketOf(Distance d, Distance delta) { return static_cast<size_t>(d / delta); }
+
+    /**
+     * @brief Lowers v's distance to d if that is an improvement; returns whether it was, and sets `first` on a first visit.
+     *
+     * A relaxed read filters out most non-improvements without the lock. The stamp is written
+     * after the distance, with release order, so a reader that sees the current stamp also sees
+     * a distance from this search.
+     */
+    static bool relaxLocked(Workspace& ws, VertexId v, Distance d, VertexId parent, bool& first) {
+        if (ws.stamp[v].load(memory_order_acquire) == ws.epoch && ws.dist[v].load(memory_order_relaxed) <= d) return false;
+        atomic<uint8_t>& lock = ws.locks[v];
+        while (lock.exchange(1, memory_order_acquire) != 0) {
+            while (lock.load(memory_order_relaxed) != 0) this_thread::yield();
+        }
+        bool seen = ws.stamp[v].load(memory_order_relaxed) == ws.epoch;
+        bool improved = !seen || d < ws.dist[v].load(memory_order_relaxed);
+        if (improved) {
+            ws.dist[v].store(d, memory_order_relaxed);
+            ws.parentOf[v] = parent;
+            if (!seen) ws.stamp[v].store(ws.epoch, memory_order_release);
+        }
+        lock.store(0, memory_order_release);
+        first = !seen;
+        return improved;
+    }
+
+    // Relaxes the edges of the current bucket's vertices, in chunks shared between threads.
+    void relaxPhase(DeltaRun& run, unsigned id) const {
+        Workspace& ws = run.ws;
+        GrowableBuffer<VertexId>* mine = ws.bins.get() + id * ws.binRing;
+        const size_t total = ws.frontier.size();
+        size_t firstVisits = 0;
+        for (;;) {
+            size_t begin = run.cursor.fetch_add(relaxChunk, memory_order_relaxed);
+            if (begin >= total) break;
+            size_t end = total - begin < relaxChunk ? total : begin + relaxChunk;
+            for (size_t i = begin; i < end; i++) {
+                VertexId u = ws.frontier[i];
+                Distance du = ws.dist[u].load(memory_order_relaxed);
+                if (bucketOf(du, run.delta) < run.current) continue;   // settled in an earlier bucket: a stale entry
+                const VertexId* targets = graph->neighbors(u).begin();
+                const W* weights = graph->weightsOf(u);
+                const size_t degree = graph->outDegree(u);
+                for (size_t e = 0; e < degree; e++) {
+                    Distance d = du + static_cast<Distance>(weights[e]);
+                    bool first = false;
+                    if (relaxLocked(ws, targets[e], d, u, first)) {
+                        mine[bucketOf(d, run.delta) % run.ring].pushBack(targets[e]);
+                        firstVisits += first;
+                    }
+                }
+            }
+        }
+        run.reached.fetch_add(firstVisits, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Between phases: finds the next non-empty bucket across all threads and sizes the frontier for it.
+     *
+     * Time Complexity  : O(threads * ring)
+     */
+    void chooseBucket(DeltaRun& run, unsigned team) const {
+        Workspace& ws = run.ws;
+        size_t next = SIZE_MAX;
+        for (unsigned t = 0; t < team; t++) {
+            GrowableBuffer<VertexId>* theirs = ws.bins.get() + t * ws.binRing;
+            for (size_t b = run.current; b < run.current + run.ring && b < next; b++) {
+                if (!theirs[b % run.ring].isEmpty()) {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        if (next == SIZE_MAX) {
+            run.step = DeltaRun::Step::Done;
+            return;
+        }
+        size_t total = 0;
+        for (unsigned t = 0; t < team; t++) {
+            ws.binOffsets[t] = total;
+            total += ws.bins[t * ws.binRing + next % run.ring].size();
+        }
+        ws.frontier.resize(total);
+        run.current = next;
+        run.step = DeltaRun::Step::Gather;
+    }
+
+    // One team member of a delta-stepping run.
+    void deltaWork(DeltaRun& run, unsigned id, unsigned team, ThreadBarrier& barrier) const {
+        Workspace& ws = run.ws;
+        for (;;) {
+            if (run.step == DeltaRun::Step::Done) return;
+            if (run.step == DeltaRun::Step::Relax) {
+                relaxPhase(run, id);
+                barrier.arriveAndWait([&] { chooseBucket(run, team); });
+            }
+            else {
+                GrowableBuffer<VertexId>& bucket = ws.bins[id * ws.binRing + run.current % run.ring];
+                if (!bucket.isEmpty()) memcpy(ws.frontier.data() + ws.binOffsets[id], bucket.data(), bucket.size() * sizeof(VertexId));
+                bucket.clear();
+                barrier.arriveAndWait([&] {
+                    run.cursor.store(0, memory_order_relaxed);
+                    run.step = DeltaRun::Step::Relax;
+                });
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Prepares queries over `graph`, which must outlive the engine.
+     *
+     * Scans the weights once for the largest, which sizes delta-stepping's buckets.
+     *
+     * Time Complexity  : O(E)
+     *
+     * @throws invalid_argument if an edge weight is negative (or NaN).
+     */
+    explicit ShortestPaths(const CsrGraph<W>& g) : graph(&g) {
+        for (VertexId u = 0; u < g.vertexCount(); u++) {
+            const W* weights = g.weightsOf(u);
+            for (size_t e = 0; e < g.outDegree(u); e++) {
+                Distance w = static_cast<Distance>(weights[e]);
+                if (!(w >= Distance())) throw invalid_argument("Edge weights must be non-negative");
+                if (heaviest < w) heaviest = w;
+            }
+        }
+        // Meyer and Sanders: delta ~ heaviest weight / average degree.
+        if (g.edgeCount() != 0) {
+            double perDegree = static_cast<double>(g.vertexCount()) / static_cast<double>(g.edgeCount());
+            defaultDelta = static_cast<Distance>(static_cast<double>(heaviest) * perDegree);
+        }
+        if (!(defaultDelta > Distance())) defaultDelta = Distance(1);   // integer rounding, or all weights 0
+    }
+
+    /**
+     * @brief Dijkstra from `source`; returns the number of settled vertices.
+     *
+     * With a target, stops as soon as the target is settled, so a short query only touches its
+     * neighbourhood. Each vertex enters the 4-ary heap once and moves up on decreaseKey.
+     *
+     * Time Complexity  : O((V + E) log V), and O(1) setup with a reused workspace
+     * Example:
+     *   0 -4-> 1, 0 -1-> 2, 2 -5-> 3  ->  distance(3) = 6, path 0, 2, 3
+     *
+     * @throws out_of_range if source is not a vertex; invalid_argument if the workspace is too small.
+     */
+    size_t dijkstra(VertexId source, Workspace& ws, VertexId target = nullVertex) const {
+        checkQuery(source, ws);
+        ws.begin();
+        reach(ws, source, Distance(), source);
+        ws.heap[0] = HeapEntry{ Distance(), source };
+        ws.heapSlot[source] = 0;
+        ws.heapSize = 1;
+
+        size_t settledCount = 0;
+        while (ws.heapSize != 0) {
+            HeapEntry top = ws.heap[0];
+            ws.heapSlot[top.vertex] = Workspace::settled;
+            if (--ws.heapSize != 0) {
+                ws.heap[0] = ws.heap[ws.heapSize];
+                siftDown(ws, 0);
+            }
+            settledCount++;
+            if (top.vertex == target) break;
+
+            const VertexId* targets = graph->neighbors(top.vertex).begin();
+            const W* weights = graph->weightsOf(top.vertex);
+            const size_t degree = graph->outDegree(top.vertex);
+            for (size_t e = 0; e < degree; e++) {
+                VertexId v = targets[e];
+                Distance d = top.key + static_cast<Distance>(weights[e]);
+                if (!ws.isReached(v)) {
+                    reach(ws, v, d, top.vertex);
+                    ws.heap[ws.heapSize] = HeapEntry{ d, v };
+                    siftUp(ws, ws.heapSize++);
+                }
+                else if (ws.heapSlot[v] != Workspace::settled && d < ws.dist[v].load(memory_order_relaxed)) {
+                    ws.dist[v].store(d, memory_order_relaxed);
+                    ws.parentOf[v] = top.vertex;
+                    ws.heap[ws.heapSlot[v]].key = d;
+                    siftUp(ws, ws.heapSlot[v]);
+                }
+            }
+        }
+        ws.settledCount = settledCount;
+        return settledCount;
+    }
+
+    /**
+     * @brief Parallel delta-stepping from `source`; returns the number of vertices reached.
+     *
+     * Buckets of width `delta` (0 = suggestedDelta()) are relaxed one at a time, each by all
+     * threads. A smaller delta does less redundant work but has less parallelism per bucket.
+     * Every distance is final when it returns. Parents are valid shortest-path parents, but
+     * may differ between runs when several exist.
+     *
+     * Time Complexity  : O(V + E) work for well-chosen delta on random weights, over `threads` threads
+     *
+     * @throws out_of_range if source is not a vertex; invalid_argument if the workspace is too small.
+     */
+    size_t deltaStepping(VertexId source, Workspace& ws, Distance delta = Distance(), unsigned threads = 0) const {
+        checkQuery(source, ws);
+        if (!(delta > Distance())) delta = defaultDelta;
+        if (threads == 0) threads = thread::hardware_concurrency() != 0 ? thread::hardware_concurrency() : 1;
+        size_t blocks = (static_cast<size_t>(graph->vertexCount()) + 1023) / 1024;
+        unsigned team = blocks < threads ? static_cast<unsigned>(blocks) : threads;
+        if (team == 0) team = 1;
+
+        // A relaxation from bucket i lands at most heaviest / delta buckets later.
+        size_t ring = static_cast<size_t>(heaviest / delta) + 2;
+        ws.prepareBins(team, ring);
+        ws.begin();
+        reach(ws, source, Distance(), source);
+        ws.frontier.clear();
+        ws.frontier.pushBack(source);
+
+        DeltaRun run(ws, delta, ring);
+        ThreadBarrier barrier(team);
+        unique_ptr<thread[]> helpers(new thread[team - 1]);
+        for (unsigned t = 1; t < team; t++) {
+            helpers[t - 1] = thread([this, &run, t, team, &barrier] { deltaWork(run, t, team, barrier); });
+        }
+        deltaWork(run, 0, team, barrier);
+        for (unsigned t = 1; t < team; t++) helpers[t - 1].join();
+        ws.settledCount = run.reached.load(memory_order_relaxed);
+        return ws.settledCount;
+    }
+
+    // The bucket width deltaStepping() uses by default: the heaviest weight over the average degree.
+    Distance suggestedDelta() const { return defaultDelta; }
+};
+
+// Deterministic R-MAT edges: a skewed, low-diameter graph like a social network.
+// Each edge picks a quadrant of the adjacency matrix scale times, with probabilities 0.57 / 0.19 / 0.19 / 0.05.
+unique_ptr<Edge<uint32_t>[]> rmatEdges(unsigned scale, size_t count) {
+    unique_ptr<Edge<uint32_t>[]> result(new Edge<uint32_t>[count]);
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    auto next = [&state] {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (size_t i = 0; i < count; i++) {
+        VertexId from = 0, to = 0;
+        for (unsigned bit = 0; bit < scale; bit++) {
+            uint32_t r = static_cast<uint32_t>(next() % 100);
+            if (r >= 57 && r < 76) to |= VertexId(1) << bit;
+            else if (r >= 76 && r < 95) from |= VertexId(1) << bit;
+            else if (r >= 95) { from |= VertexId(1) << bit; to |= VertexId(1) << bit; }
+        }
+        result[i] = Edge<uint32_t>{ from, to, static_cast<uint32_t>(next() % 100 + 1) };
+    }
+    return result;
+}
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test CsrGraph: building from an edge list
+    // ---------------------------------------------------------------
+    cout << "=== CsrGraph ===" << endl;
+    Edge<uint32_t> roads[] = { {0, 1, 4}, {0, 2, 1}, {1, 2, 2}, {2, 0, 7}, {2, 3, 5} };
+    CsrGraph<uint32_t> directed(4, roads, 5, EdgeDirection::Directed);
+    cout << "vertices / edges   -> Expected : 4 / 5 | Result : " << directed.vertexCount() << " / " << directed.edgeCount() << endl;
+    cout << "neighbors(0)       -> Expected : 1 2 | Result :";
+    for (VertexId v : directed.neighbors(0)) cout << " " << v;
+    cout << endl;
+    cout << "weightsOf(2)       -> Expected : 7 5 | Result : " << directed.weightsOf(2)[0] << " " << directed.weightsOf(2)[1] << endl;
+    cout << "inNeighbors(2)     -> Expected : 0 1 | Result :";
+    for (VertexId v : directed.inNeighbors(2)) cout << " " << v;
+    cout << endl;
+    cout << "degree out/in (3)  -> Expected : 0 / 1 | Result : " << directed.outDegree(3) << " / " << directed.inDegree(3) << endl;
+    uint32_t total = 0;
+    directed.forEachNeighbor(0, [&total](VertexId, uint32_t weight) { total += weight; });
+    cout << "forEachNeighbor(0) -> Expected : weights sum 5 | Result : weights sum " << total << endl;
+
+    CsrGraph<uint32_t> undirected(4, roads, 5, EdgeDirection::Undirected);
+    cout << "undirected edges   -> Expected : 10 (each stored both ways) | Result : " << undirected.edgeCount() << endl;
+    cout << "neighbors(2)       -> Expected : 0 1 0 3 | Result :";
+    for (VertexId v : undirected.neighbors(2)) cout << " " << v;
+    cout << endl;
+    try {
+        Edge<uint32_t> bad[] = { {0, 9} };
+        CsrGraph<uint32_t> broken(4, bad, 1, EdgeDirection::Directed);
+    }
+    catch (const invalid_argument& e) {
+        cout << "edge 0->9 correctly threw: " << e.what() << endl;
+    }
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test ParallelBfs: depths and parents on a small graph
+    // ---------------------------------------------------------------
+    cout << "\n=== BFS ===" << endl;
+    ParallelBfs<uint32_t> search(directed);
+    cout << "run(0)             -> Expected : 4 reached | Result : " << search.run(0) << " reached" << endl;
+    cout << "depths             -> Expected : 0 1 1 2 | Result :";
+    for (VertexId v = 0; v < 4; v++) cout << " " << search.depth(v);
+    cout << endl;
+    cout << "parent(3)          -> Expected : 2 | Result : " << search.parent(3) << endl;
+    cout << "run(3)             -> Expected : 1 reached (3 has no out-edges) | Result : " << search.run(3) << " reached" << endl;
+    cout << "depth(0) after     -> Expected : -1 | Result : " << search.depth(0) << endl;
+    try {
+        search.run(4);
+    }
+    catch (const out_of_range& e) {
+        cout << "run(4) correctly threw: " << e.what() << endl;
+    }
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    // ---------------------------------------------------------------
+    // Test direction-optimizing BFS on a large skewed graph
+    // ---------------------------------------------------------------
+    cout << "\n=== Direction-Optimizing BFS ===" << endl;
+    const unsigned scale = 17;
+    const VertexId vertices = VertexId(1) << scale;
+    const size_t edgeCount = size_t(16) << scale;
+    unique_ptr<Edge<uint32_t>[]> edges = rmatEdges(scale, edgeCount);
+    CsrGraph<uint32_t> social(vertices, edges.get(), edgeCount, EdgeDirection::Undirected);
+    edges.reset();
+    cout << "graph              -> Expected : 131072 vertices, 4194304 edges | Result : " << social.vertexCount()
+         << " vertices, " << social.edgeCount() << " edges" << endl;
+    cout << "CSR memory         -> Expected : 34 MB | Result : " << social.memoryBytes() / 1000000 << " MB" << endl;
+
+    ParallelBfs<uint32_t> serial(social, 1);
+    size_t expectedReached = serial.run(0, BfsDirection::TopDown);
+    unique_ptr<int32_t[]> expectedDepths(new int32_t[vertices]);
+    memcpy(expectedDepths.get(), serial.depths(), vertices * sizeof(int32_t));
+    cout << "1 thread top-down  -> Expected : 90176 reached, 5 levels | Result : " << expectedReached << " reached, "
+         << serial.levels() << " levels" << endl;
+
+    ParallelBfs<uint32_t> parallel(social, 4);
+    const BfsDirection directions[] = { BfsDirection::TopDown, BfsDirection::BottomUp, BfsDirection::Auto };
+    const char* names[] = { "top-down  ", "bottom-up ", "auto      " };
+    for (int d = 0; d < 3; d++) {
+        size_t reachedNow = parallel.run(0, directions[d]);
+        bool sameDepths = memcmp(parallel.depths(), expectedDepths.get(), vertices * sizeof(int32_t)) == 0;
+        bool validParents = true;
+        for (VertexId v = 0; v < vertices && validParents; v++) {
+            if (!parallel.isReached(v) || v == 0) continue;
+            VertexId p = parallel.parent(v);
+            bool isEdge = false;
+            for (VertexId u : social.inNeighbors(v)) isEdge = isEdge || u == p;
+            validParents = isEdge && parallel.depth(p) == parallel.depth(v) - 1;
+        }
+        cout << "4 threads " << names[d] << "-> Expected : same depths, valid parents | Result : "
+             << (reachedNow == expectedReached && sameDepths ? "same depths" : "different depths!") << ", "
+             << (validParents ? "valid parents" : "invalid parents!") << endl;
+    }
+    cout << "auto steps         -> Expected : 2 top-down, 3 bottom-up | Result : "
+         << parallel.topDownSteps() << " top-down, " << parallel.bottomUpSteps() << " bottom-up" << endl;
+
+    // ---------------------------------------------------------------
+    // Test AdjacencyBitMatrix: one bit per cell, row operations
+    // ---------------------------------------------------------------
+    cout << "\n=== AdjacencyBitMatrix ===" << endl;
+    AdjacencyBitMatrix friends(6, EdgeDirection::Undirected);
+    const VertexId pairs[][2] = { {0, 1}, {0, 2}, {0, 3}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {2, 4} };
+    for (const auto& pair : pairs) friends.addEdge(pair[0], pair[1]);
+    cout << "edges              -> Expected : 8 | Result : " << friends.edgeCount() << endl;
+    cout << "addEdge duplicate  -> Expected : false | Result : " << (friends.addEdge(3, 0) ? "true" : "false") << endl;
+    cout << "hasEdge(4, 3)      -> Expected : true (symmetric) | Result : " << (friends.hasEdge(4, 3) ? "true" : "false") << endl;
+    cout << "degree(2)          -> Expected : 4 | Result : " << friends.degree(2) << endl;
+    cout << "common(0, 4)       -> Expected : 2 | Result : " << friends.commonNeighbors(0, 4) << endl;
+    cout << "forEachCommon(0,4) -> Expected : 2 3 | Result :";
+    friends.forEachCommonNeighbor(0, 4, [](VertexId w) { cout << " " << w; });
+    cout << endl;
+    unique_ptr<uint64_t[]> either(new uint64_t[friends.rowWords()]);
+    friends.uniteRows(1, 5, either.get());
+    cout << "uniteRows(1, 5)    -> Expected : 3 vertices | Result : " << rowCount(either.get(), friends.rowWords()) << " vertices" << endl;
+    cout << "trianglesAt(2)     -> Expected : 3 | Result : " << friends.trianglesAt(2) << endl;
+    cout << "countTriangles()   -> Expected : 3 | Result : " << friends.countTriangles() << endl;
+    cout << "removeEdge(0, 2)   -> Expected : 1 triangle left | Result : " << (friends.removeEdge(2, 0), friends.countTriangles())
+         << " triangle left" << endl;
+    AdjacencyBitMatrix fromCsr(undirected);
+    cout << "from CsrGraph      -> Expected : 4 edges (duplicates merged), 2->3 and 3->2 | Result : " << fromCsr.edgeCount() << " edges, "
+         << (fromCsr.hasEdge(2, 3) && fromCsr.hasEdge(3, 2) ? "2->3 and 3->2" : "missing!") << endl;
+
+    // ---------------------------------------------------------------
+    // Test triangle counting on dense graphs
+    // ---------------------------------------------------------------
+    cout << "\n=== Triangle Counting ===" << endl;
+    uint64_t coin = 0x9E3779B97F4A7C15ULL;
+    auto flip = [&coin] {
+        coin ^= coin << 13;
+        coin ^= coin >> 7;
+        coin ^= coin << 17;
+        return (coin >> 32) & 1;
+    };
+    const VertexId small = 300;
+    AdjacencyBitMatrix dense(small, EdgeDirection::Undirected);
+    for (VertexId u = 0; u < small; u++) {
+        for (VertexId v = u + 1; v < small; v++) {
+            if (flip()) dense.addEdge(u, v);
+        }
+    }
+    uint64_t bruteForce = 0;
+    for (VertexId u = 0; u < small; u++) {
+        for (VertexId v = u + 1; v < small; v++) {
+            if (!dense.hasEdge(u, v)) continue;
+            for (VertexId w = v + 1; w < small; w++) bruteForce += dense.hasEdge(u, w) && dense.hasEdge(v, w);
+        }
+    }
+    cout << "300 vertices, p=.5 -> Expected : " << bruteForce << " (triple loop) | Result : " << dense.countTriangles() << endl;
+    uint64_t cornerSum = 0;
+    for (VertexId u = 0; u < small; u++) cornerSum += dense.trianglesAt(u);
+    cout << "sum of trianglesAt -> Expected : " << 3 * bruteForce << " (3 corners each) | Result : " << cornerSum << endl;
+
+    const VertexId large = 4096;
+    AdjacencyBitMatrix big(large, EdgeDirection::Undirected);
+    for (VertexId u = 0; u < large; u++) {
+        for (VertexId v = u + 1; v < large; v++) {
+            if (flip()) big.addEdge(u, v);
+        }
+    }
+    cout << "4096 vertices      -> Expected : 2 MB (int matrix: 67 MB) | Result : " << big.memoryBytes() / 1000000 << " MB (int matrix: "
+         << size_t(large) * large * sizeof(int) / 1000000 << " MB)" << endl;
+    cout << "triangles          -> Expected : about C(4096, 3) / 8 = 1430607360 | Result : " << big.countTriangles() << endl;
+
+    // ---------------------------------------------------------------
+    // Test ShortestPaths: Dijkstra on a small weighted graph
+    // ---------------------------------------------------------------
+    cout << "\n=== Shortest Paths ===" << endl;
+    ShortestPaths<uint32_t> routes(directed);
+    SearchWorkspace<uint32_t> workspace(directed.vertexCount());
+    cout << "dijkstra(0)        -> Expected : 4 settled | Result : " << routes.dijkstra(0, workspace) << " settled" << endl;
+    cout << "distances          -> Expected : 0 4 1 6 | Result :";
+    for (VertexId v = 0; v < 4; v++) cout << " " << workspace.distance(v);
+    cout << endl;
+    VertexId path[4];
+    size_t hops = workspace.pathTo(3, path);
+    cout << "pathTo(3)          -> Expected : 0 2 3 | Result :";
+    for (size_t i = 0; i < hops; i++) cout << " " << path[i];
+    cout << endl;
+    cout << "target 2           -> Expected : 2 settled (stops at the target) | Result : " << routes.dijkstra(0, workspace, 2)
+         << " settled" << endl;
+    routes.dijkstra(3, workspace);
+    cout << "from 3: reached 0  -> Expected : false | Result : " << (workspace.isReached(0) ? "true" : "false") << endl;
+    try {
+        Edge<int> signedRoads[] = { {0, 1, 3}, {1, 0, -1} };
+        CsrGraph<int> loop(2, signedRoads, 2, EdgeDirection::Directed);
+        ShortestPaths<int> invalid(loop);
+    }
+    catch (const invalid_argument& e) {
+        cout << "weight -1 correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test many short queries through one workspace
+    // ---------------------------------------------------------------
+    cout << "\n=== Reusable Workspace ===" << endl;
+    const VertexId side = 512;
+    unique_ptr<Edge<uint32_t>[]> streets(new Edge<uint32_t>[2 * side * side]);
+    size_t streetCount = 0;
+    for (VertexId y = 0; y < side; y++) {
+        for (VertexId x = 0; x < side; x++) {
+            VertexId here = y * side + x;
+            if (x + 1 < side) streets[streetCount++] = Edge<uint32_t>{ here, here + 1, static_cast<uint32_t>(1 + flip() * 9 + here % 7) };
+            if (y + 1 < side) streets[streetCount++] = Edge<uint32_t>{ here, here + side, static_cast<uint32_t>(1 + flip() * 9 + here % 5) };
+        }
+    }
+    CsrGraph<uint32_t> city(side * side, streets.get(), streetCount, EdgeDirection::Undirected);
+    streets.reset();
+    ShortestPaths<uint32_t> navigator(city);
+    SearchWorkspace<uint32_t> reused(city.vertexCount());
+    SearchWorkspace<uint32_t> fresh(city.vertexCount());
+    size_t settledTotal = 0;
+    bool sameAnswers = true;
+    const int queries = 20000;
+    for (int q = 0; q < queries; q++) {
+        VertexId corner = static_cast<VertexId>((uint64_t(q) * 2654435761u) % ((side - 8) * (side - 8)));
+        VertexId from = corner / (side - 8) * side + corner % (side - 8);
+        VertexId to = from + 8 * side + 8;   // eight blocks down, eight across
+        settledTotal += navigator.dijkstra(from, reused, to);
+        if (q % 2000 == 0) {
+            navigator.dijkstra(from, fresh);
+            sameAnswers = sameAnswers && reused.distance(to) == fresh.distance(to);
+        }
+    }
+    cout << "20000 queries      -> Expected : same distances as a full search | Result : "
+         << (sameAnswers ? "same distances" : "different distances!") << endl;
+    cout << "settled per query  -> Expected : a few hundred of 262144 | Result : " << settledTotal / queries << " of "
+         << city.vertexCount() << endl;
+
+    // ---------------------------------------------------------------
+    // Test parallel delta-stepping against Dijkstra
+    // ---------------------------------------------------------------
+    cout << "\n=== Delta-Stepping ===" << endl;
+    ShortestPaths<uint32_t> socialPaths(social);
+    SearchWorkspace<uint32_t> exact(social.vertexCount());
+    SearchWorkspace<uint32_t> stepped(social.vertexCount());
+    size_t exactReached = socialPaths.dijkstra(0, exact);
+    cout << "dijkstra(0)        -> Expected : 90176 settled | Result : " << exactReached << " settled" << endl;
+    cout << "suggestedDelta()   -> Expected : 3 (heaviest 100 / average degree 32) | Result : " << socialPaths.suggestedDelta() << endl;
+    const uint64_t deltas[] = { 0, 1, 1000 };
+    for (uint64_t delta : deltas) {
+        size_t reachedNow = socialPaths.deltaStepping(0, stepped, delta, 4);
+        bool sameDistances = reachedNow == exactReached;
+        bool validParents = true;
+        for (VertexId v = 0; v < social.vertexCount(); v++) {
+            sameDistances = sameDistances && stepped.distance(v) == exact.distance(v);
+            if (!stepped.isReached(v) || v == 0) continue;
+            VertexId p = stepped.parent(v);
+            bool tight = false;
+            const uint32_t* weights = social.weightsOf(v);   // undirected: v's edges are its incoming ones
+            size_t i = 0;
+            for (VertexId u : social.neighbors(v)) {
+                tight = tight || (u == p && stepped.distance(p) + weights[i] == stepped.distance(v));
+                i++;
+            }
+            validParents = validParents && tight;
+        }
+        cout << "4 threads, delta " << (delta == 0 ? string("3   ") : delta == 1 ? string("1   ") : string("1000"))
+             << " -> Expected : same distances, valid parents | Result : " << (sameDistances ? "same distances" : "different distances!")
+             << ", " << (validParents ? "valid parents" : "invalid parents!") << endl;
+    }
+
+    return 0;
+}
@@ -1,20 +1,1558 @@
-// Non-Linear-DS-Hash-Tables.cpp : This file contains the 'main' function. Program execution begins and ends there.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Group probing uses SSE2 on x86-64. Other targets (and -DDS_DISABLE_SIMD)
+// use the portable 8-byte group, which does the same matching with 64-bit arithmetic.
+#if !defined(DS_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__))
+#define DS_HASH_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define DS_HASH_SIMD_SSE2 0
+#endif
+
+// Compile with -DDS_INSTRUMENT to count probe lengths, rehashes and table memory
+// (see INSTRUMENTATION below). Without it the counters and their hooks compile to nothing.
+#if defined(DS_INSTRUMENT)
+#define DS_HASH_INSTRUMENT 1
+#else
+#define DS_HASH_INSTRUMENT 0
+#endif
+using namespace std;
+
+/**
+* **HASH TABLES - OPEN ADDRESSING WITH CONTROL BYTES (SWISS TABLE)**
+*
+*   key: "name"  ->  hash("name") = 0x9e37...  ->  h1 = hash >> 7   (where to start probing)
+*                                                 h2 = hash & 0x7F (a 7-bit fingerprint)
+*
+* A chained hash table allocates one node per entry, so every lookup
+* is a pointer chase to a node somewhere on the heap. FlatHashMap stores the entries
+* themselves in one flat array, next to a parallel array of one-byte control codes:
+*
+*   ctrl:   [ 12 ][ EMPTY ][ 77 ][ DEL ][  3 ][ EMPTY ] ...   (h2 of a full slot, or a marker)
+*   slots:  [k,v ][       ][k,v ][     ][k,v ][       ] ...
+*
+* A lookup loads 16 control bytes at once and compares all of them with h2 in one
+* SSE2 instruction. Only slots whose fingerprint matches (1 in 128 false positives) have
+* their key compared, and the probe stops at the first group with an empty slot. Most
+* lookups read one cache line of control bytes and one entry.
+*/
+
+// ***************  HASH FUNCTIONS  ****************
+
+// 64 x 64 -> 128-bit multiply; returns the low half in `a` and the high half in `b`.
+inline void multiply128(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+// Multiply, then fold the 128-bit product: the mixing step of wyhash.
+inline uint64_t wyMix(uint64_t a, uint64_t b) {
+    multiply128(a, b);
+    return a ^ b;
+}
+
+inline uint64_t read64(const unsigned char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+inline uint64_t read32(const unsigned char* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+/**
+* @brief wyhash of `length` bytes, following the final v4 reference algorithm.
+*
+* Strings up to 16 bytes are hashed with two overlapping reads and two multiplies.
+* Longer input is consumed 16 or 48 bytes per round. It passes SMHasher and runs at
+* several GB/s, far faster than byte-at-a-time hashes like FNV.
+*
+* Time Complexity  : O(length)
+*/
+inline uint64_t wyhash(const void* key, size_t length, uint64_t seed = 0) {
+    static constexpr uint64_t secret[4] = {
+        0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+    const unsigned char* p = static_cast<const unsigned char*>(key);
+    seed ^= wyMix(seed ^ secret[0], secret[1]);
+    uint64_t a, b;
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+        }
+        else if (length > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wyMix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                see1 = wyMix(read64(p + 16) ^ secret[2], read64(p + 24) ^ see1);
+                see2 = wyMix(read64(p + 32) ^ secret[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wyMix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    multiply128(a, b);
+    return wyMix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+/**
+* @brief The default hasher for FlatHashMap.
+*
+* std::hash<int> is the identity on common standard libraries. That is fine for
+* a chained table indexed by `hash % primeSize`, but fatal for a table that takes its
+* fingerprint from the low 7 bits and its position from the rest. Integers are therefore
+* mixed with one wyMix, and strings go through wyhash. The string specialisations are
+* transparent, so a map keyed by std::string can be searched with a string_view or a
+* string literal without building a temporary string.
+*/
+template <typename K, typename Enable = void>
+struct FastHash {
+    size_t operator()(const K& key) const {
+        return static_cast<size_t>(wyMix(static_cast<uint64_t>(std::hash<K>()(key)) ^ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull));
+    }
+};
+
+template <typename K>
+struct FastHash<K, enable_if_t<is_integral<K>::value || is_enum<K>::value>> {
+    size_t operator()(K key) const {
+        return static_cast<size_t>(wyMix(static_cast<uint64_t>(key) ^ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull));
+    }
+};
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(string_view text) const { return static_cast<size_t>(wyhash(text.data(), text.size())); }
+};
+
+template <> struct FastHash<string> : StringHash {};
+template <> struct FastHash<string_view> : StringHash {};
+
+// Key equality that also compares a key with other types (string with string_view, ...).
+struct KeyEqual {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const { return a == b; }
+};
+
+template <typename F, typename = void>
+struct IsTransparent : false_type {};
+
+template <typename F>
+struct IsTransparent<F, void_t<typename F::is_transparent>> : true_type {};
+
+// ***************  CONTROL-BYTE GROUPS  ****************
+
+// Control byte values. Full slots hold their 7-bit h2 (0..127), so "full" is "sign bit clear".
+constexpr int8_t ctrlEmpty = -128;   // 0b10000000
+constexpr int8_t ctrlDeleted = -2;   // 0b11111110: a tombstone, probing continues past it
+
+inline unsigned trailingZeros64(uint64_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, m);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(m));
+#endif
+}
+
+inline unsigned leadingZeros64(uint64_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, m);
+    return 63u - static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_clzll(m));
+#endif
+}
+
+/**
+* @brief The set of slots in a group that matched: one flag per slot, `1 << Shift` bits apart.
+*
+* Iterate with `for (; mask; mask.next()) use(mask.lowest());`
+*/
+template <size_t Width, unsigned Shift>
+struct BitMask {
+    uint64_t bits;
+
+    explicit operator bool() const { return bits != 0; }
+    unsigned lowest() const { return trailingZeros64(bits) >> Shift; }
+    void next() { bits &= bits - 1; }
+
+    // Slots before the first match, counting from the start / the end of the group.
+    unsigned trailingSlots() const { return bits ? trailingZeros64(bits) >> Shift : static_cast<unsigned>(Width); }
+    unsigned leadingSlots() const {
+        constexpr unsigned unusedHighBits = 64 - static_cast<unsigned>(Width << Shift);
+        return bits ? (leadingZeros64(bits) - unusedHighBits) >> Shift : static_cast<unsigned>(Width);
+    }
+};
+
+#if DS_HASH_SIMD_SSE2
+// 16 control bytes compared at once: one compare and one movemask per query.
+struct ControlGroup {
+    static constexpr size_t width = 16;
+    using Mask = BitMask<16, 0>;
+
+    __m128i ctrl;
+
+    explicit ControlGroup(const int8_t* position) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position))) {}
+
+    Mask match(int8_t h2) const {
+        return Mask{ static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))) };
+    }
+    Mask matchEmpty() const {
+        return Mask{ static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrlEmpty), ctrl))) };
+    }
+    // Empty and deleted are exactly the bytes with the sign bit set.
+    Mask matchEmptyOrDeleted() const { return Mask{ static_cast<uint64_t>(_mm_movemask_epi8(ctrl)) }; }
+};
+#else
+// 8 control bytes in one 64-bit word (SWAR); the flag of slot i is bit 8i + 7.
+struct ControlGroup {
+    static constexpr size_t width = 8;
+    using Mask = BitMask<8, 3>;
+
+    static constexpr uint64_t lsbs = 0x0101010101010101ull;
+    static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+    uint64_t ctrl;
+
+    explicit ControlGroup(const int8_t* position) { std::memcpy(&ctrl, position, 8); }   // little-endian targets
+
+    // Bytes equal to h2 become zero after the XOR; the classic has-zero-byte test flags them.
+    // It may also flag a full byte right above a real match, which only costs one extra key compare.
+    Mask match(int8_t h2) const {
+        uint64_t x = ctrl ^ (lsbs * static_cast<uint8_t>(h2));
+        return Mask{ (x - lsbs) & ~x & msbs };
+    }
+    // Empty is the only code with bit 7 set and bit 1 clear.
+    Mask matchEmpty() const { return Mask{ ctrl & ~(ctrl << 6) & msbs }; }
+    Mask matchEmptyOrDeleted() const { return Mask{ ctrl & msbs }; }
+};
+#endif
+
+// ***************  INSTRUMENTATION  ****************
 //
+// Opt-in counters for the two things that make a hash table slow in production: long
+// probe sequences (a weak hash, or a table run too full) and repeated rehashing. Built
+// with -DDS_INSTRUMENT, every FlatHashMap counts its own probes and rehashes (stats()),
+// and AllocationTracker adds up the table memory of all of them. Without it the map has
+// no counter member and every hook is an empty inline function.
 
-#include <iostream>
+/**
+* @brief What one FlatHashMap has done since it was constructed (or since resetStats()).
+*
+*   lookups        probes for a key: find, contains, erase, and the check before each insert
+*   groupsProbed   control groups those probes loaded; groupsProbed / lookups is the mean probe length
+*   longestProbe   the most groups one probe loaded; 1 is ideal, and a handful means clustering
+*   rehashes       times a populated table was moved into a new one (growth or tombstone cleanup)
+*   entriesMoved   entries those rehashes moved
+*
+* All fields stay 0 when instrumentation is compiled out.
+*/
+struct FlatHashMapStats {
+    size_t lookups = 0;
+    size_t groupsProbed = 0;
+    size_t longestProbe = 0;
+    size_t rehashes = 0;
+    size_t entriesMoved = 0;
+};
+
+// A snapshot of AllocationTracker.
+struct AllocationCounts {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesAllocated = 0;
+    size_t bytesFreed = 0;
+    size_t liveBytes = 0;     // allocated and not yet freed
+    size_t peakBytes = 0;     // the most liveBytes has been since the last reset()
+};
+
+/**
+* @brief Table memory (control bytes and slots) of every FlatHashMap in the program,
+* including the shards of ConcurrentHashMap.
+*
+* The counters are relaxed atomics, so maps on any thread are tracked together.
+* Without -DDS_INSTRUMENT the record functions are empty and snapshot() is all zeros.
+*/
+class AllocationTracker {
+#if DS_HASH_INSTRUMENT
+    inline static atomic<size_t> allocations{ 0 };
+    inline static atomic<size_t> deallocations{ 0 };
+    inline static atomic<size_t> bytesAllocated{ 0 };
+    inline static atomic<size_t> bytesFreed{ 0 };
+    inline static atomic<size_t> liveBytes{ 0 };
+    inline static atomic<size_t> peakBytes{ 0 };
+#endif
+
+public:
+    static void recordAllocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_HASH_INSTRUMENT
+        allocations.fetch_add(1, memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, memory_order_relaxed);
+        size_t live = liveBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+        size_t peak = peakBytes.load(memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+#endif
+    }
+
+    static void recordDeallocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_HASH_INSTRUMENT
+        deallocations.fetch_add(1, memory_order_relaxed);
+        bytesFreed.fetch_add(bytes, memory_order_relaxed);
+        liveBytes.fetch_sub(bytes, memory_order_relaxed);
+#endif
+    }
+
+    static AllocationCounts snapshot() noexcept {
+        AllocationCounts counts;
+#if DS_HASH_INSTRUMENT
+        counts.allocations = allocations.load(memory_order_relaxed);
+        counts.deallocations = deallocations.load(memory_order_relaxed);
+        counts.bytesAllocated = bytesAllocated.load(memory_order_relaxed);
+        counts.bytesFreed = bytesFreed.load(memory_order_relaxed);
+        counts.liveBytes = liveBytes.load(memory_order_relaxed);
+        counts.peakBytes = peakBytes.load(memory_order_relaxed);
+#endif
+        return counts;
+    }
+
+    // Zeroes the counts. Tables that are still allocated stay live, so the peak restarts from them.
+    static void reset() noexcept {
+#if DS_HASH_INSTRUMENT
+        allocations.store(0, memory_order_relaxed);
+        deallocations.store(0, memory_order_relaxed);
+        bytesAllocated.store(0, memory_order_relaxed);
+        bytesFreed.store(0, memory_order_relaxed);
+        peakBytes.store(liveBytes.load(memory_order_relaxed), memory_order_relaxed);
+#endif
+    }
+};
+
+// ***************  FLAT HASH MAP  ****************
+
+/**
+* @brief An open-addressing hash map with SIMD control-byte probing (SwissTable design).
+*
+* The capacity is a power of two, at least one group. The control array has
+* `capacity + width` bytes: the first group is mirrored at the end, so a group load
+* starting near the end of the table never has to wrap around.
+*
+* Probing visits whole groups in a triangular sequence (offsets 0, 1, 3, 6, ... groups),
+* which reaches every group of a power-of-two table. Inserting uses the first empty
+* or deleted slot on that path. Erasing leaves a tombstone only when the slot's
+* neighbourhood has been full, because only then could a probe sequence have passed through it.
+* Otherwise the slot goes straight back to empty.
+*
+* The table grows (doubling) when inserts have used up the slots allowed by the
+* max load factor. If most of those slots are tombstones, it rehashes at the same size instead.
+*
+* @tparam K      The key type.
+* @tparam V      The mapped type.
+* @tparam Hash   Hasher. Make it (and Equal) define `is_transparent` for heterogeneous lookup.
+* @tparam Equal  Key equality.
+* @tparam Allocator  Supplies the control bytes and the slots, rebound to each through
+*                    std::allocator_traits (std::allocator by default).
+*/
+template <typename K, typename V, typename Hash = FastHash<K>, typename Equal = KeyEqual,
+          typename Allocator = std::allocator<pair<const K, V>>>
+class FlatHashMap {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+private:
+    using Group = ControlGroup;
+    static constexpr size_t groupWidth = Group::width;
+    using CtrlAllocator = typename allocator_traits<Allocator>::template rebind_alloc<int8_t>;
+    using SlotAllocator = typename allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    using CtrlTraits = allocator_traits<CtrlAllocator>;
+    using SlotTraits = allocator_traits<SlotAllocator>;
+
+    int8_t* ctrl = nullptr;
+    Entry* slots = nullptr;
+    size_t capacity = 0;     // number of slots; 0 or a power of two >= groupWidth
+    size_t count = 0;
+    size_t growthLeft = 0;   // inserts into empty slots allowed before the next rehash
+    float maxLoad = 0.875f;
+    Hash hasher;
+    Equal equal;
+    Allocator alloc;
+#if DS_HASH_INSTRUMENT
+    // Lookups are const and ConcurrentHashMap runs them in parallel, hence mutable relaxed atomics.
+    struct ProbeCounters {
+        atomic<size_t> lookups{ 0 };
+        atomic<size_t> groupsProbed{ 0 };
+        atomic<size_t> longestProbe{ 0 };
+        atomic<size_t> rehashes{ 0 };
+        atomic<size_t> entriesMoved{ 0 };
+    };
+    mutable ProbeCounters counters;   // see stats()
+#endif
+
+    static size_t h1(size_t hash) { return hash >> 7; }
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    size_t growthLimit(size_t slotCount) const {
+        size_t limit = static_cast<size_t>(static_cast<double>(slotCount) * maxLoad);
+        return limit < slotCount ? limit : slotCount - 1;   // always leave one empty slot to end probes
+    }
+
+    // Instrumentation hooks; empty unless built with -DDS_INSTRUMENT.
+    void noteProbe([[maybe_unused]] size_t groups) const {
+#if DS_HASH_INSTRUMENT
+        counters.lookups.fetch_add(1, memory_order_relaxed);
+        counters.groupsProbed.fetch_add(groups, memory_order_relaxed);
+        size_t longest = counters.longestProbe.load(memory_order_relaxed);
+        while (groups > longest && !counters.longestProbe.compare_exchange_weak(longest, groups, memory_order_relaxed)) {}
+#endif
+    }
+
+    void noteRehash([[maybe_unused]] size_t moved) {
+#if DS_HASH_INSTRUMENT
+        counters.rehashes.fetch_add(1, memory_order_relaxed);
+        counters.entriesMoved.fetch_add(moved, memory_order_relaxed);
+#endif
+    }
+
+    // Bytes of one table allocation: the control bytes (with the mirrored group) and the slots.
+    static constexpr size_t tableBytes(size_t slotCount) { return slotCount + groupWidth + slotCount * sizeof(Entry); }
+
+    // Writes a control byte, keeping the mirrored first group in sync.
+    void setCtrl(size_t index, int8_t value) {
+        ctrl[index] = value;
+        if (index < groupWidth) ctrl[capacity + index] = value;
+    }
+
+    /**
+     * @brief The slot holding `key`, or SIZE_MAX.
+     *
+     * Time Complexity  : O(1) expected: usually one group load and one key compare
+     */
+    template <typename Q>
+    size_t findIndex(const Q& key, size_t hash) const {
+        if (capacity == 0) return SIZE_MAX;
+        const size_t mask = capacity - 1;
+        size_t position = h1(hash) & mask;
+        size_t step = 0;
+        for (size_t groups = 1;; groups++) {
+            Group group(ctrl + position);
+            for (typename Group::Mask match = group.match(h2(hash)); match; match.next()) {
+                size_t index = (position + match.lowest()) & mask;
+                if (equal(slots[index].key, key)) {
+                    noteProbe(groups);
+                    return index;
+                }
+            }
+            if (group.matchEmpty()) {
+                noteProbe(groups);
+                return SIZE_MAX;
+            }
+            step += groupWidth;
+            position = (position + step) & mask;
+        }
+    }
+
+    // First empty or deleted slot on the probe path of `hash`. The table must have one.
+    size_t findInsertSlot(size_t hash) const {
+        const size_t mask = capacity - 1;
+        size_t position = h1(hash) & mask;
+        size_t step = 0;
+        for (;;) {
+            typename Group::Mask free = Group(ctrl + position).matchEmptyOrDeleted();
+            if (free) return (position + free.lowest()) & mask;
+            step += groupWidth;
+            position = (position + step) & mask;
+        }
+    }
+
+    // Replaces ctrl/slots with a fresh empty table. If either allocation throws, nothing
+    // has been touched, so rehash() still has the old table.
+    void allocate(size_t slotCount) {
+        CtrlAllocator ctrlAlloc(alloc);
+        SlotAllocator slotAlloc(alloc);
+        int8_t* newCtrl = CtrlTraits::allocate(ctrlAlloc, slotCount + groupWidth);
+        Entry* newSlots;
+        try {
+            newSlots = SlotTraits::allocate(slotAlloc, slotCount);
+        }
+        catch (...) {
+            CtrlTraits::deallocate(ctrlAlloc, newCtrl, slotCount + groupWidth);
+            throw;
+        }
+        AllocationTracker::recordAllocation(tableBytes(slotCount));
+        std::memset(newCtrl, static_cast<unsigned char>(ctrlEmpty), slotCount + groupWidth);
+        ctrl = newCtrl;
+        slots = newSlots;
+        capacity = slotCount;
+        growthLeft = growthLimit(slotCount);
+    }
+
+    void deallocate(int8_t* oldCtrl, Entry* oldSlots, size_t slotCount) {
+        SlotAllocator slotAlloc(alloc);
+        CtrlAllocator ctrlAlloc(alloc);
+        SlotTraits::deallocate(slotAlloc, oldSlots, slotCount);
+        CtrlTraits::deallocate(ctrlAlloc, oldCtrl, slotCount + groupWidth);
+        AllocationTracker::recordDeallocation(tableBytes(slotCount));
+    }
+
+    void destroyAll() {
+        if (!ctrl) return;
+        if constexpr (!is_trivially_destructible<Entry>::value) {
+            for (size_t i = 0; i < capacity; i++) {
+                if (ctrl[i] >= 0) slots[i].~Entry();
+            }
+        }
+        deallocate(ctrl, slots, capacity);
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = count = growthLeft = 0;
+    }
+
+    /**
+     * @brief Moves every entry into a fresh table of `newCapacity` slots.
+     *
+     * Entries are moved when their move is noexcept and copied otherwise; if the
+     * allocation or a copy throws, the new table is discarded and this map is unchanged.
+     *
+     * Time Complexity  : O(capacity)
+     */
+    void rehash(size_t newCapacity) {
+        int8_t* oldCtrl = ctrl;
+        Entry* oldSlots = slots;
+        size_t oldCapacity = capacity;
+        size_t oldGrowthLeft = growthLeft;
+
+        allocate(newCapacity);
+        try {
+            for (size_t i = 0; i < oldCapacity; i++) {
+                if (oldCtrl[i] < 0) continue;
+                size_t hash = hasher(oldSlots[i].key);
+                size_t index = findInsertSlot(hash);
+                ::new (static_cast<void*>(slots + index)) Entry(std::move_if_noexcept(oldSlots[i]));
+                setCtrl(index, h2(hash));
+            }
+        }
+        catch (...) {
+            // Only a copy can throw, so the old table is still intact: drop the new one.
+            size_t oldCount = count;
+            destroyAll();
+            ctrl = oldCtrl;
+            slots = oldSlots;
+            capacity = oldCapacity;
+            count = oldCount;
+            growthLeft = oldGrowthLeft;
+            throw;
+        }
+        growthLeft -= count;
+
+        if (oldCtrl) {
+            for (size_t i = 0; i < oldCapacity; i++) {
+                if (oldCtrl[i] >= 0) oldSlots[i].~Entry();
+            }
+            deallocate(oldCtrl, oldSlots, oldCapacity);
+            noteRehash(count);
+        }
+    }
+
+    // Called when no growth is left: grow, or just clear out tombstones when few slots are live.
+    void makeRoomForInsert() {
+        if (capacity == 0) {
+            rehash(groupWidth);
+        }
+        else if (count * 32 <= growthLimit(capacity) * 25) {
+            rehash(capacity);          // enough of the used slots are tombstones: same size, clean table
+        }
+        else {
+            rehash(capacity * 2);
+        }
+    }
+
+    /**
+     * @brief Finds `key`, or claims a slot for it.
+     *
+     * @return {index, true} if the caller must construct the entry at `index`,
+     *         {index, false} if `key` is already there.
+     */
+    template <typename Q>
+    pair<size_t, bool> findOrPrepareInsert(const Q& key, size_t hash) {
+        size_t index = findIndex(key, hash);
+        if (index != SIZE_MAX) return { index, false };
+        if (capacity == 0) makeRoomForInsert();
+        index = findInsertSlot(hash);
+        if (growthLeft == 0 && ctrl[index] != ctrlDeleted) {
+            makeRoomForInsert();       // reusing a tombstone is free, taking an empty slot is not
+            index = findInsertSlot(hash);
+        }
+        return { index, true };
+    }
+
+    // Marks `index` full once its entry has been constructed there.
+    void commitInsert(size_t index, size_t hash) {
+        if (ctrl[index] == ctrlEmpty) growthLeft--;
+        setCtrl(index, h2(hash));
+        count++;
+    }
+
+    void eraseAt(size_t index) {
+        slots[index].~Entry();
+        count--;
+        // If the group ending at `index` and the group starting there have an empty slot within
+        // one group width of each other, no probe ever found this window full, so none continued
+        // past this slot: it can become empty. Otherwise leave a tombstone.
+        const size_t before = (index - groupWidth) & (capacity - 1);
+        typename Group::Mask emptyBefore = Group(ctrl + before).matchEmpty();
+        typename Group::Mask emptyAfter = Group(ctrl + index).matchEmpty();
+        bool neverFull = capacity <= groupWidth ||   // every probe sees the whole table and its empty slot
+                         (emptyBefore && emptyAfter &&
+                          emptyAfter.trailingSlots() + emptyBefore.leadingSlots() < groupWidth);
+        setCtrl(index, neverFull ? ctrlEmpty : ctrlDeleted);
+        if (neverFull) growthLeft++;
+    }
+
+    // Lookups by another key type are enabled only when both Hash and Equal are transparent.
+    template <typename Q>
+    using EnableIfTransparent = enable_if_t<!is_same<decay_t<Q>, K>::value &&
+                                            IsTransparent<Hash>::value && IsTransparent<Equal>::value>;
+
+public:
+    /**
+     * @brief What iteration yields: the key (read-only) and the mapped value.
+     *
+     *   for (auto [key, value] : map) { ... }
+     */
+    template <typename MappedRef>
+    struct EntryRef {
+        const K& key;
+        MappedRef value;
+    };
+
+    template <typename MapPtr, typename MappedRef>
+    class SlotIterator {
+        MapPtr map = nullptr;
+        size_t index = 0;
+
+        void skipEmpty() {
+            while (index < map->capacity && map->ctrl[index] < 0) index++;
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = EntryRef<MappedRef>;
+        using difference_type = ptrdiff_t;
+        using reference = EntryRef<MappedRef>;
+        using pointer = void;
+
+        SlotIterator() = default;
+        SlotIterator(MapPtr map, size_t index) : map(map), index(index) { skipEmpty(); }
+
+        reference operator*() const { return { map->slots[index].key, map->slots[index].value }; }
+        SlotIterator& operator++() { index++; skipEmpty(); return *this; }
+        SlotIterator operator++(int) { SlotIterator previous = *this; ++*this; return previous; }
+        bool operator==(const SlotIterator& other) const { return index == other.index; }
+        bool operator!=(const SlotIterator& other) const { return index != other.index; }
+    };
+
+    using iterator = SlotIterator<FlatHashMap*, V&>;
+    using const_iterator = SlotIterator<const FlatHashMap*, const V&>;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_t expected, const Hash& hash = Hash(), const Equal& eq = Equal(),
+                         const Allocator& allocator = Allocator())
+        : hasher(hash), equal(eq), alloc(allocator) {
+        reserve(expected);
+    }
+
+    FlatHashMap(const FlatHashMap& other)
+        : maxLoad(other.maxLoad), hasher(other.hasher), equal(other.equal),
+          alloc(allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc)) {
+        try {
+            reserve(other.count);
+            for (size_t i = 0; i < other.capacity; i++) {
+                if (other.ctrl[i] >= 0) insert(other.slots[i].key, other.slots[i].value);
+            }
+        }
+        catch (...) {
+            destroyAll();   // no destructor runs for a constructor that throws
+            throw;
+        }
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : ctrl(other.ctrl), slots(other.slots), capacity(other.capacity), count(other.count),
+          growthLeft(other.growthLeft), maxLoad(other.maxLoad), hasher(std::move(other.hasher)), equal(std::move(other.equal)),
+          alloc(std::move(other.alloc)) {
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.capacity = other.count = other.growthLeft = 0;
+    }
+
+    FlatHashMap& operator=(FlatHashMap other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(count, other.count);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(maxLoad, other.maxLoad);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+        std::swap(alloc, other.alloc);
+        return *this;
+    }
+
+    ~FlatHashMap() { destroyAll(); }
+
+    /**
+     * @brief Inserts {key, value} if `key` is not present; an existing value is left alone.
+     *
+     * Time Complexity  : O(1) expected, amortized over growth
+     *
+     * Example:
+     *   map = {}
+     *   map.insert("apple", 3)  ->  true,  {apple: 3}
+     *   map.insert("apple", 9)  ->  false, {apple: 3}
+     *
+     * @return true if the entry was inserted.
+     */
+    bool insert(const K& key, const V& value) { return emplace(key, value).second; }
+    bool insert(K&& key, V&& value) { return emplace(std::move(key), std::move(value)).second; }
+
+    /**
+     * @brief Constructs the mapped value from `args` if `key` is absent.
+     *
+     * @return The mapped value, and whether it was inserted.
+     */
+    template <typename KeyArg, typename... Args>
+    pair<V*, bool> emplace(KeyArg&& key, Args&&... args) {
+        size_t hash = hasher(key);
+        pair<size_t, bool> slot = findOrPrepareInsert(key, hash);
+        if (slot.second) {
+            ::new (static_cast<void*>(slots + slot.first)) Entry{ K(std::forward<KeyArg>(key)), V(std::forward<Args>(args)...) };
+            commitInsert(slot.first, hash);
+        }
+        return { &slots[slot.first].value, slot.second };
+    }
+
+    // Inserts, or overwrites the value of an existing key.
+    template <typename KeyArg, typename ValueArg>
+    bool insertOrAssign(KeyArg&& key, ValueArg&& value) {
+        pair<V*, bool> result = emplace(std::forward<KeyArg>(key), std::forward<ValueArg>(value));
+        if (!result.second) *result.first = std::forward<ValueArg>(value);
+        return result.second;
+    }
+
+    // The value for `key`, default-constructing it first if absent.
+    V& operator[](const K& key) { return *emplace(key).first; }
+
+    /**
+     * @brief Pointer to the value stored for `key`, or nullptr.
+     *
+     * Accepts any type the hasher and equality accept when both are transparent, e.g.
+     * a string_view or a string literal for a map keyed by std::string.
+     *
+     * Time Complexity  : O(1) expected
+     */
+    V* find(const K& key) {
+        size_t index = findIndex(key, hasher(key));
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    const V* find(const K& key) const {
+        size_t index = findIndex(key, hasher(key));
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    template <typename Q, typename = EnableIfTransparent<Q>>
+    V* find(const Q& key) {
+        size_t index = findIndex(key, hasher(key));
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    template <typename Q, typename = EnableIfTransparent<Q>>
+    const V* find(const Q& key) const {
+        size_t index = findIndex(key, hasher(key));
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    bool contains(const K& key) const { return find(key) != nullptr; }
+
+    template <typename Q, typename = EnableIfTransparent<Q>>
+    bool contains(const Q& key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief The value stored for `key`.
+     *
+     * @throws out_of_range if the key is not present.
+     */
+    V& at(const K& key) {
+        V* value = find(key);
+        if (!value) throw out_of_range("Key not found");
+        return *value;
+    }
+
+    const V& at(const K& key) const {
+        const V* value = find(key);
+        if (!value) throw out_of_range("Key not found");
+        return *value;
+    }
+
+    /**
+     * @brief Removes `key` if present.
+     *
+     * Time Complexity  : O(1) expected
+     *
+     * @return true if an entry was removed.
+     */
+    bool erase(const K& key) {
+        size_t index = findIndex(key, hasher(key));
+        if (index == SIZE_MAX) return false;
+        eraseAt(index);
+        return true;
+    }
+
+    template <typename Q, typename = EnableIfTransparent<Q>>
+    bool erase(const Q& key) {
+        size_t index = findIndex(key, hasher(key));
+        if (index == SIZE_MAX) return false;
+        eraseAt(index);
+        return true;
+    }
+
+    // ----- Pre-hashed access, for wrappers that already hashed the key (ConcurrentHashMap) -----
+    // `hash` must equal Hash()(key).
+
+    template <typename Q>
+    V* findHashed(const Q& key, size_t hash) {
+        size_t index = findIndex(key, hash);
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    template <typename Q>
+    const V* findHashed(const Q& key, size_t hash) const {
+        size_t index = findIndex(key, hash);
+        return index == SIZE_MAX ? nullptr : &slots[index].value;
+    }
+
+    template <typename KeyArg, typename... Args>
+    pair<V*, bool> emplaceHashed(size_t hash, KeyArg&& key, Args&&... args) {
+        pair<size_t, bool> slot = findOrPrepareInsert(key, hash);
+        if (slot.second) {
+            ::new (static_cast<void*>(slots + slot.first)) Entry{ K(std::forward<KeyArg>(key)), V(std::forward<Args>(args)...) };
+            commitInsert(slot.first, hash);
+        }
+        return { &slots[slot.first].value, slot.second };
+    }
+
+    template <typename Q>
+    bool eraseHashed(const Q& key, size_t hash) {
+        size_t index = findIndex(key, hash);
+        if (index == SIZE_MAX) return false;
+        eraseAt(index);
+        return true;
+    }
+
+    /**
+     * @brief Moves the entries of slots [first, first + n) out through `sink(Entry&&)` and erases them.
+     *
+     * Walking the slot array in steps lets a caller empty a table a little at a time
+     * (an incremental rehash) instead of in one pass.
+     *
+     * Time Complexity  : O(n)
+     *
+     * @return The slot to continue from; getCapacity() when the walk is done.
+     */
+    template <typename Sink>
+    size_t extractSlots(size_t first, size_t n, Sink&& sink) {
+        size_t last = first + n < capacity ? first + n : capacity;
+        for (size_t i = first; i < last; i++) {
+            if (ctrl[i] < 0) continue;
+            sink(std::move(slots[i]));
+            eraseAt(i);
+        }
+        return last;
+    }
+
+    // Inserts into empty (not reused) slots left before the table must rehash.
+    size_t growthRemaining() const { return capacity == 0 ? 0 : growthLeft; }
+
+    /**
+     * @brief Makes room for `n` entries, so that inserting them never rehashes.
+     *
+     * Time Complexity  : O(capacity) when it rehashes, otherwise O(1)
+     */
+    void reserve(size_t n) {
+        size_t needed = groupWidth;
+        while (growthLimit(needed) < n) needed *= 2;
+        if (needed > capacity) rehash(needed);
+    }
+
+    /**
+     * @brief Sets the maximum load factor, in (0, 1). Lower means shorter probes and more memory.
+     *
+     * Takes effect on the next growth. The table rehashes now if it is already over the new limit.
+     *
+     * @throws invalid_argument if the factor is not in (0, 1).
+     */
+    void setMaxLoadFactor(float factor) {
+        if (!(factor > 0.0f && factor < 1.0f)) throw invalid_argument("Max load factor must be in (0, 1)");
+        maxLoad = factor;
+        if (capacity != 0) {
+            size_t needed = capacity;
+            while (growthLimit(needed) < count) needed *= 2;
+            rehash(needed);
+        }
+    }
+
+    // Destroys every entry; the table keeps its capacity.
+    void clear() {
+        if (capacity == 0) return;
+        if constexpr (!is_trivially_destructible<Entry>::value) {
+            for (size_t i = 0; i < capacity; i++) {
+                if (ctrl[i] >= 0) slots[i].~Entry();
+            }
+        }
+        std::memset(ctrl, static_cast<unsigned char>(ctrlEmpty), capacity + groupWidth);
+        count = 0;
+        growthLeft = growthLimit(capacity);
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity); }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    size_t getCapacity() const { return capacity; }
+    float maxLoadFactor() const { return maxLoad; }
+    float loadFactor() const { return capacity ? static_cast<float>(count) / static_cast<float>(capacity) : 0.0f; }
+    static constexpr size_t probeGroupWidth() { return groupWidth; }
+
+    /**
+     * @brief Probe and rehash counters of this map (see FlatHashMapStats).
+     *
+     * Only counted when built with -DDS_INSTRUMENT; otherwise every field is 0.
+     * A copy or a move starts its own counters at 0.
+     *
+     * Example (instrumented):
+     *   reserve(1000), insert 1000 keys, find each  ->  lookups 2000, rehashes 0,
+     *                                                   groupsProbed / lookups close to 1
+     */
+    FlatHashMapStats stats() const {
+        FlatHashMapStats result;
+#if DS_HASH_INSTRUMENT
+        result.lookups = counters.lookups.load(memory_order_relaxed);
+        result.groupsProbed = counters.groupsProbed.load(memory_order_relaxed);
+        result.longestProbe = counters.longestProbe.load(memory_order_relaxed);
+        result.rehashes = counters.rehashes.load(memory_order_relaxed);
+        result.entriesMoved = counters.entriesMoved.load(memory_order_relaxed);
+#endif
+        return result;
+    }
+
+    void resetStats() {
+#if DS_HASH_INSTRUMENT
+        counters.lookups.store(0, memory_order_relaxed);
+        counters.groupsProbed.store(0, memory_order_relaxed);
+        counters.longestProbe.store(0, memory_order_relaxed);
+        counters.rehashes.store(0, memory_order_relaxed);
+        counters.entriesMoved.store(0, memory_order_relaxed);
+#endif
+    }
+};
+
+// ***************  CONCURRENT HASH MAP  ****************
+
+/**
+* @brief A thread-safe hash map: ShardCount independent FlatHashMaps, each behind its own reader-writer lock.
+*
+* The top bits of a key's hash pick the shard (the low bits are the tables' fingerprint and
+* probe start), so threads working on different keys rarely touch the same lock.
+* Lookups take the shard's lock shared and run in parallel; inserts and erases take it exclusively.
+*
+* A shard never rehashes in one go while holding its lock. When its table runs out of
+* room, the full table becomes the shard's draining table and a fresh one twice the
+* size takes its place. Every later write to that shard first moves the next
+* migrationSlotsPerWrite slots across, so the copy is spread over many operations and no
+* single call pays for the whole table. Until it is drained, lookups check both tables.
+* New entries only ever go into the fresh table.
+*
+* Lookups return copies: a reference would outlive the lock that protects it.
+*
+* @tparam ShardCount  Number of shards, a power of two.
+*/
+template <typename K, typename V, typename Hash = FastHash<K>, typename Equal = KeyEqual, size_t ShardCount = 64>
+class ConcurrentHashMap {
+    static_assert(ShardCount != 0 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of two");
+
+public:
+    // Slots a write moves from the draining table before doing its own work: one group's worth.
+    static constexpr size_t migrationSlotsPerWrite = 16;
+
+private:
+    using Table = FlatHashMap<K, V, Hash, Equal>;
+
+    // One cache line (at least) per shard, so locking one shard does not contend with its neighbours.
+    struct alignas(64) Shard {
+        mutable shared_mutex lock;
+        Table current;
+        Table draining;          // the previous table while it is being migrated, else empty
+        size_t cursor = 0;       // next slot of `draining` to migrate
+        bool migrating = false;
+    };
+
+    Shard shards[ShardCount];
+    Hash hasher;
+
+    static constexpr unsigned shardBits() {
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < ShardCount) bits++;
+        return bits;
+    }
+
+    Shard& shardFor(size_t hash) {
+        if constexpr (ShardCount == 1) return shards[0];
+        else return shards[hash >> (numeric_limits<size_t>::digits - shardBits())];
+    }
+
+    const Shard& shardFor(size_t hash) const {
+        return const_cast<ConcurrentHashMap*>(this)->shardFor(hash);
+    }
+
+    /**
+     * @brief Moves the next batch of slots out of the draining table. Caller holds the lock exclusively.
+     *
+     * Time Complexity  : O(migrationSlotsPerWrite)
+     */
+    void migrateStep(Shard& shard) {
+        shard.cursor = shard.draining.extractSlots(shard.cursor, migrationSlotsPerWrite, [&](typename Table::Entry&& entry) {
+            size_t hash = hasher(entry.key);
+            shard.current.emplaceHashed(hash, std::move(entry.key), std::move(entry.value));
+        });
+        if (shard.cursor >= shard.draining.getCapacity()) {
+            shard.draining = Table();
+            shard.cursor = 0;
+            shard.migrating = false;
+        }
+    }
+
+    /**
+     * @brief Runs before every write: advances a migration in progress, or starts one when
+     * the current table has no room left for another entry.
+     *
+     * A new migration starts only once the previous one is done. The fresh table is sized
+     * for twice the live entries, so it takes as many new keys again before it fills. The
+     * old table is drained in capacity / 16 writes, which is usually sooner. It is not when
+     * that table was mostly tombstones: then few live entries back a large capacity, and
+     * enough new keys can fill the fresh table mid-migration. The fresh table then grows
+     * in one go, but it only moves what it holds, about twice the live count.
+     */
+    void prepareWrite(Shard& shard) {
+        if (!shard.migrating && shard.current.getCapacity() != 0 && shard.current.growthRemaining() == 0) {
+            Table fresh;
+            fresh.reserve(shard.current.size() * 2);
+            shard.draining = std::move(shard.current);
+            shard.current = std::move(fresh);
+            shard.migrating = true;
+        }
+        if (shard.migrating) migrateStep(shard);
+    }
+
+    template <typename Q>
+    static V* findIn(Shard& shard, const Q& key, size_t hash) {
+        if (V* value = shard.current.findHashed(key, hash)) return value;
+        return shard.migrating ? shard.draining.findHashed(key, hash) : nullptr;
+    }
+
+    template <typename Q>
+    static const V* findIn(const Shard& shard, const Q& key, size_t hash) {
+        if (const V* value = shard.current.findHashed(key, hash)) return value;
+        return shard.migrating ? shard.draining.findHashed(key, hash) : nullptr;
+    }
+
+public:
+    ConcurrentHashMap() = default;
+
+    // Sizes every shard for its share of `expected` entries.
+    explicit ConcurrentHashMap(size_t expected) { reserve(expected); }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    /**
+     * @brief Inserts `key` -> `value` if the key is absent.
+     *
+     * Time Complexity  : O(1) expected, plus a bounded migration step
+     *
+     * @return true if the entry was inserted.
+     */
+    bool insert(const K& key, const V& value) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        unique_lock<shared_mutex> guard(shard.lock);
+        prepareWrite(shard);
+        if (shard.migrating && shard.draining.findHashed(key, hash)) return false;
+        return shard.current.emplaceHashed(hash, key, value).second;
+    }
+
+    // Inserts, or overwrites the value of an existing key. Returns true if it was inserted.
+    bool insertOrAssign(const K& key, const V& value) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        unique_lock<shared_mutex> guard(shard.lock);
+        prepareWrite(shard);
+        if (shard.migrating) {
+            if (V* old = shard.draining.findHashed(key, hash)) {
+                *old = value;
+                return false;
+            }
+        }
+        pair<V*, bool> result = shard.current.emplaceHashed(hash, key, value);
+        if (!result.second) *result.first = value;
+        return result.second;
+    }
+
+    /**
+     * @brief Applies `fn(V&)` to the value of `key` under the shard's exclusive lock.
+     *
+     * A read-modify-write, such as a counter increment, is atomic this way; a find followed
+     * by an insertOrAssign is not.
+     *
+     * Example:
+     *   hits = {"/": 4}
+     *   hits.update("/", [](int& n) { n++; })  ->  true, {"/": 5}
+     *
+     * @return false if the key is absent (fn is not called).
+     */
+    template <typename Fn>
+    bool update(const K& key, Fn&& fn) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        unique_lock<shared_mutex> guard(shard.lock);
+        prepareWrite(shard);
+        V* value = findIn(shard, key, hash);
+        if (!value) return false;
+        fn(*value);
+        return true;
+    }
+
+    // Removes `key`; returns whether it was present.
+    bool erase(const K& key) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        unique_lock<shared_mutex> guard(shard.lock);
+        prepareWrite(shard);
+        if (shard.current.eraseHashed(key, hash)) return true;
+        return shard.migrating && shard.draining.eraseHashed(key, hash);
+    }
+
+    /**
+     * @brief Copies the value of `key` into `out`.
+     *
+     * Takes the shard's lock shared, so lookups on the same shard run concurrently.
+     *
+     * Time Complexity  : O(1) expected
+     *
+     * @return false if the key is absent (`out` is untouched).
+     */
+    bool find(const K& key, V& out) const {
+        size_t hash = hasher(key);
+        const Shard& shard = shardFor(hash);
+        shared_lock<shared_mutex> guard(shard.lock);
+        const V* value = findIn(shard, key, hash);
+        if (!value) return false;
+        out = *value;
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        size_t hash = hasher(key);
+        const Shard& shard = shardFor(hash);
+        shared_lock<shared_mutex> guard(shard.lock);
+        return findIn(shard, key, hash) != nullptr;
+    }
+
+    /**
+     * @brief Calls `fn(key, value)` for every entry, one shard at a time.
+     *
+     * Each shard is locked shared while it is visited. Writes to other shards carry on,
+     * so under concurrent writes the result is not one consistent snapshot.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            for (auto entry : shard.current) fn(entry.key, entry.value);
+            if (shard.migrating) {
+                for (auto entry : shard.draining) fn(entry.key, entry.value);
+            }
+        }
+    }
+
+    /**
+     * @brief Sizes every shard for its share of `n` entries.
+     *
+     * A shard that is migrating is left alone; it is already sized for twice its entries.
+     */
+    void reserve(size_t n) {
+        size_t perShard = (n + ShardCount - 1) / ShardCount;
+        for (Shard& shard : shards) {
+            unique_lock<shared_mutex> guard(shard.lock);
+            if (!shard.migrating) shard.current.reserve(perShard + perShard / 8);   // slack for uneven shards
+        }
+    }
+
+    void clear() {
+        for (Shard& shard : shards) {
+            unique_lock<shared_mutex> guard(shard.lock);
+            shard.current.clear();
+            shard.draining = Table();
+            shard.cursor = 0;
+            shard.migrating = false;
+        }
+    }
+
+    // Exact when no writes are running; otherwise a value the map passed through shard by shard.
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            total += shard.current.size() + shard.draining.size();
+        }
+        return total;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    // Shards with a migration still in progress.
+    size_t shardsMigrating() const {
+        size_t migrating = 0;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            if (shard.migrating) migrating++;
+        }
+        return migrating;
+    }
+
+    bool isRehashing() const { return shardsMigrating() != 0; }
+
+    /**
+     * @brief The probe counters of every shard table added up; longestProbe is the longest of any.
+     *
+     * Entries moved by incremental migration are not rehashes and are not counted.
+     * All zero unless built with -DDS_INSTRUMENT.
+     */
+    FlatHashMapStats stats() const {
+        FlatHashMapStats total;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            for (const Table* table : { &shard.current, &shard.draining }) {
+                FlatHashMapStats s = table->stats();
+                total.lookups += s.lookups;
+                total.groupsProbed += s.groupsProbed;
+                if (s.longestProbe > total.longestProbe) total.longestProbe = s.longestProbe;
+                total.rehashes += s.rehashes;
+                total.entriesMoved += s.entriesMoved;
+            }
+        }
+        return total;
+    }
+
+    static constexpr size_t shardCount() { return ShardCount; }
+};
+
+// Allocator for the tests: forwards to operator new until `allowed` allocations are used up, then throws.
+struct AllocationBudget {
+    static inline size_t allowed = SIZE_MAX;
+};
+
+template <typename T>
+struct FailingAllocator {
+    using value_type = T;
+
+    FailingAllocator() = default;
+    template <typename U>
+    FailingAllocator(const FailingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (AllocationBudget::allowed == 0) throw bad_alloc();
+        AllocationBudget::allowed--;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p); }
+
+    bool operator==(const FailingAllocator&) const { return true; }
+    bool operator!=(const FailingAllocator&) const { return false; }
+};
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test FlatHashMap: basic operations
+    // ---------------------------------------------------------------
+    cout << "=== FlatHashMap ===" << endl;
+    FlatHashMap<string, int> stock;
+    stock.insert("apple", 3);
+    stock.insert("banana", 12);
+    stock.insert("cherry", 7);
+    cout << "insert x3          -> Expected : 3 | Result : " << stock.size() << endl;
+    cout << "insert duplicate   -> Expected : false (value stays 3) | Result : "
+         << (stock.insert("apple", 9) ? "true" : "false") << " (value stays " << stock.at("apple") << ")" << endl;
+    stock.insertOrAssign(string("apple"), 9);
+    cout << "insertOrAssign     -> Expected : 9 | Result : " << stock.at("apple") << endl;
+    stock["durian"] += 5;
+    cout << "operator[]         -> Expected : 5 | Result : " << stock.at("durian") << endl;
+    cout << "erase(\"banana\")    -> Expected : true / contains false | Result : " << (stock.erase("banana") ? "true" : "false")
+         << " / contains " << (stock.contains("banana") ? "true" : "false") << endl;
+    try {
+        stock.at("mango");
+    }
+    catch (const out_of_range& e) {
+        cout << "at(\"mango\") correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test heterogeneous lookup: no temporary std::string is built
+    // ---------------------------------------------------------------
+    cout << "\n=== Heterogeneous Lookup ===" << endl;
+    string_view request = "GET /cherry HTTP/1.1";
+    string_view fruit = request.substr(5, 6);
+    const int* found = stock.find(fruit);
+    cout << "find(string_view)  -> Expected : 7 | Result : " << (found ? *found : -1) << endl;
+    cout << "find(const char*)  -> Expected : 5 | Result : " << *stock.find("durian") << endl;
+
+    // ---------------------------------------------------------------
+    // Test capacity control: reserve and max load factor
+    // ---------------------------------------------------------------
+    cout << "\n=== Reserve & Load Factor ===" << endl;
+    FlatHashMap<int, int> squares;
+    squares.reserve(1000);
+    size_t reserved = squares.getCapacity();
+    for (int i = 0; i < 1000; i++) squares.insert(i, i * i);
+    cout << "reserve(1000)      -> Expected : capacity unchanged by 1000 inserts | Result : "
+         << (squares.getCapacity() == reserved ? "capacity unchanged by 1000 inserts" : "rehashed!") << endl;
+    cout << "find(31)           -> Expected : 961 | Result : " << *squares.find(31) << endl;
+    cout << "load factor        -> Expected : <= 0.875 | Result : " << squares.loadFactor() << endl;
+    squares.setMaxLoadFactor(0.5f);
+    cout << "setMaxLoadFactor   -> Expected : <= 0.5, 1000 entries | Result : " << squares.loadFactor()
+         << ", " << squares.size() << " entries" << endl;
+    try {
+        squares.setMaxLoadFactor(1.5f);
+    }
+    catch (const invalid_argument& e) {
+        cout << "setMaxLoadFactor(1.5) correctly threw: " << e.what() << endl;
+    }
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test churn: erase/insert cycles reuse slots instead of growing
+    // ---------------------------------------------------------------
+    cout << "\n=== Churn ===" << endl;
+    FlatHashMap<uint64_t, uint64_t> window;
+    for (uint64_t i = 0; i < 100000; i++) {
+        window.insert(i, i);
+        if (i >= 500) window.erase(i - 500);   // a sliding window of 500 live keys
+    }
+    cout << "sliding window     -> Expected : 500 live, capacity <= 1024 | Result : " << window.size()
+         << " live, capacity " << window.getCapacity() << endl;
+    uint64_t sum = 0;
+    for (auto [key, value] : window) sum += key + value;
+    cout << "iteration sum      -> Expected : " << 2 * (99500ull + 99999ull) * 500 / 2 << " | Result : " << sum << endl;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    // ---------------------------------------------------------------
+    // Test allocation failure: a rehash that cannot get memory leaves the map as it was
+    // ---------------------------------------------------------------
+    cout << "\n=== Allocation Failure ===" << endl;
+    {
+        FlatHashMap<int, int, FastHash<int>, KeyEqual, FailingAllocator<pair<const int, int>>> fragile;
+        for (int i = 0; i < 10; i++) fragile.insert(i, i * 10);
+        size_t capacityBefore = fragile.getCapacity();
+        AllocationBudget::allowed = 1;   // the control bytes succeed, the slots throw
+        try {
+            fragile.reserve(1000);
+        }
+        catch (const bad_alloc&) {
+            cout << "reserve(1000) correctly threw bad_alloc" << endl;
+        }
+        AllocationBudget::allowed = SIZE_MAX;
+        cout << "after failed rehash -> Expected : 10 entries, capacity " << capacityBefore << ", find(7) = 70 | Result : "
+             << fragile.size() << " entries, capacity " << fragile.getCapacity() << ", find(7) = " << *fragile.find(7) << endl;
+        for (int i = 10; i < 100; i++) fragile.insert(i, i * 10);
+        cout << "grow afterwards     -> Expected : 100 entries, find(99) = 990 | Result : "
+             << fragile.size() << " entries, find(99) = " << *fragile.find(99) << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test hash functions
+    // ---------------------------------------------------------------
+    cout << "\n=== Hashing ===" << endl;
+    cout << "wyhash(\"\") stable  -> Expected : true | Result : " << (wyhash("", 0) == wyhash("", 0) ? "true" : "false") << endl;
+    cout << "string == view     -> Expected : true | Result : "
+         << (FastHash<string>()(string("cherry")) == FastHash<string>()(string_view("cherry")) ? "true" : "false") << endl;
+    cout << "FastHash<int>(1/2) -> Expected : low 7 bits differ | Result : "
+         << ((FastHash<int>()(1) & 0x7F) != (FastHash<int>()(2) & 0x7F) ? "low 7 bits differ" : "same h2") << endl;
+    cout << "probe group width  -> Expected : 16 (SSE2) or 8 (portable) | Result : " << FlatHashMap<int, int>::probeGroupWidth() << endl;
+
+    // ---------------------------------------------------------------
+    // Test instrumentation (every counter is 0 unless built with -DDS_INSTRUMENT)
+    // ---------------------------------------------------------------
+    const bool instrumented = DS_HASH_INSTRUMENT != 0;
+    cout << "\n=== Instrumentation (DS_INSTRUMENT " << (instrumented ? "on" : "off") << ") ===" << endl;
+    AllocationTracker::reset();
+    size_t liveBefore = AllocationTracker::snapshot().liveBytes;   // the maps of the tests above
+    {
+        FlatHashMap<int, int> grown;
+        for (int i = 0; i < 1000; i++) grown.insert(i, i);
+        FlatHashMapStats growth = grown.stats();
+        bool wide = FlatHashMap<int, int>::probeGroupWidth() == 16;   // the first table has one group of slots
+        cout << "1000 inserts, no reserve -> Expected : " << (instrumented ? (wide ? 7 : 8) : 0) << " rehashes ("
+             << FlatHashMap<int, int>::probeGroupWidth() << " -> ... -> 2048 slots), " << (instrumented ? (wide ? 1778 : 1785) : 0)
+             << " moved | Result : " << growth.rehashes << " rehashes, " << growth.entriesMoved << " moved" << endl;
+
+        grown.resetStats();
+        for (int i = 0; i < 1000; i++) grown.contains(i);
+        FlatHashMapStats hits = grown.stats();
+        cout << "1000 finds               -> Expected : " << (instrumented ? 1000 : 0) << " lookups, under 1.1 groups each | Result : "
+             << hits.lookups << " lookups, "
+             << (hits.lookups ? static_cast<double>(hits.groupsProbed) / static_cast<double>(hits.lookups) : 0.0) << " groups each" << endl;
+
+        struct OneBucketHash {
+            size_t operator()(int) const { return 42; }   // every key collides: the worst hash there is
+        };
+        FlatHashMap<int, int, OneBucketHash> clustered;
+        for (int i = 0; i < 100; i++) clustered.insert(i, i);
+        cout << "100 keys, constant hash  -> Expected : longest probe " << (instrumented ? 100 / FlatHashMap<int, int>::probeGroupWidth() + 1 : 0)
+             << " groups | Result : longest probe " << clustered.stats().longestProbe << " groups" << endl;
+    }
+    AllocationCounts heap = AllocationTracker::snapshot();
+    cout << "table memory after       -> Expected : allocations == frees, live +0 | Result : "
+         << (heap.allocations == heap.deallocations ? "allocations == frees" : "allocations != frees")
+         << " (" << heap.allocations << "), live +" << heap.liveBytes - liveBefore
+         << ", peak +" << heap.peakBytes - liveBefore << " bytes" << endl;
+
+    // ---------------------------------------------------------------
+    // Test ConcurrentHashMap: incremental migration (one shard, to watch it)
+    // ---------------------------------------------------------------
+    cout << "\n=== ConcurrentHashMap: Incremental Rehash ===" << endl;
+    ConcurrentHashMap<int, int, FastHash<int>, KeyEqual, 1> single;
+    int next = 0;
+    while (next < 1000 || !single.isRehashing()) {   // the small early migrations finish at once; wait for a big one
+        single.insert(next, next);
+        next++;
+    }
+    cout << "migration starts   -> Expected : on insert 1793 (1792 = 2048 * 0.875 fill the table) | Result : on insert "
+         << next << endl;
+    int writes = 0;
+    bool allFound = true;
+    while (single.isRehashing()) {
+        single.insert(next, next);
+        next++;
+        writes++;
+        for (int key = 0; key < next; key += 97) allFound = allFound && single.contains(key);
+    }
+    cout << "writes to drain    -> Expected : 127 more (2048 slots / 16 per write; insert 1793 moved the first 16) | Result : " << writes << " more" << endl;
+    cout << "found mid-rehash   -> Expected : true | Result : " << (allFound ? "true" : "false") << endl;
+    cout << "size after         -> Expected : " << next << " | Result : " << single.size() << endl;
+
+    // ---------------------------------------------------------------
+    // Test ConcurrentHashMap: threads writing and reading at once
+    // ---------------------------------------------------------------
+    cout << "\n=== ConcurrentHashMap: Threads ===" << endl;
+    ConcurrentHashMap<uint64_t, uint64_t> shared;
+    const int writerCount = 4;
+    const uint64_t perWriter = 50000;
+    thread workers[writerCount + 2];
+    for (int w = 0; w < writerCount; w++) {
+        workers[w] = thread([&shared, w, perWriter] {
+            for (uint64_t i = 0; i < perWriter; i++) {
+                uint64_t key = i * writerCount + w;   // writers own disjoint keys
+                shared.insert(key, key * 2);
+                shared.insertOrAssign(0, 0);         // and all fight over one hot key
+            }
+        });
+    }
+    bool readsConsistent = true;
+    uint64_t counter = 0;
+    for (int r = 0; r < 2; r++) {
+        workers[writerCount + r] = thread([&shared, &readsConsistent, r, perWriter] {
+            bool consistent = true;
+            for (uint64_t i = 0; i < perWriter * writerCount; i++) {
+                uint64_t key = (i * 7919 + r) % (perWriter * writerCount), value = 0;
+                if (shared.find(key, value)) consistent = consistent && value == key * 2;   // present means complete
+            }
+            if (!consistent) readsConsistent = false;
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    cout << "4 writers, 2 readers -> Expected : 200000 entries | Result : " << shared.size() << " entries" << endl;
+    cout << "readers saw        -> Expected : only complete values | Result : "
+         << (readsConsistent ? "only complete values" : "torn values!") << endl;
+    uint64_t total = 0;
+    shared.forEach([&total](uint64_t, uint64_t value) { total += value; });
+    cout << "forEach sum        -> Expected : " << (perWriter * writerCount - 1) * (perWriter * writerCount) << " | Result : " << total << endl;
+
+    shared.insertOrAssign(0, 0);
+    thread counters[writerCount];
+    for (thread& worker : counters) {
+        worker = thread([&shared] {
+            for (int i = 0; i < 10000; i++) shared.update(0, [](uint64_t& n) { n++; });
+        });
+    }
+    for (thread& worker : counters) worker.join();
+    shared.find(0, counter);
+    cout << "update() x 40000   -> Expected : 40000 | Result : " << counter << endl;
+    cout << "erase / contains   -> Expected : true / false | Result : " << (shared.erase(8) ? "true" : "false")
+         << " / " << (shared.contains(8) ? "true" : "false") << endl;
+    cout << "shards             -> Expected : 64 | Result : " << shared.shardCount() << endl;
+
+    return 0;
+}
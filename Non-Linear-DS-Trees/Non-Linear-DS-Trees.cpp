@@ -1,20 +1,2686 @@
-// Non-Linear-DS-Trees.cpp : This file contains the 'main' function. Program execution begins and ends there.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// In-node key search uses SSE2 on x86-64 and NEON on AArch64 for 32-bit integer keys.
+// Compile with -DDS_DISABLE_SIMD to force the scalar loops.
+#if defined(DS_DISABLE_SIMD)
+#define DS_TREES_SIMD_X86 0
+#define DS_TREES_SIMD_NEON 0
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define DS_TREES_SIMD_X86 1
+#define DS_TREES_SIMD_NEON 0
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DS_TREES_SIMD_X86 0
+#define DS_TREES_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define DS_TREES_SIMD_X86 0
+#define DS_TREES_SIMD_NEON 0
+#endif
+
+// Compile with -DDS_INSTRUMENT to count search depths and node memory
+// (see INSTRUMENTATION below). Without it the counters and their hooks compile to nothing.
+#if defined(DS_INSTRUMENT)
+#define DS_TREES_INSTRUMENT 1
+#else
+#define DS_TREES_INSTRUMENT 0
+#endif
+using namespace std;
+
+/**
+* **TREES - WIDE NODES**
+*
+* A binary search tree stores one key per node, so a lookup in a million keys
+* follows about 20 child pointers, and each one is likely a cache miss:
+*
+*   BST:      [50] -> [25] -> [37] -> [31] -> ...        one key compared per miss
+*
+* BinarySearchTree and AvlTree keep those nodes in a per-tree arena: slabs of
+* slots addressed by 32-bit indices, so a child link is 4 bytes instead of 8, and
+* a whole tree is destroyed by dropping its slabs instead of deleting node by node.
+* buildFromSorted() builds a perfectly balanced tree from sorted input in O(n).
+*
+* A B+-tree packs many sorted keys into each node, sized to a few cache lines (or a page).
+* One miss brings in a whole node, and the search inside it runs on data already in cache:
+*
+*   B+-tree:  [ 10 | 20 | 30 | 40 | ... ]                 ~20 keys compared per miss
+*             /    |    |    |      \
+*        [leaf] [leaf] [leaf] [leaf] ...  <->  linked left to right
+*
+* All values sit in the leaves, and the leaves form a linked list. A range query descends
+* once to its first key, then walks leaves sequentially, without going back up the tree.
+*/
+
+// ***************  INSTRUMENTATION  ****************
 //
+// Opt-in counters for the cost a complexity table cannot show: how deep searches really
+// go. A BinarySearchTree fed sorted keys is O(n) deep, and that only shows up as a slow
+// call site. Built with -DDS_INSTRUMENT, BinarySearchTree and AvlTree count the nodes
+// every search visits (stats()), and AllocationTracker adds up the node memory of every
+// tree. Without it the trees have no counter member and every hook is an empty inline function.
 
-#include <iostream>
+/**
+* @brief What the searches of one BinarySearchTree or AvlTree have done since construction
+* (or since resetStats()).
+*
+*   searches       descents from the root: contains(), and BinarySearchTree's insert() / erase()
+*   nodesVisited   nodes those descents compared against; nodesVisited / searches is the mean depth
+*   deepestSearch  the most nodes one descent visited; far above log2(size()) means a degenerate tree
+*
+* All fields stay 0 when instrumentation is compiled out.
+*/
+struct TreeSearchStats {
+    size_t searches = 0;
+    size_t nodesVisited = 0;
+    size_t deepestSearch = 0;
+};
+
+// A snapshot of AllocationTracker.
+struct AllocationCounts {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesAllocated = 0;
+    size_t bytesFreed = 0;
+    size_t liveBytes = 0;     // allocated and not yet freed
+    size_t peakBytes = 0;     // the most liveBytes has been since the last reset()
+};
+
+/**
+* @brief Node memory of every tree in the program: arena slabs and their index tables,
+* B+-tree nodes, and ART nodes and leaves.
+*
+* The counters are relaxed atomics, so trees on any thread are tracked together.
+* Without -DDS_INSTRUMENT the record functions are empty and snapshot() is all zeros.
+*/
+class AllocationTracker {
+#if DS_TREES_INSTRUMENT
+    inline static atomic<size_t> allocations{ 0 };
+    inline static atomic<size_t> deallocations{ 0 };
+    inline static atomic<size_t> bytesAllocated{ 0 };
+    inline static atomic<size_t> bytesFreed{ 0 };
+    inline static atomic<size_t> liveBytes{ 0 };
+    inline static atomic<size_t> peakBytes{ 0 };
+#endif
+
+public:
+    static void recordAllocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_TREES_INSTRUMENT
+        allocations.fetch_add(1, memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, memory_order_relaxed);
+        size_t live = liveBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+        size_t peak = peakBytes.load(memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+#endif
+    }
+
+    static void recordDeallocation([[maybe_unused]] size_t bytes) noexcept {
+#if DS_TREES_INSTRUMENT
+        deallocations.fetch_add(1, memory_order_relaxed);
+        bytesFreed.fetch_add(bytes, memory_order_relaxed);
+        liveBytes.fetch_sub(bytes, memory_order_relaxed);
+#endif
+    }
+
+    static AllocationCounts snapshot() noexcept {
+        AllocationCounts counts;
+#if DS_TREES_INSTRUMENT
+        counts.allocations = allocations.load(memory_order_relaxed);
+        counts.deallocations = deallocations.load(memory_order_relaxed);
+        counts.bytesAllocated = bytesAllocated.load(memory_order_relaxed);
+        counts.bytesFreed = bytesFreed.load(memory_order_relaxed);
+        counts.liveBytes = liveBytes.load(memory_order_relaxed);
+        counts.peakBytes = peakBytes.load(memory_order_relaxed);
+#endif
+        return counts;
+    }
+
+    // Zeroes the counts. Nodes that are still allocated stay live, so the peak restarts from them.
+    static void reset() noexcept {
+#if DS_TREES_INSTRUMENT
+        allocations.store(0, memory_order_relaxed);
+        deallocations.store(0, memory_order_relaxed);
+        bytesAllocated.store(0, memory_order_relaxed);
+        bytesFreed.store(0, memory_order_relaxed);
+        peakBytes.store(liveBytes.load(memory_order_relaxed), memory_order_relaxed);
+#endif
+    }
+};
+
+// ***************  NODE ARENA  ****************
+
+// A node handle: the index of the node's slot in its tree's arena.
+using NodeIndex = uint32_t;
+
+// The "null pointer" of index links.
+constexpr NodeIndex nullNode = UINT32_MAX;
+
+// Child links stored next to each value. The free list reuses `left`.
+struct BstLinks {
+    NodeIndex left = nullNode;
+    NodeIndex right = nullNode;
+};
+
+struct AvlLinks {
+    NodeIndex left = nullNode;
+    NodeIndex right = nullNode;
+    int32_t height = 1;   // levels in the subtree rooted here; a leaf is 1
+};
+
+constexpr size_t log2Exact(size_t n) {
+    return n <= 1 ? 0 : 1 + log2Exact(n / 2);
+}
+
+/**
+* @brief A slab allocator for tree nodes, addressed by 32-bit indices.
+*
+* Every tree owns one. Nodes are carved from slabs of SlabSize slots that never move,
+* so references stay valid as the arena grows. Erased slots go onto a free list.
+*
+* Tearing a tree down is a matter of dropping the arena, not of visiting nodes.
+* For trivially destructible values, clear() just resets two counters and keeps the
+* slabs for the next build, and the destructor frees one block per slab. Other
+* values are destroyed by one sequential sweep over the slabs, not a recursive walk.
+*
+* Time Complexity  : create / destroy / value O(1); clear O(1) for trivially destructible T
+*
+* @tparam Payload   The value stored in each node.
+* @tparam Links     BstLinks or AvlLinks.
+* @tparam SlabSize  Slots per slab (a power of two).
+*/
+template <typename Payload, typename Links, size_t SlabSize = 1024>
+class TreeArena {
+    static_assert(SlabSize > 0 && (SlabSize & (SlabSize - 1)) == 0, "SlabSize must be a power of two");
+
+    struct Slot {
+        Links links;
+        alignas(Payload) unsigned char bytes[sizeof(Payload)];
+    };
+
+    static constexpr size_t slabShift = log2Exact(SlabSize);
+    static constexpr NodeIndex freeSlot = nullNode - 1;   // `right` of a slot on the free list
+
+    Slot** slabs = nullptr;
+    size_t slabCount = 0;
+    size_t slabTableCapacity = 0;
+    NodeIndex highWater = 0;        // slots [0, highWater) have been handed out at least once
+    NodeIndex freeHead = nullNode;
+    size_t live = 0;
+
+    Slot& slot(NodeIndex index) { return slabs[index >> slabShift][index & (SlabSize - 1)]; }
+    const Slot& slot(NodeIndex index) const { return slabs[index >> slabShift][index & (SlabSize - 1)]; }
+
+    void addSlab() {
+        if (slabCount == slabTableCapacity) {
+            size_t newCapacity = slabTableCapacity == 0 ? 4 : slabTableCapacity * 2;
+            Slot** table = new Slot*[newCapacity];
+            AllocationTracker::recordAllocation(newCapacity * sizeof(Slot*));
+            if (slabCount > 0) std::memcpy(table, slabs, slabCount * sizeof(Slot*));
+            releaseSlabTable();
+            slabs = table;
+            slabTableCapacity = newCapacity;
+        }
+        slabs[slabCount] = std::allocator<Slot>().allocate(SlabSize);
+        AllocationTracker::recordAllocation(SlabSize * sizeof(Slot));
+        slabCount++;
+    }
+
+    void releaseSlabTable() {
+        if (!slabs) return;
+        delete[] slabs;
+        AllocationTracker::recordDeallocation(slabTableCapacity * sizeof(Slot*));
+    }
+
+    // Destroys every live payload, in slot order.
+    void destroyPayloads() {
+        if constexpr (!is_trivially_destructible<Payload>::value) {
+            for (NodeIndex i = 0; i < highWater; i++) {
+                Slot& s = slot(i);
+                if (s.links.right != freeSlot) std::launder(reinterpret_cast<Payload*>(s.bytes))->~Payload();
+            }
+        }
+    }
+
+    void releaseSlabs() {
+        destroyPayloads();
+        for (size_t i = 0; i < slabCount; i++) {
+            std::allocator<Slot>().deallocate(slabs[i], SlabSize);
+            AllocationTracker::recordDeallocation(SlabSize * sizeof(Slot));
+        }
+        releaseSlabTable();
+        slabs = nullptr;
+        slabCount = slabTableCapacity = 0;
+        highWater = 0;
+        freeHead = nullNode;
+        live = 0;
+    }
+
+public:
+    TreeArena() = default;
+    TreeArena(const TreeArena&) = delete;
+    TreeArena& operator=(const TreeArena&) = delete;
+
+    TreeArena(TreeArena&& other) noexcept
+        : slabs(other.slabs), slabCount(other.slabCount), slabTableCapacity(other.slabTableCapacity),
+          highWater(other.highWater), freeHead(other.freeHead), live(other.live) {
+        other.slabs = nullptr;
+        other.slabCount = other.slabTableCapacity = 0;
+        other.highWater = 0;
+        other.freeHead = nullNode;
+        other.live = 0;
+    }
+
+    TreeArena& operator=(TreeArena&& other) noexcept {
+        if (this != &other) {
+            releaseSlabs();
+            std::swap(slabs, other.slabs);
+            std::swap(slabCount, other.slabCount);
+            std::swap(slabTableCapacity, other.slabTableCapacity);
+            std::swap(highWater, other.highWater);
+            std::swap(freeHead, other.freeHead);
+            std::swap(live, other.live);
+        }
+        return *this;
+    }
+
+    ~TreeArena() { releaseSlabs(); }
+
+    /**
+     * @brief Constructs a payload in a free slot and returns its handle, with links reset.
+     *
+     * If the payload constructor throws, the arena is left unchanged.
+     *
+     * Time Complexity : O(1) (amortized when a slab is added)
+     *
+     * @throws length_error if the index space is used up.
+     */
+    template <typename... Args>
+    NodeIndex create(Args&&... args) {
+        bool fromFreeList = freeHead != nullNode;
+        NodeIndex index = freeHead;
+        if (!fromFreeList) {
+            if (highWater == freeSlot) throw length_error("TreeArena is full");
+            if ((static_cast<size_t>(highWater) >> slabShift) >= slabCount) addSlab();
+            index = highWater;
+        }
+
+        Slot& s = slot(index);
+        ::new (static_cast<void*>(s.bytes)) Payload(std::forward<Args>(args)...);
+
+        if (fromFreeList) freeHead = s.links.left;
+        else highWater++;
+        s.links = Links{};
+        live++;
+        return index;
+    }
+
+    // Destroys the payload of a node and puts its slot on the free list.
+    void destroy(NodeIndex index) {
+        Slot& s = slot(index);
+        std::launder(reinterpret_cast<Payload*>(s.bytes))->~Payload();
+        s.links.left = freeHead;
+        s.links.right = freeSlot;
+        freeHead = index;
+        live--;
+    }
+
+    /**
+     * @brief Drops every node at once. The slabs are kept, so rebuilding allocates nothing.
+     *
+     * Time Complexity : O(1) for trivially destructible payloads, else one sweep over the slots
+     */
+    void clear() {
+        destroyPayloads();
+        highWater = 0;
+        freeHead = nullNode;
+        live = 0;
+    }
+
+    Payload& value(NodeIndex index) { return *std::launder(reinterpret_cast<Payload*>(slot(index).bytes)); }
+    const Payload& value(NodeIndex index) const { return *std::launder(reinterpret_cast<const Payload*>(slot(index).bytes)); }
+
+    Links& links(NodeIndex index) { return slot(index).links; }
+    const Links& links(NodeIndex index) const { return slot(index).links; }
+
+    // Adds slabs until at least n slots exist, so the next n creates never allocate.
+    void reserve(size_t n) {
+        while (capacity() < n) addSlab();
+    }
+
+    size_t size() const { return live; }
+    size_t capacity() const { return slabCount * SlabSize; }
+    size_t slabsAllocated() const { return slabCount; }
+};
+
+// ***************  ARENA TREE BASE  ****************
+
+/**
+* @brief What BinarySearchTree and AvlTree share: the arena, the root, lookups, traversal and bulk build.
+*
+* Values are ordered by operator< and unique.
+*/
+template <typename T, typename Links>
+class ArenaTreeBase {
+protected:
+    TreeArena<T, Links> arena;
+    NodeIndex root = nullNode;
+    size_t depthBound = 0;   // no path from the root is longer than this (sizes traversal stacks)
+#if DS_TREES_INSTRUMENT
+    // contains() is const and may run on several threads at once, hence mutable relaxed atomics.
+    struct SearchCounters {
+        atomic<size_t> searches{ 0 };
+        atomic<size_t> nodesVisited{ 0 };
+        atomic<size_t> deepestSearch{ 0 };
+    };
+    mutable SearchCounters counters;   // see stats()
+#endif
+
+    // Instrumentation hook: one descent that compared against `visited` nodes. Empty unless built with -DDS_INSTRUMENT.
+    void noteSearch([[maybe_unused]] size_t visited) const {
+#if DS_TREES_INSTRUMENT
+        counters.searches.fetch_add(1, memory_order_relaxed);
+        counters.nodesVisited.fetch_add(visited, memory_order_relaxed);
+        size_t deepest = counters.deepestSearch.load(memory_order_relaxed);
+        while (visited > deepest && !counters.deepestSearch.compare_exchange_weak(deepest, visited, memory_order_relaxed)) {}
+#endif
+    }
+
+    NodeIndex& left(NodeIndex node) { return arena.links(node).left; }
+    NodeIndex& right(NodeIndex node) { return arena.links(node).right; }
+    NodeIndex left(NodeIndex node) const { return arena.links(node).left; }
+    NodeIndex right(NodeIndex node) const { return arena.links(node).right; }
+    T& value(NodeIndex node) { return arena.value(node); }
+    const T& value(NodeIndex node) const { return arena.value(node); }
+
+    NodeIndex findNode(const T& target) const {
+        NodeIndex node = root;
+        size_t visited = 0;
+        while (node != nullNode) {
+            visited++;
+            const T& current = value(node);
+            if (target < current) node = left(node);
+            else if (current < target) node = right(node);
+            else break;
+        }
+        noteSearch(visited);
+        return node;
+    }
+
+    /**
+     * @brief Builds a perfectly balanced subtree over data[lo, hi): the middle element is
+     * the root, each half builds one side.
+     *
+     * Nodes are created in pre-order, so a parent and its left child are neighbours in
+     * the arena and every subtree occupies one contiguous run of slots.
+     *
+     * @return The subtree's root, or nullNode for an empty range.
+     */
+    NodeIndex buildRange(const T* data, size_t lo, size_t hi) {
+        if (lo >= hi) return nullNode;
+        size_t middle = lo + (hi - lo) / 2;
+        NodeIndex node = arena.create(data[middle]);
+        NodeIndex l = buildRange(data, lo, middle);
+        NodeIndex r = buildRange(data, middle + 1, hi);
+        left(node) = l;
+        right(node) = r;
+        if constexpr (is_same<Links, AvlLinks>::value) {
+            arena.links(node).height = static_cast<int32_t>(log2Exact(hi - lo) + 1);   // floor(log2 m) + 1 levels for m nodes
+        }
+        return node;
+    }
+
+public:
+    ArenaTreeBase() = default;
+    ArenaTreeBase(ArenaTreeBase&& other) noexcept
+        : arena(std::move(other.arena)), root(other.root), depthBound(other.depthBound) {
+        other.root = nullNode;
+        other.depthBound = 0;
+    }
+
+    ArenaTreeBase& operator=(ArenaTreeBase&& other) noexcept {
+        arena = std::move(other.arena);
+        root = other.root;
+        depthBound = other.depthBound;
+        other.root = nullNode;
+        other.depthBound = 0;
+        return *this;
+    }
+
+    bool contains(const T& target) const { return findNode(target) != nullNode; }
+
+    /**
+     * @brief Replaces the contents with a perfectly balanced tree over data[0, n).
+     *
+     * Picking the middle element as the root, recursively, gives every node subtrees whose
+     * sizes differ by at most one. That is already a valid AVL tree, so no rotation is ever done.
+     * The arena is reserved up front, so the build makes at most one round of slab allocations.
+     *
+     * Time Complexity  : O(n)
+     * Example:
+     *   buildFromSorted([1, 2, 3, 4, 5, 6, 7], 7)  ->        4
+     *                                                     /     \
+     *                                                    2       6
+     *                                                   / \     / \
+     *                                                  1   3   5   7
+     *
+     * @throws invalid_argument if the values are not strictly increasing (the tree is unchanged).
+     */
+    void buildFromSorted(const T* data, size_t n) {
+        for (size_t i = 1; i < n; i++) {
+            if (!(data[i - 1] < data[i])) throw invalid_argument("Values must be strictly increasing");
+        }
+        if (n >= nullNode) throw length_error("Too many values for 32-bit node indices");
+        clear();
+        arena.reserve(n);
+        try {
+            root = buildRange(data, 0, n);
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+        depthBound = n == 0 ? 0 : log2Exact(n) + 1;
+    }
+
+    /**
+     * @brief Calls `fn(value)` for every value in ascending order.
+     *
+     * Iterative, with an explicit stack sized from the depth bound, so a degenerate
+     * (list-shaped) BST cannot overflow the call stack.
+     *
+     * Time Complexity  : O(n)
+     */
+    template <typename Fn>
+    void forEachInOrder(Fn&& fn) const {
+        if (root == nullNode) return;
+        NodeIndex small[64];
+        unique_ptr<NodeIndex[]> large(depthBound > 64 ? new NodeIndex[depthBound] : nullptr);
+        NodeIndex* stack = large ? large.get() : small;
+        size_t top = 0;
+        NodeIndex node = root;
+        while (node != nullNode || top > 0) {
+            while (node != nullNode) {
+                stack[top++] = node;
+                node = left(node);
+            }
+            node = stack[--top];
+            fn(value(node));
+            node = right(node);
+        }
+    }
+
+    // Smallest / largest value. Throws runtime_error if the tree is empty.
+    const T& min() const {
+        if (root == nullNode) throw runtime_error("Tree is empty");
+        NodeIndex node = root;
+        while (left(node) != nullNode) node = left(node);
+        return value(node);
+    }
+
+    const T& max() const {
+        if (root == nullNode) throw runtime_error("Tree is empty");
+        NodeIndex node = root;
+        while (right(node) != nullNode) node = right(node);
+        return value(node);
+    }
+
+    /**
+     * @brief Removes every value in one step: the arena is reset, not walked node by node.
+     *
+     * The slabs are kept for the next build. Destroying the tree frees them with one
+     * deallocation per slab.
+     *
+     * Time Complexity  : O(1) for trivially destructible T
+     */
+    void clear() {
+        arena.clear();
+        root = nullNode;
+        depthBound = 0;
+    }
+
+    // Levels from the root to the deepest leaf; 0 when empty.
+    size_t height() const {
+        if (root == nullNode) return 0;
+        size_t deepest = 0;
+        NodeIndex small[64];
+        size_t smallDepth[64];
+        // Pre-order with an explicit stack holds at most one pending right child per level, plus one.
+        size_t needed = depthBound + 1;
+        unique_ptr<NodeIndex[]> large(needed > 64 ? new NodeIndex[needed] : nullptr);
+        unique_ptr<size_t[]> largeDepth(needed > 64 ? new size_t[needed] : nullptr);
+        NodeIndex* stack = large ? large.get() : small;
+        size_t* depth = large ? largeDepth.get() : smallDepth;
+        size_t top = 0;
+        stack[top] = root;
+        depth[top++] = 1;
+        while (top > 0) {
+            top--;
+            NodeIndex node = stack[top];
+            size_t d = depth[top];
+            if (d > deepest) deepest = d;
+            if (right(node) != nullNode) { stack[top] = right(node); depth[top++] = d + 1; }
+            if (left(node) != nullNode) { stack[top] = left(node); depth[top++] = d + 1; }
+        }
+        return deepest;
+    }
+
+    size_t size() const { return arena.size(); }
+    bool isEmpty() const { return root == nullNode; }
+    size_t arenaSlabs() const { return arena.slabsAllocated(); }
+
+    /**
+     * @brief Search depth counters of this tree (see TreeSearchStats).
+     *
+     * Only counted when built with -DDS_INSTRUMENT; otherwise every field is 0.
+     * A moved-to tree starts its own counters at 0.
+     *
+     * Example (instrumented):
+     *   BinarySearchTree: insert 1, 2, ..., 100, then contains(100)  ->  deepestSearch 100
+     *   AvlTree:          insert 1, 2, ..., 100, then contains(100)  ->  deepestSearch 7
+     */
+    TreeSearchStats stats() const {
+        TreeSearchStats result;
+#if DS_TREES_INSTRUMENT
+        result.searches = counters.searches.load(memory_order_relaxed);
+        result.nodesVisited = counters.nodesVisited.load(memory_order_relaxed);
+        result.deepestSearch = counters.deepestSearch.load(memory_order_relaxed);
+#endif
+        return result;
+    }
+
+    void resetStats() {
+#if DS_TREES_INSTRUMENT
+        counters.searches.store(0, memory_order_relaxed);
+        counters.nodesVisited.store(0, memory_order_relaxed);
+        counters.deepestSearch.store(0, memory_order_relaxed);
+#endif
+    }
+
+    void display() const {
+        cout << "[";
+        bool first = true;
+        forEachInOrder([&first](const T& v) {
+            if (!first) cout << ", ";
+            cout << v;
+            first = false;
+        });
+        cout << "]" << endl;
+    }
+};
+
+// ***************  BINARY SEARCH TREE  ****************
+
+/**
+* @brief An unbalanced binary search tree whose nodes live in a TreeArena.
+*
+* Every operation is iterative, so sorted input (which degenerates the tree into a
+* list) costs O(n) per operation but never overflows the stack. Use buildFromSorted()
+* for sorted input, or AvlTree for guaranteed O(log n).
+*/
+template <typename T>
+class BinarySearchTree : public ArenaTreeBase<T, BstLinks> {
+    using Base = ArenaTreeBase<T, BstLinks>;
+    using Base::arena;
+    using Base::root;
+    using Base::depthBound;
+    using Base::left;
+    using Base::right;
+    using Base::value;
+    using Base::noteSearch;
+
+public:
+    /**
+     * @brief Inserts `item` as a new leaf if it is absent.
+     *
+     * Time Complexity  : O(height)
+     *
+     * @return true if the value was inserted.
+     */
+    bool insert(const T& item) {
+        NodeIndex parent = nullNode;
+        NodeIndex node = root;
+        bool goLeft = false;
+        size_t depth = 1;
+        while (node != nullNode) {
+            const T& current = value(node);
+            if (item < current) goLeft = true;
+            else if (current < item) goLeft = false;
+            else {
+                noteSearch(depth);
+                return false;
+            }
+            parent = node;
+            node = goLeft ? left(node) : right(node);
+            depth++;
+        }
+        noteSearch(depth - 1);
+        NodeIndex created = arena.create(item);
+        if (parent == nullNode) root = created;
+        else if (goLeft) left(parent) = created;
+        else right(parent) = created;
+        if (depth > depthBound) depthBound = depth;
+        return true;
+    }
+
+    /**
+     * @brief Removes `item` if present. A node with two children takes its in-order
+     * successor's value, and the successor's node (which has no left child) is unlinked instead.
+     *
+     * Time Complexity  : O(height)
+     *
+     * @return true if the value was present.
+     */
+    bool erase(const T& item) {
+        NodeIndex* link = &root;   // the link that points at `*link`'s node
+        size_t visited = 0;
+        while (*link != nullNode) {
+            visited++;
+            const T& current = value(*link);
+            if (item < current) link = &left(*link);
+            else if (current < item) link = &right(*link);
+            else break;
+        }
+        noteSearch(visited);
+        if (*link == nullNode) return false;
+
+        NodeIndex node = *link;
+        if (left(node) != nullNode && right(node) != nullNode) {
+            NodeIndex* successor = &right(node);
+            while (left(*successor) != nullNode) successor = &left(*successor);
+            value(node) = std::move(value(*successor));
+            link = successor;
+            node = *successor;
+        }
+        *link = left(node) != nullNode ? left(node) : right(node);
+        arena.destroy(node);
+        return true;
+    }
+};
+
+// ***************  AVL TREE  ****************
+
+/**
+* @brief A self-balancing binary search tree whose nodes live in a TreeArena.
+*
+* Every node's subtrees differ in height by at most one; inserts and erases restore
+* that with at most two rotations per level on the way back up. A rotation only
+* rewrites 32-bit child indices, never moves a value.
+*/
+template <typename T>
+class AvlTree : public ArenaTreeBase<T, AvlLinks> {
+    using Base = ArenaTreeBase<T, AvlLinks>;
+    using Base::arena;
+    using Base::root;
+    using Base::depthBound;
+    using Base::left;
+    using Base::right;
+    using Base::value;
+
+    int32_t heightOf(NodeIndex node) const { return node == nullNode ? 0 : arena.links(node).height; }
+
+    void updateHeight(NodeIndex node) {
+        int32_t l = heightOf(left(node)), r = heightOf(right(node));
+        arena.links(node).height = (l > r ? l : r) + 1;
+    }
+
+    int32_t balanceOf(NodeIndex node) const { return heightOf(left(node)) - heightOf(right(node)); }
+
+    /*
+     *      node              l
+     *      /  \             / \
+     *     l    c    ->     a  node
+     *    / \                  /  \
+     *   a   b                b    c
+     */
+    NodeIndex rotateRight(NodeIndex node) {
+        NodeIndex l = left(node);
+        left(node) = right(l);
+        right(l) = node;
+        updateHeight(node);
+        updateHeight(l);
+        return l;
+    }
+
+    NodeIndex rotateLeft(NodeIndex node) {
+        NodeIndex r = right(node);
+        right(node) = left(r);
+        left(r) = node;
+        updateHeight(node);
+        updateHeight(r);
+        return r;
+    }
+
+    // Restores the height and balance of `node` after one of its subtrees changed; returns the subtree's new root.
+    NodeIndex rebalance(NodeIndex node) {
+        updateHeight(node);
+        int32_t balance = balanceOf(node);
+        if (balance > 1) {
+            if (balanceOf(left(node)) < 0) left(node) = rotateLeft(left(node));     // left-right case
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (balanceOf(right(node)) > 0) right(node) = rotateRight(right(node)); // right-left case
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Recursion depth is the tree height, at most ~1.44 log2(n).
+    NodeIndex insertAt(NodeIndex node, const T& item, bool& inserted) {
+        if (node == nullNode) {
+            inserted = true;
+            return arena.create(item);
+        }
+        const T& current = value(node);
+        if (item < current) left(node) = insertAt(left(node), item, inserted);
+        else if (current < item) right(node) = insertAt(right(node), item, inserted);
+        else return node;
+        return inserted ? rebalance(node) : node;
+    }
+
+    // Unlinks the smallest node of a subtree into `minimum`; returns the subtree's new root.
+    NodeIndex detachMin(NodeIndex node, NodeIndex& minimum) {
+        if (left(node) == nullNode) {
+            minimum = node;
+            return right(node);
+        }
+        left(node) = detachMin(left(node), minimum);
+        return rebalance(node);
+    }
+
+    NodeIndex eraseAt(NodeIndex node, const T& item, bool& erased) {
+        if (node == nullNode) return nullNode;
+        const T& current = value(node);
+        if (item < current) left(node) = eraseAt(left(node), item, erased);
+        else if (current < item) right(node) = eraseAt(right(node), item, erased);
+        else {
+            erased = true;
+            NodeIndex l = left(node), r = right(node);
+            arena.destroy(node);
+            if (l == nullNode) return r;
+            if (r == nullNode) return l;
+            // Two children: the successor node takes this node's place; no value is moved.
+            NodeIndex successor = nullNode;
+            NodeIndex rest = detachMin(r, successor);
+            left(successor) = l;
+            right(successor) = rest;
+            return rebalance(successor);
+        }
+        return erased ? rebalance(node) : node;
+    }
+
+public:
+    /**
+     * @brief Inserts `item` if it is absent, rotating on the way back up to keep the tree balanced.
+     *
+     * Time Complexity  : O(log n)
+     * Example:
+     *   insert 1, 2, 3  ->  rotation at 1  ->    2
+     *                                           / \
+     *                                          1   3
+     *
+     * @return true if the value was inserted.
+     */
+    bool insert(const T& item) {
+        bool inserted = false;
+        root = insertAt(root, item, inserted);
+        depthBound = static_cast<size_t>(heightOf(root));
+        return inserted;
+    }
+
+    /**
+     * @brief Removes `item` if present, rebalancing on the way back up.
+     *
+     * Time Complexity  : O(log n)
+     *
+     * @return true if the value was present.
+     */
+    bool erase(const T& item) {
+        bool erased = false;
+        root = eraseAt(root, item, erased);
+        depthBound = static_cast<size_t>(heightOf(root));
+        return erased;
+    }
+};
+
+// ***************  IN-NODE SEARCH  ****************
+//
+// Both functions return a position in a sorted key array k[0, n):
+//   countLess(k, n, key)      = number of keys <  key   (lower bound: where `key` is, or would go)
+//   countLessEqual(k, n, key) = number of keys <= key   (which child of an inner node holds `key`)
+//
+// Large nodes are first narrowed with a branch-free binary search, then the last
+// window of at most searchWindow keys is counted in one pass: no unpredictable branches,
+// and for 32-bit integer keys four keys per SIMD compare.
+
+constexpr size_t searchWindow = 32;
+
+template <bool OrEqual, typename K>
+size_t countBelowScalar(const K* keys, size_t n, const K& key) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += OrEqual ? !(key < keys[i]) : (keys[i] < key);
+    }
+    return count;
+}
+
+#if DS_TREES_SIMD_X86
+// `bias` flips the sign bit of unsigned keys, so the signed compare orders them correctly.
+template <bool OrEqual>
+inline size_t countBelowSse2(const int32_t* keys, size_t n, int32_t key, int32_t bias) {
+    const __m128i flip = _mm_set1_epi32(bias);
+    const __m128i target = _mm_set1_epi32(key ^ bias);
+    __m128i counts = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i lane = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), flip);
+        // A true compare is -1 in its lane; subtracting it adds 1 to that lane's count.
+        __m128i below = OrEqual ? _mm_xor_si128(_mm_cmpgt_epi32(lane, target), _mm_set1_epi32(-1))
+                                : _mm_cmpgt_epi32(target, lane);
+        counts = _mm_sub_epi32(counts, below);
+    }
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), counts);
+    size_t count = static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < n; i++) {
+        int32_t k = keys[i] ^ bias, t = key ^ bias;
+        count += OrEqual ? (k <= t) : (k < t);
+    }
+    return count;
+}
+#elif DS_TREES_SIMD_NEON
+template <bool OrEqual>
+inline size_t countBelowNeon(const int32_t* keys, size_t n, int32_t key, int32_t bias) {
+    const int32x4_t flip = vdupq_n_s32(bias);
+    const int32x4_t target = vdupq_n_s32(key ^ bias);
+    uint32x4_t counts = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t lane = veorq_s32(vld1q_s32(keys + i), flip);
+        uint32x4_t below = OrEqual ? vcleq_s32(lane, target) : vcltq_s32(lane, target);
+        counts = vsubq_u32(counts, below);
+    }
+    size_t count = vaddvq_u32(counts);
+    for (; i < n; i++) {
+        int32_t k = keys[i] ^ bias, t = key ^ bias;
+        count += OrEqual ? (k <= t) : (k < t);
+    }
+    return count;
+}
+#endif
+
+template <bool OrEqual, typename K>
+size_t countBelowWindow(const K* keys, size_t n, const K& key) {
+#if DS_TREES_SIMD_X86 || DS_TREES_SIMD_NEON
+    if constexpr (is_integral<K>::value && sizeof(K) == 4) {
+        int32_t bias = is_signed<K>::value ? 0 : INT32_MIN;
+        int32_t k32;
+        std::memcpy(&k32, &key, 4);
+#if DS_TREES_SIMD_X86
+        return countBelowSse2<OrEqual>(reinterpret_cast<const int32_t*>(keys), n, k32, bias);
+#else
+        return countBelowNeon<OrEqual>(reinterpret_cast<const int32_t*>(keys), n, k32, bias);
+#endif
+    }
+#endif
+    return countBelowScalar<OrEqual>(keys, n, key);
+}
+
+template <bool OrEqual, typename K>
+size_t countBelow(const K* keys, size_t n, const K& key) {
+    // The answer always lies in [base, base + n].
+    size_t base = 0;
+    while (n > searchWindow) {
+        size_t half = n / 2;
+        const K& probe = keys[base + half - 1];
+        bool below = OrEqual ? !(key < probe) : (probe < key);
+        base += below ? half : 0;
+        n -= half;
+    }
+    return base + countBelowWindow<OrEqual>(keys + base, n, key);
+}
+
+template <typename K>
+size_t countLess(const K* keys, size_t n, const K& key) { return countBelow<false>(keys, n, key); }
+
+template <typename K>
+size_t countLessEqual(const K* keys, size_t n, const K& key) { return countBelow<true>(keys, n, key); }
+
+// ***************  B+ TREE  ****************
+
+/**
+* @brief An ordered map with wide, cache-friendly nodes and linked leaves.
+*
+* Inner nodes hold only separator keys and child pointers; child i holds the keys in
+* [keys[i - 1], keys[i]). Leaves hold the entries and are linked in key order, so
+* iteration and range scans read leaves one after another.
+*
+* Nodes hold between half their capacity and their capacity (the root excepted). Inserts
+* split full nodes on the way down and erases refill thin ones on the way down, so both
+* make a single root-to-leaf pass. A missing key may still cause one split or merge per level.
+*
+* Keys and values are stored inline and shifted with memmove, so both must be trivially
+* copyable. Store an index or pointer for larger payloads.
+*
+* @tparam K          The key type, ordered by operator<.
+* @tparam V          The mapped type.
+* @tparam NodeBytes  Target node size: 256 (four cache lines) by default, 4096 for page-sized nodes.
+*/
+template <typename K, typename V, size_t NodeBytes = 256>
+class BPlusTree {
+    static_assert(is_trivially_copyable<K>::value && is_trivially_copyable<V>::value,
+                  "BPlusTree stores keys and values inline: both must be trivially copyable");
+
+public:
+    static constexpr size_t leafCapacity = (NodeBytes - 3 * sizeof(void*)) / (sizeof(K) + sizeof(V)) < 4
+        ? 4 : (NodeBytes - 3 * sizeof(void*)) / (sizeof(K) + sizeof(V));
+    static constexpr size_t innerCapacity = (NodeBytes - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*)) < 4
+        ? 4 : (NodeBytes - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*));
+    static_assert(leafCapacity <= UINT16_MAX && innerCapacity <= UINT16_MAX, "NodeBytes is too large");
+
+private:
+    static constexpr size_t minLeaf = leafCapacity / 2;
+    static constexpr size_t minInner = (innerCapacity - 1) / 2;   // an inner split leaves cap - cap/2 - 1 keys on the right
+
+    struct Node {
+        uint16_t count;   // keys in the node
+        bool leaf;
+    };
+
+    struct alignas(64) Leaf : Node {
+        Leaf* prev;
+        Leaf* next;
+        K keys[leafCapacity];
+        V values[leafCapacity];
+    };
+
+    struct alignas(64) Inner : Node {
+        K keys[innerCapacity];
+        Node* children[innerCapacity + 1];
+    };
+
+    Node* root = nullptr;
+    Leaf* head = nullptr;    // leftmost leaf
+    Leaf* tail = nullptr;    // rightmost leaf
+    size_t count = 0;
+    size_t levels = 0;
+
+    static Leaf* newLeaf() {
+        Leaf* leaf = new Leaf();
+        AllocationTracker::recordAllocation(sizeof(Leaf));
+        leaf->leaf = true;
+        return leaf;
+    }
+
+    static Inner* newInner() {
+        Inner* inner = new Inner();
+        AllocationTracker::recordAllocation(sizeof(Inner));
+        inner->leaf = false;
+        return inner;
+    }
+
+    static void freeNode(Leaf* leaf) {
+        delete leaf;
+        AllocationTracker::recordDeallocation(sizeof(Leaf));
+    }
+
+    static void freeNode(Inner* inner) {
+        delete inner;
+        AllocationTracker::recordDeallocation(sizeof(Inner));
+    }
+
+    static Node* newLike(const Node* node) {
+        if (node->leaf) return newLeaf();
+        return newInner();
+    }
+
+    static Leaf* asLeaf(Node* node) { return static_cast<Leaf*>(node); }
+    static Inner* asInner(Node* node) { return static_cast<Inner*>(node); }
+    static const Leaf* asLeaf(const Node* node) { return static_cast<const Leaf*>(node); }
+    static const Inner* asInner(const Node* node) { return static_cast<const Inner*>(node); }
+
+    static bool isFull(const Node* node) {
+        return node->count == (node->leaf ? leafCapacity : innerCapacity);
+    }
+
+    static void destroy(Node* node) {
+        if (!node) return;
+        if (!node->leaf) {
+            Inner* inner = asInner(node);
+            for (size_t i = 0; i <= inner->count; i++) destroy(inner->children[i]);
+            freeNode(inner);
+        }
+        else {
+            freeNode(asLeaf(node));
+        }
+    }
+
+    // The leaf whose key range covers `key`. The tree must not be empty.
+    const Leaf* leafFor(const K& key) const {
+        const Node* node = root;
+        while (!node->leaf) {
+            const Inner* inner = asInner(node);
+            node = inner->children[countLessEqual(inner->keys, inner->count, key)];
+        }
+        return asLeaf(node);
+    }
+
+    // Inserts `key` and `child` at key index i and child index i + 1 of a non-full inner node.
+    static void insertIntoInner(Inner* node, size_t i, const K& key, Node* child) {
+        std::memmove(node->keys + i + 1, node->keys + i, (node->count - i) * sizeof(K));
+        std::memmove(node->children + i + 2, node->children + i + 1, (node->count - i) * sizeof(Node*));
+        node->keys[i] = key;
+        node->children[i + 1] = child;
+        node->count++;
+    }
+
+    // Removes key index i and child index i + 1 of an inner node.
+    static void removeFromInner(Inner* node, size_t i) {
+        std::memmove(node->keys + i, node->keys + i + 1, (node->count - i - 1) * sizeof(K));
+        std::memmove(node->children + i + 1, node->children + i + 2, (node->count - i - 1) * sizeof(Node*));
+        node->count--;
+    }
+
+    /**
+     * @brief Splits the full child i of a non-full parent into child i and `sibling`, which becomes child i + 1.
+     *
+     * `sibling` is allocated by the caller, so nothing here can throw and the tree is never half-split.
+     */
+    void splitChild(Inner* parent, size_t i, Node* sibling) {
+        Node* child = parent->children[i];
+        if (child->leaf) {
+            Leaf* left = asLeaf(child);
+            Leaf* right = asLeaf(sibling);
+            size_t keep = leafCapacity / 2;
+            right->count = static_cast<uint16_t>(leafCapacity - keep);
+            std::memcpy(right->keys, left->keys + keep, right->count * sizeof(K));
+            std::memcpy(right->values, left->values + keep, right->count * sizeof(V));
+            left->count = static_cast<uint16_t>(keep);
+            right->prev = left;
+            right->next = left->next;
+            if (left->next) left->next->prev = right;
+            else tail = right;
+            left->next = right;
+            insertIntoInner(parent, i, right->keys[0], right);
+        }
+        else {
+            Inner* left = asInner(child);
+            Inner* right = asInner(sibling);
+            size_t middle = innerCapacity / 2;   // this key moves up to the parent
+            right->count = static_cast<uint16_t>(innerCapacity - middle - 1);
+            std::memcpy(right->keys, left->keys + middle + 1, right->count * sizeof(K));
+            std::memcpy(right->children, left->children + middle + 1, (right->count + 1) * sizeof(Node*));
+            left->count = static_cast<uint16_t>(middle);
+            insertIntoInner(parent, i, left->keys[middle], right);
+        }
+    }
+
+    /**
+     * @brief Gives child i of `parent` more than the minimum number of keys, so an erase
+     * below it cannot leave it under-full. Borrows one entry from a sibling that can spare it,
+     * or merges with a sibling.
+     *
+     * @return The child to descend into (the left sibling if the child was merged into it).
+     */
+    Node* refillChild(Inner* parent, size_t i) {
+        Node* child = parent->children[i];
+        Node* left = i > 0 ? parent->children[i - 1] : nullptr;
+        Node* right = i < parent->count ? parent->children[i + 1] : nullptr;
+        size_t minimum = child->leaf ? minLeaf : minInner;
+
+        if (child->leaf) {
+            Leaf* c = asLeaf(child);
+            if (left && left->count > minimum) {
+                Leaf* l = asLeaf(left);
+                std::memmove(c->keys + 1, c->keys, c->count * sizeof(K));
+                std::memmove(c->values + 1, c->values, c->count * sizeof(V));
+                c->keys[0] = l->keys[l->count - 1];
+                c->values[0] = l->values[l->count - 1];
+                c->count++;
+                l->count--;
+                parent->keys[i - 1] = c->keys[0];
+                return c;
+            }
+            if (right && right->count > minimum) {
+                Leaf* r = asLeaf(right);
+                c->keys[c->count] = r->keys[0];
+                c->values[c->count] = r->values[0];
+                c->count++;
+                std::memmove(r->keys, r->keys + 1, (r->count - 1) * sizeof(K));
+                std::memmove(r->values, r->values + 1, (r->count - 1) * sizeof(V));
+                r->count--;
+                parent->keys[i] = r->keys[0];
+                return c;
+            }
+            // Merge the right one of the pair into the left one.
+            Leaf* l = right ? c : asLeaf(left);
+            Leaf* r = right ? asLeaf(right) : c;
+            std::memcpy(l->keys + l->count, r->keys, r->count * sizeof(K));
+            std::memcpy(l->values + l->count, r->values, r->count * sizeof(V));
+            l->count = static_cast<uint16_t>(l->count + r->count);
+            l->next = r->next;
+            if (r->next) r->next->prev = l;
+            else tail = l;
+            removeFromInner(parent, right ? i : i - 1);
+            freeNode(r);
+            return l;
+        }
+
+        Inner* c = asInner(child);
+        if (left && left->count > minimum) {
+            Inner* l = asInner(left);
+            std::memmove(c->keys + 1, c->keys, c->count * sizeof(K));
+            std::memmove(c->children + 1, c->children, (c->count + 1) * sizeof(Node*));
+            c->keys[0] = parent->keys[i - 1];
+            c->children[0] = l->children[l->count];
+            c->count++;
+            parent->keys[i - 1] = l->keys[l->count - 1];
+            l->count--;
+            return c;
+        }
+        if (right && right->count > minimum) {
+            Inner* r = asInner(right);
+            c->keys[c->count] = parent->keys[i];
+            c->children[c->count + 1] = r->children[0];
+            c->count++;
+            parent->keys[i] = r->keys[0];
+            std::memmove(r->keys, r->keys + 1, (r->count - 1) * sizeof(K));
+            std::memmove(r->children, r->children + 1, r->count * sizeof(Node*));
+            r->count--;
+            return c;
+        }
+        // Merge: the separator comes down between the two halves.
+        size_t separator = right ? i : i - 1;
+        Inner* l = right ? c : asInner(left);
+        Inner* r = right ? asInner(right) : c;
+        l->keys[l->count] = parent->keys[separator];
+        std::memcpy(l->keys + l->count + 1, r->keys, r->count * sizeof(K));
+        std::memcpy(l->children + l->count + 1, r->children, (r->count + 1) * sizeof(Node*));
+        l->count = static_cast<uint16_t>(l->count + 1 + r->count);
+        removeFromInner(parent, separator);
+        freeNode(r);
+        return l;
+    }
+
+    /**
+     * @brief Builds the tree bottom-up from `n` entries already in strictly increasing key order.
+     *
+     * Each level is cut into nodes of `perLeaf` / `perInner` entries, spread evenly so
+     * that the last node is not left nearly empty. `entryAt(i)` yields entry i as {key, value}.
+     */
+    template <typename EntryAt>
+    void build(size_t n, size_t perLeaf, size_t perInner, EntryAt entryAt) {
+        if (n == 0) return;
+        size_t nodes = (n + perLeaf - 1) / perLeaf;
+        unique_ptr<Node*[]> level(new Node*[nodes]);
+        unique_ptr<K[]> lowest(new K[nodes]);   // smallest key under each node of `level`
+        size_t built = 0;
+        try {
+            size_t next = 0;
+            Leaf* previous = nullptr;
+            for (; built < nodes; built++) {
+                Leaf* leaf = newLeaf();
+                size_t take = n / nodes + (built < n % nodes);
+                for (size_t j = 0; j < take; j++) {
+                    pair<K, V> entry = entryAt(next++);
+                    leaf->keys[j] = entry.first;
+                    leaf->values[j] = entry.second;
+                }
+                leaf->count = static_cast<uint16_t>(take);
+                leaf->prev = previous;
+                if (previous) previous->next = leaf;
+                previous = leaf;
+                level[built] = leaf;
+                lowest[built] = leaf->keys[0];
+            }
+            head = asLeaf(level[0]);
+            tail = previous;
+            levels = 1;
+
+            // Each inner node takes up to perInner + 1 children, and at least 2.
+            while (nodes > 1) {
+                size_t parents = (nodes + perInner) / (perInner + 1);
+                if (parents > nodes / 2) parents = nodes / 2;
+                size_t child = 0;
+                for (size_t p = 0; p < parents; p++) {
+                    Inner* inner;
+                    try {
+                        inner = newInner();
+                    }
+                    catch (...) {
+                        for (size_t j = child; j < nodes; j++) destroy(level[j]);   // not yet adopted
+                        built = p;
+                        throw;
+                    }
+                    size_t take = nodes / parents + (p < nodes % parents);
+                    K first = lowest[child];
+                    inner->children[0] = level[child++];
+                    for (size_t j = 1; j < take; j++) {
+                        inner->keys[j - 1] = lowest[child];
+                        inner->children[j] = level[child++];
+                    }
+                    inner->count = static_cast<uint16_t>(take - 1);
+                    level[p] = inner;   // p < child: this level's nodes are already taken
+                    lowest[p] = first;
+                }
+                nodes = parents;
+                built = parents;
+                levels++;
+            }
+        }
+        catch (...) {
+            // `level[0, built)` holds the roots of the subtrees built so far.
+            for (size_t i = 0; i < built; i++) destroy(level[i]);
+            head = tail = nullptr;
+            levels = 0;
+            throw;
+        }
+        root = level[0];
+        count = n;
+    }
+
+public:
+    /**
+     * @brief What iteration yields: the key (read-only) and the mapped value.
+     *
+     * Example:
+     *   for (auto [key, value] : tree) { ... }   // ascending key order
+     */
+    template <typename MappedRef>
+    struct EntryRef {
+        const K& key;
+        MappedRef value;
+    };
+
+    // Walks the leaf chain: ++ stays inside a leaf until it runs out, then follows `next`.
+    template <typename LeafPtr, typename MappedRef>
+    class LeafIterator {
+        LeafPtr leaf = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = EntryRef<MappedRef>;
+        using difference_type = ptrdiff_t;
+        using reference = EntryRef<MappedRef>;
+        using pointer = void;
+
+        LeafIterator() = default;
+        LeafIterator(LeafPtr leaf, size_t index) : leaf(leaf), index(index) {
+            if (leaf && index == leaf->count) ++*this;   // a lower bound past a leaf's last key
+        }
+
+        reference operator*() const { return { leaf->keys[index], leaf->values[index] }; }
+        LeafIterator& operator++() {
+            if (++index >= leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        LeafIterator operator++(int) { LeafIterator previous = *this; ++*this; return previous; }
+        bool operator==(const LeafIterator& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const LeafIterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = LeafIterator<Leaf*, V&>;
+    using const_iterator = LeafIterator<const Leaf*, const V&>;
+
+    BPlusTree() = default;
+
+    // Copies by bulk-loading the other tree's entries: O(n), with full nodes.
+    BPlusTree(const BPlusTree& other) {
+        const Leaf* leaf = other.head;
+        size_t index = 0;
+        build(other.count, leafCapacity, innerCapacity, [&](size_t) {
+            if (index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            pair<K, V> entry(leaf->keys[index], leaf->values[index]);
+            index++;
+            return entry;
+        });
+    }
+
+    BPlusTree(BPlusTree&& other) noexcept
+        : root(other.root), head(other.head), tail(other.tail), count(other.count), levels(other.levels) {
+        other.root = nullptr;
+        other.head = other.tail = nullptr;
+        other.count = other.levels = 0;
+    }
+
+    BPlusTree& operator=(BPlusTree other) noexcept {
+        std::swap(root, other.root);
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+        std::swap(levels, other.levels);
+        return *this;
+    }
+
+    ~BPlusTree() { destroy(root); }
+
+    /**
+     * @brief Inserts `key` -> `value` if the key is absent.
+     *
+     * Full nodes met on the way down are split first, so the leaf always has room and
+     * nothing has to be fixed on the way back up.
+     *
+     * Time Complexity  : O(log n) = O(height x node search)
+     * Example:
+     *   tree = {10: a, 30: c}
+     *   tree.insert(20, b)  ->  true,  {10: a, 20: b, 30: c}
+     *   tree.insert(20, x)  ->  false, unchanged
+     *
+     * @return true if the entry was inserted.
+     */
+    bool insert(const K& key, const V& value) {
+        if (!root) {
+            head = tail = newLeaf();
+            root = head;
+            levels = 1;
+        }
+        if (isFull(root)) {
+            Inner* top = newInner();
+            Node* sibling;
+            try {
+                sibling = newLike(root);
+            }
+            catch (...) {
+                freeNode(top);
+                throw;
+            }
+            top->children[0] = root;
+            splitChild(top, 0, sibling);
+            root = top;
+            levels++;
+        }
+        Node* node = root;
+        while (!node->leaf) {
+            Inner* inner = asInner(node);
+            size_t i = countLessEqual(inner->keys, inner->count, key);
+            if (isFull(inner->children[i])) {
+                splitChild(inner, i, newLike(inner->children[i]));
+                if (!(key < inner->keys[i])) i++;
+            }
+            node = inner->children[i];
+        }
+        Leaf* leaf = asLeaf(node);
+        size_t position = countLess(leaf->keys, leaf->count, key);
+        if (position < leaf->count && !(key < leaf->keys[position])) return false;
+        std::memmove(leaf->keys + position + 1, leaf->keys + position, (leaf->count - position) * sizeof(K));
+        std::memmove(leaf->values + position + 1, leaf->values + position, (leaf->count - position) * sizeof(V));
+        leaf->keys[position] = key;
+        leaf->values[position] = value;
+        leaf->count++;
+        count++;
+        return true;
+    }
+
+    // Inserts, or overwrites the value of an existing key. Returns true if it was inserted.
+    bool insertOrAssign(const K& key, const V& value) {
+        if (V* existing = find(key)) {
+            *existing = value;
+            return false;
+        }
+        return insert(key, value);
+    }
+
+    /**
+     * @brief Removes `key` if present.
+     *
+     * Children about to be descended into are refilled first (borrow or merge), so the
+     * erase never has to walk back up. An inner root left with one child is dropped.
+     *
+     * Time Complexity  : O(log n)
+     *
+     * @return true if the key was present.
+     */
+    bool erase(const K& key) {
+        if (!root) return false;
+        Node* node = root;
+        while (!node->leaf) {
+            Inner* inner = asInner(node);
+            size_t i = countLessEqual(inner->keys, inner->count, key);
+            Node* child = inner->children[i];
+            if (child->count <= (child->leaf ? minLeaf : minInner)) {
+                child = refillChild(inner, i);
+                if (inner == root && inner->count == 0) {
+                    root = child;
+                    freeNode(inner);
+                    levels--;
+                }
+            }
+            node = child;
+        }
+        Leaf* leaf = asLeaf(node);
+        size_t position = countLess(leaf->keys, leaf->count, key);
+        if (position == leaf->count || key < leaf->keys[position]) return false;
+        std::memmove(leaf->keys + position, leaf->keys + position + 1, (leaf->count - position - 1) * sizeof(K));
+        std::memmove(leaf->values + position, leaf->values + position + 1, (leaf->count - position - 1) * sizeof(V));
+        leaf->count--;
+        count--;
+        if (count == 0) {
+            freeNode(leaf);   // the root is a leaf once one entry is left
+            root = nullptr;
+            head = tail = nullptr;
+            levels = 0;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Pointer to the value stored for `key`, or nullptr.
+     *
+     * Time Complexity  : O(log n): one node per level, searched with SIMD compares for 32-bit keys
+     */
+    V* find(const K& key) { return const_cast<V*>(static_cast<const BPlusTree*>(this)->find(key)); }
+
+    const V* find(const K& key) const {
+        if (!root) return nullptr;
+        const Leaf* leaf = leafFor(key);
+        size_t position = countLess(leaf->keys, leaf->count, key);
+        if (position == leaf->count || key < leaf->keys[position]) return nullptr;
+        return &leaf->values[position];
+    }
+
+    bool contains(const K& key) const { return find(key) != nullptr; }
+
+    // Iterator to the first entry with a key >= `key`, or end().
+    iterator lowerBound(const K& key) {
+        if (!root) return end();
+        Leaf* leaf = const_cast<Leaf*>(leafFor(key));
+        return iterator(leaf, countLess(leaf->keys, leaf->count, key));
+    }
+
+    const_iterator lowerBound(const K& key) const {
+        if (!root) return end();
+        const Leaf* leaf = leafFor(key);
+        return const_iterator(leaf, countLess(leaf->keys, leaf->count, key));
+    }
+
+    /**
+     * @brief Calls `fn(key, value)` for every entry with first <= key < last, in order.
+     *
+     * One descent finds the first leaf; the rest is a sequential walk along the leaf chain,
+     * reading whole leaves of contiguous keys.
+     *
+     * Time Complexity  : O(log n + k) for k entries in range
+     * Example:
+     *   tree = {5, 10, 15, 20, 25}
+     *   tree.scan(10, 25, fn)  ->  fn(10), fn(15), fn(20)
+     *
+     * @return The number of entries visited.
+     */
+    template <typename Fn>
+    size_t scan(const K& first, const K& last, Fn&& fn) const {
+        if (!root || !(first < last)) return 0;
+        const Leaf* leaf = leafFor(first);
+        size_t index = countLess(leaf->keys, leaf->count, first);
+        size_t visited = 0;
+        while (leaf) {
+            // Everything up to `stop` is in range, so the inner loop has no bounds check per key.
+            size_t stop = countLess(leaf->keys, leaf->count, last);
+            if (stop > index) visited += stop - index;
+            for (; index < stop; index++) fn(leaf->keys[index], leaf->values[index]);
+            if (stop < leaf->count) break;
+            leaf = leaf->next;
+            index = 0;
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Replaces the contents with `n` entries given in strictly increasing key order.
+     *
+     * Builds the tree bottom-up: fills leaves left to right, then builds each inner level
+     * over the one below. No search, no split, and every node is written once.
+     * `fillFactor` is the share of each node to fill. 1.0 gives the smallest, shallowest
+     * tree; leave headroom (e.g. 0.7) when many inserts will follow, so they do not split
+     * every node at once. Pass `DynamicArray::data()` for data held in a DynamicArray.
+     *
+     * Time Complexity  : O(n)
+     * Example:
+     *   keys = [1, 2, 3, ..., 1000000], values = [...]
+     *   tree.bulkLoad(keys, values, 1000000)  ->  height 3 instead of ~20 levels of a BST
+     *
+     * @throws invalid_argument if the keys are not strictly increasing, or fillFactor is not in (0, 1].
+     *         The tree is unchanged.
+     */
+    void bulkLoad(const K* keys, const V* values, size_t n, float fillFactor = 1.0f) {
+        if (!(fillFactor > 0.0f && fillFactor <= 1.0f)) throw invalid_argument("Fill factor must be in (0, 1]");
+        for (size_t i = 1; i < n; i++) {
+            if (!(keys[i - 1] < keys[i])) throw invalid_argument("Keys must be strictly increasing");
+        }
+        size_t perLeaf = static_cast<size_t>(leafCapacity * fillFactor);
+        size_t perInner = static_cast<size_t>(innerCapacity * fillFactor);
+        BPlusTree loaded;
+        loaded.build(n, perLeaf < 1 ? 1 : perLeaf, perInner < 1 ? 1 : perInner,
+                     [&](size_t i) { return pair<K, V>(keys[i], values[i]); });
+        *this = std::move(loaded);
+    }
+
+    // Destroys every node.
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        head = tail = nullptr;
+        count = levels = 0;
+    }
+
+    iterator begin() { return iterator(head, 0); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head, 0); }
+    const_iterator end() const { return const_iterator(); }
+
+    // Smallest / largest entry. Throws runtime_error if the tree is empty.
+    pair<K, V> front() const {
+        if (!head) throw runtime_error("Tree is empty");
+        return { head->keys[0], head->values[0] };
+    }
+
+    pair<K, V> back() const {
+        if (!tail) throw runtime_error("Tree is empty");
+        return { tail->keys[tail->count - 1], tail->values[tail->count - 1] };
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    // Levels from the root to the leaves; 0 when empty.
+    size_t height() const { return levels; }
+};
+
+// ***************  ADAPTIVE RADIX TREE  ****************
+
+// Bytes of a compressed path stored in each node. Longer paths keep only their length
+// and first artMaxPrefix bytes; the rest is checked against a leaf's full key.
+constexpr size_t artMaxPrefix = 8;
+
+inline unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned n = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+* @brief A map from byte-string keys to V: a radix trie whose nodes grow and shrink with their fan-out (ART).
+*
+* A trie node indexed by the next key byte needs 256 child pointers (2 KB) however few
+* children it has. ART picks one of four layouts by the number of children:
+*
+*   Node4    up to   4 children   sorted keys[4]    + children[4]      64 bytes
+*   Node16   up to  16 children   sorted keys[16]   + children[16]     168 bytes, one SIMD compare
+*   Node48   up to  48 children   slotOf[256] bytes + children[48]     664 bytes
+*   Node256  up to 256 children   children[256]                        2072 bytes
+*
+* Path compression: a chain of single-child nodes collapses into a prefix stored in the
+* node below it, so "application" and "apply" share one node with prefix "appl".
+* Leaves hold the full key and the value, and hang off any level: a key is stored
+* as soon as it is the only one left on its path ("lazy expansion"). A key that ends exactly at a node
+* (like "app" next to "apple") is that node's `ending` leaf.
+*
+* Children are kept in byte order, so traversal visits keys in lexicographic (unsigned byte) order.
+*
+* @tparam V  The mapped type.
+*/
+template <typename V>
+class AdaptiveRadixTree {
+    // A child reference: a pointer to an inner node, or to a leaf with the low bit set.
+    using Ref = uintptr_t;
+
+    struct Leaf {
+        V value;
+        uint32_t length;
+        // The key bytes follow the struct in the same allocation.
+        const char* key() const { return reinterpret_cast<const char*>(this + 1); }
+        string_view view() const { return string_view(key(), length); }
+    };
+
+    enum NodeType : uint8_t { type4, type16, type48, type256 };
+
+    struct Inner {
+        NodeType type;
+        uint16_t count = 0;            // children
+        uint32_t prefixLength = 0;     // compressed path length (may exceed artMaxPrefix)
+        uint8_t prefix[artMaxPrefix];  // its first bytes
+        Leaf* ending = nullptr;        // the key that ends at this node, if any
+    };
+
+    struct Node4 : Inner {
+        uint8_t keys[4];
+        Ref children[4];
+    };
+
+    struct Node16 : Inner {
+        uint8_t keys[16];
+        Ref children[16];
+    };
+
+    struct Node48 : Inner {
+        uint8_t slotOf[256];   // 1 + index into children, 0 = no child for that byte
+        Ref children[48];
+    };
+
+    struct Node256 : Inner {
+        Ref children[256];
+    };
+
+    Ref root = 0;
+    size_t count = 0;
+    size_t bytes = 0;   // heap bytes held by nodes and leaves
+
+    static bool isLeaf(Ref ref) { return ref & 1; }
+    static Leaf* asLeaf(Ref ref) { return reinterpret_cast<Leaf*>(ref & ~Ref(1)); }
+    static Ref leafRef(Leaf* leaf) { return reinterpret_cast<Ref>(leaf) | 1; }
+    static Inner* asInner(Ref ref) { return reinterpret_cast<Inner*>(ref); }
+    static Ref innerRef(Inner* node) { return reinterpret_cast<Ref>(node); }
+
+    static bool matches(const Leaf* leaf, string_view key) {
+        return leaf->length == key.size() && (key.empty() || std::memcmp(leaf->key(), key.data(), key.size()) == 0);
+    }
+
+    static uint8_t byteAt(string_view key, size_t i) { return static_cast<uint8_t>(key[i]); }
+
+    template <typename ValueArg>
+    Leaf* makeLeaf(string_view key, ValueArg&& value) {
+        if (key.size() > UINT32_MAX) throw length_error("Key is too long");
+        void* memory = ::operator new(sizeof(Leaf) + key.size());
+        Leaf* leaf;
+        try {
+            leaf = ::new (memory) Leaf{ V(std::forward<ValueArg>(value)), static_cast<uint32_t>(key.size()) };
+        }
+        catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+        if (!key.empty()) std::memcpy(leaf + 1, key.data(), key.size());
+        bytes += sizeof(Leaf) + key.size();
+        AllocationTracker::recordAllocation(sizeof(Leaf) + key.size());
+        return leaf;
+    }
+
+    void freeLeaf(Leaf* leaf) {
+        bytes -= sizeof(Leaf) + leaf->length;
+        AllocationTracker::recordDeallocation(sizeof(Leaf) + leaf->length);
+        leaf->~Leaf();
+        ::operator delete(leaf);
+    }
+
+    template <typename Node>
+    Node* makeNode(NodeType type) {
+        Node* node = new Node();
+        node->type = type;
+        bytes += sizeof(Node);
+        AllocationTracker::recordAllocation(sizeof(Node));
+        return node;
+    }
+
+    void freeNode(Inner* node) {
+        size_t nodeBytes = 0;
+        switch (node->type) {
+        case type4:   nodeBytes = sizeof(Node4);   delete static_cast<Node4*>(node);   break;
+        case type16:  nodeBytes = sizeof(Node16);  delete static_cast<Node16*>(node);  break;
+        case type48:  nodeBytes = sizeof(Node48);  delete static_cast<Node48*>(node);  break;
+        case type256: nodeBytes = sizeof(Node256); delete static_cast<Node256*>(node); break;
+        }
+        bytes -= nodeBytes;
+        AllocationTracker::recordDeallocation(nodeBytes);
+    }
+
+    // Frees a subtree. Recursion depth is bounded by the longest key.
+    void destroy(Ref ref) {
+        if (ref == 0) return;
+        if (isLeaf(ref)) {
+            freeLeaf(asLeaf(ref));
+            return;
+        }
+        Inner* node = asInner(ref);
+        if (node->ending) freeLeaf(node->ending);
+        forEachChild(node, [this](uint8_t, Ref child) { destroy(child); return true; });
+        freeNode(node);
+    }
+
+    static void copyHeader(Inner* to, const Inner* from) {
+        to->count = from->count;
+        to->prefixLength = from->prefixLength;
+        std::memcpy(to->prefix, from->prefix, artMaxPrefix);
+        to->ending = from->ending;
+    }
+
+    /**
+     * @brief The slot holding the child for `byte`, or nullptr.
+     *
+     * Node16 compares all 16 keys with the byte at once (SSE2 / NEON) and takes the first match.
+     */
+    static Ref* findChild(Inner* node, uint8_t byte) {
+        switch (node->type) {
+        case type4: {
+            Node4* n = static_cast<Node4*>(node);
+            for (size_t i = 0; i < n->count; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case type16: {
+            Node16* n = static_cast<Node16*>(node);
+#if DS_TREES_SIMD_X86
+            __m128i match = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match)) & ((1u << n->count) - 1);
+            return mask ? &n->children[countTrailingZeros(mask)] : nullptr;
+#elif DS_TREES_SIMD_NEON
+            uint8x16_t match = vceqq_u8(vdupq_n_u8(byte), vld1q_u8(n->keys));
+            // Narrow each 8-bit lane to 4 bits: a 64-bit mask with 4 bits per key.
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+            if (n->count < 16) mask &= (uint64_t(1) << (4 * n->count)) - 1;
+            return mask ? &n->children[countTrailingZeros(mask) / 4] : nullptr;
+#else
+            for (size_t i = 0; i < n->count; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+#endif
+        }
+        case type48: {
+            Node48* n = static_cast<Node48*>(node);
+            return n->slotOf[byte] ? &n->children[n->slotOf[byte] - 1] : nullptr;
+        }
+        case type256: {
+            Node256* n = static_cast<Node256*>(node);
+            return n->children[byte] ? &n->children[byte] : nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    // Calls fn(byte, child) for every child in byte order, until fn returns false.
+    template <typename Fn>
+    static bool forEachChild(const Inner* node, Fn&& fn) {
+        switch (node->type) {
+        case type4: {
+            const Node4* n = static_cast<const Node4*>(node);
+            for (size_t i = 0; i < n->count; i++) {
+                if (!fn(n->keys[i], n->children[i])) return false;
+            }
+            break;
+        }
+        case type16: {
+            const Node16* n = static_cast<const Node16*>(node);
+            for (size_t i = 0; i < n->count; i++) {
+                if (!fn(n->keys[i], n->children[i])) return false;
+            }
+            break;
+        }
+        case type48: {
+            const Node48* n = static_cast<const Node48*>(node);
+            for (size_t b = 0; b < 256; b++) {
+                if (n->slotOf[b] && !fn(static_cast<uint8_t>(b), n->children[n->slotOf[b] - 1])) return false;
+            }
+            break;
+        }
+        case type256: {
+            const Node256* n = static_cast<const Node256*>(node);
+            for (size_t b = 0; b < 256; b++) {
+                if (n->children[b] && !fn(static_cast<uint8_t>(b), n->children[b])) return false;
+            }
+            break;
+        }
+        }
+        return true;
+    }
+
+    // Inserts into a sorted keys/children pair with room for one more.
+    static void insertSorted(uint8_t* keys, Ref* children, size_t n, uint8_t byte, Ref child) {
+        size_t position = 0;
+        while (position < n && keys[position] < byte) position++;
+        std::memmove(keys + position + 1, keys + position, n - position);
+        std::memmove(children + position + 1, children + position, (n - position) * sizeof(Ref));
+        keys[position] = byte;
+        children[position] = child;
+    }
+
+    /**
+     * @brief Adds a child for a byte the node does not have yet, growing the node
+     * to the next layout when it is full. `ref` is updated if the node is replaced.
+     *
+     * The bigger node is allocated before anything changes, so a failed allocation leaves the tree intact.
+     */
+    void addChild(Ref& ref, uint8_t byte, Ref child) {
+        Inner* node = asInner(ref);
+        switch (node->type) {
+        case type4: {
+            Node4* n = static_cast<Node4*>(node);
+            if (n->count < 4) {
+                insertSorted(n->keys, n->children, n->count, byte, child);
+                n->count++;
+                return;
+            }
+            Node16* grown = makeNode<Node16>(type16);
+            copyHeader(grown, n);
+            std::memcpy(grown->keys, n->keys, 4);
+            std::memcpy(grown->children, n->children, 4 * sizeof(Ref));
+            insertSorted(grown->keys, grown->children, 4, byte, child);
+            grown->count = 5;
+            freeNode(n);
+            ref = innerRef(grown);
+            return;
+        }
+        case type16: {
+            Node16* n = static_cast<Node16*>(node);
+            if (n->count < 16) {
+                insertSorted(n->keys, n->children, n->count, byte, child);
+                n->count++;
+                return;
+            }
+            Node48* grown = makeNode<Node48>(type48);
+            copyHeader(grown, n);
+            for (size_t i = 0; i < 16; i++) {
+                grown->children[i] = n->children[i];
+                grown->slotOf[n->keys[i]] = static_cast<uint8_t>(i + 1);
+            }
+            grown->children[16] = child;
+            grown->slotOf[byte] = 17;
+            grown->count = 17;
+            freeNode(n);
+            ref = innerRef(grown);
+            return;
+        }
+        case type48: {
+            Node48* n = static_cast<Node48*>(node);
+            if (n->count < 48) {
+                size_t slot = 0;
+                while (n->children[slot] != 0) slot++;   // erased children leave holes
+                n->children[slot] = child;
+                n->slotOf[byte] = static_cast<uint8_t>(slot + 1);
+                n->count++;
+                return;
+            }
+            Node256* grown = makeNode<Node256>(type256);
+            copyHeader(grown, n);
+            for (size_t b = 0; b < 256; b++) {
+                if (n->slotOf[b]) grown->children[b] = n->children[n->slotOf[b] - 1];
+            }
+            grown->children[byte] = child;
+            grown->count = 49;
+            freeNode(n);
+            ref = innerRef(grown);
+            return;
+        }
+        case type256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = child;
+            n->count++;
+            return;
+        }
+        }
+    }
+
+    /**
+     * @brief Removes the child for `byte`, moving to the next smaller layout once the
+     * node is well under its capacity (the gap avoids flip-flopping on add / remove).
+     *
+     * Shrinking allocates; if that fails the node just stays at its current size.
+     */
+    void removeChild(Ref& ref, uint8_t byte) {
+        Inner* node = asInner(ref);
+        switch (node->type) {
+        case type4:
+        case type16: {
+            uint8_t* keys = node->type == type4 ? static_cast<Node4*>(node)->keys : static_cast<Node16*>(node)->keys;
+            Ref* children = node->type == type4 ? static_cast<Node4*>(node)->children : static_cast<Node16*>(node)->children;
+            size_t i = 0;
+            while (keys[i] != byte) i++;
+            std::memmove(keys + i, keys + i + 1, node->count - i - 1);
+            std::memmove(children + i, children + i + 1, (node->count - i - 1) * sizeof(Ref));
+            node->count--;
+            if (node->type == type16 && node->count == 3) {
+                Node4* shrunk;
+                try { shrunk = makeNode<Node4>(type4); } catch (const bad_alloc&) { return; }
+                copyHeader(shrunk, node);
+                std::memcpy(shrunk->keys, keys, 3);
+                std::memcpy(shrunk->children, children, 3 * sizeof(Ref));
+                freeNode(node);
+                ref = innerRef(shrunk);
+            }
+            return;
+        }
+        case type48: {
+            Node48* n = static_cast<Node48*>(node);
+            n->children[n->slotOf[byte] - 1] = 0;
+            n->slotOf[byte] = 0;
+            n->count--;
+            if (n->count == 12) {
+                Node16* shrunk;
+                try { shrunk = makeNode<Node16>(type16); } catch (const bad_alloc&) { return; }
+                copyHeader(shrunk, n);
+                size_t j = 0;
+                for (size_t b = 0; b < 256; b++) {
+                    if (n->slotOf[b]) {
+                        shrunk->keys[j] = static_cast<uint8_t>(b);
+                        shrunk->children[j++] = n->children[n->slotOf[b] - 1];
+                    }
+                }
+                freeNode(n);
+                ref = innerRef(shrunk);
+            }
+            return;
+        }
+        case type256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = 0;
+            n->count--;
+            if (n->count == 37) {
+                Node48* shrunk;
+                try { shrunk = makeNode<Node48>(type48); } catch (const bad_alloc&) { return; }
+                copyHeader(shrunk, n);
+                size_t j = 0;
+                for (size_t b = 0; b < 256; b++) {
+                    if (n->children[b]) {
+                        shrunk->children[j] = n->children[b];
+                        shrunk->slotOf[b] = static_cast<uint8_t>(++j);
+                    }
+                }
+                freeNode(n);
+                ref = innerRef(shrunk);
+            }
+            return;
+        }
+        }
+    }
+
+    // Any leaf below `ref`; all of them share the compressed paths above it.
+    static const Leaf* minimumLeaf(Ref ref) {
+        while (!isLeaf(ref)) {
+            const Inner* node = asInner(ref);
+            if (node->ending) return node->ending;
+            forEachChild(node, [&ref](uint8_t, Ref child) { ref = child; return false; });
+        }
+        return asLeaf(ref);
+    }
+
+    /**
+     * @brief How many bytes of the node's compressed path match `key` from `depth`.
+     *
+     * The first artMaxPrefix bytes are in the node; beyond those, the path is read from the
+     * key of any leaf below.
+     */
+    static size_t prefixMismatch(const Inner* node, string_view key, size_t depth) {
+        size_t stored = node->prefixLength < artMaxPrefix ? node->prefixLength : artMaxPrefix;
+        size_t i = 0;
+        for (; i < stored; i++) {
+            if (depth + i >= key.size() || byteAt(key, depth + i) != node->prefix[i]) return i;
+        }
+        if (node->prefixLength > artMaxPrefix) {
+            string_view full = minimumLeaf(innerRef(const_cast<Inner*>(node)))->view();
+            for (; i < node->prefixLength; i++) {
+                if (depth + i >= key.size() || key[depth + i] != full[depth + i]) return i;
+            }
+        }
+        return node->prefixLength;
+    }
+
+    /**
+     * @brief After an erase below it: frees a node left with no children, and merges a
+     * node left with one child (and no ending key) into that child, so paths stay compressed.
+     */
+    void compact(Ref& ref) {
+        Inner* node = asInner(ref);
+        if (node->count == 0) {
+            ref = node->ending ? leafRef(node->ending) : 0;
+            freeNode(node);
+            return;
+        }
+        if (node->count > 1 || node->ending) return;
+        uint8_t byte = 0;
+        Ref child = 0;
+        forEachChild(node, [&](uint8_t b, Ref c) { byte = b; child = c; return false; });
+        if (!isLeaf(child)) {
+            // Child path becomes: node's path + the edge byte + the child's own path.
+            Inner* below = asInner(child);
+            uint8_t merged[artMaxPrefix];
+            size_t length = 0;
+            size_t fromNode = node->prefixLength < artMaxPrefix ? node->prefixLength : artMaxPrefix;
+            for (size_t i = 0; i < fromNode; i++) merged[length++] = node->prefix[i];
+            if (length < artMaxPrefix) merged[length++] = byte;
+            for (size_t i = 0; length < artMaxPrefix && i < below->prefixLength && i < artMaxPrefix; i++) merged[length++] = below->prefix[i];
+            std::memcpy(below->prefix, merged, length);
+            below->prefixLength += node->prefixLength + 1;
+        }
+        ref = child;
+        freeNode(node);
+    }
+
+    bool eraseAt(Ref& ref, string_view key, size_t depth) {
+        if (ref == 0) return false;
+        if (isLeaf(ref)) {
+            if (!matches(asLeaf(ref), key)) return false;
+            freeLeaf(asLeaf(ref));
+            ref = 0;
+            count--;
+            return true;
+        }
+        Inner* node = asInner(ref);
+        if (node->prefixLength != 0) {
+            if (prefixMismatch(node, key, depth) < node->prefixLength) return false;
+            depth += node->prefixLength;
+        }
+        if (depth == key.size()) {
+            if (!node->ending) return false;
+            freeLeaf(node->ending);
+            node->ending = nullptr;
+            count--;
+        }
+        else {
+            Ref* child = findChild(node, byteAt(key, depth));
+            if (!child || !eraseAt(*child, key, depth + 1)) return false;
+            if (*child == 0) removeChild(ref, byteAt(key, depth));
+        }
+        compact(ref);
+        return true;
+    }
+
+    // Visits a subtree in key order; returns false once `remaining` runs out.
+    template <typename Fn>
+    bool visit(Ref ref, Fn& fn, size_t& remaining) const {
+        if (isLeaf(ref)) {
+            Leaf* leaf = asLeaf(ref);
+            fn(leaf->view(), leaf->value);
+            return --remaining != 0;
+        }
+        const Inner* node = asInner(ref);
+        if (node->ending) {
+            fn(node->ending->view(), node->ending->value);
+            if (--remaining == 0) return false;
+        }
+        return forEachChild(node, [&](uint8_t, Ref child) { return visit(child, fn, remaining); });
+    }
+
+    /**
+     * @brief Finds `key`, or inserts a leaf for it built from `value`.
+     *
+     * @return The value, and whether it was inserted.
+     */
+    template <typename ValueArg>
+    pair<V*, bool> findOrInsert(string_view key, ValueArg&& value) {
+        Ref* slot = &root;
+        size_t depth = 0;
+        for (;;) {
+            Ref ref = *slot;
+            if (ref == 0) {
+                Leaf* fresh = makeLeaf(key, std::forward<ValueArg>(value));
+                *slot = leafRef(fresh);
+                count++;
+                return { &fresh->value, true };
+            }
+            if (isLeaf(ref)) {
+                // Lazy expansion ends here: split the leaf into a Node4 over the shared bytes.
+                Leaf* existing = asLeaf(ref);
+                if (matches(existing, key)) return { &existing->value, false };
+                string_view other = existing->view();
+                size_t limit = (other.size() < key.size() ? other.size() : key.size()) - depth;
+                size_t common = 0;
+                while (common < limit && other[depth + common] == key[depth + common]) common++;
+                Leaf* fresh = makeLeaf(key, std::forward<ValueArg>(value));
+                Node4* split;
+                try {
+                    split = makeNode<Node4>(type4);
+                }
+                catch (...) {
+                    freeLeaf(fresh);
+                    throw;
+                }
+                split->prefixLength = static_cast<uint32_t>(common);
+                std::memcpy(split->prefix, key.data() + depth, common < artMaxPrefix ? common : artMaxPrefix);
+                Ref splitRef = innerRef(split);
+                size_t at = depth + common;
+                if (other.size() == at) split->ending = existing;
+                else addChild(splitRef, byteAt(other, at), ref);
+                if (key.size() == at) split->ending = fresh;
+                else addChild(splitRef, byteAt(key, at), leafRef(fresh));
+                *slot = splitRef;
+                count++;
+                return { &fresh->value, true };
+            }
+            Inner* node = asInner(ref);
+            if (node->prefixLength != 0) {
+                size_t mismatch = prefixMismatch(node, key, depth);
+                if (mismatch < node->prefixLength) {
+                    // The key leaves the compressed path part-way: a Node4 takes the shared part,
+                    // and the old node keeps what is left after the branching byte.
+                    Leaf* fresh = makeLeaf(key, std::forward<ValueArg>(value));
+                    Node4* split;
+                    try {
+                        split = makeNode<Node4>(type4);
+                    }
+                    catch (...) {
+                        freeLeaf(fresh);
+                        throw;
+                    }
+                    const uint8_t* path = node->prefixLength <= artMaxPrefix
+                        ? node->prefix
+                        : reinterpret_cast<const uint8_t*>(minimumLeaf(ref)->key()) + depth;
+                    split->prefixLength = static_cast<uint32_t>(mismatch);
+                    std::memcpy(split->prefix, path, mismatch < artMaxPrefix ? mismatch : artMaxPrefix);
+                    uint8_t edge = path[mismatch];
+                    size_t rest = node->prefixLength - mismatch - 1;
+                    std::memmove(node->prefix, path + mismatch + 1, rest < artMaxPrefix ? rest : artMaxPrefix);
+                    node->prefixLength = static_cast<uint32_t>(rest);
+                    Ref splitRef = innerRef(split);
+                    addChild(splitRef, edge, ref);
+                    if (key.size() == depth + mismatch) split->ending = fresh;
+                    else addChild(splitRef, byteAt(key, depth + mismatch), leafRef(fresh));
+                    *slot = splitRef;
+                    count++;
+                    return { &fresh->value, true };
+                }
+                depth += node->prefixLength;
+            }
+            if (depth == key.size()) {
+                if (node->ending) return { &node->ending->value, false };
+                node->ending = makeLeaf(key, std::forward<ValueArg>(value));
+                count++;
+                return { &node->ending->value, true };
+            }
+            if (Ref* child = findChild(node, byteAt(key, depth))) {
+                slot = child;
+                depth++;
+                continue;
+            }
+            Leaf* fresh = makeLeaf(key, std::forward<ValueArg>(value));
+            try {
+                addChild(*slot, byteAt(key, depth), leafRef(fresh));
+            }
+            catch (...) {
+                freeLeaf(fresh);
+                throw;
+            }
+            count++;
+            return { &fresh->value, true };
+        }
+    }
+
+public:
+    // How many nodes of each layout the tree uses (see stats()).
+    struct NodeStats {
+        size_t node4 = 0, node16 = 0, node48 = 0, node256 = 0, leaves = 0;
+    };
+
+    AdaptiveRadixTree() = default;
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+    AdaptiveRadixTree(AdaptiveRadixTree&& other) noexcept : root(other.root), count(other.count), bytes(other.bytes) {
+        other.root = 0;
+        other.count = other.bytes = 0;
+    }
+
+    AdaptiveRadixTree& operator=(AdaptiveRadixTree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            std::swap(root, other.root);
+            std::swap(count, other.count);
+            std::swap(bytes, other.bytes);
+        }
+        return *this;
+    }
+
+    ~AdaptiveRadixTree() { destroy(root); }
+
+    /**
+     * @brief Inserts `key` -> `value` if the key is absent.
+     *
+     * Time Complexity  : O(m) for a key of m bytes, independent of the number of keys
+     * Example:
+     *   trie = {"apple"}
+     *   trie.insert("apply", 2)  ->  true:  Node4 "appl" -> 'e': "apple", 'y': "apply"
+     *   trie.insert("app", 3)    ->  true:  Node4 "app" (ending "app") -> 'l': Node4 ...
+     *
+     * @return true if the key was inserted.
+     */
+    bool insert(string_view key, const V& value) { return findOrInsert(key, value).second; }
+
+    // Inserts, or overwrites the value of an existing key. Returns true if it was inserted.
+    bool insertOrAssign(string_view key, const V& value) {
+        pair<V*, bool> result = findOrInsert(key, value);
+        if (!result.second) *result.first = value;
+        return result.second;
+    }
+
+    /**
+     * @brief Pointer to the value stored for `key`, or nullptr.
+     *
+     * Compressed paths are compared only as far as the node stores them; the leaf
+     * reached at the end is compared with the whole key.
+     *
+     * Time Complexity  : O(m)
+     */
+    V* find(string_view key) { return const_cast<V*>(static_cast<const AdaptiveRadixTree*>(this)->find(key)); }
+
+    const V* find(string_view key) const {
+        Ref ref = root;
+        size_t depth = 0;
+        while (ref != 0) {
+            if (isLeaf(ref)) {
+                Leaf* leaf = asLeaf(ref);
+                return matches(leaf, key) ? &leaf->value : nullptr;
+            }
+            Inner* node = asInner(ref);
+            if (node->prefixLength != 0) {
+                if (key.size() < depth + node->prefixLength) return nullptr;
+                size_t stored = node->prefixLength < artMaxPrefix ? node->prefixLength : artMaxPrefix;
+                if (std::memcmp(key.data() + depth, node->prefix, stored) != 0) return nullptr;
+                depth += node->prefixLength;
+            }
+            if (depth == key.size()) return node->ending && matches(node->ending, key) ? &node->ending->value : nullptr;
+            Ref* child = findChild(node, byteAt(key, depth));
+            if (!child) return nullptr;
+            ref = *child;
+            depth++;
+        }
+        return nullptr;
+    }
+
+    bool contains(string_view key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Removes `key` if present. Nodes shrink to smaller layouts as they empty,
+     * and a node left with a single child is merged into it.
+     *
+     * Time Complexity  : O(m)
+     *
+     * @return true if the key was present.
+     */
+    bool erase(string_view key) { return eraseAt(root, key, 0); }
+
+    /**
+     * @brief Calls `fn(key, value)` for the keys starting with `prefix`, in lexicographic order,
+     * stopping after `limit` of them.
+     *
+     * Descends along the prefix once, then walks only the subtree below it. With a
+     * small limit this is the autocomplete query: the first few completions of what
+     * has been typed so far.
+     *
+     * Time Complexity  : O(|prefix| + output)
+     * Example:
+     *   trie = {"car", "card", "care", "cat", "dog"}
+     *   trie.forEachWithPrefix("car", fn)     ->  fn("car"), fn("card"), fn("care")
+     *   trie.forEachWithPrefix("ca", fn, 2)   ->  fn("car"), fn("card")
+     *
+     * @return The number of keys visited.
+     */
+    template <typename Fn>
+    size_t forEachWithPrefix(string_view prefix, Fn&& fn, size_t limit = SIZE_MAX) const {
+        if (limit == 0) return 0;
+        Ref ref = root;
+        size_t depth = 0;
+        while (ref != 0) {
+            if (!isLeaf(ref)) {
+                const Inner* node = asInner(ref);
+                if (depth + node->prefixLength < prefix.size()) {
+                    // The prefix goes past this node's path: follow the next byte.
+                    size_t stored = node->prefixLength < artMaxPrefix ? node->prefixLength : artMaxPrefix;
+                    if (std::memcmp(prefix.data() + depth, node->prefix, stored) != 0) return 0;
+                    depth += node->prefixLength;
+                    Ref* child = findChild(const_cast<Inner*>(node), byteAt(prefix, depth));
+                    if (!child) return 0;
+                    ref = *child;
+                    depth++;
+                    continue;
+                }
+            }
+            // Every key below `ref` shares its path, so one leaf tells whether they all match.
+            string_view sample = minimumLeaf(ref)->view();
+            if (sample.substr(0, prefix.size()) != prefix) return 0;
+            size_t remaining = limit;
+            visit(ref, fn, remaining);
+            return limit - remaining;
+        }
+        return 0;
+    }
+
+    // Calls fn(key, value) for every key, in lexicographic order.
+    template <typename Fn>
+    void forEach(Fn&& fn) const { forEachWithPrefix(string_view(), fn); }
+
+    // Counts nodes by layout.
+    NodeStats stats() const {
+        NodeStats result;
+        if (root == 0) return result;
+        auto walk = [&result](Ref ref, auto& self) -> void {
+            if (isLeaf(ref)) {
+                result.leaves++;
+                return;
+            }
+            const Inner* node = asInner(ref);
+            if (node->ending) result.leaves++;
+            switch (node->type) {
+            case type4:   result.node4++;   break;
+            case type16:  result.node16++;  break;
+            case type48:  result.node48++;  break;
+            case type256: result.node256++; break;
+            }
+            forEachChild(node, [&](uint8_t, Ref child) { self(child, self); return true; });
+        };
+        walk(root, walk);
+        return result;
+    }
+
+    void clear() {
+        destroy(root);
+        root = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    // Heap bytes used by nodes and leaves (keys included).
+    size_t memoryBytes() const { return bytes; }
+};
 
 int main()
 {
-    std::cout << "Hello World!\n";
-}
+    // ---------------------------------------------------------------
+    // Test BinarySearchTree: nodes in an arena, linked by 32-bit indices
+    // ---------------------------------------------------------------
+    cout << "=== BinarySearchTree ===" << endl;
+    BinarySearchTree<int> bst;
+    for (int v : { 50, 30, 70, 20, 40, 60, 80 }) bst.insert(v);
+    cout << "insert x7          -> Expected : [20, 30, 40, 50, 60, 70, 80] | Result : "; bst.display();
+    cout << "insert duplicate   -> Expected : false | Result : " << (bst.insert(40) ? "true" : "false") << endl;
+    cout << "contains(60 / 65)  -> Expected : true / false | Result : " << (bst.contains(60) ? "true" : "false")
+         << " / " << (bst.contains(65) ? "true" : "false") << endl;
+    bst.erase(30);   // two children: 40 takes its place
+    cout << "erase(30)          -> Expected : [20, 40, 50, 60, 70, 80] | Result : "; bst.display();
+    cout << "min / max / height -> Expected : 20 / 80 / 3 | Result : " << bst.min() << " / " << bst.max() << " / " << bst.height() << endl;
+    BinarySearchTree<int> chain;
+    for (int v = 0; v < 5000; v++) chain.insert(v);   // sorted input: the tree degenerates into a list
+    size_t visited = 0;
+    chain.forEachInOrder([&visited](int) { visited++; });
+    cout << "sorted inserts     -> Expected : height 5000, 5000 visited (no stack overflow) | Result : height "
+         << chain.height() << ", " << visited << " visited" << endl;
+
+    // ---------------------------------------------------------------
+    // Test AvlTree: rotations keep it balanced
+    // ---------------------------------------------------------------
+    cout << "\n=== AvlTree ===" << endl;
+    AvlTree<int> avl;
+    for (int v = 1; v <= 7; v++) avl.insert(v);
+    cout << "insert 1..7        -> Expected : height 3, [1, 2, 3, 4, 5, 6, 7] | Result : height " << avl.height() << ", ";
+    avl.display();
+    AvlTree<int> sequential;
+    for (int v = 0; v < 100000; v++) sequential.insert(v);
+    cout << "insert 0..99999    -> Expected : height 17 (a plain BST: 100000) | Result : height " << sequential.height() << endl;
+    for (int v = 0; v < 100000; v += 2) sequential.erase(v);
+    cout << "erase evens        -> Expected : 50000 left, height 16, min 1 | Result : " << sequential.size()
+         << " left, height " << sequential.height() << ", min " << sequential.min() << endl;
+    AvlTree<string> words;
+    for (const char* w : { "pear", "apple", "fig", "kiwi", "banana" }) words.insert(w);
+    words.erase("fig");
+    cout << "string values      -> Expected : [apple, banana, kiwi, pear] | Result : "; words.display();
+
+    // ---------------------------------------------------------------
+    // Test buildFromSorted: balanced in O(n), no rotations; O(1) teardown
+    // ---------------------------------------------------------------
+    cout << "\n=== buildFromSorted ===" << endl;
+    const size_t sortedCount = 1000000;
+    unique_ptr<int[]> sortedValues(new int[sortedCount]);
+    for (size_t i = 0; i < sortedCount; i++) sortedValues[i] = static_cast<int>(i * 2);
+    AvlTree<int> built;
+    built.buildFromSorted(sortedValues.get(), sortedCount);
+    cout << "build 1000000      -> Expected : 1000000 values, height 20 | Result : " << built.size()
+         << " values, height " << built.height() << endl;
+    cout << "contains(777776)   -> Expected : true | Result : " << (built.contains(777776) ? "true" : "false") << endl;
+    built.insert(1);   // the built tree is a valid AVL tree, so normal updates carry on from it
+    cout << "insert after build -> Expected : height 21, min 0 | Result : height " << built.height() << ", min " << built.min() << endl;
+    size_t slabs = built.arenaSlabs();
+    built.clear();     // drops all nodes at once, keeps the slabs
+    built.buildFromSorted(sortedValues.get(), sortedCount / 2);
+    cout << "clear + rebuild    -> Expected : 500000 values, no new slabs | Result : " << built.size() << " values, "
+         << (built.arenaSlabs() == slabs ? "no new slabs" : "allocated again!") << endl;
+    int unsorted[] = { 1, 3, 2 };
+    try {
+        built.buildFromSorted(unsorted, 3);
+    }
+    catch (const invalid_argument& e) {
+        cout << "buildFromSorted(unsorted) correctly threw: " << e.what() << " (tree keeps " << built.size() << " values)" << endl;
+    }
+    try {
+        BinarySearchTree<int>().min();
+    }
+    catch (const runtime_error& e) {
+        cout << "min() on empty correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test BPlusTree: basic operations
+    // ---------------------------------------------------------------
+    cout << "\n=== BPlusTree ===" << endl;
+    cout << "node capacity      -> Expected : 29 entries per leaf, 20 keys per inner node (int -> int, 256 bytes) | Result : "
+         << BPlusTree<int, int>::leafCapacity << " entries per leaf, " << BPlusTree<int, int>::innerCapacity
+         << " keys per inner node" << endl;
+    BPlusTree<int, int> prices;
+    prices.insert(30, 300);
+    prices.insert(10, 100);
+    prices.insert(20, 200);
+    cout << "insert x3          -> Expected : 3 | Result : " << prices.size() << endl;
+    cout << "insert duplicate   -> Expected : false | Result : " << (prices.insert(20, 999) ? "true" : "false") << endl;
+    cout << "find(20)           -> Expected : 200 | Result : " << *prices.find(20) << endl;
+    cout << "find(25)           -> Expected : nullptr | Result : " << (prices.find(25) ? "found" : "nullptr") << endl;
+    cout << "in order           -> Expected : 10 20 30 | Result :";
+    for (auto [key, value] : prices) cout << " " << key;
+    cout << endl;
+    prices.insertOrAssign(20, 250);
+    cout << "insertOrAssign     -> Expected : 250 | Result : " << *prices.find(20) << endl;
+    cout << "erase(10)          -> Expected : true / front 20 | Result : " << (prices.erase(10) ? "true" : "false")
+         << " / front " << prices.front().first << endl;
+    prices.clear();
+    try {
+        prices.front();
+    }
+    catch (const runtime_error& e) {
+        cout << "front() on empty correctly threw: " << e.what() << endl;
+    }
+
+    // ---------------------------------------------------------------
+    // Test splits and merges: many keys, inserted and erased out of order
+    // ---------------------------------------------------------------
+    cout << "\n=== Splits & Merges ===" << endl;
+    BPlusTree<int, int> tree;
+    const int total = 100000;
+    for (int i = 0; i < total; i++) {
+        int key = static_cast<int>((static_cast<long long>(i) * 7919) % total);   // a permutation of 0..total-1
+        tree.insert(key, key * 2);
+    }
+    bool sorted = true;
+    int previous = -1;
+    for (auto [key, value] : tree) {
+        sorted = sorted && key == previous + 1 && value == key * 2;
+        previous = key;
+    }
+    cout << "100000 inserts     -> Expected : 100000, in order | Result : " << tree.size() << ", "
+         << (sorted ? "in order" : "out of order!") << endl;
+    cout << "height             -> Expected : 5 (a BST would need >= 17) | Result : " << tree.height() << endl;
+    for (int key = 0; key < total; key += 2) tree.erase(key);
+    bool oddsLeft = tree.size() == static_cast<size_t>(total / 2) && !tree.contains(500) && tree.contains(501);
+    cout << "erase evens        -> Expected : 50000, odds left | Result : " << tree.size() << ", "
+         << (oddsLeft ? "odds left" : "wrong keys!") << endl;
+    for (int key = 1; key < total; key += 2) tree.erase(key);
+    cout << "erase all          -> Expected : empty, height 0 | Result : " << (tree.isEmpty() ? "empty" : "not empty")
+         << ", height " << tree.height() << endl;
+
+    // ---------------------------------------------------------------
+    // Test range scans along the linked leaves
+    // ---------------------------------------------------------------
+    cout << "\n=== Range Scan ===" << endl;
+    BPlusTree<uint32_t, uint32_t> events;
+    for (uint32_t t = 0; t < 10000; t++) events.insert(t * 5, t);   // timestamps 0, 5, 10, ...
+    uint64_t sum = 0;
+    size_t hits = 0;
+    events.scan(1000, 2000, [&](uint32_t, uint32_t value) { sum += value; hits++; });
+    cout << "scan [1000, 2000)  -> Expected : 200 events, sum 59900 | Result : " << hits << " events, sum " << sum << endl;
+    auto it = events.lowerBound(1003);
+    cout << "lowerBound(1003)   -> Expected : 1005 | Result : " << (*it).key << endl;
+    cout << "lowerBound(99999)  -> Expected : end | Result : " << (events.lowerBound(99999) == events.end() ? "end" : "not end") << endl;
+    cout << "unsigned keys      -> Expected : 4000000000 found | Result : "
+         << (events.insert(4000000000u, 1) && events.contains(4000000000u) && events.back().first == 4000000000u ? "4000000000 found" : "missing!") << endl;
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+    // ---------------------------------------------------------------
+    // Test bulk loading from sorted arrays
+    // ---------------------------------------------------------------
+    cout << "\n=== Bulk Load ===" << endl;
+    const size_t n = 1000000;
+    unique_ptr<uint32_t[]> keys(new uint32_t[n]), values(new uint32_t[n]);
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = static_cast<uint32_t>(i * 3);
+        values[i] = static_cast<uint32_t>(i);
+    }
+    BPlusTree<uint32_t, uint32_t> loaded;
+    loaded.bulkLoad(keys.get(), values.get(), n);
+    cout << "bulkLoad(1000000)  -> Expected : 1000000 entries, height 5 | Result : " << loaded.size()
+         << " entries, height " << loaded.height() << endl;
+    cout << "find(2999997)      -> Expected : 999999 | Result : " << *loaded.find(2999997) << endl;
+    loaded.insert(1, 42);   // splits a full leaf
+    cout << "insert after load  -> Expected : 42, next key 3 | Result : " << *loaded.find(1) << ", next key "
+         << (*++loaded.lowerBound(1)).key << endl;
+    BPlusTree<uint32_t, uint32_t> roomy;
+    roomy.bulkLoad(keys.get(), values.get(), n, 0.7f);
+    cout << "fill factor 0.7    -> Expected : 1000000 entries | Result : " << roomy.size() << " entries" << endl;
+    BPlusTree<uint32_t, uint32_t> copy = roomy;
+    cout << "copy               -> Expected : 1000000 entries, find(300) = 100 | Result : " << copy.size()
+         << " entries, find(300) = " << *copy.find(300) << endl;
+    swap(keys[10], keys[11]);
+    try {
+        loaded.bulkLoad(keys.get(), values.get(), n);
+    }
+    catch (const invalid_argument& e) {
+        cout << "bulkLoad(unsorted) correctly threw: " << e.what() << " (tree keeps " << loaded.size() << " entries)" << endl;
+    }
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+    // ---------------------------------------------------------------
+    // Test AdaptiveRadixTree: path compression and prefix search
+    // ---------------------------------------------------------------
+    cout << "\n=== AdaptiveRadixTree ===" << endl;
+    AdaptiveRadixTree<int> dictionary;
+    for (const char* w : { "car", "card", "care", "careful", "cat", "dog" }) dictionary.insert(w, static_cast<int>(strlen(w)));
+    cout << "insert x6          -> Expected : 6 | Result : " << dictionary.size() << endl;
+    cout << "insert duplicate   -> Expected : false | Result : " << (dictionary.insert("cat", 0) ? "true" : "false") << endl;
+    cout << "find(\"care\")       -> Expected : 4 | Result : " << *dictionary.find("care") << endl;
+    cout << "find(\"ca\")         -> Expected : nullptr (only a prefix) | Result : " << (dictionary.find("ca") ? "found" : "nullptr") << endl;
+    cout << "prefix \"car\"       -> Expected : car card care careful | Result :";
+    dictionary.forEachWithPrefix("car", [](string_view key, int) { cout << " " << key; });
+    cout << endl;
+    cout << "autocomplete \"ca\"  -> Expected : 2 of them: car card | Result :";
+    size_t shown = dictionary.forEachWithPrefix("ca", [](string_view key, int) { cout << " " << key; }, 2);
+    cout << " (" << shown << " shown)" << endl;
+    dictionary.erase("car");
+    cout << "erase(\"car\")       -> Expected : card care careful | Result :";
+    dictionary.forEachWithPrefix("car", [](string_view key, int) { cout << " " << key; });
+    cout << endl;
+
+    // ---------------------------------------------------------------
+    // Test adaptive nodes: a node grows Node4 -> 16 -> 48 -> 256 and shrinks back
+    // ---------------------------------------------------------------
+    cout << "\n=== Adaptive Nodes ===" << endl;
+    AdaptiveRadixTree<int> fanout;
+    auto layout = [&fanout]() {
+        auto s = fanout.stats();
+        return to_string(s.node4) + "/" + to_string(s.node16) + "/" + to_string(s.node48) + "/" + to_string(s.node256);
+    };
+    string key = "x?";
+    for (int b = 0; b < 256; b++) {
+        key[1] = static_cast<char>(b);
+        fanout.insert(key, b);
+        if (b == 3 || b == 15 || b == 47 || b == 255) {
+            cout << (b + 1) << " children" << string(b < 9 ? 4 : b < 99 ? 3 : 2, ' ') << "      -> Expected : Node4/16/48/256 = "
+                 << (b == 3 ? "1/0/0/0" : b == 15 ? "0/1/0/0" : b == 47 ? "0/0/1/0" : "0/0/0/1") << " | Result : " << layout() << endl;
+        }
+    }
+    key[1] = static_cast<char>(200);
+    cout << "find(x\\xC8)        -> Expected : 200 | Result : " << *fanout.find(key) << endl;
+    for (int b = 0; b < 254; b++) {
+        key[1] = static_cast<char>(b);
+        fanout.erase(key);
+    }
+    cout << "erase to 2 keys    -> Expected : Node4/16/48/256 = 1/0/0/0 | Result : " << layout() << endl;
+
+    // ---------------------------------------------------------------
+    // Test memory per key on a large key set
+    // ---------------------------------------------------------------
+    cout << "\n=== Memory ===" << endl;
+    AdaptiveRadixTree<uint32_t> index;
+    char buffer[32];
+    const uint32_t keyCount = 200000;
+    size_t keyBytes = 0;
+    for (uint32_t i = 0; i < keyCount; i++) {
+        int length = snprintf(buffer, sizeof(buffer), "user/%u/profile", i * 7919u % keyCount);   // 0..199999, shuffled
+        index.insert(string_view(buffer, static_cast<size_t>(length)), i);
+        keyBytes += static_cast<size_t>(length);
+    }
+    auto layoutCounts = index.stats();
+    cout << "200000 keys        -> Expected : 200000 | Result : " << index.size() << endl;
+    cout << "bytes per key      -> Expected : under 3x the raw key + value (one 256-way node alone: 2048) | Result : "
+         << index.memoryBytes() / keyCount << " (key + value alone: " << (keyBytes + keyCount * sizeof(uint32_t)) / keyCount << ")" << endl;
+    cout << "node layouts       -> Expected : mostly small nodes | Result : Node4 " << layoutCounts.node4 << ", Node16 "
+         << layoutCounts.node16 << ", Node48 " << layoutCounts.node48 << ", Node256 " << layoutCounts.node256 << endl;
+    cout << "prefix user/19999  -> Expected : 11 keys (19999, 199990..199999) | Result : "
+         << index.forEachWithPrefix("user/19999", [](string_view, uint32_t) {}) << " keys" << endl;
+
+    // ---------------------------------------------------------------
+    // Test instrumentation (every counter is 0 unless built with -DDS_INSTRUMENT)
+    // ---------------------------------------------------------------
+    const bool instrumented = DS_TREES_INSTRUMENT != 0;
+    cout << "\n=== Instrumentation (DS_INSTRUMENT " << (instrumented ? "on" : "off") << ") ===" << endl;
+    AllocationTracker::reset();
+    size_t liveBefore = AllocationTracker::snapshot().liveBytes;   // the trees of the tests above
+    {
+        BinarySearchTree<int> chain;
+        AvlTree<int> balanced;
+        for (int i = 1; i <= 100; i++) {
+            chain.insert(i);
+            balanced.insert(i);
+        }
+        chain.resetStats();
+        balanced.resetStats();
+        chain.contains(100);
+        balanced.contains(100);
+        cout << "contains(100), sorted inserts -> Expected : BST " << (instrumented ? 100 : 0) << " nodes deep, AVL "
+             << (instrumented ? 7 : 0) << " | Result : BST " << chain.stats().deepestSearch << " nodes deep, AVL "
+             << balanced.stats().deepestSearch << endl;
+
+        size_t treesLive = AllocationTracker::snapshot().liveBytes;
+        AdaptiveRadixTree<uint32_t> words;
+        for (uint32_t i = 0; i < 1000; i++) {
+            int length = snprintf(buffer, sizeof(buffer), "word%u", i);
+            words.insert(string_view(buffer, static_cast<size_t>(length)), i);
+        }
+        size_t tracked = AllocationTracker::snapshot().liveBytes - treesLive;
+        cout << "ART of 1000 keys              -> Expected : tracked bytes == memoryBytes() | Result : "
+             << (!instrumented || tracked == words.memoryBytes() ? "tracked bytes == memoryBytes()" : "mismatch") << endl;
+    }
+    AllocationCounts heap = AllocationTracker::snapshot();
+    cout << "node memory after             -> Expected : allocations == frees, live +0 | Result : "
+         << (heap.allocations == heap.deallocations ? "allocations == frees" : "allocations != frees")
+         << " (" << heap.allocations << "), live +" << heap.liveBytes - liveBefore << endl;
+
+    return 0;
+}